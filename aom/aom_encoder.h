@@ -226,6 +226,10 @@ enum aom_kf_mode {
 typedef long aom_enc_frame_flags_t;
 #define AOM_EFLAG_FORCE_KF (1 << 0) /**< Force this frame to be a keyframe */
 
+/*!\brief Usage profiles passed as aom_codec_enc_cfg::g_usage */
+#define AOM_USAGE_GOOD_QUALITY (0) /**< Good quality, offline encoding */
+#define AOM_USAGE_REALTIME (1)     /**< Low latency, realtime encoding */
+
 /*!\brief Encoder configuration structure
  *
  * This structure contains the encoder settings that have common representations
@@ -683,6 +683,36 @@ enum aome_enc_control_id {
    * 0 : off, 1 : MAX_EXTREME_MV, 2 : MIN_EXTREME_MV
    */
   AV1E_ENABLE_MOTION_VECTOR_UNIT_TEST,
+
+  /*!\brief Codec control function to enable gathering of per-stage encoder
+   * timings, see aom_enc_stage_stats_t.
+   *
+   * 0 : off (default), 1 : on
+   */
+  AV1E_SET_ENABLE_STAGE_STATS,
+
+  /*!\brief Codec control function to get the accumulated per-stage encoder
+   * timings and counters, see aom_enc_stage_stats_t.
+   */
+  AV1E_GET_STAGE_STATS,
+
+  /*!\brief Codec control function to denoise the source before encoding.
+   *
+   * The value is the standard deviation of the noise, in 8-bit pixel units,
+   * assumed until a noise model has been fitted to the source. After that
+   * the fitted, intensity dependent noise strength is used. Only 8-bit
+   * sources are denoised.
+   *
+   * 0 : off (default), 1..50 : on
+   */
+  AV1E_SET_DENOISE_NOISE_LEVEL,
+
+  /*!\brief Codec control function to set the size of the blocks the noise
+   * model is fitted on when denoising the source.
+   *
+   * Valid range: 8..64, default is 32.
+   */
+  AV1E_SET_DENOISE_BLOCK_SIZE,
 };
 
 /*!\brief aom 1-D scaling mode
@@ -746,6 +776,29 @@ typedef struct aom_scaling_mode {
   AOM_SCALING_MODE v_scaling_mode; /**< vertical scaling mode   */
 } aom_scaling_mode_t;
 
+/*!\brief Encoder per-stage timings and counters
+ *
+ * Accumulated over all frames encoded so far, including recode iterations.
+ * Times are wall-clock microseconds summed over all encoder threads and are
+ * only gathered while AV1E_SET_ENABLE_STAGE_STATS is on; the counters are
+ * always gathered. Stages nest: partition_search includes the motion and
+ * transform searches run while evaluating partitions.
+ */
+typedef struct aom_enc_stage_stats {
+  int64_t partition_search;   /**< Superblock partition and mode search. */
+  int64_t motion_search;      /**< New motion vector search. */
+  int64_t tx_search;          /**< Luma transform type and size search. */
+  int64_t temporal_filter;    /**< Alt-ref temporal filtering. */
+  int64_t loop_filter_search; /**< Deblocking filter level search. */
+  int64_t cdef_search;        /**< CDEF strength search. */
+  int64_t restoration_search; /**< Loop restoration search. */
+  int64_t pack_bitstream;     /**< Bitstream packing, including dry runs. */
+  int64_t blocks_evaluated;   /**< Blocks evaluated by the mode search. */
+  int64_t early_terminations; /**< Partition and tx searches cut short. */
+  int64_t tx_cache_hits;      /**< Transform searches reused from cache. */
+  int frames;                 /**< Number of frames encoded. */
+} aom_enc_stage_stats_t;
+
 /*!brief AV1 encoder content type */
 typedef enum {
   AOM_CONTENT_DEFAULT,
@@ -933,6 +986,18 @@ AOM_CTRL_USE_TYPE(AV1E_SET_SINGLE_TILE_DECODING, unsigned int)
 AOM_CTRL_USE_TYPE(AV1E_ENABLE_MOTION_VECTOR_UNIT_TEST, unsigned int)
 #define AOM_CTRL_AV1E_ENABLE_MOTION_VECTOR_UNIT_TEST
 
+AOM_CTRL_USE_TYPE(AV1E_SET_ENABLE_STAGE_STATS, unsigned int)
+#define AOM_CTRL_AV1E_SET_ENABLE_STAGE_STATS
+
+AOM_CTRL_USE_TYPE(AV1E_GET_STAGE_STATS, aom_enc_stage_stats_t *)
+#define AOM_CTRL_AV1E_GET_STAGE_STATS
+
+AOM_CTRL_USE_TYPE(AV1E_SET_DENOISE_NOISE_LEVEL, unsigned int)
+#define AOM_CTRL_AV1E_SET_DENOISE_NOISE_LEVEL
+
+AOM_CTRL_USE_TYPE(AV1E_SET_DENOISE_BLOCK_SIZE, unsigned int)
+#define AOM_CTRL_AV1E_SET_DENOISE_BLOCK_SIZE
+
 /*!\endcond */
 /*! @} - end defgroup aom_encoder */
 #ifdef __cplusplus
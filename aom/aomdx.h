@@ -60,6 +60,52 @@ typedef struct aom_inspect_init {
   void *inspect_ctx;
 } aom_inspect_init;
 
+/*!\brief Structure to hold per-stage decoder timings.
+ *
+ * Accumulated wall-clock time, in microseconds, spent in each stage of the
+ * decoder since it was initialized. Tiles are parsed and reconstructed one
+ * superblock row at a time; with several threads a row is reconstructed while
+ * the next one is parsed, so the two stages overlap. coeff_read is only
+ * populated when the library is built with TXCOEFF_TIMER enabled.
+ */
+typedef struct aom_dec_stage_timing {
+  int64_t tile_parse;       /**< Tile symbol parsing. */
+  int64_t tile_recon;       /**< Tile prediction and reconstruction. */
+  int64_t coeff_read;       /**< Coefficient reading (TXCOEFF_TIMER only). */
+  int64_t loop_filter;      /**< Deblocking loop filter. */
+  int64_t cdef;             /**< Constrained directional enhancement. */
+  int64_t superres;         /**< Super-resolution upscaling. */
+  int64_t loop_restoration; /**< Loop restoration filtering. */
+  int frames;               /**< Number of frames decoded. */
+} aom_dec_stage_timing_t;
+
+/*!\brief Structure to hold the external reference frames.
+ *
+ * The images are used in place as references of the tiles of a tile list, see
+ * AV1D_SET_EXT_REF_PTR. They must keep their contents until the external
+ * references are set again or the decoder is destroyed.
+ */
+typedef struct av1_ext_ref_frame {
+  const aom_image_t *img; /**< Array of reference images. */
+  int num;                /**< Number of images in the array. */
+} av1_ext_ref_frame_t;
+
+/*!\brief Structure to hold one tile of a tile list.
+ */
+typedef struct aom_tile_list_entry {
+  int tile_row; /**< Tile row in the frame. */
+  int tile_col; /**< Tile column in the frame. */
+  int ref_idx;  /**< Index of its reference in the external references. */
+} aom_tile_list_entry_t;
+
+/*!\brief Structure to hold a tile list, see AV1D_SET_TILE_LIST.
+ */
+typedef struct aom_tile_list {
+  const aom_tile_list_entry_t *entries; /**< Tiles to decode, in order. */
+  int num_entries;                      /**< Number of tiles in the list. */
+  int output_cols; /**< Number of tiles per row of the output mosaic. */
+} aom_tile_list_t;
+
 /*!\enum aom_dec_control_id
  * \brief AOM decoder control functions
  *
@@ -152,6 +198,40 @@ enum aom_dec_control_id {
    */
   AV1_SET_INSPECTION_CALLBACK,
 
+  /** control function to get the accumulated per-stage decode timings, see
+   * aom_dec_stage_timing_t. With frame parallel decoding the timings of all
+   * frame workers are summed.
+   */
+  AV1D_GET_STAGE_TIMING,
+
+  /** control function to record bit accounting for every Nth decoded frame
+   * only, N being a positive integer. The Accounting of the other frames has
+   * no symbols. The default value is 1. When compiled without
+   * --enable-accounting, this returns AOM_CODEC_INCAPABLE.
+   */
+  AV1_SET_ACCOUNTING_INTERVAL,
+
+  /** control function to set the external reference frames of the tile list
+   * decoding, see av1_ext_ref_frame_t. The images are not copied and must
+   * have the dimensions and format of the decoded frames. A tile whose
+   * ref_idx selects one of them predicts from it in place of LAST_FRAME.
+   * This is only supported in serial decode. When compiled without
+   * --enable-ext_tile, this returns AOM_CODEC_INCAPABLE.
+   */
+  AV1D_SET_EXT_REF_PTR,
+
+  /** control function to set the tiles decoded from each large-scale tile
+   * frame, see aom_tile_list_t. Every following aom_codec_decode() call
+   * decodes the listed tiles, each from its own external reference, and
+   * aom_codec_get_frame() returns them as a mosaic which has output_cols
+   * tiles per row, in list order. The frame header and tile sizes are only
+   * parsed once per frame. The list is copied. A list without entries restores
+   * the normal decoding. Tile list decoding needs frames coded for single tile
+   * decoding and is only supported in serial decode. When compiled without
+   * --enable-ext_tile, this returns AOM_CODEC_INCAPABLE.
+   */
+  AV1D_SET_TILE_LIST,
+
   AOM_DECODER_CTRL_ID_MAX,
 };
 
@@ -189,6 +269,14 @@ AOM_CTRL_USE_TYPE(AV1_SET_TILE_MODE, unsigned int)
 #define AOM_CTRL_AV1_SET_TILE_MODE
 AOM_CTRL_USE_TYPE(AV1_SET_INSPECTION_CALLBACK, aom_inspect_init *)
 #define AOM_CTRL_AV1_SET_INSPECTION_CALLBACK
+AOM_CTRL_USE_TYPE(AV1D_GET_STAGE_TIMING, aom_dec_stage_timing_t *)
+#define AOM_CTRL_AV1D_GET_STAGE_TIMING
+AOM_CTRL_USE_TYPE(AV1_SET_ACCOUNTING_INTERVAL, int)
+#define AOM_CTRL_AV1_SET_ACCOUNTING_INTERVAL
+AOM_CTRL_USE_TYPE(AV1D_SET_EXT_REF_PTR, av1_ext_ref_frame_t *)
+#define AOM_CTRL_AV1D_SET_EXT_REF_PTR
+AOM_CTRL_USE_TYPE(AV1D_SET_TILE_LIST, aom_tile_list_t *)
+#define AOM_CTRL_AV1D_SET_TILE_LIST
 /*!\endcond */
 /*! @} - end defgroup aom_decoder */
 
@@ -19,6 +19,8 @@ print <<EOF
 #include "av1/common/enums.h"
 #include "av1/common/blockd.h"
 
+struct aom_flat_block_moments;
+
 EOF
 }
 forward_decls qw/aom_dsp_forward_decls/;
@@ -80,6 +82,12 @@ foreach $w (@tx_dims) {
 
 @pred_names = qw/dc dc_top dc_left dc_128 v h d207e d63e d45e d117 d135 d153 paeth smooth smooth_v smooth_h/;
 
+#
+# Entropy coding
+#
+add_proto qw/void aom_update_cdf/, "aom_cdf_prob *cdf, int val, int nsymbs";
+specialize qw/aom_update_cdf sse2 avx2/;
+
 #
 # Intra prediction
 #
@@ -708,6 +716,15 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
 
     add_proto qw/uint64_t aom_sum_squares_i16/, "const int16_t *src, uint32_t N";
     specialize qw/aom_sum_squares_i16 sse2/;
+
+    #
+    # Noise model
+    #
+    add_proto qw/void aom_flat_block_get_moments/, "const uint8_t *data, int stride, int block_size, struct aom_flat_block_moments *moments";
+    specialize qw/aom_flat_block_get_moments sse2/;
+
+    add_proto qw/void aom_noise_accumulate_covariance/, "const int16_t *samples, int num_samples, int n, int stride, int32_t *acc";
+    specialize qw/aom_noise_accumulate_covariance sse2/;
   }
 
 
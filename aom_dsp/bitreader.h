@@ -16,6 +16,7 @@
 #include <limits.h>
 
 #include "./aom_config.h"
+#include "./aom_dsp_rtcd.h"
 
 #include "aom/aomdx.h"
 #include "aom/aom_integer.h"
@@ -146,7 +147,12 @@ static INLINE int aom_read_symbol_(aom_reader *r, aom_cdf_prob *cdf,
                                    int nsymbs ACCT_STR_PARAM) {
   int ret;
   ret = aom_read_cdf(r, cdf, nsymbs, ACCT_STR_NAME);
-  if (r->allow_update_cdf) update_cdf(cdf, ret, nsymbs);
+  if (r->allow_update_cdf) {
+    if (nsymbs < CDF_UPDATE_MIN_SIMD_SYMBS)
+      update_cdf(cdf, ret, nsymbs);
+    else
+      aom_update_cdf(cdf, ret, nsymbs);
+  }
   return ret;
 }
 
@@ -14,6 +14,7 @@
 
 #include <assert.h>
 #include "./aom_config.h"
+#include "./aom_dsp_rtcd.h"
 
 #include "aom_dsp/daalaboolwriter.h"
 #include "aom_dsp/prob.h"
@@ -98,7 +99,12 @@ static INLINE void aom_write_cdf(aom_writer *w, int symb,
 static INLINE void aom_write_symbol(aom_writer *w, int symb, aom_cdf_prob *cdf,
                                     int nsymbs) {
   aom_write_cdf(w, symb, cdf, nsymbs);
-  if (w->allow_update_cdf) update_cdf(cdf, symb, nsymbs);
+  if (w->allow_update_cdf) {
+    if (nsymbs < CDF_UPDATE_MIN_SIMD_SYMBS)
+      update_cdf(cdf, symb, nsymbs);
+    else
+      aom_update_cdf(cdf, symb, nsymbs);
+  }
 }
 
 #if CONFIG_LV_MAP
@@ -13,6 +13,7 @@
 #include "./config.h"
 #endif
 
+#include "./aom_dsp_rtcd.h"
 #include "aom_dsp/entcode.h"
 
 /*Given the current total integer number of bits used and the current value of
@@ -51,3 +52,10 @@ uint32_t od_ec_tell_frac(uint32_t nbits_total, uint32_t rng) {
   }
   return nbits - l;
 }
+
+/*Adapts a CDF towards the symbol val that was just coded.
+  This is the reference for the SIMD versions of aom_update_cdf(); see
+   update_cdf() for the adaptation rule.*/
+void aom_update_cdf_c(aom_cdf_prob *cdf, int val, int nsymbs) {
+  update_cdf(cdf, val, nsymbs);
+}
@@ -23,6 +23,10 @@
    on a larger type, you can speed up the decoder by using it here.*/
 typedef uint32_t od_ec_window;
 
+/*The encoder buffers up to 7 bytes of output plus a carry byte before flushing
+   them, so its window is always 64 bits.*/
+typedef uint64_t od_ec_enc_window;
+
 #define OD_EC_WINDOW_SIZE ((int)sizeof(od_ec_window) * CHAR_BIT)
 
 /*The number of bits to use for the range-coded part of unsigned integers.*/
@@ -182,11 +182,12 @@ int od_ec_decode_bool_q15(od_ec_dec *dec, unsigned f) {
 int od_ec_decode_cdf_q15(od_ec_dec *dec, const uint16_t *icdf, int nsyms) {
   od_ec_window dif;
   unsigned r;
+  unsigned r8;
   unsigned c;
   unsigned u;
   unsigned v;
   int ret;
-  (void)nsyms;
+  int i;
   dif = dec->dif;
   r = dec->rng;
   const int N = nsyms - 1;
@@ -195,15 +196,32 @@ int od_ec_decode_cdf_q15(od_ec_dec *dec, const uint16_t *icdf, int nsyms) {
   OD_ASSERT(icdf[nsyms - 1] == OD_ICDF(CDF_PROB_TOP));
   OD_ASSERT(32768U <= r);
   OD_ASSERT(7 - EC_PROB_SHIFT - CDF_SHIFT >= 0);
+  OD_ASSERT(nsyms <= 16);
   c = (unsigned)(dif >> (OD_EC_WINDOW_SIZE - 16));
-  v = r;
-  ret = -1;
-  do {
-    u = v;
-    v = ((r >> 8) * (uint32_t)(icdf[++ret] >> EC_PROB_SHIFT) >>
-         (7 - EC_PROB_SHIFT - CDF_SHIFT));
-    v += EC_MIN_PROB * (N - ret);
-  } while (c < v);
+  r8 = r >> 8;
+  /*The thresholds are strictly decreasing in the symbol index, so the decoded
+     symbol is the number of them that lie above c.
+    Counting them in a single pass with no data-dependent exit lets the
+     compiler evaluate all of them at once instead of taking a hard to
+     predict branch per symbol.
+    The last threshold is always 0 and never needs to be compared.*/
+  ret = 0;
+  for (i = 0; i < N; ++i) {
+    v = (r8 * (uint32_t)(icdf[i] >> EC_PROB_SHIFT) >>
+         (7 - EC_PROB_SHIFT - CDF_SHIFT)) +
+        EC_MIN_PROB * (N - i);
+    ret += c < v;
+  }
+  u = r;
+  if (ret > 0) {
+    u = (r8 * (uint32_t)(icdf[ret - 1] >> EC_PROB_SHIFT) >>
+         (7 - EC_PROB_SHIFT - CDF_SHIFT)) +
+        EC_MIN_PROB * (N - (ret - 1));
+  }
+  v = (r8 * (uint32_t)(icdf[ret] >> EC_PROB_SHIFT) >>
+       (7 - EC_PROB_SHIFT - CDF_SHIFT)) +
+      EC_MIN_PROB * (N - ret);
+  OD_ASSERT(c >= v);
   OD_ASSERT(v < u);
   OD_ASSERT(u <= r);
   r = u - v;
@@ -17,6 +17,7 @@
 #include <string.h>
 #include "aom_dsp/entenc.h"
 #include "aom_dsp/prob.h"
+#include "aom_util/endian_inl.h"
 
 /*A range encoder.
   See entdec.c and the references for implementation details \cite{Mar79,MNW98}.
@@ -43,58 +44,92 @@
    URL="http://researchcommons.waikato.ac.nz/bitstream/handle/10289/78/content.pdf"
   }*/
 
+/*Adds a carry to the byte at offs and propagates it towards the start of the
+   buffer for as long as the bytes overflow.
+  Each byte that overflows becomes 0, so the run of 0xFF bytes this walks over
+   was produced by earlier symbols and is bounded by the data already output.*/
+static void propagate_carry_bwd(unsigned char *buf, uint32_t offs) {
+  uint16_t sum;
+  uint16_t carry = 1;
+  do {
+    sum = (uint16_t)buf[offs] + 1;
+    buf[offs--] = (unsigned char)sum;
+    carry = sum >> 8;
+  } while (carry);
+}
+
+/*Writes the num_bytes_ready least significant bytes of output to out + offs
+   in big-endian order with a single 8-byte store, then resolves the carry
+   into the bytes that were already written, if there is one.
+  The caller must guarantee that there are at least 8 bytes of storage left.*/
+static void write_enc_data_to_out_buf(unsigned char *out, uint32_t offs,
+                                      uint64_t output, uint64_t carry,
+                                      uint32_t *enc_offs,
+                                      uint8_t num_bytes_ready) {
+  const uint64_t reg = HToBE64(output << ((8 - num_bytes_ready) << 3));
+  memcpy(&out[offs], &reg, 8);
+  if (carry) {
+    OD_ASSERT(offs > 0);
+    propagate_carry_bwd(out, offs - 1);
+  }
+  *enc_offs = offs + num_bytes_ready;
+}
+
 /*Takes updated low and range values, renormalizes them so that
-   32768 <= rng < 65536 (flushing bytes from low to the pre-carry buffer if
+   32768 <= rng < 65536 (flushing bytes from low to the output buffer if
    necessary), and stores them back in the encoder context.
   low: The new value of low.
   rng: The new value of the range.*/
-static void od_ec_enc_normalize(od_ec_enc *enc, od_ec_window low,
+static void od_ec_enc_normalize(od_ec_enc *enc, od_ec_enc_window low,
                                 unsigned rng) {
   int d;
   int c;
   int s;
+  if (enc->error) return;
   c = enc->cnt;
   OD_ASSERT(rng <= 65535U);
+  /*The number of leading zeros in the 16-bit binary representation of rng.*/
   d = 16 - OD_ILOG_NZ(rng);
   s = c + d;
-  /*TODO: Right now we flush every time we have at least one byte available.
-    Instead we should use an od_ec_window and flush right before we're about to
-     shift bits off the end of the window.
-    For a 32-bit window this is about the same amount of work, but for a 64-bit
-     window it should be a fair win.*/
-  if (s >= 0) {
-    uint16_t *buf;
+  /*We flush only when low can no longer safely hold another symbol.
+    The 64-bit window must keep one byte free for the carry, so s may not
+     exceed 56 bits, and we leave 16 more bits of room for the next symbol's
+     shift of up to d bits.*/
+  if (s >= 40) {
+    unsigned char *out;
     uint32_t storage;
     uint32_t offs;
-    unsigned m;
-    buf = enc->precarry_buf;
-    storage = enc->precarry_storage;
+    uint8_t num_bytes_ready;
+    uint64_t output;
+    uint64_t mask;
+    uint64_t carry;
+    out = enc->buf;
+    storage = enc->storage;
     offs = enc->offs;
-    if (offs + 2 > storage) {
-      storage = 2 * storage + 2;
-      buf = (uint16_t *)realloc(buf, sizeof(*buf) * storage);
-      if (buf == NULL) {
+    if (offs + 8 > storage) {
+      storage = 2 * storage + 8;
+      out = (unsigned char *)realloc(out, sizeof(*out) * storage);
+      if (out == NULL) {
         enc->error = -1;
-        enc->offs = 0;
         return;
       }
-      enc->precarry_buf = buf;
-      enc->precarry_storage = storage;
-    }
-    c += 16;
-    m = (1 << c) - 1;
-    if (s >= 8) {
-      OD_ASSERT(offs < storage);
-      buf[offs++] = (uint16_t)(low >> c);
-      low &= m;
-      c -= 8;
-      m >>= 8;
+      enc->buf = out;
+      enc->storage = storage;
     }
-    OD_ASSERT(offs < storage);
-    buf[offs++] = (uint16_t)(low >> c);
+    /*cnt is biased by -9 (one byte plus the carry bit), so one more byte is
+       ready than s alone would indicate.*/
+    num_bytes_ready = (uint8_t)((s >> 3) + 1);
+    /*The number of bits left in low once the ready bytes are removed: the
+       64 - 40 bits of cushion minus the bits that are being output.*/
+    c += 24 - (num_bytes_ready << 3);
+    output = low >> c;
+    low &= ((uint64_t)1 << c) - 1;
+    mask = (uint64_t)1 << (num_bytes_ready << 3);
+    carry = output & mask;
+    output &= mask - 1;
+    write_enc_data_to_out_buf(out, offs, output, carry, &enc->offs,
+                              num_bytes_ready);
     s = c + d - 24;
-    low &= m;
-    enc->offs = offs;
   }
   enc->low = low << d;
   enc->rng = rng << d;
@@ -111,19 +146,10 @@ void od_ec_enc_init(od_ec_enc *enc, uint32_t size) {
     enc->storage = 0;
     enc->error = -1;
   }
-  enc->precarry_buf = (uint16_t *)malloc(sizeof(*enc->precarry_buf) * size);
-  enc->precarry_storage = size;
-  if (size > 0 && enc->precarry_buf == NULL) {
-    enc->precarry_storage = 0;
-    enc->error = -1;
-  }
 }
 
 /*Reinitializes the encoder.*/
 void od_ec_enc_reset(od_ec_enc *enc) {
-  enc->end_offs = 0;
-  enc->end_window = 0;
-  enc->nend_bits = 0;
   enc->offs = 0;
   enc->low = 0;
   enc->rng = 0x8000;
@@ -139,7 +165,6 @@ void od_ec_enc_reset(od_ec_enc *enc) {
 
 /*Frees the buffers used by the encoder.*/
 void od_ec_enc_clear(od_ec_enc *enc) {
-  free(enc->precarry_buf);
   free(enc->buf);
 }
 
@@ -152,7 +177,7 @@ void od_ec_enc_clear(od_ec_enc *enc) {
        the one to be encoded.*/
 static void od_ec_encode_q15(od_ec_enc *enc, unsigned fl, unsigned fh, int s,
                              int nsyms) {
-  od_ec_window l;
+  od_ec_enc_window l;
   unsigned r;
   unsigned u;
   unsigned v;
@@ -188,7 +213,7 @@ static void od_ec_encode_q15(od_ec_enc *enc, unsigned fl, unsigned fh, int s,
   val: The value to encode (0 or 1).
   f: The probability that the val is one, scaled by 32768.*/
 void od_ec_encode_bool_q15(od_ec_enc *enc, int val, unsigned f) {
-  od_ec_window l;
+  od_ec_enc_window l;
   unsigned r;
   unsigned v;
   OD_ASSERT(0 < f);
@@ -248,12 +273,11 @@ void od_ec_enc_patch_initial_bits(od_ec_enc *enc, unsigned val, int nbits) {
   mask = ((1U << nbits) - 1) << shift;
   if (enc->offs > 0) {
     /*The first byte has been finalized.*/
-    enc->precarry_buf[0] =
-        (uint16_t)((enc->precarry_buf[0] & ~mask) | val << shift);
+    enc->buf[0] = (unsigned char)((enc->buf[0] & ~mask) | val << shift);
   } else if (9 + enc->cnt + (enc->rng == 0x8000) > nbits) {
     /*The first byte has yet to be output.*/
-    enc->low = (enc->low & ~((od_ec_window)mask << (16 + enc->cnt))) |
-               (od_ec_window)val << (16 + enc->cnt + shift);
+    enc->low = (enc->low & ~((od_ec_enc_window)mask << (16 + enc->cnt))) |
+               (od_ec_enc_window)val << (16 + enc->cnt + shift);
   } else {
     /*The encoder hasn't even encoded _nbits of data yet.*/
     enc->error = -1;
@@ -273,13 +297,10 @@ void od_ec_enc_patch_initial_bits(od_ec_enc *enc, unsigned val, int nbits) {
 unsigned char *od_ec_enc_done(od_ec_enc *enc, uint32_t *nbytes) {
   unsigned char *out;
   uint32_t storage;
-  uint16_t *buf;
   uint32_t offs;
-  uint32_t end_offs;
-  int nend_bits;
-  od_ec_window m;
-  od_ec_window e;
-  od_ec_window l;
+  od_ec_enc_window m;
+  od_ec_enc_window e;
+  od_ec_enc_window l;
   unsigned r;
   int c;
   int s;
@@ -310,73 +331,39 @@ unsigned char *od_ec_enc_done(od_ec_enc *enc, uint32_t *nbytes) {
   }
   s += c;
   offs = enc->offs;
-  buf = enc->precarry_buf;
-  if (s > 0) {
-    unsigned n;
-    storage = enc->precarry_storage;
-    if (offs + ((s + 7) >> 3) > storage) {
-      storage = storage * 2 + ((s + 7) >> 3);
-      buf = (uint16_t *)realloc(buf, sizeof(*buf) * storage);
-      if (buf == NULL) {
-        enc->error = -1;
-        return NULL;
-      }
-      enc->precarry_buf = buf;
-      enc->precarry_storage = storage;
-    }
-    n = (1 << (c + 16)) - 1;
-    do {
-      OD_ASSERT(offs < storage);
-      buf[offs++] = (uint16_t)(e >> (c + 16));
-      e &= n;
-      s -= 8;
-      c -= 8;
-      n >>= 8;
-    } while (s > 0);
-  }
-  /*Make sure there's enough room for the entropy-coded bits and the raw
-     bits.*/
+  /*Make sure there's enough room for the remaining entropy-coded bits.*/
   out = enc->buf;
   storage = enc->storage;
-  end_offs = enc->end_offs;
-  e = enc->end_window;
-  nend_bits = enc->nend_bits;
-  s = -s;
-  c = OD_MAXI((nend_bits - s + 7) >> 3, 0);
-  if (offs + end_offs + c > storage) {
-    storage = offs + end_offs + c;
+  if (s > 0 && offs + ((s + 7) >> 3) > storage) {
+    storage = offs + ((s + 7) >> 3);
     out = (unsigned char *)realloc(out, sizeof(*out) * storage);
     if (out == NULL) {
       enc->error = -1;
       return NULL;
     }
-    OD_MOVE(out + storage - end_offs, out + enc->storage - end_offs, end_offs);
     enc->buf = out;
     enc->storage = storage;
   }
-  /*If we have buffered raw bits, flush them as well.*/
-  while (nend_bits > s) {
-    OD_ASSERT(end_offs < storage);
-    out[storage - ++end_offs] = (unsigned char)e;
-    e >>= 8;
-    nend_bits -= 8;
-  }
-  *nbytes = offs + end_offs;
-  /*Perform carry propagation.*/
-  OD_ASSERT(offs + end_offs <= storage);
-  out = out + storage - (offs + end_offs);
-  c = 0;
-  end_offs = offs;
-  while (offs > 0) {
-    offs--;
-    c = buf[offs] + c;
-    out[offs] = (unsigned char)c;
-    c >>= 8;
+  if (s > 0) {
+    od_ec_enc_window n;
+    n = ((od_ec_enc_window)1 << (c + 16)) - 1;
+    do {
+      uint16_t val;
+      OD_ASSERT(offs < storage);
+      val = (uint16_t)(e >> (c + 16));
+      out[offs] = (unsigned char)val;
+      if (val & 0x100) {
+        OD_ASSERT(offs > 0);
+        propagate_carry_bwd(out, offs - 1);
+      }
+      offs++;
+      e &= n;
+      s -= 8;
+      c -= 8;
+      n >>= 8;
+    } while (s > 0);
   }
-  /*Add any remaining raw bits to the last byte.
-    There is guaranteed to be enough room, because nend_bits <= s.*/
-  OD_ASSERT(nend_bits <= 0 || end_offs > 0);
-  if (nend_bits > 0) out[end_offs - 1] |= (unsigned char)e;
+  *nbytes = offs;
   /*Note: Unless there's an allocation error, if you keep encoding into the
      current buffer and call this function again later, everything will work
      just fine (you won't get a new packet out, but you will get a single
@@ -398,7 +385,7 @@ unsigned char *od_ec_enc_done(od_ec_enc *enc, uint32_t *nbytes) {
 int od_ec_enc_tell(const od_ec_enc *enc) {
   /*The 10 here counteracts the offset of -9 baked into cnt, and adds 1 extra
      bit, which we reserve for terminating the stream.*/
-  return (enc->cnt + 10 + enc->nend_bits) + (enc->offs + enc->end_offs) * 8;
+  return (enc->cnt + 10) + enc->offs * 8;
 }
 
 /*Returns the number of bits "used" by the encoded symbols so far.
@@ -427,21 +414,17 @@ void od_ec_enc_checkpoint(od_ec_enc *dst, const od_ec_enc *src) {
    state's history: you can not switch backwards and forwards or otherwise
    switch to a state which isn't a casual ancestor of the current state.
   Restore is also incompatible with patching the initial bits, as the
-   changes will remain in the restored version.*/
+   changes will remain in the restored version.
+  Carries are propagated into the output buffer as soon as bytes are flushed,
+   so restoring is only exact if no carry reached a byte written before the
+   checkpoint was taken.*/
 void od_ec_enc_rollback(od_ec_enc *dst, const od_ec_enc *src) {
   unsigned char *buf;
   uint32_t storage;
-  uint16_t *precarry_buf;
-  uint32_t precarry_storage;
   OD_ASSERT(dst->storage >= src->storage);
-  OD_ASSERT(dst->precarry_storage >= src->precarry_storage);
   buf = dst->buf;
   storage = dst->storage;
-  precarry_buf = dst->precarry_buf;
-  precarry_storage = dst->precarry_storage;
   OD_COPY(dst, src, 1);
   dst->buf = buf;
   dst->storage = storage;
-  dst->precarry_buf = precarry_buf;
-  dst->precarry_storage = precarry_storage;
 }
@@ -9,15 +9,18 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <assert.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "./aom_dsp_rtcd.h"
 #include "aom_dsp/aom_dsp_common.h"
 #include "aom_dsp/noise_model.h"
 #include "aom_dsp/noise_util.h"
 #include "aom_mem/aom_mem.h"
+#include "aom_ports/mem.h"
 #include "av1/encoder/mathutils.h"
 
 #define kLowPolyNumParams 3
@@ -409,80 +412,220 @@ void aom_flat_block_finder_extract_block(
   }
 }
 
-int aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
-                              const uint8_t *const data, int w, int h,
-                              int stride, uint8_t *flat_blocks) {
+void aom_flat_block_get_moments_c(const uint8_t *data, int stride,
+                                  int block_size,
+                                  aom_flat_block_moments_t *moments) {
+  int x, y;
+  memset(moments, 0, sizeof(*moments));
+  for (y = 0; y < block_size; ++y) {
+    const uint8_t *const row = data + y * stride;
+    const int wy = 2 * y - block_size;
+    int sum = 0, sum_x = 0;
+    for (x = 0; x < block_size; ++x) {
+      sum += row[x];
+      sum_x += (2 * x - block_size) * row[x];
+    }
+    moments->sum += sum;
+    moments->sum_x += sum_x;
+    moments->sum_y += wy * sum;
+    if (y == 0 || y == block_size - 1) continue;
+
+    sum = sum_x = 0;
+    for (x = 1; x < block_size - 1; ++x) {
+      const int d = row[x];
+      const int dx = row[x + 1] - row[x - 1];
+      const int dy = row[x + stride] - row[x - stride];
+      sum += d;
+      sum_x += (2 * x - block_size) * d;
+      moments->inner_sum_sq += d * d;
+      moments->dx += dx;
+      moments->dy += dy;
+      moments->dxx += dx * dx;
+      moments->dxy += dx * dy;
+      moments->dyy += dy * dy;
+    }
+    moments->inner_sum += sum;
+    moments->inner_sum_x += sum_x;
+    moments->inner_sum_y += wy * sum;
+  }
+}
+
+// Each job takes a contiguous band of the rows of blocks.
+static int get_num_jobs(AVxWorker *workers, int num_workers,
+                        int num_blocks_h) {
+  if (!workers) return 1;
+  return AOMMAX(1, AOMMIN(num_workers, num_blocks_h));
+}
+
+typedef struct {
+  const aom_flat_block_finder_t *block_finder;
+  const uint8_t *data;
+  int w;
+  int h;
+  int stride;
+  uint8_t *flat_blocks;
+  int by_start;
+  int by_end;
+  uint8_t *block;  // Copy of the blocks that cross the frame edge
+  int num_flat;
+} flat_block_job_t;
+
+// Fits the plane of the block from its moments and scores the residual, with
+// the same measures as when the residual is taken from
+// aom_flat_block_finder_extract_block().
+static int is_block_flat(const aom_flat_block_finder_t *block_finder,
+                         const aom_flat_block_moments_t *m,
+                         double inner_coord_sum, double inner_coord_sq) {
   const int block_size = block_finder->block_size;
   const int n = block_size * block_size;
+  const int inner_size = block_size - 2;
+  const double num_inner = inner_size * inner_size;
   const double kTraceThreshold = 0.1 / (32 * 32);
   const double kRatioThreshold = 1.2;
   const double kNormThreshold = 0.05 / (32 * 32);
   const double kVarThreshold = 0.005 / (double)n;
-  const int num_blocks_w = (w + block_size - 1) / block_size;
-  const int num_blocks_h = (h + block_size - 1) / block_size;
-  int num_flat = 0;
-  int bx = 0, by = 0;
-  double *plane = (double *)aom_malloc(n * sizeof(*plane));
-  double *block = (double *)aom_malloc(n * sizeof(*block));
-  if (plane == NULL || block == NULL) {
-    fprintf(stderr, "Failed to allocate memory for block of size %d\n", n);
-    aom_free(plane);
-    aom_free(block);
-    return -1;
+  const double k = kBlockNormalization;
+  const double Atb[kLowPolyNumParams] = { m->sum_y / (block_size * k),
+                                          m->sum_x / (block_size * k),
+                                          m->sum / k };
+  double plane[kLowPolyNumParams];
+  double plane_sum, plane_sq, data_plane, mean, var;
+  double gx, gy, Gxx, Gxy, Gyy;
+
+  multiply_mat(block_finder->AtA_inv, Atb, plane, kLowPolyNumParams,
+               kLowPolyNumParams, 1);
+
+  // Sums of the plane, and of its product with the data, over the inner
+  // pixels.
+  plane_sum = (plane[0] + plane[1]) * inner_size * inner_coord_sum +
+              plane[2] * num_inner;
+  plane_sq = (plane[0] * plane[0] + plane[1] * plane[1]) * inner_size *
+                 inner_coord_sq +
+             2 * plane[0] * plane[1] * inner_coord_sum * inner_coord_sum +
+             2 * (plane[0] + plane[1]) * plane[2] * inner_size *
+                 inner_coord_sum +
+             plane[2] * plane[2] * num_inner;
+  data_plane = (plane[0] * m->inner_sum_y + plane[1] * m->inner_sum_x) /
+                   block_size +
+               plane[2] * m->inner_sum;
+
+  mean = (m->inner_sum / k - plane_sum) / num_inner;
+  var = m->inner_sum_sq / (k * k) - 2 * data_plane / k + plane_sq -
+        mean * mean;
+
+  // The residual gradients are half the central differences of the data,
+  // less those of the plane, which are constant.
+  gx = 2 * plane[1] / block_size;
+  gy = 2 * plane[0] / block_size;
+  Gxx = (m->dxx / (4 * k * k) - gx * m->dx / k) / num_inner + gx * gx;
+  Gyy = (m->dyy / (4 * k * k) - gy * m->dy / k) / num_inner + gy * gy;
+  Gxy = (m->dxy / (4 * k * k) - (gy * m->dx + gx * m->dy) / (2 * k)) /
+            num_inner +
+        gx * gy;
+
+  {
+    const double trace = Gxx + Gyy;
+    const double det = Gxx * Gyy - Gxy * Gxy;
+    const double e1 = (trace + sqrt(trace * trace - 4 * det)) / 2.;
+    const double e2 = (trace - sqrt(trace * trace - 4 * det)) / 2.;
+    const double norm = sqrt(Gxx * Gxx + Gxy * Gxy * 2 + Gyy * Gyy);
+    return (trace < kTraceThreshold) &&
+           (e1 / AOMMAX(e2, 1e-8) < kRatioThreshold) &&
+           norm < kNormThreshold && var > kVarThreshold;
   }
+}
 
-  for (by = 0; by < num_blocks_h; ++by) {
+static int flat_block_finder_worker(flat_block_job_t *const job,
+                                    void *unused) {
+  const aom_flat_block_finder_t *const block_finder = job->block_finder;
+  const int block_size = block_finder->block_size;
+  const int num_blocks_w = (job->w + block_size - 1) / block_size;
+  void (*const get_moments)(const uint8_t *, int, int,
+                            aom_flat_block_moments_t *) =
+      (block_size % 8 == 0 && block_size <= 128) ? aom_flat_block_get_moments
+                                                 : aom_flat_block_get_moments_c;
+  double inner_coord_sum = 0, inner_coord_sq = 0;
+  int i, bx, by;
+  (void)unused;
+
+  // Sums of the normalized coordinate of the plane over a row or column of
+  // the inner pixels.
+  for (i = 1; i < block_size - 1; ++i) {
+    const double coord = (2. * i - block_size) / block_size;
+    inner_coord_sum += coord;
+    inner_coord_sq += coord * coord;
+  }
+
+  job->num_flat = 0;
+  for (by = job->by_start; by < job->by_end; ++by) {
+    const int y_o = by * block_size;
     for (bx = 0; bx < num_blocks_w; ++bx) {
-      // Compute gradient covariance matrix.
-      double Gxx = 0, Gxy = 0, Gyy = 0;
-      double var = 0;
-      double mean = 0;
-      int xi, yi;
-      aom_flat_block_finder_extract_block(block_finder, data, w, h, stride,
-                                          bx * block_size, by * block_size,
-                                          plane, block);
-
-      for (yi = 1; yi < block_size - 1; ++yi) {
-        for (xi = 1; xi < block_size - 1; ++xi) {
-          const double gx = (block[yi * block_size + xi + 1] -
-                             block[yi * block_size + xi - 1]) /
-                            2;
-          const double gy = (block[yi * block_size + xi + block_size] -
-                             block[yi * block_size + xi - block_size]) /
-                            2;
-          Gxx += gx * gx;
-          Gxy += gx * gy;
-          Gyy += gy * gy;
-
-          mean += block[yi * block_size + xi];
-          var += block[yi * block_size + xi] * block[yi * block_size + xi];
+      const int x_o = bx * block_size;
+      aom_flat_block_moments_t moments;
+      int is_flat;
+      if (x_o + block_size <= job->w && y_o + block_size <= job->h) {
+        get_moments(job->data + y_o * job->stride + x_o, job->stride,
+                    block_size, &moments);
+      } else {
+        int xi, yi;
+        for (yi = 0; yi < block_size; ++yi) {
+          const int y = AOMMIN(job->h - 1, y_o + yi);
+          for (xi = 0; xi < block_size; ++xi) {
+            const int x = AOMMIN(job->w - 1, x_o + xi);
+            job->block[yi * block_size + xi] = job->data[y * job->stride + x];
+          }
         }
+        get_moments(job->block, block_size, block_size, &moments);
       }
-      mean /= (block_size - 2) * (block_size - 2);
-
-      // Normalize gradients by block_size.
-      Gxx /= (block_size - 2) * (block_size - 2);
-      Gxy /= (block_size - 2) * (block_size - 2);
-      Gyy /= (block_size - 2) * (block_size - 2);
-      var = var / (block_size - 2) * (block_size - 2) - mean * mean;
-
-      {
-        const double trace = Gxx + Gyy;
-        const double det = Gxx * Gyy - Gxy * Gxy;
-        const double e1 = (trace + sqrt(trace * trace - 4 * det)) / 2.;
-        const double e2 = (trace - sqrt(trace * trace - 4 * det)) / 2.;
-        const double norm = sqrt(Gxx * Gxx + Gxy * Gxy * 2 + Gyy * Gyy);
-        const int is_flat = (trace < kTraceThreshold) &&
-                            (e1 / AOMMAX(e2, 1e-8) < kRatioThreshold) &&
-                            norm < kNormThreshold && var > kVarThreshold;
-        flat_blocks[by * num_blocks_w + bx] = is_flat ? 255 : 0;
-        num_flat += is_flat;
-      }
+      is_flat = is_block_flat(block_finder, &moments, inner_coord_sum,
+                              inner_coord_sq);
+      job->flat_blocks[by * num_blocks_w + bx] = is_flat ? 255 : 0;
+      job->num_flat += is_flat;
     }
   }
+  return 1;
+}
 
-  aom_free(block);
-  aom_free(plane);
+int aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
+                              const uint8_t *const data, int w, int h,
+                              int stride, uint8_t *flat_blocks,
+                              AVxWorker *workers, int num_workers) {
+  const int block_size = block_finder->block_size;
+  const int n = block_size * block_size;
+  const int num_blocks_h = (h + block_size - 1) / block_size;
+  const int num_jobs = get_num_jobs(workers, num_workers, num_blocks_h);
+  flat_block_job_t *jobs =
+      (flat_block_job_t *)aom_calloc(num_jobs, sizeof(*jobs));
+  int num_flat = -1;
+  int i;
+
+  if (jobs == NULL) goto Error;
+  for (i = 0; i < num_jobs; ++i) {
+    flat_block_job_t *const job = &jobs[i];
+    job->block_finder = block_finder;
+    job->data = data;
+    job->w = w;
+    job->h = h;
+    job->stride = stride;
+    job->flat_blocks = flat_blocks;
+    job->by_start = num_blocks_h * i / num_jobs;
+    job->by_end = num_blocks_h * (i + 1) / num_jobs;
+    job->block = (uint8_t *)aom_malloc(n);
+    if (job->block == NULL) goto Error;
+  }
+
+  aom_run_worker_jobs((AVxWorkerHook)flat_block_finder_worker, jobs,
+                      sizeof(*jobs), num_jobs, workers);
+  num_flat = 0;
+  for (i = 0; i < num_jobs; ++i) num_flat += jobs[i].num_flat;
+
+Error:
+  if (num_flat < 0)
+    fprintf(stderr, "Failed to allocate memory for block of size %d\n", n);
+  if (jobs) {
+    for (i = 0; i < num_jobs; ++i) aom_free(jobs[i].block);
+  }
+  aom_free(jobs);
   return num_flat;
 }
 
@@ -561,110 +704,234 @@ void aom_noise_model_free(aom_noise_model_t *model) {
   memset(model, 0, sizeof(*model));
 }
 
-static int add_block_observations(
-    aom_noise_model_t *noise_model, int c, const uint8_t *const data,
-    const uint8_t *const denoised, int w, int h, int stride, int sub_log2[2],
-    const uint8_t *const alt_data, const uint8_t *const alt_denoised,
-    int alt_stride, const uint8_t *const flat_blocks, int block_size,
-    int num_blocks_w, int num_blocks_h) {
+void aom_noise_accumulate_covariance_c(const int16_t *samples,
+                                       int num_samples, int n, int stride,
+                                       int32_t *acc) {
+  int i, j, k;
+  for (k = 0; k < num_samples; ++k) {
+    const int16_t *const s = samples + k * stride;
+    for (i = 0; i < n; ++i) {
+      for (j = i; j < n; ++j) acc[i * stride + j] += s[i] * s[j];
+    }
+  }
+}
+
+// Samples are gathered in batches of kNumBatchSamples for
+// aom_noise_accumulate_covariance(), and the 32-bit sums flushed to the
+// equation system before kMaxCovarianceSamples products of up to 255 * 255
+// could overflow them.
+#define kNumBatchSamples 64
+#define kMaxCovarianceSamples 32768
+
+// Shared state of the jobs of a multi-threaded aom_noise_model_update() on a
+// channel. Each job takes a band of rows of blocks.
+typedef struct {
+  const aom_noise_model_t *noise_model;
+  const uint8_t *data;
+  const uint8_t *denoised;
+  int w;
+  int h;
+  int stride;
+  const uint8_t *alt_data;
+  const uint8_t *alt_denoised;
+  int alt_stride;
+  const uint8_t *flat_blocks;
+  int block_size;
+  int num_blocks_w;
+  int num_blocks_h;
+  const double *coeffs;  // Solved AR coefficients, for the noise strength
+  double *block_means;   // Per block, for the noise strength
+  double *block_stds;
+} noise_model_frame_t;
+
+typedef struct {
+  const noise_model_frame_t *frame;
+  int by_start;
+  int by_end;
+  // Upper triangle of the system of the band, in integer units.
+  aom_equation_system_t eqns;
+  int16_t *samples;  // kNumBatchSamples rows of stride values
+  int32_t *acc;      // Pending sums of the system and its right hand side
+  int stride;
+} noise_model_job_t;
+
+// Adds the pending integer sums of the job to its system. The last sample is
+// the value being predicted, so its column goes to the right hand side.
+static void flush_covariance(noise_model_job_t *job) {
+  const int n = job->eqns.n;
+  int i, j;
+  for (i = 0; i < n; ++i) {
+    const int32_t *const acc_row = job->acc + i * job->stride;
+    for (j = i; j < n; ++j) job->eqns.A[i * n + j] += acc_row[j];
+    job->eqns.b[i] += acc_row[n];
+  }
+  memset(job->acc, 0, sizeof(*job->acc) * (n + 1) * job->stride);
+}
+
+static int add_block_observations_worker(noise_model_job_t *const job,
+                                         void *unused) {
+  const noise_model_frame_t *const f = job->frame;
+  const aom_noise_model_t *const noise_model = f->noise_model;
   const int lag = noise_model->params.lag;
   const int num_coords = noise_model->n;
-  double *A = noise_model->latest_state[c].eqns.A;
-  double *b = noise_model->latest_state[c].eqns.b;
-  double *buffer = (double *)aom_malloc(sizeof(*buffer) * (num_coords + 1));
-  const int n = noise_model->latest_state[c].eqns.n;
+  const int n = job->eqns.n;
+  const int block_size = f->block_size;
+  const int num_blocks_w = f->num_blocks_w;
+  const int num_blocks_h = f->num_blocks_h;
+  const uint8_t *const flat_blocks = f->flat_blocks;
+  int num_samples = 0, num_pending = 0;
   int bx, by;
-  (void)sub_log2;
+  (void)unused;
 
-  if (!buffer) {
-    fprintf(stderr, "Unable to allocate buffer of size %d\n", num_coords + 1);
-    return 0;
-  }
-  for (by = 0; by < num_blocks_h; ++by) {
+  for (by = job->by_start; by < job->by_end; ++by) {
     const int y_o = by * block_size;
     for (bx = 0; bx < num_blocks_w; ++bx) {
       const int x_o = bx * block_size;
       int x_start = 0, y_start = 0, x_end = 0, y_end = 0;
-      int x, y, i, j;
+      int x, y, i;
       if (!flat_blocks[by * num_blocks_w + bx]) {
         continue;
       }
       y_start = (by > 0 && flat_blocks[(by - 1) * num_blocks_w + bx]) ? 0 : lag;
       x_start = (bx > 0 && flat_blocks[by * num_blocks_w + bx - 1]) ? 0 : lag;
       y_end = AOMMIN(
-          h - by * block_size,
+          f->h - by * block_size,
           (by + 1 < num_blocks_h && flat_blocks[(by + 1) * num_blocks_w + bx])
               ? block_size
               : block_size - lag);
       x_end = AOMMIN(
-          w - bx * block_size - lag,
+          f->w - bx * block_size - lag,
           (bx + 1 < num_blocks_w && flat_blocks[by * num_blocks_w + bx + 1])
               ? block_size
               : block_size - lag);
       for (y = y_start; y < y_end; ++y) {
         for (x = x_start; x < x_end; ++x) {
-          double val = 0;
+          int16_t *const sample = job->samples + num_samples * job->stride;
           for (i = 0; i < num_coords; ++i) {
-            const int dx_i = noise_model->coords[i][0];
-            const int dy_i = noise_model->coords[i][1];
-            const int x_i = x_o + x + dx_i;
-            const int y_i = y_o + y + dy_i;
-            assert(x_i < w && y_i < h);
-            buffer[i] = ((double)(data[y_i * stride + x_i]) -
-                         (double)(denoised[y_i * stride + x_i]));
+            const int x_i = x_o + x + noise_model->coords[i][0];
+            const int y_i = y_o + y + noise_model->coords[i][1];
+            assert(x_i < f->w && y_i < f->h);
+            sample[i] = f->data[y_i * f->stride + x_i] -
+                        f->denoised[y_i * f->stride + x_i];
           }
-          val = ((double)data[(y_o + y) * stride + (x_o + x)]) -
-                ((double)denoised[(y_o + y) * stride + (x_o + x)]);
-
           // For the color channels we must also consider the correlation with
           // the luma channel.
-          if (alt_data && alt_denoised) {
-            buffer[num_coords] =
-                ((double)alt_data[(y_o + y) * alt_stride + (x_o + x)]) -
-                ((double)alt_denoised[(y_o + y) * alt_stride + (x_o + x)]);
+          if (f->alt_data && f->alt_denoised) {
+            sample[num_coords] =
+                f->alt_data[(y_o + y) * f->alt_stride + (x_o + x)] -
+                f->alt_denoised[(y_o + y) * f->alt_stride + (x_o + x)];
           }
+          sample[n] = f->data[(y_o + y) * f->stride + (x_o + x)] -
+                      f->denoised[(y_o + y) * f->stride + (x_o + x)];
 
-          for (i = 0; i < n; ++i) {
-            for (j = 0; j < n; ++j) {
-              A[i * n + j] += (buffer[i] * buffer[j]) /
-                              (kBlockNormalization * kBlockNormalization);
+          if (++num_samples == kNumBatchSamples) {
+            if (num_pending + num_samples > kMaxCovarianceSamples) {
+              flush_covariance(job);
+              num_pending = 0;
             }
-            b[i] +=
-                (buffer[i] * val) / (kBlockNormalization * kBlockNormalization);
+            aom_noise_accumulate_covariance(job->samples, num_samples, n + 1,
+                                            job->stride, job->acc);
+            num_pending += num_samples;
+            num_samples = 0;
           }
         }
       }
     }
   }
-  aom_free(buffer);
+  if (num_pending + num_samples > kMaxCovarianceSamples) flush_covariance(job);
+  aom_noise_accumulate_covariance(job->samples, num_samples, n + 1, job->stride,
+                                  job->acc);
+  flush_covariance(job);
   return 1;
 }
 
-void add_noise_std_observations(aom_noise_model_t *noise_model, int c,
-                                const double *coeffs, const uint8_t *const data,
-                                const uint8_t *const denoised, int w, int h,
-                                int stride, const uint8_t *const alt_data,
-                                const uint8_t *const alt_denoised,
-                                int alt_stride,
-                                const uint8_t *const flat_blocks,
-                                int block_size, int num_blocks_w,
-                                int num_blocks_h) {
+// Adds the observations of the flat blocks to the latest system of channel c.
+// The per job systems hold integer sums, which are exact in double, so the
+// result does not depend on the number of jobs.
+static int add_block_observations(aom_noise_model_t *noise_model, int c,
+                                  noise_model_frame_t *frame,
+                                  AVxWorker *workers, int num_jobs) {
+  aom_equation_system_t *const eqns = &noise_model->latest_state[c].eqns;
+  const int n = eqns->n;
+  const int stride = ALIGN_POWER_OF_TWO(n + 1, 3);
+  const double kScale = 1.0 / (kBlockNormalization * kBlockNormalization);
+  noise_model_job_t *jobs =
+      (noise_model_job_t *)aom_calloc(num_jobs, sizeof(*jobs));
+  int ret = 0;
+  int i, j, k;
+
+  if (jobs == NULL) goto Error;
+  for (k = 0; k < num_jobs; ++k) {
+    noise_model_job_t *const job = &jobs[k];
+    job->frame = frame;
+    job->by_start = frame->num_blocks_h * k / num_jobs;
+    job->by_end = frame->num_blocks_h * (k + 1) / num_jobs;
+    job->stride = stride;
+    job->samples = (int16_t *)aom_calloc(kNumBatchSamples * stride,
+                                         sizeof(*job->samples));
+    job->acc = (int32_t *)aom_calloc((n + 1) * stride, sizeof(*job->acc));
+    if (job->samples == NULL || job->acc == NULL ||
+        !equation_system_init(&job->eqns, n))
+      goto Error;
+  }
+
+  aom_run_worker_jobs((AVxWorkerHook)add_block_observations_worker, jobs,
+                      sizeof(*jobs), num_jobs, workers);
+
+  for (k = 0; k < num_jobs; ++k) {
+    for (i = 0; i < n; ++i) {
+      for (j = i; j < n; ++j) eqns->A[i * n + j] += jobs[k].eqns.A[i * n + j];
+      eqns->b[i] += jobs[k].eqns.b[i];
+    }
+  }
+  for (i = 0; i < n; ++i) {
+    for (j = i; j < n; ++j) {
+      eqns->A[i * n + j] *= kScale;
+      eqns->A[j * n + i] = eqns->A[i * n + j];
+    }
+    eqns->b[i] *= kScale;
+  }
+  ret = 1;
+
+Error:
+  if (!ret) fprintf(stderr, "Unable to allocate noise model jobs\n");
+  if (jobs) {
+    for (k = 0; k < num_jobs; ++k) {
+      aom_free(jobs[k].samples);
+      aom_free(jobs[k].acc);
+      equation_system_free(&jobs[k].eqns);
+    }
+  }
+  aom_free(jobs);
+  return ret;
+}
+
+static int add_noise_std_observations_worker(noise_model_job_t *const job,
+                                             void *unused) {
+  const noise_model_frame_t *const f = job->frame;
+  const aom_noise_model_t *const noise_model = f->noise_model;
   const int lag = noise_model->params.lag;
   const int num_coords = noise_model->n;
-  aom_noise_strength_solver_t *noise_strength_solver =
-      &noise_model->latest_state[c].strength_solver;
+  const double *const coeffs = f->coeffs;
+  const uint8_t *const data = f->data;
+  const uint8_t *const denoised = f->denoised;
+  const uint8_t *const alt_data = f->alt_data;
+  const uint8_t *const alt_denoised = f->alt_denoised;
+  const int stride = f->stride;
+  const int block_size = f->block_size;
+  const int num_blocks_w = f->num_blocks_w;
+  const int num_blocks_h = f->num_blocks_h;
+  const uint8_t *const flat_blocks = f->flat_blocks;
   int bx = 0, by = 0;
+  (void)unused;
 
-  for (by = 0; by < num_blocks_h; ++by) {
+  for (by = job->by_start; by < job->by_end; ++by) {
     const int y_o = by * block_size;
     for (bx = 0; bx < num_blocks_w; ++bx) {
       const int x_o = bx * block_size;
       if (!flat_blocks[by * num_blocks_w + bx]) {
         continue;
       }
-      const double block_mean =
-          get_block_mean(alt_data ? alt_data : data, w, h,
-                         alt_data ? alt_stride : stride, x_o, y_o, block_size);
       double noise_var = 0;
       int num_samples_in_block = 0;
       int y_start =
@@ -702,22 +969,69 @@ void add_noise_std_observations(aom_noise_model_t *noise_model, int c,
           num_samples_in_block++;
         }
       }
-      const double noise_std = sqrt(noise_var / num_samples_in_block);
-      aom_noise_strength_solver_add_measurement(noise_strength_solver,
-                                                block_mean, noise_std);
+      f->block_means[by * num_blocks_w + bx] = get_block_mean(
+          alt_data ? alt_data : data, f->w, f->h,
+          alt_data ? f->alt_stride : stride, x_o, y_o, block_size);
+      f->block_stds[by * num_blocks_w + bx] =
+          sqrt(noise_var / num_samples_in_block);
     }
   }
+  return 1;
+}
+
+// The strength of each flat block is measured in parallel, and then added to
+// the solver in raster order so that the result does not depend on the number
+// of jobs.
+static int add_noise_std_observations(aom_noise_model_t *noise_model, int c,
+                                      noise_model_frame_t *frame,
+                                      AVxWorker *workers, int num_jobs) {
+  const int num_blocks = frame->num_blocks_w * frame->num_blocks_h;
+  noise_model_job_t *jobs =
+      (noise_model_job_t *)aom_calloc(num_jobs, sizeof(*jobs));
+  int ret = 0;
+  int i;
+
+  frame->block_means =
+      (double *)aom_malloc(num_blocks * sizeof(*frame->block_means));
+  frame->block_stds =
+      (double *)aom_malloc(num_blocks * sizeof(*frame->block_stds));
+  if (jobs && frame->block_means && frame->block_stds) {
+    for (i = 0; i < num_jobs; ++i) {
+      jobs[i].frame = frame;
+      jobs[i].by_start = frame->num_blocks_h * i / num_jobs;
+      jobs[i].by_end = frame->num_blocks_h * (i + 1) / num_jobs;
+    }
+    aom_run_worker_jobs((AVxWorkerHook)add_noise_std_observations_worker,
+                        jobs, sizeof(*jobs), num_jobs, workers);
+    for (i = 0; i < num_blocks; ++i) {
+      if (!frame->flat_blocks[i]) continue;
+      aom_noise_strength_solver_add_measurement(
+          &noise_model->latest_state[c].strength_solver,
+          frame->block_means[i], frame->block_stds[i]);
+    }
+    ret = 1;
+  } else {
+    fprintf(stderr, "Unable to allocate noise strength measurements\n");
+  }
+  aom_free(frame->block_means);
+  aom_free(frame->block_stds);
+  frame->block_means = frame->block_stds = NULL;
+  aom_free(jobs);
+  return ret;
 }
 
 aom_noise_status_t aom_noise_model_update(
     aom_noise_model_t *const noise_model, const uint8_t *const data[3],
     const uint8_t *const denoised[3], int w, int h, int stride[3],
-    int chroma_sub[2], const uint8_t *const flat_blocks, int block_size) {
+    int chroma_sub[2], const uint8_t *const flat_blocks, int block_size,
+    AVxWorker *workers, int num_workers) {
   const int num_blocks_w = (w + block_size - 1) / block_size;
   const int num_blocks_h = (h + block_size - 1) / block_size;
+  const int num_jobs = get_num_jobs(workers, num_workers, num_blocks_h);
   int y_model_different = 0;
   int num_blocks = 0;
   int i = 0, channel = 0;
+  (void)chroma_sub;
 
   if (block_size <= 1) {
     fprintf(stderr, "block_size = %d must be > 1\n", block_size);
@@ -748,15 +1062,26 @@ aom_noise_status_t aom_noise_model_update(
   }
 
   for (channel = 0; channel < 3; ++channel) {
-    const uint8_t *alt_data = channel > 0 ? data[0] : 0;
-    const uint8_t *alt_denoised = channel > 0 ? denoised[0] : 0;
-    int *sub = channel > 0 ? chroma_sub : 0;
+    noise_model_frame_t frame;
     if (!data[channel] || !denoised[channel]) break;
 
-    if (!add_block_observations(noise_model, channel, data[channel],
-                                denoised[channel], w, h, stride[channel], sub,
-                                alt_data, alt_denoised, stride[0], flat_blocks,
-                                block_size, num_blocks_w, num_blocks_h)) {
+    memset(&frame, 0, sizeof(frame));
+    frame.noise_model = noise_model;
+    frame.data = data[channel];
+    frame.denoised = denoised[channel];
+    frame.w = w;
+    frame.h = h;
+    frame.stride = stride[channel];
+    frame.alt_data = channel > 0 ? data[0] : 0;
+    frame.alt_denoised = channel > 0 ? denoised[0] : 0;
+    frame.alt_stride = stride[0];
+    frame.flat_blocks = flat_blocks;
+    frame.block_size = block_size;
+    frame.num_blocks_w = num_blocks_w;
+    frame.num_blocks_h = num_blocks_h;
+
+    if (!add_block_observations(noise_model, channel, &frame, workers,
+                                num_jobs)) {
       fprintf(stderr, "Adding block observation failed\n");
       return AOM_NOISE_STATUS_INTERNAL_ERROR;
     }
@@ -766,11 +1091,12 @@ aom_noise_status_t aom_noise_model_update(
       return AOM_NOISE_STATUS_INTERNAL_ERROR;
     }
 
-    add_noise_std_observations(
-        noise_model, channel, noise_model->latest_state[channel].eqns.x,
-        data[channel], denoised[channel], w, h, stride[channel], alt_data,
-        alt_denoised, stride[0], flat_blocks, block_size, num_blocks_w,
-        num_blocks_h);
+    frame.coeffs = noise_model->latest_state[channel].eqns.x;
+    if (!add_noise_std_observations(noise_model, channel, &frame, workers,
+                                    num_jobs)) {
+      fprintf(stderr, "Adding noise strength observation failed\n");
+      return AOM_NOISE_STATUS_INTERNAL_ERROR;
+    }
 
     if (!aom_noise_strength_solver_solve(
             &noise_model->latest_state[channel].strength_solver)) {
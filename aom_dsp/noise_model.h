@@ -18,6 +18,8 @@ extern "C" {
 
 #include <stdint.h>
 
+#include "aom_util/aom_thread.h"
+
 /*!\brief Wrapper of data required to represent linear system of eqns and soln.
  */
 typedef struct {
@@ -139,9 +141,49 @@ void aom_flat_block_finder_extract_block(
     int w, int h, int stride, int offsx, int offsy, double *plane,
     double *block);
 
+/*!\brief Integer moments of a block used to score its flatness.
+ *
+ * The inner sums and the gradients exclude the outermost ring of pixels of
+ * the block. Coordinates are scaled as (2 * x - block_size) so that they stay
+ * integral for odd block sizes, and the gradients are the central differences
+ * dx = d(x + 1, y) - d(x - 1, y) and dy = d(x, y + 1) - d(x, y - 1).
+ */
+typedef struct aom_flat_block_moments {
+  int64_t sum;           // sum(d)
+  int64_t sum_x;         // sum((2 * x - block_size) * d)
+  int64_t sum_y;         // sum((2 * y - block_size) * d)
+  int64_t inner_sum;     // sum(d) over the inner pixels
+  int64_t inner_sum_x;   // sum((2 * x - block_size) * d) over the inner pixels
+  int64_t inner_sum_y;   // sum((2 * y - block_size) * d) over the inner pixels
+  int64_t inner_sum_sq;  // sum(d * d) over the inner pixels
+  int64_t dx;            // sum(dx)
+  int64_t dy;            // sum(dy)
+  int64_t dxx;           // sum(dx * dx)
+  int64_t dxy;           // sum(dx * dy)
+  int64_t dyy;           // sum(dy * dy)
+} aom_flat_block_moments_t;
+
+/*!\brief Finds the flat blocks of a frame.
+ *
+ * Each block is fitted with a plane, and is flat when the gradients of the
+ * residual are weak and isotropic. Rows of blocks are split between the
+ * workers, which must be idle; the result does not depend on their number.
+ *
+ * \param[in]  block_finder  The block finder
+ * \param[in]  data          Frame data
+ * \param[in]  w             Frame width
+ * \param[in]  h             Frame height
+ * \param[in]  stride        Frame stride
+ * \param[out] flat_blocks   255 for each flat block and 0 otherwise
+ * \param[in]  workers       Workers to run on, or NULL to run serially
+ * \param[in]  num_workers   Number of workers
+ *
+ * Returns the number of flat blocks, or -1 on allocation failure.
+ */
 int aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
                               const uint8_t *const data, int w, int h,
-                              int stride, uint8_t *flat_blocks);
+                              int stride, uint8_t *flat_blocks,
+                              AVxWorker *workers, int num_workers);
 
 // The noise shape indicates the allowed coefficients in the AR model.
 typedef enum {
@@ -217,11 +259,16 @@ void aom_noise_model_free(aom_noise_model_t *model);
  * \param[in]     chroma_sub_log2 Chroma subsampling for planes != 0.
  * \param[in]     flat_blocks     A map to blocks that have been determined flat
  * \param[in]     block_size      The size of blocks.
+ * \param[in]     workers         Idle workers that rows of blocks are split
+ *                                between, or NULL to run serially. The result
+ *                                does not depend on their number.
+ * \param[in]     num_workers     Number of workers
  */
 aom_noise_status_t aom_noise_model_update(
     aom_noise_model_t *const noise_model, const uint8_t *const data[3],
     const uint8_t *const denoised[3], int w, int h, int strides[3],
-    int chroma_sub_log2[2], const uint8_t *const flat_blocks, int block_size);
+    int chroma_sub_log2[2], const uint8_t *const flat_blocks, int block_size,
+    AVxWorker *workers, int num_workers);
 
 #ifdef __cplusplus
 }  // extern "C"
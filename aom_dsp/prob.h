@@ -652,13 +652,14 @@ static INLINE aom_prob get_prob(unsigned int num, unsigned int den) {
   }
 }
 
-static INLINE void update_cdf(aom_cdf_prob *cdf, int val, int nsymbs) {
-  int rate;
-  const int rate2 = 5;
-  int i, tmp;
-  int diff;
+// CDFs of fewer symbols are adapted inline with update_cdf() when coding, as
+// they are too short for the SIMD versions of aom_update_cdf() to pay for the
+// call.
+#define CDF_UPDATE_MIN_SIMD_SYMBS 7
 
-#if 1
+// Returns the shift used to adapt cdf, which grows with the number of symbols
+// and with the adaptation counter stored in cdf[nsymbs].
+static INLINE int get_cdf_update_rate(const aom_cdf_prob *cdf, int nsymbs) {
   // static const int nsymbs2speed[17] = { 0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
   // 3, 3, 3, 3, 4 };
   // static const int nsymbs2speed[17] = { 0, 0, 1, 1, 2, 2, 2, 2, 2,
@@ -666,8 +667,18 @@ static INLINE void update_cdf(aom_cdf_prob *cdf, int val, int nsymbs) {
   static const int nsymbs2speed[17] = { 0, 0, 1, 1, 2, 2, 2, 2, 2,
                                         2, 2, 2, 2, 2, 2, 2, 2 };
   assert(nsymbs < 17);
-  rate = 3 + (cdf[nsymbs] > 15) + (cdf[nsymbs] > 31) +
+  return 3 + (cdf[nsymbs] > 15) + (cdf[nsymbs] > 31) +
          nsymbs2speed[nsymbs];  // + get_msb(nsymbs);
+}
+
+static INLINE void update_cdf(aom_cdf_prob *cdf, int val, int nsymbs) {
+  int rate;
+  const int rate2 = 5;
+  int i, tmp;
+  int diff;
+
+#if 1
+  rate = get_cdf_update_rate(cdf, nsymbs);
   tmp = AOM_ICDF(0);
   (void)rate2;
   (void)diff;
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "./aom_dsp_rtcd.h"
+#include "aom_dsp/prob.h"
+
+void aom_update_cdf_avx2(aom_cdf_prob *cdf, int val, int nsymbs) {
+  const __m256i idx =
+      _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  const __m256i top = _mm256_set1_epi16((int16_t)CDF_PROB_TOP);
+  __m256i v_val, v_last, up, keep, c, inc, dec, upd;
+  __m128i v_rate;
+
+  // A single vector covers the 16 entries only when they all lie before the
+  // adaptation counter in cdf[nsymbs].
+  if (nsymbs < 15) {
+    aom_update_cdf_sse2(cdf, val, nsymbs);
+    return;
+  }
+
+  v_val = _mm256_set1_epi16(val);
+  v_last = _mm256_set1_epi16(nsymbs - 1);
+  v_rate = _mm_cvtsi32_si128(get_cdf_update_rate(cdf, nsymbs));
+
+  c = _mm256_loadu_si256((const __m256i *)cdf);
+  // Entries before the coded symbol move towards CDF_PROB_TOP and the others
+  // towards 0. Entries at or beyond nsymbs - 1 are left unchanged.
+  up = _mm256_cmpgt_epi16(v_val, idx);
+  keep = _mm256_cmpgt_epi16(v_last, idx);
+  inc = _mm256_add_epi16(c, _mm256_srl_epi16(_mm256_sub_epi16(top, c), v_rate));
+  dec = _mm256_sub_epi16(c, _mm256_srl_epi16(c, v_rate));
+  upd = _mm256_blendv_epi8(dec, inc, up);
+  c = _mm256_blendv_epi8(c, upd, keep);
+  _mm256_storeu_si256((__m256i *)cdf, c);
+  cdf[nsymbs] += (cdf[nsymbs] < 32);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <emmintrin.h>
+
+#include "./aom_dsp_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/prob.h"
+
+// Computes the adapted values of the 8 CDF entries in c, whose indices are
+// idx. Entries before the coded symbol move towards CDF_PROB_TOP and the
+// others towards 0. Entries at or beyond nsymbs - 1 (the terminating 0 and
+// the adaptation counter) are returned unchanged.
+static INLINE __m128i update_cdf_8(const __m128i c, const __m128i idx,
+                                   const __m128i val, const __m128i last,
+                                   const __m128i rate) {
+  const __m128i top = _mm_set1_epi16((int16_t)CDF_PROB_TOP);
+  const __m128i up = _mm_cmplt_epi16(idx, val);
+  const __m128i keep = _mm_cmplt_epi16(idx, last);
+  const __m128i inc =
+      _mm_add_epi16(c, _mm_srl_epi16(_mm_sub_epi16(top, c), rate));
+  const __m128i dec = _mm_sub_epi16(c, _mm_srl_epi16(c, rate));
+  const __m128i upd =
+      _mm_or_si128(_mm_and_si128(up, inc), _mm_andnot_si128(up, dec));
+  return _mm_or_si128(_mm_and_si128(keep, upd), _mm_andnot_si128(keep, c));
+}
+
+void aom_update_cdf_sse2(aom_cdf_prob *cdf, int val, int nsymbs) {
+  const __m128i idx0 = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+  __m128i v_val, v_last, v_rate;
+  __m128i c0, c1, idx1;
+  int offset;
+
+  // The vectors must not extend past the adaptation counter in cdf[nsymbs].
+  if (nsymbs < CDF_UPDATE_MIN_SIMD_SYMBS) {
+    update_cdf(cdf, val, nsymbs);
+    return;
+  }
+
+  v_val = _mm_set1_epi16(val);
+  v_last = _mm_set1_epi16(nsymbs - 1);
+  v_rate = _mm_cvtsi32_si128(get_cdf_update_rate(cdf, nsymbs));
+
+  c0 = _mm_loadu_si128((const __m128i *)cdf);
+  if (nsymbs > 9) {
+    // The second vector starts right after the first one or overlaps it, and
+    // never reaches past the counter. Both are loaded before either is stored
+    // so that overlapping entries are only adapted once.
+    offset = AOMMIN(nsymbs - 7, 8);
+    idx1 = _mm_add_epi16(idx0, _mm_set1_epi16(offset));
+    c1 = _mm_loadu_si128((const __m128i *)(cdf + offset));
+    c0 = update_cdf_8(c0, idx0, v_val, v_last, v_rate);
+    c1 = update_cdf_8(c1, idx1, v_val, v_last, v_rate);
+    _mm_storeu_si128((__m128i *)cdf, c0);
+    _mm_storeu_si128((__m128i *)(cdf + offset), c1);
+  } else {
+    c0 = update_cdf_8(c0, idx0, v_val, v_last, v_rate);
+    _mm_storeu_si128((__m128i *)cdf, c0);
+  }
+  cdf[nsymbs] += (cdf[nsymbs] < 32);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <emmintrin.h>
+
+#include "aom_dsp/noise_model.h"
+#include "aom_dsp/x86/synonyms.h"
+
+#include "./aom_dsp_rtcd.h"
+
+static INLINE __m128i load_u8_8(const uint8_t *p) {
+  return _mm_unpacklo_epi8(xx_loadl_64(p), _mm_setzero_si128());
+}
+
+static INLINE int64_t hsum_epi32(__m128i v) {
+  int32_t lanes[4];
+  xx_storeu_128(lanes, v);
+  return (int64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// Every 32-bit lane sums a quarter of the pixels of the block, which keeps the
+// largest sum, dxx or dyy, within range for blocks of up to 128x128.
+void aom_flat_block_get_moments_sse2(const uint8_t *data, int stride,
+                                     int block_size,
+                                     aom_flat_block_moments_t *moments) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one = _mm_set1_epi16(1);
+  const __m128i ramp = _mm_setr_epi16(0, 2, 4, 6, 8, 10, 12, 14);
+  const __m128i first_col = _mm_setr_epi16(0, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i last_col = _mm_setr_epi16(-1, -1, -1, -1, -1, -1, -1, 0);
+  __m128i sum = zero, sum_x = zero, sum_y = zero;
+  __m128i inner_sum = zero, inner_sum_x = zero, inner_sum_y = zero;
+  __m128i inner_sum_sq = zero;
+  __m128i dx = zero, dy = zero, dxx = zero, dxy = zero, dyy = zero;
+  int x, y;
+
+  assert(block_size % 8 == 0 && block_size <= 128);
+
+  for (y = 0; y < block_size; ++y) {
+    const uint8_t *const row = data + y * stride;
+    const __m128i wy = _mm_set1_epi16(2 * y - block_size);
+    for (x = 0; x < block_size; x += 8) {
+      const __m128i d = load_u8_8(row + x);
+      const __m128i wx =
+          _mm_add_epi16(_mm_set1_epi16(2 * x - block_size), ramp);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(d, one));
+      sum_x = _mm_add_epi32(sum_x, _mm_madd_epi16(d, wx));
+      sum_y = _mm_add_epi32(sum_y, _mm_madd_epi16(d, wy));
+
+      if (y > 0 && y < block_size - 1) {
+        // Drop the first and last column of the block.
+        __m128i mask = _mm_cmpeq_epi16(zero, zero);
+        if (x == 0) mask = _mm_and_si128(mask, first_col);
+        if (x + 8 == block_size) mask = _mm_and_si128(mask, last_col);
+        {
+          const __m128i left = x > 0 ? load_u8_8(row + x - 8) : zero;
+          const __m128i right =
+              x + 8 < block_size ? load_u8_8(row + x + 8) : zero;
+          const __m128i next =
+              _mm_or_si128(_mm_srli_si128(d, 2), _mm_slli_si128(right, 14));
+          const __m128i prev =
+              _mm_or_si128(_mm_slli_si128(d, 2), _mm_srli_si128(left, 14));
+          const __m128i gx = _mm_and_si128(_mm_sub_epi16(next, prev), mask);
+          const __m128i gy = _mm_and_si128(
+              _mm_sub_epi16(load_u8_8(row + x + stride),
+                            load_u8_8(row + x - stride)),
+              mask);
+          const __m128i di = _mm_and_si128(d, mask);
+          inner_sum = _mm_add_epi32(inner_sum, _mm_madd_epi16(di, one));
+          inner_sum_x = _mm_add_epi32(inner_sum_x, _mm_madd_epi16(di, wx));
+          inner_sum_y = _mm_add_epi32(inner_sum_y, _mm_madd_epi16(di, wy));
+          inner_sum_sq = _mm_add_epi32(inner_sum_sq, _mm_madd_epi16(di, di));
+          dx = _mm_add_epi32(dx, _mm_madd_epi16(gx, one));
+          dy = _mm_add_epi32(dy, _mm_madd_epi16(gy, one));
+          dxx = _mm_add_epi32(dxx, _mm_madd_epi16(gx, gx));
+          dxy = _mm_add_epi32(dxy, _mm_madd_epi16(gx, gy));
+          dyy = _mm_add_epi32(dyy, _mm_madd_epi16(gy, gy));
+        }
+      }
+    }
+  }
+
+  moments->sum = hsum_epi32(sum);
+  moments->sum_x = hsum_epi32(sum_x);
+  moments->sum_y = hsum_epi32(sum_y);
+  moments->inner_sum = hsum_epi32(inner_sum);
+  moments->inner_sum_x = hsum_epi32(inner_sum_x);
+  moments->inner_sum_y = hsum_epi32(inner_sum_y);
+  moments->inner_sum_sq = hsum_epi32(inner_sum_sq);
+  moments->dx = hsum_epi32(dx);
+  moments->dy = hsum_epi32(dy);
+  moments->dxx = hsum_epi32(dxx);
+  moments->dxy = hsum_epi32(dxy);
+  moments->dyy = hsum_epi32(dyy);
+}
+
+// Two samples are accumulated at a time: their values are interleaved so that
+// a single _mm_madd_epi16() adds both products to an entry.
+void aom_noise_accumulate_covariance_sse2(const int16_t *samples,
+                                          int num_samples, int n, int stride,
+                                          int32_t *acc) {
+  const __m128i zero = _mm_setzero_si128();
+  int i, j, k;
+
+  assert(stride % 8 == 0 && stride >= n);
+
+  for (k = 0; k < num_samples; k += 2) {
+    const int16_t *const s0 = samples + k * stride;
+    const int16_t *const s1 = k + 1 < num_samples ? s0 + stride : NULL;
+    for (i = 0; i < n; ++i) {
+      int32_t *const acc_row = acc + i * stride;
+      const __m128i a = _mm_unpacklo_epi16(_mm_set1_epi16(s0[i]),
+                                           _mm_set1_epi16(s1 ? s1[i] : 0));
+      for (j = i & ~7; j < n; j += 8) {
+        const __m128i b0 = xx_loadu_128(s0 + j);
+        const __m128i b1 = s1 ? xx_loadu_128(s1 + j) : zero;
+        const __m128i lo = _mm_madd_epi16(a, _mm_unpacklo_epi16(b0, b1));
+        const __m128i hi = _mm_madd_epi16(a, _mm_unpackhi_epi16(b0, b1));
+        xx_storeu_128(acc_row + j,
+                      _mm_add_epi32(xx_loadu_128(acc_row + j), lo));
+        xx_storeu_128(acc_row + j + 4,
+                      _mm_add_epi32(xx_loadu_128(acc_row + j + 4), hi));
+      }
+    }
+  }
+}
@@ -37,6 +37,12 @@ extern "C" {
 #define AOM_BORDER_IN_PIXELS 160
 #endif  // CONFIG_EXT_PARTITION
 
+// The decoder does not extend the borders of its frames: inter prediction
+// rebuilds the edges of reference blocks that reach outside the frame. The
+// remaining border only has to hold the parts of the blocks at the bottom and
+// right edges that overhang the frame, and in-place loop restoration.
+#define AOM_DEC_BORDER_IN_PIXELS 64
+
 typedef struct yv12_buffer_config {
   union {
     struct {
@@ -180,4 +180,25 @@ const AVxWorkerInterface *aom_get_worker_interface(void) {
   return &g_worker_interface;
 }
 
+void aom_run_worker_jobs(AVxWorkerHook hook, void *jobs, size_t job_size,
+                         int num_jobs, AVxWorker *workers) {
+  int i;
+
+  if (num_jobs == 1) {
+    hook(jobs, NULL);
+    return;
+  }
+  for (i = 0; i < num_jobs; ++i) {
+    AVxWorker *const worker = &workers[i];
+    worker->hook = hook;
+    worker->data1 = (char *)jobs + i * job_size;
+    worker->data2 = NULL;
+    if (i == num_jobs - 1)
+      g_worker_interface.execute(worker);
+    else
+      g_worker_interface.launch(worker);
+  }
+  for (i = 0; i < num_jobs; ++i) g_worker_interface.sync(&workers[i]);
+}
+
 //------------------------------------------------------------------------------
@@ -17,6 +17,8 @@
 #ifndef AOM_THREAD_H_
 #define AOM_THREAD_H_
 
+#include <stddef.h>
+
 #include "./aom_config.h"
 
 #ifdef __cplusplus
@@ -403,6 +405,14 @@ int aom_set_worker_interface(const AVxWorkerInterface *const winterface);
 // Retrieve the currently set thread worker interface.
 const AVxWorkerInterface *aom_get_worker_interface(void);
 
+// Runs 'hook' once for each of the num_jobs job descriptors in 'jobs', which
+// are job_size bytes apart, and waits for all of them. Jobs 0..num_jobs-2 are
+// launched on the corresponding workers and the last one runs on the calling
+// thread, so num_jobs must not exceed the number of workers, which must be
+// idle. With a single job no worker is needed.
+void aom_run_worker_jobs(AVxWorkerHook hook, void *jobs, size_t job_size,
+                         int num_jobs, AVxWorker *workers);
+
 //------------------------------------------------------------------------------
 
 #ifdef __cplusplus
@@ -48,6 +48,7 @@
 #include "aom_dsp/aom_dsp_common.h"
 #include "aom_ports/aom_timer.h"
 #include "aom_ports/mem_ops.h"
+#include "aom_util/aom_thread.h"
 #if CONFIG_WEBM_IO
 #include "./webmenc.h"
 #endif
@@ -112,6 +113,229 @@ static int read_frame(struct AvxInputContext *input_ctx, aom_image_t *img) {
   return !shortread;
 }
 
+/* Number of decoded input frames the reader may hold ahead of the encoder. */
+#define FRAME_QUEUE_SIZE 4
+
+/* Reads input frames into a bounded ring of images. In multithreaded builds
+ * this runs on its own thread so that file I/O, y4m chroma conversion and bit
+ * depth conversion overlap with encoding. Y4M frames that the reader hands out
+ * in place from the mapped input file are queued without being copied.
+ */
+struct frame_reader {
+  struct AvxInputContext *input;
+  int limit;
+  int input_shift;
+  int upshift;
+  aom_img_fmt_t fmt;
+  aom_image_t raw;
+  aom_image_t *frames[FRAME_QUEUE_SIZE];
+  aom_image_t buffers[FRAME_QUEUE_SIZE];
+  aom_image_t y4m_frames[FRAME_QUEUE_SIZE];
+  int64_t positions[FRAME_QUEUE_SIZE];
+  int64_t pos;
+  int frames_read;
+  int head;
+  int count;
+  int eof;
+#if CONFIG_MULTITHREAD
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  int stop;
+#endif
+};
+
+static void copy_image(aom_image_t *dst, const aom_image_t *src) {
+  const int bytespp = (src->fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  int plane;
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int w = aom_img_plane_width(src, plane) * bytespp;
+    const int h = aom_img_plane_height(src, plane);
+    int r;
+
+    for (r = 0; r < h; ++r) {
+      memcpy(dst->planes[plane] + r * dst->stride[plane],
+             src->planes[plane] + r * src->stride[plane], w);
+    }
+  }
+}
+
+/* Returns the buffer owned by the given queue slot, allocating it on first
+ * use.
+ */
+static aom_image_t *frame_reader_buffer(struct frame_reader *reader,
+                                        int slot) {
+  aom_image_t *const img = &reader->buffers[slot];
+
+  if (!img->img_data &&
+      !aom_img_alloc(img, reader->fmt, reader->input->width,
+                     reader->input->height, 32))
+    fatal("Failed to allocate input frame buffers");
+  return img;
+}
+
+/* Reads the next frame into the given queue slot, converting it to the
+ * encoder's input format, and records the input position after it. Returns 0
+ * at the end of the input or once the limit is reached.
+ */
+static int frame_reader_read(struct frame_reader *reader, int slot) {
+  struct AvxInputContext *const input = reader->input;
+  int ok;
+
+  if (reader->limit && reader->frames_read >= reader->limit) {
+    ok = 0;
+  } else if (reader->upshift) {
+    ok = read_frame(input, &reader->raw);
+    if (ok) {
+      reader->frames[slot] = frame_reader_buffer(reader, slot);
+      aom_img_upshift(reader->frames[slot], &reader->raw, reader->input_shift);
+    }
+  } else if (input->file_type == FILE_TYPE_Y4M) {
+    aom_image_t *const img = &reader->y4m_frames[slot];
+    ok = read_frame(input, img);
+    if (ok && y4m_input_frame_is_mapped(&input->y4m, img)) {
+      reader->frames[slot] = img;
+    } else if (ok) {
+      /* The Y4M reader decoded into its own buffer, which is reused. */
+      reader->frames[slot] = frame_reader_buffer(reader, slot);
+      copy_image(reader->frames[slot], img);
+    }
+  } else {
+    reader->frames[slot] = frame_reader_buffer(reader, slot);
+    ok = read_frame(input, reader->frames[slot]);
+  }
+
+  /* Only the thread reading the file may query its position. */
+  reader->positions[slot] = ftello(input->file);
+  if (ok) ++reader->frames_read;
+  return ok;
+}
+
+#if CONFIG_MULTITHREAD
+static THREADFN frame_reader_thread(void *arg) {
+  struct frame_reader *const reader = (struct frame_reader *)arg;
+  int eof = 0;
+
+  while (!eof) {
+    int slot;
+
+    pthread_mutex_lock(&reader->mutex);
+    while (reader->count == FRAME_QUEUE_SIZE && !reader->stop)
+      pthread_cond_wait(&reader->cond, &reader->mutex);
+    if (reader->stop) {
+      pthread_mutex_unlock(&reader->mutex);
+      break;
+    }
+    /* The slot past the queued frames is not touched by the encoder until it
+     * is queued below.
+     */
+    slot = (reader->head + reader->count) % FRAME_QUEUE_SIZE;
+    pthread_mutex_unlock(&reader->mutex);
+
+    eof = !frame_reader_read(reader, slot);
+
+    pthread_mutex_lock(&reader->mutex);
+    if (eof)
+      reader->eof = 1;
+    else
+      ++reader->count;
+    pthread_cond_signal(&reader->cond);
+    pthread_mutex_unlock(&reader->mutex);
+  }
+
+  return THREAD_RETURN(NULL);
+}
+#endif
+
+static void frame_reader_init(struct frame_reader *reader,
+                              struct AvxInputContext *input, int limit,
+                              int input_shift, int upshift) {
+  memset(reader, 0, sizeof(*reader));
+  reader->input = input;
+  reader->limit = limit;
+  reader->input_shift = input_shift;
+  reader->upshift = upshift;
+  reader->fmt = upshift ? input->fmt | AOM_IMG_FMT_HIGHBITDEPTH : input->fmt;
+
+  /* The Y4M reader fills in raw itself. */
+  if (upshift && input->file_type != FILE_TYPE_Y4M)
+    aom_img_alloc(&reader->raw, input->fmt, input->width, input->height, 32);
+
+#if CONFIG_MULTITHREAD
+  pthread_mutex_init(&reader->mutex, NULL);
+  pthread_cond_init(&reader->cond, NULL);
+  if (pthread_create(&reader->thread, NULL, frame_reader_thread, reader))
+    fatal("Failed to create the input reader thread");
+#endif
+}
+
+/* Returns the oldest queued frame, waiting for the reader if necessary, or
+ * NULL at the end of the input. The frame stays valid until
+ * frame_reader_release() is called.
+ */
+static aom_image_t *frame_reader_get(struct frame_reader *reader) {
+  aom_image_t *img = NULL;
+
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&reader->mutex);
+  while (!reader->count && !reader->eof)
+    pthread_cond_wait(&reader->cond, &reader->mutex);
+  if (reader->count) img = reader->frames[reader->head];
+  /* At the end of the input the head slot holds the final position. */
+  reader->pos = reader->positions[reader->head];
+  pthread_mutex_unlock(&reader->mutex);
+#else
+  if (!reader->count && !reader->eof) {
+    if (frame_reader_read(reader, reader->head))
+      reader->count = 1;
+    else
+      reader->eof = 1;
+  }
+  if (reader->count) img = reader->frames[reader->head];
+  reader->pos = reader->positions[reader->head];
+#endif
+  return img;
+}
+
+/* Returns the input file position after the frame last returned by
+ * frame_reader_get().
+ */
+static int64_t frame_reader_tell(const struct frame_reader *reader) {
+  return reader->pos;
+}
+
+static void frame_reader_release(struct frame_reader *reader) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&reader->mutex);
+#endif
+  assert(reader->count > 0);
+  reader->head = (reader->head + 1) % FRAME_QUEUE_SIZE;
+  --reader->count;
+#if CONFIG_MULTITHREAD
+  pthread_cond_signal(&reader->cond);
+  pthread_mutex_unlock(&reader->mutex);
+#endif
+}
+
+static void frame_reader_destroy(struct frame_reader *reader) {
+  int i;
+
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&reader->mutex);
+  reader->stop = 1;
+  pthread_cond_signal(&reader->cond);
+  pthread_mutex_unlock(&reader->mutex);
+  pthread_join(reader->thread, NULL);
+  pthread_mutex_destroy(&reader->mutex);
+  pthread_cond_destroy(&reader->cond);
+#endif
+
+  if (reader->upshift && reader->input->file_type != FILE_TYPE_Y4M)
+    aom_img_free(&reader->raw);
+  for (i = 0; i < FRAME_QUEUE_SIZE; ++i) aom_img_free(&reader->buffers[i]);
+}
+
 static int file_is_y4m(const char detect[4]) {
   if (memcmp(detect, "YUV4", 4) == 0) {
     return 1;
@@ -193,6 +417,10 @@ static const arg_def_t disable_warnings =
 static const arg_def_t disable_warning_prompt =
     ARG_DEF("y", "disable-warning-prompt", 0,
             "Display warnings, but do not prompt user to continue.");
+static const arg_def_t abr_ladder_arg =
+    ARG_DEF(NULL, "abr-ladder", 0,
+            "Encode the streams concurrently and share first pass analysis "
+            "between streams that differ only in target bitrate");
 static const struct arg_enum_list bitdepth_enum[] = {
   { "8", AOM_BITS_8 }, { "10", AOM_BITS_10 }, { "12", AOM_BITS_12 }, { NULL, 0 }
 };
@@ -226,6 +454,7 @@ static const arg_def_t *main_args[] = { &help,
                                         &disable_warnings,
                                         &disable_warning_prompt,
                                         &recontest,
+                                        &abr_ladder_arg,
                                         NULL };
 
 static const arg_def_t usage =
@@ -377,6 +606,13 @@ static const arg_def_t *kf_args[] = { &kf_min_dist, &kf_max_dist, &kf_disabled,
 
 static const arg_def_t noise_sens =
     ARG_DEF(NULL, "noise-sensitivity", 1, "Noise sensitivity (frames to blur)");
+static const arg_def_t denoise_noise_level =
+    ARG_DEF(NULL, "denoise-noise-level", 1,
+            "Denoise the source, assuming this noise level until the noise "
+            "model is fitted (0: off (default), 1..50)");
+static const arg_def_t denoise_block_size =
+    ARG_DEF(NULL, "denoise-block-size", 1,
+            "Noise model block size (8..64, default 32)");
 static const arg_def_t sharpness =
     ARG_DEF(NULL, "sharpness", 1, "Loop filter sharpness (0..7)");
 static const arg_def_t static_thresh =
@@ -679,6 +915,8 @@ static const arg_def_t *av1_args[] = { &cpu_used_av1,
 #endif
                                        &frame_periodic_boost,
                                        &noise_sens,
+                                       &denoise_noise_level,
+                                       &denoise_block_size,
                                        &tune_content,
 #if CONFIG_CICP
                                        &input_color_primaries,
@@ -747,6 +985,8 @@ static const int av1_arg_ctrl_map[] = { AOME_SET_CPUUSED,
 #endif
                                         AV1E_SET_FRAME_PERIODIC_BOOST,
                                         AV1E_SET_NOISE_SENSITIVITY,
+                                        AV1E_SET_DENOISE_NOISE_LEVEL,
+                                        AV1E_SET_DENOISE_BLOCK_SIZE,
                                         AV1E_SET_TUNE_CONTENT,
 #if CONFIG_CICP
                                         AV1E_SET_COLOR_PRIMARIES,
@@ -870,6 +1110,12 @@ struct stream_state {
   struct aom_image *img;
   aom_codec_ctx_t decoder;
   int mismatch_seen;
+  /* Earlier stream of the same size whose scaled input is reused. */
+  struct stream_state *scale_source;
+  /* Earlier stream whose first pass statistics are reused. */
+  struct stream_state *analysis_source;
+  /* The current input frame, scaled to the stream's size. */
+  struct aom_image *frame;
 };
 
 static void validate_positive_rational(const char *msg,
@@ -957,6 +1203,8 @@ static void parse_global_config(struct AvxEncoderConfig *global, char **argv) {
       global->disable_warnings = 1;
     else if (arg_match(&arg, &disable_warning_prompt, argi))
       global->disable_warning_prompt = 1;
+    else if (arg_match(&arg, &abr_ladder_arg, argi))
+      global->abr_ladder = 1;
     else
       argj++;
   }
@@ -1514,6 +1762,58 @@ static void close_output_file(struct stream_state *stream,
   fclose(stream->file);
 }
 
+/* Returns whether the first pass of stream b would produce the same
+ * statistics as that of stream a. The first pass does not depend on the
+ * target bitrate, so that is the only setting allowed to differ.
+ */
+static int same_first_pass(const struct stream_state *a,
+                           const struct stream_state *b) {
+  struct aom_codec_enc_cfg cfg;
+
+  memcpy(&cfg, &b->config.cfg, sizeof(cfg));
+  cfg.rc_target_bitrate = a->config.cfg.rc_target_bitrate;
+  return !memcmp(&cfg, &a->config.cfg, sizeof(cfg)) &&
+         a->config.use_16bit_internal == b->config.use_16bit_internal &&
+         a->config.arg_ctrl_cnt == b->config.arg_ctrl_cnt &&
+         !memcmp(a->config.arg_ctrls, b->config.arg_ctrls,
+                 a->config.arg_ctrl_cnt * sizeof(a->config.arg_ctrls[0]));
+}
+
+/* Points each stream at an earlier stream whose work it can reuse: the
+ * scaled input of one with the same dimensions and, in ABR ladder mode, the
+ * first pass of one with the same first pass settings.
+ */
+static void find_shared_stream_work(struct stream_state *streams,
+                                    const struct AvxEncoderConfig *global) {
+  const int share_first_pass =
+      global->abr_ladder && global->passes == 2 && !global->pass;
+
+  FOREACH_STREAM(stream, streams) {
+    struct stream_state *prev;
+
+    stream->scale_source = NULL;
+    stream->analysis_source = NULL;
+    for (prev = streams; prev != stream; prev = prev->next) {
+      if (!stream->scale_source &&
+          prev->config.cfg.g_w == stream->config.cfg.g_w &&
+          prev->config.cfg.g_h == stream->config.cfg.g_h &&
+          prev->config.use_16bit_internal ==
+              stream->config.use_16bit_internal)
+        stream->scale_source = prev;
+      /* A stream whose statistics go to a file must run its own first pass
+       * to produce them.
+       */
+      if (share_first_pass && !stream->analysis_source &&
+          !stream->config.stats_fn &&
+#if CONFIG_FP_MB_STATS
+          !stream->config.fpmb_stats_fn &&
+#endif
+          same_first_pass(prev, stream))
+        stream->analysis_source = prev;
+    }
+  }
+}
+
 static void setup_pass(struct stream_state *stream,
                        struct AvxEncoderConfig *global, int pass) {
   if (stream->config.stats_fn) {
@@ -1539,10 +1839,12 @@ static void setup_pass(struct stream_state *stream,
                                   ? pass ? AOM_RC_LAST_PASS : AOM_RC_FIRST_PASS
                                   : AOM_RC_ONE_PASS;
   if (pass) {
-    stream->config.cfg.rc_twopass_stats_in = stats_get(&stream->stats);
+    struct stream_state *const source =
+        stream->analysis_source ? stream->analysis_source : stream;
+    stream->config.cfg.rc_twopass_stats_in = stats_get(&source->stats);
 #if CONFIG_FP_MB_STATS
     stream->config.cfg.rc_firstpass_mb_stats_in =
-        stats_get(&stream->fpmb_stats);
+        stats_get(&source->fpmb_stats);
 #endif
   }
 
@@ -1601,21 +1903,15 @@ static void initialize_encoder(struct stream_state *stream,
 #endif
 }
 
-static void encode_frame(struct stream_state *stream,
-                         struct AvxEncoderConfig *global, struct aom_image *img,
-                         unsigned int frames_in) {
-  aom_codec_pts_t frame_start, next_frame_start;
+/* Returns img scaled to the stream's dimensions. Streams of the same size
+ * share the image scaled for the first of them.
+ */
+static struct aom_image *scale_frame(struct stream_state *stream,
+                                     struct aom_image *img) {
   struct aom_codec_enc_cfg *cfg = &stream->config.cfg;
-  struct aom_usec_timer timer;
 
-  frame_start =
-      (cfg->g_timebase.den * (int64_t)(frames_in - 1) * global->framerate.den) /
-      cfg->g_timebase.num / global->framerate.num;
-  next_frame_start =
-      (cfg->g_timebase.den * (int64_t)(frames_in)*global->framerate.den) /
-      cfg->g_timebase.num / global->framerate.num;
+  if (stream->scale_source) return stream->scale_source->frame;
 
-  /* Scale if necessary */
   if (img) {
     if ((img->fmt & AOM_IMG_FMT_HIGHBITDEPTH) &&
         (img->d_w != cfg->g_w || img->d_h != cfg->g_h)) {
@@ -1679,6 +1975,25 @@ static void encode_frame(struct stream_state *stream,
                       stream->index);
 #endif
   }
+  return img;
+}
+
+static void encode_frame(struct stream_state *stream,
+                         struct AvxEncoderConfig *global, struct aom_image *img,
+                         unsigned int frames_in) {
+  aom_codec_pts_t frame_start, next_frame_start;
+  struct aom_codec_enc_cfg *cfg = &stream->config.cfg;
+  struct aom_usec_timer timer;
+
+  frame_start =
+      (cfg->g_timebase.den * (int64_t)(frames_in - 1) * global->framerate.den) /
+      cfg->g_timebase.num / global->framerate.num;
+  next_frame_start =
+      (cfg->g_timebase.den * (int64_t)(frames_in)*global->framerate.den) /
+      cfg->g_timebase.num / global->framerate.num;
+
+  /* First pass statistics for this stream come from another stream. */
+  if (stream->analysis_source && cfg->g_pass == AOM_RC_FIRST_PASS) return;
 
   aom_usec_timer_start(&timer);
   aom_codec_encode(&stream->encoder, img, frame_start,
@@ -1689,6 +2004,116 @@ static void encode_frame(struct stream_state *stream,
                     stream->index);
 }
 
+#if CONFIG_MULTITHREAD
+/* Runs encode_frame() for all streams concurrently. The calling thread takes
+ * part, so a pool for n streams has n - 1 threads of its own.
+ */
+struct stream_pool {
+  struct stream_state *streams;
+  struct AvxEncoderConfig *global;
+  unsigned int frames_in;
+  /* The next stream to encode for the current frame. */
+  struct stream_state *next;
+  /* Streams of the current frame that have not finished. */
+  int pending;
+  int generation;
+  int stop;
+  int num_threads;
+  pthread_t *threads;
+  pthread_mutex_t mutex;
+  pthread_cond_t work_cond;
+  pthread_cond_t done_cond;
+};
+
+/* Encodes streams until none is left for the current frame. Called with the
+ * pool mutex held.
+ */
+static void stream_pool_run(struct stream_pool *pool) {
+  while (pool->next) {
+    struct stream_state *const stream = pool->next;
+
+    pool->next = stream->next;
+    pthread_mutex_unlock(&pool->mutex);
+    encode_frame(stream, pool->global, stream->frame, pool->frames_in);
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->pending == 0) pthread_cond_signal(&pool->done_cond);
+  }
+}
+
+static THREADFN stream_pool_thread(void *arg) {
+  struct stream_pool *const pool = (struct stream_pool *)arg;
+  int generation = 0;
+
+  pthread_mutex_lock(&pool->mutex);
+  for (;;) {
+    while (pool->generation == generation && !pool->stop)
+      pthread_cond_wait(&pool->work_cond, &pool->mutex);
+    if (pool->stop) break;
+    generation = pool->generation;
+    stream_pool_run(pool);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+
+  return THREAD_RETURN(NULL);
+}
+
+static void stream_pool_init(struct stream_pool *pool,
+                             struct stream_state *streams,
+                             struct AvxEncoderConfig *global, int stream_cnt) {
+  int i;
+
+  memset(pool, 0, sizeof(*pool));
+  pool->streams = streams;
+  pool->global = global;
+  pool->num_threads = stream_cnt - 1;
+  pool->threads = malloc(pool->num_threads * sizeof(*pool->threads));
+  if (!pool->threads) fatal("Failed to allocate stream threads");
+
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->work_cond, NULL);
+  pthread_cond_init(&pool->done_cond, NULL);
+  for (i = 0; i < pool->num_threads; ++i) {
+    if (pthread_create(&pool->threads[i], NULL, stream_pool_thread, pool))
+      fatal("Failed to create stream thread");
+  }
+}
+
+static void stream_pool_encode(struct stream_pool *pool,
+                               unsigned int frames_in) {
+  int i;
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->frames_in = frames_in;
+  pool->next = pool->streams;
+  pool->pending = 0;
+  FOREACH_STREAM(stream, pool->streams) { ++pool->pending; }
+  ++pool->generation;
+  /* There is no portable broadcast, so wake the threads one by one. */
+  for (i = 0; i < pool->num_threads; ++i)
+    pthread_cond_signal(&pool->work_cond);
+
+  stream_pool_run(pool);
+  while (pool->pending) pthread_cond_wait(&pool->done_cond, &pool->mutex);
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+static void stream_pool_destroy(struct stream_pool *pool) {
+  int i;
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->stop = 1;
+  for (i = 0; i < pool->num_threads; ++i)
+    pthread_cond_signal(&pool->work_cond);
+  pthread_mutex_unlock(&pool->mutex);
+
+  for (i = 0; i < pool->num_threads; ++i) pthread_join(pool->threads[i], NULL);
+  pthread_cond_destroy(&pool->done_cond);
+  pthread_cond_destroy(&pool->work_cond);
+  pthread_mutex_destroy(&pool->mutex);
+  free(pool->threads);
+}
+#endif  // CONFIG_MULTITHREAD
+
 static void update_quantizer_histogram(struct stream_state *stream) {
   if (stream->config.cfg.g_pass != AOM_RC_FIRST_PASS) {
     int q;
@@ -1896,9 +2321,7 @@ static void print_time(const char *label, int64_t etl) {
 
 int main(int argc, const char **argv_) {
   int pass;
-  aom_image_t raw;
-  aom_image_t raw_shift;
-  int allocated_raw_shift = 0;
+  struct frame_reader reader;
   int use_16bit_internal = 0;
   int input_shift = 0;
   int frame_avail, got_data;
@@ -1909,6 +2332,10 @@ int main(int argc, const char **argv_) {
   char **argv, **argi;
   uint64_t cx_time = 0;
   int stream_cnt = 0;
+#if CONFIG_MULTITHREAD
+  struct stream_pool stream_pool;
+  int use_stream_pool;
+#endif
   int res = 0;
   int profile_updated = 0;
 
@@ -1973,6 +2400,12 @@ int main(int argc, const char **argv_) {
   /* Decide if other chroma subsamplings than 4:2:0 are supported */
   if (global.codec->fourcc == AV1_FOURCC) input.only_i420 = 0;
 
+#if CONFIG_MULTITHREAD
+  use_stream_pool = global.abr_ladder && stream_cnt > 1;
+  if (use_stream_pool)
+    stream_pool_init(&stream_pool, streams, &global, stream_cnt);
+#endif
+
   for (pass = global.pass ? global.pass - 1 : 0; pass < global.passes; pass++) {
     int frames_in = 0, seen_frames = 0;
     int64_t estimated_time_left = -1;
@@ -2145,18 +2578,11 @@ int main(int argc, const char **argv_) {
     }
 
     if (pass == (global.pass ? global.pass - 1 : 0)) {
-      if (input.file_type == FILE_TYPE_Y4M)
-        /*The Y4M reader does its own allocation.
-          Just initialize this here to avoid problems if we never read any
-          frames.*/
-        memset(&raw, 0, sizeof(raw));
-      else
-        aom_img_alloc(&raw, input.fmt, input.width, input.height, 32);
-
       FOREACH_STREAM(stream, streams) {
         stream->rate_hist =
             init_rate_histogram(&stream->config.cfg, &global.framerate);
       }
+      find_shared_stream_work(streams, &global);
     }
 
     FOREACH_STREAM(stream, streams) { setup_pass(stream, &global, pass); }
@@ -2182,14 +2608,25 @@ int main(int argc, const char **argv_) {
       };
     }
 
+    if (input_shift || (use_16bit_internal && input.bit_depth == 8)) {
+      assert(use_16bit_internal);
+      // Input bit depth and stream bit depth do not match, so the reader up
+      // shifts frames to stream bit depth
+      frame_reader_init(&reader, &input, global.limit, input_shift, 1);
+    } else {
+      frame_reader_init(&reader, &input, global.limit, 0, 0);
+    }
+
     frame_avail = 1;
     got_data = 0;
 
     while (frame_avail || got_data) {
       struct aom_usec_timer timer;
+      aom_image_t *frame_to_encode = NULL;
 
       if (!global.limit || frames_in < global.limit) {
-        frame_avail = read_frame(&input, &raw);
+        frame_to_encode = frame_reader_get(&reader);
+        frame_avail = frame_to_encode != NULL;
 
         if (frame_avail) frames_in++;
         seen_frames =
@@ -2217,38 +2654,28 @@ int main(int argc, const char **argv_) {
       }
 
       if (frames_in > global.skip_frames) {
-        aom_image_t *frame_to_encode;
-        if (input_shift || (use_16bit_internal && input.bit_depth == 8)) {
-          assert(use_16bit_internal);
-          // Input bit depth and stream bit depth do not match, so up
-          // shift frame to stream bit depth
-          if (!allocated_raw_shift) {
-            aom_img_alloc(&raw_shift, raw.fmt | AOM_IMG_FMT_HIGHBITDEPTH,
-                          input.width, input.height, 32);
-            allocated_raw_shift = 1;
-          }
-          aom_img_upshift(&raw_shift, &raw, input_shift);
-          frame_to_encode = &raw_shift;
-        } else {
-          frame_to_encode = &raw;
-        }
         aom_usec_timer_start(&timer);
         if (use_16bit_internal) {
-          assert(frame_to_encode->fmt & AOM_IMG_FMT_HIGHBITDEPTH);
+          assert(!frame_to_encode ||
+                 (frame_to_encode->fmt & AOM_IMG_FMT_HIGHBITDEPTH));
           FOREACH_STREAM(stream, streams) {
-            if (stream->config.use_16bit_internal)
-              encode_frame(stream, &global,
-                           frame_avail ? frame_to_encode : NULL, frames_in);
-            else
-              assert(0);
-          };
+            assert(stream->config.use_16bit_internal);
+          }
         } else {
-          assert((frame_to_encode->fmt & AOM_IMG_FMT_HIGHBITDEPTH) == 0);
+          assert(!frame_to_encode ||
+                 (frame_to_encode->fmt & AOM_IMG_FMT_HIGHBITDEPTH) == 0);
+        }
+        FOREACH_STREAM(stream, streams) {
+          stream->frame = scale_frame(stream, frame_to_encode);
+        }
+#if CONFIG_MULTITHREAD
+        if (use_stream_pool)
+          stream_pool_encode(&stream_pool, frames_in);
+        else
+#endif
           FOREACH_STREAM(stream, streams) {
-            encode_frame(stream, &global, frame_avail ? frame_to_encode : NULL,
-                         frames_in);
+            encode_frame(stream, &global, stream->frame, frames_in);
           }
-        }
         aom_usec_timer_mark(&timer);
         cx_time += aom_usec_timer_elapsed(&timer);
 
@@ -2261,7 +2688,8 @@ int main(int argc, const char **argv_) {
 
         if (!got_data && input.length && streams != NULL &&
             !streams->frames_out) {
-          lagged_count = global.limit ? seen_frames : ftello(input.file);
+          lagged_count =
+              global.limit ? seen_frames : frame_reader_tell(&reader);
         } else if (input.length) {
           int64_t remaining;
           int64_t rate;
@@ -2273,7 +2701,7 @@ int main(int argc, const char **argv_) {
             remaining = 1000 * (global.limit - global.skip_frames -
                                 seen_frames + lagged_count);
           } else {
-            const int64_t input_pos = ftello(input.file);
+            const int64_t input_pos = frame_reader_tell(&reader);
             const int64_t input_pos_lagged = input_pos - lagged_count;
             const int64_t input_limit = input.length;
 
@@ -2293,10 +2721,15 @@ int main(int argc, const char **argv_) {
         }
       }
 
+      // The encoder has taken its own copy of the frame by now.
+      if (frame_to_encode) frame_reader_release(&reader);
+
       fflush(stdout);
       if (!global.quiet) fprintf(stderr, "\033[K");
     }
 
+    frame_reader_destroy(&reader);
+
     if (stream_cnt > 1) fprintf(stderr, "\n");
 
     if (!global.quiet) {
@@ -2358,6 +2791,10 @@ int main(int argc, const char **argv_) {
     if (global.pass) break;
   }
 
+#if CONFIG_MULTITHREAD
+  if (use_stream_pool) stream_pool_destroy(&stream_pool);
+#endif
+
   if (global.show_q_hist_buckets) {
     FOREACH_STREAM(stream, streams) {
       show_q_histogram(stream->counts, global.show_q_hist_buckets);
@@ -2390,8 +2827,6 @@ int main(int argc, const char **argv_) {
   }
 #endif
 
-  if (allocated_raw_shift) aom_img_free(&raw_shift);
-  aom_img_free(&raw);
   free(argv);
   free(streams);
   return res ? EXIT_FAILURE : EXIT_SUCCESS;
@@ -55,6 +55,7 @@ struct AvxEncoderConfig {
   int disable_warnings;
   int disable_warning_prompt;
   int experimental_bitstream;
+  int abr_ladder;
 };
 
 #ifdef __cplusplus
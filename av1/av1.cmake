@@ -122,6 +122,8 @@ set(AOM_AV1_ENCODER_SOURCES
     "${AOM_ROOT}/av1/encoder/cost.c"
     "${AOM_ROOT}/av1/encoder/cost.h"
     "${AOM_ROOT}/av1/encoder/dct.c"
+    "${AOM_ROOT}/av1/encoder/denoise.c"
+    "${AOM_ROOT}/av1/encoder/denoise.h"
     "${AOM_ROOT}/av1/encoder/encodeframe.c"
     "${AOM_ROOT}/av1/encoder/encodeframe.h"
     "${AOM_ROOT}/av1/encoder/encodemb.c"
@@ -148,6 +150,7 @@ set(AOM_AV1_ENCODER_SOURCES
     "${AOM_ROOT}/av1/encoder/mcomp.h"
     "${AOM_ROOT}/av1/encoder/palette.c"
     "${AOM_ROOT}/av1/encoder/palette.h"
+    "${AOM_ROOT}/av1/encoder/partition_model_weights.h"
     "${AOM_ROOT}/av1/encoder/picklpf.c"
     "${AOM_ROOT}/av1/encoder/picklpf.h"
     "${AOM_ROOT}/av1/encoder/ratectrl.c"
@@ -173,7 +176,8 @@ if (CONFIG_DAALA_TX)
 endif ()
 
 set(AOM_AV1_COMMON_INTRIN_SSE2
-    "${AOM_ROOT}/av1/common/x86/idct_intrin_sse2.c")
+    "${AOM_ROOT}/av1/common/x86/idct_intrin_sse2.c"
+    "${AOM_ROOT}/av1/common/x86/resize_sse2.c")
 
 set(AOM_AV1_COMMON_INTRIN_SSSE3
     "${AOM_ROOT}/av1/common/x86/av1_convolve_ssse3.c")
@@ -181,7 +185,8 @@ set(AOM_AV1_COMMON_INTRIN_SSSE3
 set(AOM_AV1_COMMON_INTRIN_SSE4_1
     "${AOM_ROOT}/av1/common/x86/av1_txfm_sse4.c"
     "${AOM_ROOT}/av1/common/x86/av1_txfm_sse4.h"
-    "${AOM_ROOT}/av1/common/x86/highbd_inv_txfm_sse4.c")
+    "${AOM_ROOT}/av1/common/x86/highbd_inv_txfm_sse4.c"
+    "${AOM_ROOT}/av1/common/x86/reconintra_sse4.c")
 
 set(AOM_AV1_COMMON_INTRIN_AVX2
     "${AOM_ROOT}/av1/common/x86/highbd_inv_txfm_avx2.c"
@@ -206,6 +211,7 @@ set(AOM_AV1_ENCODER_ASM_SSE2
 set(AOM_AV1_ENCODER_INTRIN_SSE2
     "${AOM_ROOT}/av1/encoder/x86/dct_intrin_sse2.c"
     "${AOM_ROOT}/av1/encoder/x86/highbd_block_error_intrin_sse2.c"
+    "${AOM_ROOT}/av1/encoder/x86/av1_k_means_sse2.c"
     "${AOM_ROOT}/av1/encoder/x86/av1_quantize_sse2.c")
 
 set(AOM_AV1_ENCODER_ASM_SSSE3_X86_64
@@ -442,6 +448,12 @@ if (CONFIG_INTRA_EDGE)
       "${AOM_ROOT}/av1/common/x86/intra_edge_sse4.c")
 endif ()
 
+if (CONFIG_FILTER_INTRA)
+  set(AOM_AV1_COMMON_INTRIN_SSE4_1
+      ${AOM_AV1_COMMON_INTRIN_SSE4_1}
+      "${AOM_ROOT}/av1/common/x86/filterintra_sse4.c")
+endif ()
+
 set(AOM_AV1_COMMON_SOURCES
     ${AOM_AV1_COMMON_SOURCES}
     "${AOM_ROOT}/av1/common/warped_motion.c"
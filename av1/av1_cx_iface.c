@@ -100,6 +100,9 @@ struct av1_extracfg {
 #endif  // CONFIG_EXT_TILE
 
   unsigned int motion_vector_unit_test;
+  unsigned int enable_stage_stats;
+  unsigned int denoise_noise_level;
+  unsigned int denoise_block_size;
 };
 
 static struct av1_extracfg default_extra_cfg = {
@@ -172,7 +175,10 @@ static struct av1_extracfg default_extra_cfg = {
   0,    // Single tile decoding is off by default.
 #endif  // CONFIG_EXT_TILE
 
-  0,  // motion_vector_unit_test
+  0,   // motion_vector_unit_test
+  0,   // enable_stage_stats
+  0,   // denoise_noise_level
+  32,  // denoise_block_size
 };
 
 struct aom_codec_alg_priv {
@@ -242,6 +248,7 @@ static aom_codec_err_t validate_config(aom_codec_alg_priv_t *ctx,
   RANGE_CHECK(cfg, g_timebase.den, 1, 1000000000);
   RANGE_CHECK(cfg, g_timebase.num, 1, cfg->g_timebase.den);
   RANGE_CHECK_HI(cfg, g_profile, MAX_PROFILES - 1);
+  RANGE_CHECK_HI(cfg, g_usage, AOM_USAGE_REALTIME);
 
   RANGE_CHECK_HI(cfg, rc_max_quantizer, 63);
   RANGE_CHECK_HI(cfg, rc_min_quantizer, cfg->rc_max_quantizer);
@@ -294,6 +301,9 @@ static aom_codec_err_t validate_config(aom_codec_alg_priv_t *ctx,
         "or kf_max_dist instead.");
 
   RANGE_CHECK_HI(extra_cfg, motion_vector_unit_test, 2);
+  RANGE_CHECK_HI(extra_cfg, enable_stage_stats, 1);
+  RANGE_CHECK_HI(extra_cfg, denoise_noise_level, 50);
+  RANGE_CHECK(extra_cfg, denoise_block_size, 8, 64);
   RANGE_CHECK_HI(extra_cfg, enable_auto_alt_ref, 2);
   RANGE_CHECK_HI(extra_cfg, enable_auto_bwd_ref, 2);
   RANGE_CHECK(extra_cfg, cpu_used, 0, 8);
@@ -499,7 +509,7 @@ static aom_codec_err_t set_encoder_config(
   oxcf->init_framerate = (double)cfg->g_timebase.den / cfg->g_timebase.num;
   if (oxcf->init_framerate > 180) oxcf->init_framerate = 30;
 
-  oxcf->mode = GOOD;
+  oxcf->mode = cfg->g_usage == AOM_USAGE_REALTIME ? REALTIME : GOOD;
 
   switch (cfg->g_pass) {
     case AOM_RC_ONE_PASS: oxcf->pass = 0; break;
@@ -713,6 +723,9 @@ static aom_codec_err_t set_encoder_config(
 
   oxcf->frame_periodic_boost = extra_cfg->frame_periodic_boost;
   oxcf->motion_vector_unit_test = extra_cfg->motion_vector_unit_test;
+  oxcf->enable_stage_stats = extra_cfg->enable_stage_stats;
+  oxcf->denoise_noise_level = extra_cfg->denoise_noise_level;
+  oxcf->denoise_block_size = extra_cfg->denoise_block_size;
   return AOM_CODEC_OK;
 }
 
@@ -1052,6 +1065,27 @@ static aom_codec_err_t ctrl_enable_motion_vector_unit_test(
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static aom_codec_err_t ctrl_set_enable_stage_stats(aom_codec_alg_priv_t *ctx,
+                                                   va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.enable_stage_stats = CAST(AV1E_SET_ENABLE_STAGE_STATS, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static aom_codec_err_t ctrl_set_denoise_noise_level(aom_codec_alg_priv_t *ctx,
+                                                    va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.denoise_noise_level = CAST(AV1E_SET_DENOISE_NOISE_LEVEL, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static aom_codec_err_t ctrl_set_denoise_block_size(aom_codec_alg_priv_t *ctx,
+                                                   va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.denoise_block_size = CAST(AV1E_SET_DENOISE_BLOCK_SIZE, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
 static aom_codec_err_t encoder_init(aom_codec_ctx_t *ctx,
                                     aom_codec_priv_enc_mr_cfg_t *data) {
   aom_codec_err_t res = AOM_CODEC_OK;
@@ -1240,11 +1274,6 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
     }
   }
 
-  if (ctx->oxcf.mode != GOOD) {
-    ctx->oxcf.mode = GOOD;
-    av1_change_config(ctx->cpi, &ctx->oxcf);
-  }
-
   aom_codec_pkt_list_init(&ctx->pkt_list);
 
   volatile aom_enc_frame_flags_t flags = enc_flags;
@@ -1531,6 +1560,14 @@ static aom_codec_err_t ctrl_get_active_map(aom_codec_alg_priv_t *ctx,
   }
 }
 
+static aom_codec_err_t ctrl_get_stage_stats(aom_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  aom_enc_stage_stats_t *const stats = va_arg(args, aom_enc_stage_stats_t *);
+  if (stats == NULL) return AOM_CODEC_INVALID_PARAM;
+  *stats = ctx->cpi->stage_stats;
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_scale_mode(aom_codec_alg_priv_t *ctx,
                                            va_list args) {
   aom_scaling_mode_t *const mode = va_arg(args, aom_scaling_mode_t *);
@@ -1711,6 +1748,9 @@ static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AV1E_SET_SINGLE_TILE_DECODING, ctrl_set_single_tile_decoding },
 #endif  // CONFIG_EXT_TILE
   { AV1E_ENABLE_MOTION_VECTOR_UNIT_TEST, ctrl_enable_motion_vector_unit_test },
+  { AV1E_SET_ENABLE_STAGE_STATS, ctrl_set_enable_stage_stats },
+  { AV1E_SET_DENOISE_NOISE_LEVEL, ctrl_set_denoise_noise_level },
+  { AV1E_SET_DENOISE_BLOCK_SIZE, ctrl_set_denoise_block_size },
 
   // Getters
   { AOME_GET_LAST_QUANTIZER, ctrl_get_quantizer },
@@ -1718,6 +1758,7 @@ static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AV1_GET_REFERENCE, ctrl_get_reference },
   { AV1E_GET_ACTIVEMAP, ctrl_get_active_map },
   { AV1_GET_NEW_FRAME_IMAGE, ctrl_get_new_frame_image },
+  { AV1E_GET_STAGE_STATS, ctrl_get_stage_stats },
 
   { -1, NULL },
 };
@@ -1771,6 +1812,65 @@ static aom_codec_enc_cfg_map_t encoder_usage_cfg_map[] = {
         0,     // rc_two_pass_vbrmin_section
         2000,  // rc_two_pass_vbrmax_section
 
+        // keyframing settings (kf)
+        AOM_KF_AUTO,  // g_kfmode
+        0,            // kf_min_dist
+        9999,         // kf_max_dist
+        0,            // large_scale_tile
+        0,            // monochrome
+        0,            // tile_width_count
+        0,            // tile_height_count
+        { 0 },        // tile_widths
+        { 0 },        // tile_heights
+    } },
+  { 1,
+    {
+        // NOLINT
+        1,  // g_usage
+        8,  // g_threads
+        0,  // g_profile
+
+        320,         // g_width
+        240,         // g_height
+        AOM_BITS_8,  // g_bit_depth
+        8,           // g_input_bit_depth
+
+        { 1, 30 },  // g_timebase
+
+        0,  // g_error_resilient
+
+        AOM_RC_ONE_PASS,  // g_pass
+
+        0,  // g_lag_in_frames
+
+        0,                // rc_dropframe_thresh
+        RESIZE_NONE,      // rc_resize_mode
+        SCALE_NUMERATOR,  // rc_resize_denominator
+        SCALE_NUMERATOR,  // rc_resize_kf_denominator
+
+        0,                // rc_superres_mode
+        SCALE_NUMERATOR,  // rc_superres_denominator
+        SCALE_NUMERATOR,  // rc_superres_kf_denominator
+        63,               // rc_superres_qthresh
+        63,               // rc_superres_kf_qthresh
+
+        AOM_CBR,      // rc_end_usage
+        { NULL, 0 },  // rc_twopass_stats_in
+        { NULL, 0 },  // rc_firstpass_mb_stats_in
+        256,          // rc_target_bandwidth
+        0,            // rc_min_quantizer
+        63,           // rc_max_quantizer
+        25,           // rc_undershoot_pct
+        25,           // rc_overshoot_pct
+
+        6000,  // rc_max_buffer_size
+        4000,  // rc_buffer_initial_size
+        5000,  // rc_buffer_optimal_size
+
+        50,    // rc_two_pass_vbrbias
+        0,     // rc_two_pass_vbrmin_section
+        2000,  // rc_two_pass_vbrmax_section
+
         // keyframing settings (kf)
         AOM_KF_AUTO,  // g_kfmode
         0,            // kf_min_dist
@@ -1805,7 +1905,7 @@ CODEC_INTERFACE(aom_codec_av1_cx) = {
   },
   {
       // NOLINT
-      1,                      // 1 cfg map
+      2,                      // 2 cfg maps
       encoder_usage_cfg_map,  // aom_codec_enc_cfg_map_t
       encoder_encode,         // aom_codec_encode_fn_t
       encoder_get_cxdata,     // aom_codec_get_cx_data_fn_t
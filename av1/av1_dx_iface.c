@@ -56,6 +56,15 @@ struct aom_codec_alg_priv {
   int decode_tile_row;
   int decode_tile_col;
   unsigned int tile_mode;
+  int accounting_interval;
+#if CONFIG_EXT_TILE
+  // Tile list decoding, see AV1D_SET_TILE_LIST.
+  YV12_BUFFER_CONFIG *ext_refs;
+  int num_ext_refs;
+  aom_tile_list_entry_t *tile_list;
+  int tile_list_size;
+  int tile_list_cols;
+#endif  // CONFIG_EXT_TILE
 
   // Frame parallel related.
   int frame_parallel_decode;  // frame-based threading.
@@ -152,6 +161,10 @@ static aom_codec_err_t decoder_destroy(aom_codec_alg_priv_t *ctx) {
 
   aom_free(ctx->frame_workers);
   aom_free(ctx->buffer_pool);
+#if CONFIG_EXT_TILE
+  aom_free(ctx->ext_refs);
+  aom_free(ctx->tile_list);
+#endif  // CONFIG_EXT_TILE
   aom_free(ctx);
   return AOM_CODEC_OK;
 }
@@ -562,6 +575,10 @@ static aom_codec_err_t init_decoder(aom_codec_alg_priv_t *ctx) {
     frame_worker_data->pbi->inv_tile_order = ctx->invert_tile_order;
     frame_worker_data->pbi->common.frame_parallel_decode =
         ctx->frame_parallel_decode;
+#if CONFIG_ACCOUNTING
+    if (ctx->accounting_interval > 0)
+      frame_worker_data->pbi->acct_interval = ctx->accounting_interval;
+#endif
 #if CONFIG_EXT_TILE
     frame_worker_data->pbi->common.large_scale_tile = ctx->tile_mode;
     frame_worker_data->pbi->dec_tile_row = ctx->decode_tile_row;
@@ -621,6 +638,16 @@ static aom_codec_err_t decode_one(aom_codec_alg_priv_t *ctx,
     frame_worker_data->pbi->inspect_cb = ctx->inspect_cb;
     frame_worker_data->pbi->inspect_ctx = ctx->inspect_ctx;
 #endif
+#if CONFIG_EXT_TILE
+    frame_worker_data->pbi->common.large_scale_tile = ctx->tile_mode;
+    frame_worker_data->pbi->dec_tile_row = ctx->decode_tile_row;
+    frame_worker_data->pbi->dec_tile_col = ctx->decode_tile_col;
+    frame_worker_data->pbi->ext_refs = ctx->ext_refs;
+    frame_worker_data->pbi->num_ext_refs = ctx->num_ext_refs;
+    frame_worker_data->pbi->tile_list = ctx->tile_list;
+    frame_worker_data->pbi->tile_list_size = ctx->tile_list_size;
+    frame_worker_data->pbi->tile_list_cols = ctx->tile_list_cols;
+#endif  // CONFIG_EXT_TILE
 
     worker->had_error = 0;
     winterface->execute(worker);
@@ -883,6 +910,16 @@ static aom_image_t *decoder_get_frame(aom_codec_alg_priv_t *ctx,
           yuvconfig2image(&ctx->img, &sd, frame_worker_data->user_priv);
 
 #if CONFIG_EXT_TILE
+          if (cm->large_scale_tile && !cm->show_existing_frame &&
+              frame_worker_data->pbi->tile_list_size > 0) {
+            // The listed tiles are output as a mosaic.
+            yuvconfig2image(&ctx->img,
+                            &frame_worker_data->pbi->tile_list_outbuf,
+                            frame_worker_data->user_priv);
+            img = &ctx->img;
+            return img;
+          }
+
           if (cm->single_tile_decoding &&
               frame_worker_data->pbi->dec_tile_row >= 0) {
             const int tile_row =
@@ -1187,6 +1224,32 @@ static aom_codec_err_t ctrl_get_bit_depth(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_INVALID_PARAM;
 }
 
+static aom_codec_err_t ctrl_get_stage_timing(aom_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  aom_dec_stage_timing_t *const timing = va_arg(args, aom_dec_stage_timing_t *);
+  int i;
+
+  if (!timing) return AOM_CODEC_INVALID_PARAM;
+  if (!ctx->frame_workers) return AOM_CODEC_ERROR;
+
+  memset(timing, 0, sizeof(*timing));
+  for (i = 0; i < ctx->num_frame_workers; ++i) {
+    const FrameWorkerData *const frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[i].data1;
+    const aom_dec_stage_timing_t *const t =
+        &frame_worker_data->pbi->stage_timing;
+    timing->tile_parse += t->tile_parse;
+    timing->tile_recon += t->tile_recon;
+    timing->coeff_read += t->coeff_read;
+    timing->loop_filter += t->loop_filter;
+    timing->cdef += t->cdef;
+    timing->superres += t->superres;
+    timing->loop_restoration += t->loop_restoration;
+    timing->frames += t->frames;
+  }
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_invert_tile_order(aom_codec_alg_priv_t *ctx,
                                                   va_list args) {
   ctx->invert_tile_order = va_arg(args, int);
@@ -1246,6 +1309,29 @@ static aom_codec_err_t ctrl_get_accounting(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_ERROR;
 #endif
 }
+static aom_codec_err_t ctrl_set_accounting_interval(aom_codec_alg_priv_t *ctx,
+                                                    va_list args) {
+#if !CONFIG_ACCOUNTING
+  (void)ctx;
+  (void)args;
+  return AOM_CODEC_INCAPABLE;
+#else
+  const int interval = va_arg(args, int);
+  if (interval < 1) return AOM_CODEC_INVALID_PARAM;
+  ctx->accounting_interval = interval;
+
+  if (ctx->frame_workers) {
+    for (int i = 0; i < ctx->num_frame_workers; ++i) {
+      AVxWorker *const worker = &ctx->frame_workers[i];
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)worker->data1;
+      frame_worker_data->pbi->acct_interval = interval;
+    }
+  }
+  return AOM_CODEC_OK;
+#endif
+}
+
 static aom_codec_err_t ctrl_set_decode_tile_row(aom_codec_alg_priv_t *ctx,
                                                 va_list args) {
   ctx->decode_tile_row = va_arg(args, int);
@@ -1264,6 +1350,79 @@ static aom_codec_err_t ctrl_set_tile_mode(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_set_ext_ref_ptr(aom_codec_alg_priv_t *ctx,
+                                           va_list args) {
+#if !CONFIG_EXT_TILE
+  (void)ctx;
+  (void)args;
+  return AOM_CODEC_INCAPABLE;
+#else
+  const av1_ext_ref_frame_t *const data = va_arg(args, av1_ext_ref_frame_t *);
+  YV12_BUFFER_CONFIG *ext_refs = NULL;
+
+  // Only support this function in serial decode.
+  if (ctx->frame_parallel_decode) {
+    set_error_detail(ctx, "Not supported in frame parallel decode");
+    return AOM_CODEC_INCAPABLE;
+  }
+
+  if (data == NULL || data->num < 0 || (data->num > 0 && data->img == NULL))
+    return AOM_CODEC_INVALID_PARAM;
+
+  // The images are wrapped, not copied.
+  if (data->num > 0) {
+    ext_refs = (YV12_BUFFER_CONFIG *)aom_calloc(data->num, sizeof(*ext_refs));
+    if (ext_refs == NULL) {
+      set_error_detail(ctx, "Failed to allocate external references");
+      return AOM_CODEC_MEM_ERROR;
+    }
+    for (int i = 0; i < data->num; ++i)
+      image2yuvconfig(&data->img[i], &ext_refs[i]);
+  }
+  aom_free(ctx->ext_refs);
+  ctx->ext_refs = ext_refs;
+  ctx->num_ext_refs = data->num;
+  return AOM_CODEC_OK;
+#endif  // !CONFIG_EXT_TILE
+}
+
+static aom_codec_err_t ctrl_set_tile_list(aom_codec_alg_priv_t *ctx,
+                                          va_list args) {
+#if !CONFIG_EXT_TILE
+  (void)ctx;
+  (void)args;
+  return AOM_CODEC_INCAPABLE;
+#else
+  const aom_tile_list_t *const list = va_arg(args, aom_tile_list_t *);
+  aom_tile_list_entry_t *tile_list = NULL;
+
+  // Only support this function in serial decode.
+  if (ctx->frame_parallel_decode) {
+    set_error_detail(ctx, "Not supported in frame parallel decode");
+    return AOM_CODEC_INCAPABLE;
+  }
+
+  if (list == NULL || list->num_entries < 0 ||
+      (list->num_entries > 0 && list->entries == NULL))
+    return AOM_CODEC_INVALID_PARAM;
+
+  if (list->num_entries > 0) {
+    tile_list = (aom_tile_list_entry_t *)aom_malloc(list->num_entries *
+                                                    sizeof(*tile_list));
+    if (tile_list == NULL) {
+      set_error_detail(ctx, "Failed to allocate tile list");
+      return AOM_CODEC_MEM_ERROR;
+    }
+    memcpy(tile_list, list->entries, list->num_entries * sizeof(*tile_list));
+  }
+  aom_free(ctx->tile_list);
+  ctx->tile_list = tile_list;
+  ctx->tile_list_size = list->num_entries;
+  ctx->tile_list_cols = list->output_cols;
+  return AOM_CODEC_OK;
+#endif  // !CONFIG_EXT_TILE
+}
+
 static aom_codec_err_t ctrl_set_inspection_callback(aom_codec_alg_priv_t *ctx,
                                                     va_list args) {
 #if !CONFIG_INSPECTION
@@ -1295,6 +1454,9 @@ static aom_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { AV1_SET_DECODE_TILE_COL, ctrl_set_decode_tile_col },
   { AV1_SET_TILE_MODE, ctrl_set_tile_mode },
   { AV1_SET_INSPECTION_CALLBACK, ctrl_set_inspection_callback },
+  { AV1_SET_ACCOUNTING_INTERVAL, ctrl_set_accounting_interval },
+  { AV1D_SET_EXT_REF_PTR, ctrl_set_ext_ref_ptr },
+  { AV1D_SET_TILE_LIST, ctrl_set_tile_list },
 
   // Getters
   { AOMD_GET_FRAME_CORRUPTED, ctrl_get_frame_corrupted },
@@ -1306,6 +1468,7 @@ static aom_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { AV1_GET_ACCOUNTING, ctrl_get_accounting },
   { AV1_GET_NEW_FRAME_IMAGE, ctrl_get_new_frame_image },
   { AV1_GET_REFERENCE, ctrl_get_reference },
+  { AV1D_GET_STAGE_TIMING, ctrl_get_stage_timing },
 
   { -1, NULL },
 };
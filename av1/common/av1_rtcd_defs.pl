@@ -69,6 +69,12 @@ specialize qw/av1_convolve_horiz ssse3/;
 add_proto qw/void av1_convolve_vert/, "const uint8_t *src, int src_stride, uint8_t *dst, int dst_stride, int w, int h, const InterpFilterParams fp, const int subpel_x_q4, int x_step_q4, ConvolveParams *conv_params";
 specialize qw/av1_convolve_vert ssse3/;
 
+#
+# Frame resizing
+#
+add_proto qw/void av1_resize_vert_8tap/, "const uint8_t *const *rows, const int16_t *filter, uint8_t *output, int cols";
+specialize qw/av1_resize_vert_8tap sse2/;
+
 if (aom_config("CONFIG_HORZONLY_FRAME_SUPERRES") eq "yes") {
   add_proto qw/void av1_convolve_horiz_rs/, "const uint8_t *src, int src_stride, uint8_t *dst, int dst_stride, int w, int h, const int16_t *x_filters, const int x0_qn, const int x_step_qn";
   specialize qw/av1_convolve_horiz_rs sse4_1/;
@@ -182,8 +188,33 @@ if (aom_config("CONFIG_FILTER_INTRA") eq "yes") {
     add_proto qw/void av1_highbd_d153_filter_predictor/, "uint16_t *dst, ptrdiff_t stride, TX_SIZE tx_size, const uint16_t *above, const uint16_t *left, int bd";
     add_proto qw/void av1_highbd_paeth_filter_predictor/, "uint16_t *dst, ptrdiff_t stride, TX_SIZE tx_size, const uint16_t *above, const uint16_t *left, int bd";
 
+  specialize qw/av1_dc_filter_predictor sse4_1/;
+  specialize qw/av1_v_filter_predictor sse4_1/;
+  specialize qw/av1_h_filter_predictor sse4_1/;
+  specialize qw/av1_d153_filter_predictor sse4_1/;
+  specialize qw/av1_paeth_filter_predictor sse4_1/;
+  specialize qw/av1_highbd_dc_filter_predictor sse4_1/;
+  specialize qw/av1_highbd_v_filter_predictor sse4_1/;
+  specialize qw/av1_highbd_h_filter_predictor sse4_1/;
+  specialize qw/av1_highbd_d153_filter_predictor sse4_1/;
+  specialize qw/av1_highbd_paeth_filter_predictor sse4_1/;
 }
 
+# Directional intra predictors
+add_proto qw/void av1_dr_prediction_z1/, "uint8_t *dst, ptrdiff_t stride, int bw, int bh, const uint8_t *above, const uint8_t *left, int upsample_above, int dx, int dy";
+specialize qw/av1_dr_prediction_z1 sse4_1/;
+add_proto qw/void av1_dr_prediction_z2/, "uint8_t *dst, ptrdiff_t stride, int bw, int bh, const uint8_t *above, const uint8_t *left, int upsample_above, int upsample_left, int dx, int dy";
+specialize qw/av1_dr_prediction_z2 sse4_1/;
+add_proto qw/void av1_dr_prediction_z3/, "uint8_t *dst, ptrdiff_t stride, int bw, int bh, const uint8_t *above, const uint8_t *left, int upsample_left, int dx, int dy";
+specialize qw/av1_dr_prediction_z3 sse4_1/;
+
+add_proto qw/void av1_highbd_dr_prediction_z1/, "uint16_t *dst, ptrdiff_t stride, int bw, int bh, const uint16_t *above, const uint16_t *left, int upsample_above, int dx, int dy, int bd";
+specialize qw/av1_highbd_dr_prediction_z1 sse4_1/;
+add_proto qw/void av1_highbd_dr_prediction_z2/, "uint16_t *dst, ptrdiff_t stride, int bw, int bh, const uint16_t *above, const uint16_t *left, int upsample_above, int upsample_left, int dx, int dy, int bd";
+specialize qw/av1_highbd_dr_prediction_z2 sse4_1/;
+add_proto qw/void av1_highbd_dr_prediction_z3/, "uint16_t *dst, ptrdiff_t stride, int bw, int bh, const uint16_t *above, const uint16_t *left, int upsample_left, int dx, int dy, int bd";
+specialize qw/av1_highbd_dr_prediction_z3 sse4_1/;
+
 # High bitdepth functions
   #
   # Sub Pixel Filters
@@ -458,6 +489,12 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
   add_proto qw/void av1_wedge_compute_delta_squares/, "int16_t *d, const int16_t *a, const int16_t *b, int N";
   specialize qw/av1_wedge_compute_delta_squares sse2/;
 
+  # palette
+  add_proto qw/void av1_calc_indices_dim1/, "const int16_t *data, const int *centroids, uint8_t *indices, int n, int k";
+  specialize qw/av1_calc_indices_dim1 sse2/;
+  add_proto qw/void av1_calc_indices_dim2/, "const int16_t *data, const int *centroids, uint8_t *indices, int n, int k";
+  specialize qw/av1_calc_indices_dim2 sse2/;
+
 }
 # end encoder functions
 
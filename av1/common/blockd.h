@@ -595,6 +595,11 @@ typedef struct macroblockd {
   /* pointer to current frame */
   const YV12_BUFFER_CONFIG *cur_buf;
 
+  // Scratch for each reference, of MC_BORDER_BUF_SIZE samples, in which inter
+  // prediction rebuilds reference blocks that reach outside the frame. Set by
+  // decoders whose reference frames have no extended borders; NULL otherwise.
+  uint8_t *mc_buf[2];
+
   ENTROPY_CONTEXT *above_context[MAX_MB_PLANE];
   ENTROPY_CONTEXT left_context[MAX_MB_PLANE][2 * MAX_MIB_SIZE];
 
@@ -663,6 +668,14 @@ typedef struct macroblockd {
 
   DECLARE_ALIGNED(16, uint8_t, seg_mask[2 * MAX_SB_SQUARE]);
 
+  // CDEF strength of each 64x64 unit of the current superblock, or -1 while it
+  // has not been coded yet. Kept per tile so tiles can be coded in parallel.
+#if CONFIG_EXT_PARTITION
+  int cdef_preset[4];
+#else
+  int cdef_preset;
+#endif
+
 #if CONFIG_CFL
   CFL_CTX cfl;
 #endif
@@ -9,6 +9,7 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include "aom_mem/aom_mem.h"
 #include "av1/common/mvref_common.h"
 #include "av1/common/warped_motion.h"
 
@@ -1415,15 +1416,25 @@ static int get_block_position(AV1_COMMON *cm, int *mi_r, int *mi_c, int blk_row,
   return 1;
 }
 
-static int motion_field_projection(AV1_COMMON *cm, MV_REFERENCE_FRAME ref_frame,
-                                   int ref_stamp, int dir) {
-  TPL_MV_REF *tpl_mvs_base = cm->tpl_mvs;
+// Parameters of the projection of one reference frame's motion field onto
+// the current frame.
+typedef struct {
+  const MV_REF *mv_ref_base;
+  int ref_stamp;
+  int dir;
+  int ref_to_cur;
+  int cur_offset[TOTAL_REFS_PER_FRAME];
+  int ref_offset[TOTAL_REFS_PER_FRAME];
+} MotionFieldProjection;
+
+static int setup_motion_field_projection(const AV1_COMMON *cm,
+                                         MV_REFERENCE_FRAME ref_frame,
+                                         int ref_stamp, int dir,
+                                         MotionFieldProjection *proj) {
   int cur_rf_index[TOTAL_REFS_PER_FRAME] = { 0 };
   int ref_rf_idx[TOTAL_REFS_PER_FRAME] = { 0 };
-  int cur_offset[TOTAL_REFS_PER_FRAME] = { 0 };
-  int ref_offset[TOTAL_REFS_PER_FRAME] = { 0 };
-
-  (void)dir;
+  int *const cur_offset = proj->cur_offset;
+  int *const ref_offset = proj->ref_offset;
 
   int ref_frame_idx = cm->frame_refs[FWD_RF_OFFSET(ref_frame)].idx;
   if (ref_frame_idx < 0) return 0;
@@ -1452,6 +1463,8 @@ static int motion_field_projection(AV1_COMMON *cm, MV_REFERENCE_FRAME ref_frame,
   ref_rf_idx[ALTREF_FRAME] =
       cm->buffer_pool->frame_bufs[ref_frame_idx].alt_frame_offset;
 
+  memset(cur_offset, 0, sizeof(proj->cur_offset));
+  memset(ref_offset, 0, sizeof(proj->ref_offset));
   for (MV_REFERENCE_FRAME rf = LAST_FRAME; rf <= INTER_REFS_PER_FRAME; ++rf) {
     int buf_idx = cm->frame_refs[FWD_RF_OFFSET(rf)].idx;
     if (buf_idx >= 0)
@@ -1470,28 +1483,43 @@ static int motion_field_projection(AV1_COMMON *cm, MV_REFERENCE_FRAME ref_frame,
 
   if (dir == 2) ref_to_cur = -ref_to_cur;
 
-  MV_REF *mv_ref_base = cm->buffer_pool->frame_bufs[ref_frame_idx].mvs;
-  const int mvs_rows = (cm->mi_rows + 1) >> 1;
+  proj->mv_ref_base = cm->buffer_pool->frame_bufs[ref_frame_idx].mvs;
+  proj->ref_stamp = ref_stamp;
+  proj->dir = dir;
+  proj->ref_to_cur = ref_to_cur;
+  return 1;
+}
+
+// Projects the motion vectors of rows [row_start, row_end) of a reference
+// frame's motion field.
+static void motion_field_projection_rows(AV1_COMMON *cm,
+                                         const MotionFieldProjection *proj,
+                                         int row_start, int row_end) {
+  TPL_MV_REF *tpl_mvs_base = cm->tpl_mvs;
+  const int dir = proj->dir;
+  const int ref_stamp = proj->ref_stamp;
   const int mvs_cols = (cm->mi_cols + 1) >> 1;
 
-  for (int blk_row = 0; blk_row < mvs_rows; ++blk_row) {
+  for (int blk_row = row_start; blk_row < row_end; ++blk_row) {
     for (int blk_col = 0; blk_col < mvs_cols; ++blk_col) {
-      MV_REF *mv_ref = &mv_ref_base[blk_row * mvs_cols + blk_col];
+      const MV_REF *mv_ref = &proj->mv_ref_base[blk_row * mvs_cols + blk_col];
       MV fwd_mv = mv_ref->mv[dir & 0x01].as_mv;
 
       if (mv_ref->ref_frame[dir & 0x01] > INTRA_FRAME) {
         int_mv this_mv;
         int mi_r, mi_c;
-        const int ref_frame_offset = ref_offset[mv_ref->ref_frame[dir & 0x01]];
+        const int ref_frame_offset =
+            proj->ref_offset[mv_ref->ref_frame[dir & 0x01]];
 
-        get_mv_projection(&this_mv.as_mv, fwd_mv, ref_to_cur, ref_frame_offset);
+        get_mv_projection(&this_mv.as_mv, fwd_mv, proj->ref_to_cur,
+                          ref_frame_offset);
         int pos_valid = get_block_position(cm, &mi_r, &mi_c, blk_row, blk_col,
                                            this_mv.as_mv, dir >> 1);
         if (pos_valid) {
           int mi_offset = mi_r * (cm->mi_stride >> 1) + mi_c;
 
           for (MV_REFERENCE_FRAME rf = ALTREF_FRAME; rf >= LAST_FRAME; --rf) {
-            get_mv_projection(&this_mv.as_mv, fwd_mv, cur_offset[rf],
+            get_mv_projection(&this_mv.as_mv, fwd_mv, proj->cur_offset[rf],
                               ref_frame_offset);
             tpl_mvs_base[mi_offset].mfmv[FWD_RF_OFFSET(rf)][ref_stamp].as_int =
                 this_mv.as_int;
@@ -1500,24 +1528,52 @@ static int motion_field_projection(AV1_COMMON *cm, MV_REFERENCE_FRAME ref_frame,
       }
     }
   }
-
-  return 1;
 }
 
-void av1_setup_motion_field(AV1_COMMON *cm) {
-  int cur_frame_index = cm->cur_frame->cur_frame_offset;
-  int alt_frame_index = 0, gld_frame_index = 0;
-  int bwd_frame_index = 0, alt2_frame_index = 0;
-
+// The motion field is set up in bands of MFMV_BAND_ROWS rows. A projected
+// motion vector never leaves the band of the block it was projected from (see
+// get_block_position()), so the bands can be set up independently.
+#define MFMV_BAND_ROWS 8
+
+typedef struct {
+  AV1_COMMON *cm;
+  const MotionFieldProjection *projs;
+  int num_projs;
+  int row_start;
+  int row_end;
+} MotionFieldJobData;
+
+static int motion_field_worker(MotionFieldJobData *const job, void *unused) {
+  AV1_COMMON *const cm = job->cm;
   TPL_MV_REF *tpl_mvs_base = cm->tpl_mvs;
-  for (int ref_frame = 0; ref_frame < INTER_REFS_PER_FRAME; ++ref_frame) {
-    int size = ((cm->mi_rows + MAX_MIB_SIZE) >> 1) * (cm->mi_stride >> 1);
-    for (int idx = 0; idx < size; ++idx) {
+  const int tpl_stride = cm->mi_stride >> 1;
+  const int mvs_rows = (cm->mi_rows + 1) >> 1;
+  (void)unused;
+
+  for (int idx = job->row_start * tpl_stride; idx < job->row_end * tpl_stride;
+       ++idx) {
+    for (int ref_frame = 0; ref_frame < INTER_REFS_PER_FRAME; ++ref_frame) {
       for (int i = 0; i < MFMV_STACK_SIZE; ++i)
         tpl_mvs_base[idx].mfmv[ref_frame][i].as_int = INVALID_MV;
     }
   }
 
+  for (int i = 0; i < job->num_projs; ++i) {
+    motion_field_projection_rows(cm, &job->projs[i], job->row_start,
+                                 AOMMIN(job->row_end, mvs_rows));
+  }
+  return 1;
+}
+
+void av1_setup_motion_field(AV1_COMMON *cm, AVxWorker *workers,
+                            int num_workers) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  int cur_frame_index = cm->cur_frame->cur_frame_offset;
+  int alt_frame_index = 0, gld_frame_index = 0;
+  int bwd_frame_index = 0, alt2_frame_index = 0;
+  MotionFieldProjection projs[4];
+  int num_projs = 0;
+
   int gld_buf_idx = cm->frame_refs[GOLDEN_FRAME - LAST_FRAME].idx;
   int alt_buf_idx = cm->frame_refs[ALTREF_FRAME - LAST_FRAME].idx;
   int lst_buf_idx = cm->frame_refs[LAST_FRAME - LAST_FRAME].idx;
@@ -1550,6 +1606,8 @@ void av1_setup_motion_field(AV1_COMMON *cm) {
       cm->ref_frame_side[ref_frame] = -1;
   }
 
+  // Each reference is projected into its own slot of the stack, so the order
+  // in which they are applied to a band does not matter.
   int ref_stamp = MFMV_STACK_SIZE - 1;
 
   if (lst_buf_idx >= 0) {
@@ -1557,21 +1615,77 @@ void av1_setup_motion_field(AV1_COMMON *cm) {
         cm->buffer_pool->frame_bufs[lst_buf_idx].alt_frame_offset;
 
     const int is_lst_overlay = (alt_frame_idx == gld_frame_index);
-    if (!is_lst_overlay) motion_field_projection(cm, LAST_FRAME, ref_stamp, 1);
+    if (!is_lst_overlay &&
+        setup_motion_field_projection(cm, LAST_FRAME, ref_stamp, 1,
+                                      &projs[num_projs]))
+      ++num_projs;
 
     --ref_stamp;
   }
 
   if (bwd_frame_index > cur_frame_index) {
-    if (motion_field_projection(cm, BWDREF_FRAME, ref_stamp, 0)) --ref_stamp;
+    if (setup_motion_field_projection(cm, BWDREF_FRAME, ref_stamp, 0,
+                                      &projs[num_projs])) {
+      ++num_projs;
+      --ref_stamp;
+    }
   }
 
   if (alt2_frame_index > cur_frame_index) {
-    if (motion_field_projection(cm, ALTREF2_FRAME, ref_stamp, 0)) --ref_stamp;
+    if (setup_motion_field_projection(cm, ALTREF2_FRAME, ref_stamp, 0,
+                                      &projs[num_projs])) {
+      ++num_projs;
+      --ref_stamp;
+    }
+  }
+
+  if (alt_frame_index > cur_frame_index && ref_stamp >= 0) {
+    if (setup_motion_field_projection(cm, ALTREF_FRAME, ref_stamp, 0,
+                                      &projs[num_projs]))
+      ++num_projs;
   }
 
-  if (alt_frame_index > cur_frame_index && ref_stamp >= 0)
-    if (motion_field_projection(cm, ALTREF_FRAME, ref_stamp, 0)) --ref_stamp;
+  const int tpl_rows = (cm->mi_rows + MAX_MIB_SIZE) >> 1;
+  const int num_bands = (tpl_rows + MFMV_BAND_ROWS - 1) / MFMV_BAND_ROWS;
+  MotionFieldJobData single_job;
+  MotionFieldJobData *jobs = &single_job;
+  int num_jobs = AOMMAX(AOMMIN(num_workers, num_bands), 1);
+
+  if (num_jobs > 1) {
+    jobs = (MotionFieldJobData *)aom_malloc(num_jobs * sizeof(*jobs));
+    if (jobs == NULL) {
+      jobs = &single_job;
+      num_jobs = 1;
+    }
+  }
+
+  for (int i = 0; i < num_jobs; ++i) {
+    MotionFieldJobData *const job = &jobs[i];
+    job->cm = cm;
+    job->projs = projs;
+    job->num_projs = num_projs;
+    job->row_start = (i * num_bands / num_jobs) * MFMV_BAND_ROWS;
+    job->row_end =
+        AOMMIN(((i + 1) * num_bands / num_jobs) * MFMV_BAND_ROWS, tpl_rows);
+  }
+
+  if (num_jobs == 1) {
+    motion_field_worker(jobs, NULL);
+    return;
+  }
+
+  for (int i = 0; i < num_jobs; ++i) {
+    AVxWorker *const worker = &workers[i];
+    worker->hook = (AVxWorkerHook)motion_field_worker;
+    worker->data1 = &jobs[i];
+    worker->data2 = NULL;
+    if (i == num_jobs - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+  for (int i = 0; i < num_jobs; ++i) winterface->sync(&workers[i]);
+  aom_free(jobs);
 }
 #endif  // CONFIG_MFMV
 
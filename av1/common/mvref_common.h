@@ -451,7 +451,11 @@ void av1_setup_frame_sign_bias(AV1_COMMON *cm);
 void av1_setup_skip_mode_allowed(AV1_COMMON *cm);
 #endif  // CONFIG_EXT_SKIP
 #if CONFIG_MFMV
-void av1_setup_motion_field(AV1_COMMON *cm);
+// Projects the motion fields of the reference frames onto the current frame.
+// If num_workers > 1, the work is shared between up to num_workers of the
+// given workers, which must be idle.
+void av1_setup_motion_field(AV1_COMMON *cm, AVxWorker *workers,
+                            int num_workers);
 #endif  // CONFIG_MFMV
 #endif  // CONFIG_FRAME_MARKER
 
@@ -550,11 +550,6 @@ typedef struct AV1Common {
   int cdef_strengths[CDEF_MAX_STRENGTHS];
   int cdef_uv_strengths[CDEF_MAX_STRENGTHS];
   int cdef_bits;
-#if CONFIG_EXT_PARTITION
-  int cdef_preset[4];
-#else
-  int cdef_preset;
-#endif
 
   int delta_q_present_flag;
   // Resolution of delta quant
@@ -916,6 +916,85 @@ void av1_jnt_comp_weight_assign(const AV1_COMMON *cm, const MB_MODE_INFO *mbmi,
 }
 #endif  // CONFIG_JNT_COMP
 
+// Copies the b_w x b_h block at (x, y) of a w x h frame to dst, replicating the
+// outermost frame samples for the parts outside the frame, the way
+// aom_extend_frame_borders() would have.
+static void build_mc_border(const uint8_t *frame, int frame_stride,
+                            uint8_t *dst, int dst_stride, int x, int y,
+                            int b_w, int b_h, int w, int h) {
+  const int left = AOMMIN(b_w, AOMMAX(0, -x));
+  const int right = AOMMIN(b_w - left, AOMMAX(0, x + b_w - w));
+  const int copy = b_w - left - right;
+
+  for (int r = 0; r < b_h; ++r, dst += dst_stride) {
+    const uint8_t *const row = frame + clamp(y + r, 0, h - 1) * frame_stride;
+    if (left) memset(dst, row[0], left);
+    if (copy) memcpy(dst + left, row + x + left, copy);
+    if (right) memset(dst + left + copy, row[w - 1], right);
+  }
+}
+
+static void highbd_build_mc_border(const uint16_t *frame, int frame_stride,
+                                   uint16_t *dst, int dst_stride, int x, int y,
+                                   int b_w, int b_h, int w, int h) {
+  const int left = AOMMIN(b_w, AOMMAX(0, -x));
+  const int right = AOMMIN(b_w - left, AOMMAX(0, x + b_w - w));
+  const int copy = b_w - left - right;
+
+  for (int r = 0; r < b_h; ++r, dst += dst_stride) {
+    const uint16_t *const row = frame + clamp(y + r, 0, h - 1) * frame_stride;
+    if (left) aom_memset16(dst, row[0], left);
+    if (copy) memcpy(dst + left, row + x + left, copy * sizeof(*dst));
+    if (right) aom_memset16(dst + left + copy, row[w - 1], right);
+  }
+}
+
+// The prediction of a block whose first and last full-sample positions in the
+// reference frame are (x0, y0) and (x1, y1) reads the filter taps around them.
+// When xd provides edge emulation scratch and any of those samples lie outside
+// the frame, rebuilds them in xd->mc_buf[ref] and points *pre and *pre_stride
+// at the copy instead of the frame.
+static INLINE void extend_mc_border(const MACROBLOCKD *xd, int ref,
+                                    const struct buf_2d *pre_buf, int x0,
+                                    int y0, int x1, int y1, uint8_t **pre,
+                                    int *pre_stride) {
+  const int x = x0 - (AOM_INTERP_EXTEND - 1);
+  const int y = y0 - (AOM_INTERP_EXTEND - 1);
+  const int b_w = x1 - x0 + 2 * AOM_INTERP_EXTEND;
+  const int b_h = y1 - y0 + 2 * AOM_INTERP_EXTEND;
+  const int offset =
+      (AOM_INTERP_EXTEND - 1) * MC_BORDER_BUF_STRIDE + AOM_INTERP_EXTEND - 1;
+
+  if (xd->mc_buf[ref] == NULL) return;
+  if (x >= 0 && y >= 0 && x + b_w <= pre_buf->width &&
+      y + b_h <= pre_buf->height)
+    return;
+
+  assert(b_w <= MC_BORDER_BUF_STRIDE && b_h <= MC_BORDER_BUF_STRIDE);
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    uint16_t *const buf = (uint16_t *)xd->mc_buf[ref];
+    highbd_build_mc_border(CONVERT_TO_SHORTPTR(pre_buf->buf0), pre_buf->stride,
+                           buf, MC_BORDER_BUF_STRIDE, x, y, b_w, b_h,
+                           pre_buf->width, pre_buf->height);
+    *pre = CONVERT_TO_BYTEPTR(buf + offset);
+  } else {
+    build_mc_border(pre_buf->buf0, pre_buf->stride, xd->mc_buf[ref],
+                    MC_BORDER_BUF_STRIDE, x, y, b_w, b_h, pre_buf->width,
+                    pre_buf->height);
+    *pre = xd->mc_buf[ref] + offset;
+  }
+  *pre_stride = MC_BORDER_BUF_STRIDE;
+}
+
+// Returns the full-sample position of the top-left sample of the block that
+// pre_buf->buf points to, which lies inside the frame.
+static INLINE void get_block_position(const struct buf_2d *pre_buf, int *x,
+                                      int *y) {
+  const int offset = (int)(pre_buf->buf - pre_buf->buf0);
+  *x = offset % pre_buf->stride;
+  *y = offset / pre_buf->stride;
+}
+
 static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
                                           int plane, const MODE_INFO *mi,
                                           int build_for_obmc, int bw, int bh,
@@ -1029,6 +1108,7 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
           const MV mv = this_mbmi->mv[ref].as_mv;
 
           uint8_t *pre;
+          int pre_stride = pre_buf->stride;
           int xs, ys, subpel_x, subpel_y;
           const int is_scaled = av1_is_scaled(sf);
           WarpTypesAllowed warp_types;
@@ -1064,15 +1144,27 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
             subpel_y = pos_y & SCALE_SUBPEL_MASK;
             xs = sf->x_step_q4;
             ys = sf->y_step_q4;
+            extend_mc_border(xd, ref, pre_buf, pos_x >> SCALE_SUBPEL_BITS,
+                             pos_y >> SCALE_SUBPEL_BITS,
+                             (pos_x + (b4_w - 1) * xs) >> SCALE_SUBPEL_BITS,
+                             (pos_y + (b4_h - 1) * ys) >> SCALE_SUBPEL_BITS,
+                             &pre, &pre_stride);
           } else {
             const MV mv_q4 = clamp_mv_to_umv_border_sb(
                 xd, &mv, bw, bh, pd->subsampling_x, pd->subsampling_y);
+            int block_x, block_y;
             xs = ys = SCALE_SUBPEL_SHIFTS;
             subpel_x = (mv_q4.col & SUBPEL_MASK) << SCALE_EXTRA_BITS;
             subpel_y = (mv_q4.row & SUBPEL_MASK) << SCALE_EXTRA_BITS;
             pre = pre_buf->buf +
                   (y + (mv_q4.row >> SUBPEL_BITS)) * pre_buf->stride +
                   (x + (mv_q4.col >> SUBPEL_BITS));
+            get_block_position(pre_buf, &block_x, &block_y);
+            block_x += x + (mv_q4.col >> SUBPEL_BITS);
+            block_y += y + (mv_q4.row >> SUBPEL_BITS);
+            extend_mc_border(xd, ref, pre_buf, block_x, block_y,
+                             block_x + b4_w - 1, block_y + b4_h - 1, &pre,
+                             &pre_stride);
           }
 
           conv_params.ref = ref;
@@ -1083,14 +1175,14 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
           }
           if (ref && is_masked_compound_type(mi->mbmi.interinter_compound_type))
             av1_make_masked_inter_predictor(
-                pre, pre_buf->stride, dst, dst_buf->stride, subpel_x, subpel_y,
-                sf, b4_w, b4_h, &conv_params, mi->mbmi.interp_filters, xs, ys,
+                pre, pre_stride, dst, dst_buf->stride, subpel_x, subpel_y, sf,
+                b4_w, b4_h, &conv_params, mi->mbmi.interp_filters, xs, ys,
                 plane, &warp_types, (mi_x >> pd->subsampling_x) + x,
                 (mi_y >> pd->subsampling_y) + y, ref, xd);
           else
             av1_make_inter_predictor(
-                pre, pre_buf->stride, dst, dst_buf->stride, subpel_x, subpel_y,
-                sf, b4_w, b4_h, &conv_params, this_mbmi->interp_filters,
+                pre, pre_stride, dst, dst_buf->stride, subpel_x, subpel_y, sf,
+                b4_w, b4_h, &conv_params, this_mbmi->interp_filters,
                 &warp_types, (mi_x >> pd->subsampling_x) + x,
                 (mi_y >> pd->subsampling_y) + y, plane, ref, mi, build_for_obmc,
                 xs, ys, xd);
@@ -1121,6 +1213,7 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
     struct buf_2d *const dst_buf = &pd->dst;
     uint8_t *const dst = dst_buf->buf + dst_buf->stride * y + x;
     uint8_t *pre[2];
+    int pre_stride[2];
     SubpelParams subpel_params[2];
     DECLARE_ALIGNED(16, int32_t, tmp_dst[MAX_SB_SIZE * MAX_SB_SIZE]);
 
@@ -1135,6 +1228,7 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
 #endif  // CONFIG_INTRABC
       const MV mv = mi->mbmi.mv[ref].as_mv;
 
+      pre_stride[ref] = pre_buf->stride;
       const int is_scaled = av1_is_scaled(sf);
       if (is_scaled) {
         // Note: The various inputs here have different units:
@@ -1172,9 +1266,16 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
         subpel_params[ref].subpel_y = pos_y & SCALE_SUBPEL_MASK;
         subpel_params[ref].xs = sf->x_step_q4;
         subpel_params[ref].ys = sf->y_step_q4;
+        extend_mc_border(
+            xd, ref, pre_buf, pos_x >> SCALE_SUBPEL_BITS,
+            pos_y >> SCALE_SUBPEL_BITS,
+            (pos_x + (w - 1) * subpel_params[ref].xs) >> SCALE_SUBPEL_BITS,
+            (pos_y + (h - 1) * subpel_params[ref].ys) >> SCALE_SUBPEL_BITS,
+            &pre[ref], &pre_stride[ref]);
       } else {
         const MV mv_q4 = clamp_mv_to_umv_border_sb(
             xd, &mv, bw, bh, pd->subsampling_x, pd->subsampling_y);
+        int block_x, block_y;
         subpel_params[ref].subpel_x = (mv_q4.col & SUBPEL_MASK)
                                       << SCALE_EXTRA_BITS;
         subpel_params[ref].subpel_y = (mv_q4.row & SUBPEL_MASK)
@@ -1184,6 +1285,11 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
         pre[ref] = pre_buf->buf +
                    (y + (mv_q4.row >> SUBPEL_BITS)) * pre_buf->stride +
                    (x + (mv_q4.col >> SUBPEL_BITS));
+        get_block_position(pre_buf, &block_x, &block_y);
+        block_x += x + (mv_q4.col >> SUBPEL_BITS);
+        block_y += y + (mv_q4.row >> SUBPEL_BITS);
+        extend_mc_border(xd, ref, pre_buf, block_x, block_y, block_x + w - 1,
+                         block_y + h - 1, &pre[ref], &pre_stride[ref]);
       }
     }
 
@@ -1199,10 +1305,8 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
 #if CONFIG_INTRABC
       const struct scale_factors *const sf =
           is_intrabc ? &cm->sf_identity : &xd->block_refs[ref]->sf;
-      struct buf_2d *const pre_buf = is_intrabc ? dst_buf : &pd->pre[ref];
 #else
       const struct scale_factors *const sf = &xd->block_refs[ref]->sf;
-      struct buf_2d *const pre_buf = &pd->pre[ref];
 #endif  // CONFIG_INTRABC
       WarpTypesAllowed warp_types;
       warp_types.global_warp_allowed = is_global[ref];
@@ -1216,7 +1320,7 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
 
       if (ref && is_masked_compound_type(mi->mbmi.interinter_compound_type))
         av1_make_masked_inter_predictor(
-            pre[ref], pre_buf->stride, dst, dst_buf->stride,
+            pre[ref], pre_stride[ref], dst, dst_buf->stride,
             subpel_params[ref].subpel_x, subpel_params[ref].subpel_y, sf, w, h,
             &conv_params, mi->mbmi.interp_filters, subpel_params[ref].xs,
             subpel_params[ref].ys, plane, &warp_types,
@@ -1224,7 +1328,7 @@ static INLINE void build_inter_predictors(const AV1_COMMON *cm, MACROBLOCKD *xd,
             ref, xd);
       else
         av1_make_inter_predictor(
-            pre[ref], pre_buf->stride, dst, dst_buf->stride,
+            pre[ref], pre_stride[ref], dst, dst_buf->stride,
             subpel_params[ref].subpel_x, subpel_params[ref].subpel_y, sf, w, h,
             &conv_params, mi->mbmi.interp_filters, &warp_types,
             (mi_x >> pd->subsampling_x) + x, (mi_y >> pd->subsampling_y) + y,
@@ -1566,12 +1670,14 @@ static INLINE void build_prediction_by_above_pred(MACROBLOCKD *xd,
                                                   uint8_t above_mi_width,
                                                   MODE_INFO *above_mi,
                                                   void *fun_ctxt) {
-  MB_MODE_INFO *above_mbmi = &above_mi->mbmi;
+  // The neighbor is predicted from a modified copy of its mode info, which
+  // leaves the mode info grid untouched.
+  MODE_INFO above_mi_copy = *above_mi;
+  MB_MODE_INFO *above_mbmi = &above_mi_copy.mbmi;
   const BLOCK_SIZE a_bsize = AOMMAX(BLOCK_8X8, above_mbmi->sb_type);
   struct build_prediction_ctxt *ctxt = (struct build_prediction_ctxt *)fun_ctxt;
   const int above_mi_col = ctxt->mi_col + rel_mi_col;
 
-  MB_MODE_INFO backup_mbmi = *above_mbmi;
   modify_neighbor_predictor_for_obmc(above_mbmi);
 
   for (int j = 0; j < MAX_MB_PLANE; ++j) {
@@ -1612,10 +1718,9 @@ static INLINE void build_prediction_by_above_pred(MACROBLOCKD *xd,
                    block_size_high[BLOCK_64X64] >> (pd->subsampling_y + 1));
 
     if (skip_u4x4_pred_in_obmc(bsize, pd, 0)) continue;
-    build_inter_predictors(ctxt->cm, xd, j, above_mi, 1, bw, bh, 0, 0, bw, bh,
-                           mi_x, mi_y);
+    build_inter_predictors(ctxt->cm, xd, j, &above_mi_copy, 1, bw, bh, 0, 0,
+                           bw, bh, mi_x, mi_y);
   }
-  *above_mbmi = backup_mbmi;
 }
 
 void av1_build_prediction_by_above_preds(const AV1_COMMON *cm, MACROBLOCKD *xd,
@@ -1652,12 +1757,13 @@ static INLINE void build_prediction_by_left_pred(MACROBLOCKD *xd,
                                                  uint8_t left_mi_height,
                                                  MODE_INFO *left_mi,
                                                  void *fun_ctxt) {
-  MB_MODE_INFO *left_mbmi = &left_mi->mbmi;
+  // Predicted from a modified copy, as for the above neighbors.
+  MODE_INFO left_mi_copy = *left_mi;
+  MB_MODE_INFO *left_mbmi = &left_mi_copy.mbmi;
   const BLOCK_SIZE l_bsize = AOMMAX(BLOCK_8X8, left_mbmi->sb_type);
   struct build_prediction_ctxt *ctxt = (struct build_prediction_ctxt *)fun_ctxt;
   const int left_mi_row = ctxt->mi_row + rel_mi_row;
 
-  MB_MODE_INFO backup_mbmi = *left_mbmi;
   modify_neighbor_predictor_for_obmc(left_mbmi);
 
   for (int j = 0; j < MAX_MB_PLANE; ++j) {
@@ -1699,10 +1805,9 @@ static INLINE void build_prediction_by_left_pred(MACROBLOCKD *xd,
     int bh = (left_mi_height << MI_SIZE_LOG2) >> pd->subsampling_y;
 
     if (skip_u4x4_pred_in_obmc(bsize, pd, 1)) continue;
-    build_inter_predictors(ctxt->cm, xd, j, left_mi, 1, bw, bh, 0, 0, bw, bh,
-                           mi_x, mi_y);
+    build_inter_predictors(ctxt->cm, xd, j, &left_mi_copy, 1, bw, bh, 0, 0,
+                           bw, bh, mi_x, mi_y);
   }
-  *left_mbmi = backup_mbmi;
 }
 
 void av1_build_prediction_by_left_preds(const AV1_COMMON *cm, MACROBLOCKD *xd,
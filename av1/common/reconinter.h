@@ -35,6 +35,11 @@
 #define AOM_LEFT_TOP_MARGIN_SCALED(subsampling) \
   (AOM_LEFT_TOP_MARGIN_PX(subsampling) << SCALE_SUBPEL_BITS)
 
+// Stride and size, in samples, of each MACROBLOCKD::mc_buf. A block predicted
+// from a scaled reference reads up to twice its size, plus the filter taps.
+#define MC_BORDER_BUF_STRIDE (2 * (MAX_SB_SIZE + AOM_INTERP_EXTEND) + 16)
+#define MC_BORDER_BUF_SIZE (MC_BORDER_BUF_STRIDE * MC_BORDER_BUF_STRIDE)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
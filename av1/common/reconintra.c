@@ -665,12 +665,9 @@ static void av1_init_intra_predictors_internal(void) {
 }
 
 // Directional prediction, zone 1: 0 < angle < 90
-static void dr_prediction_z1(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
-                             const uint8_t *above, const uint8_t *left,
-#if CONFIG_INTRA_EDGE
-                             int upsample_above,
-#endif  // CONFIG_INTRA_EDGE
-                             int dx, int dy) {
+void av1_dr_prediction_z1_c(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
+                            const uint8_t *above, const uint8_t *left,
+                            int upsample_above, int dx, int dy) {
   int r, c, x, base, shift, val;
 
   (void)left;
@@ -678,9 +675,6 @@ static void dr_prediction_z1(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
   assert(dy == 1);
   assert(dx > 0);
 
-#if !CONFIG_INTRA_EDGE
-  const int upsample_above = 0;
-#endif  // !CONFIG_INTRA_EDGE
   const int max_base_x = ((bw + bh) - 1) << upsample_above;
 #if CONFIG_EXT_INTRA_MOD2
   const int frac_bits = 6 - upsample_above;
@@ -723,21 +717,15 @@ static void dr_prediction_z1(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
 }
 
 // Directional prediction, zone 2: 90 < angle < 180
-static void dr_prediction_z2(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
-                             const uint8_t *above, const uint8_t *left,
-#if CONFIG_INTRA_EDGE
-                             int upsample_above, int upsample_left,
-#endif  // CONFIG_INTRA_EDGE
-                             int dx, int dy) {
+void av1_dr_prediction_z2_c(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
+                            const uint8_t *above, const uint8_t *left,
+                            int upsample_above, int upsample_left, int dx,
+                            int dy) {
   int r, c, x, y, shift1, shift2, val, base1, base2;
 
   assert(dx > 0);
   assert(dy > 0);
 
-#if !CONFIG_INTRA_EDGE
-  const int upsample_above = 0;
-  const int upsample_left = 0;
-#endif  // !CONFIG_INTRA_EDGE
   const int min_base_x = -(1 << upsample_above);
 #if CONFIG_EXT_INTRA_MOD2
   const int frac_bits_x = 6 - upsample_above;
@@ -785,12 +773,9 @@ static void dr_prediction_z2(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
 }
 
 // Directional prediction, zone 3: 180 < angle < 270
-static void dr_prediction_z3(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
-                             const uint8_t *above, const uint8_t *left,
-#if CONFIG_INTRA_EDGE
-                             int upsample_left,
-#endif  // CONFIG_INTRA_EDGE
-                             int dx, int dy) {
+void av1_dr_prediction_z3_c(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
+                            const uint8_t *above, const uint8_t *left,
+                            int upsample_left, int dx, int dy) {
   int r, c, y, base, shift, val;
 
   (void)above;
@@ -799,9 +784,6 @@ static void dr_prediction_z3(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
   assert(dx == 1);
   assert(dy > 0);
 
-#if !CONFIG_INTRA_EDGE
-  const int upsample_left = 0;
-#endif  // !CONFIG_INTRA_EDGE
   const int max_base_y = (bw + bh - 1) << upsample_left;
 #if CONFIG_EXT_INTRA_MOD2
   const int frac_bits = 6 - upsample_left;
@@ -878,24 +860,20 @@ static void dr_predictor(uint8_t *dst, ptrdiff_t stride, TX_SIZE tx_size,
   const int bh = tx_size_high[tx_size];
   assert(angle > 0 && angle < 270);
 
+#if !CONFIG_INTRA_EDGE
+  const int upsample_above = 0;
+  const int upsample_left = 0;
+#endif  // !CONFIG_INTRA_EDGE
+
   if (angle > 0 && angle < 90) {
-    dr_prediction_z1(dst, stride, bw, bh, above, left,
-#if CONFIG_INTRA_EDGE
-                     upsample_above,
-#endif  // CONFIG_INTRA_EDGE
-                     dx, dy);
+    av1_dr_prediction_z1(dst, stride, bw, bh, above, left, upsample_above, dx,
+                         dy);
   } else if (angle > 90 && angle < 180) {
-    dr_prediction_z2(dst, stride, bw, bh, above, left,
-#if CONFIG_INTRA_EDGE
-                     upsample_above, upsample_left,
-#endif  // CONFIG_INTRA_EDGE
-                     dx, dy);
+    av1_dr_prediction_z2(dst, stride, bw, bh, above, left, upsample_above,
+                         upsample_left, dx, dy);
   } else if (angle > 180 && angle < 270) {
-    dr_prediction_z3(dst, stride, bw, bh, above, left,
-#if CONFIG_INTRA_EDGE
-                     upsample_left,
-#endif  // CONFIG_INTRA_EDGE
-                     dx, dy);
+    av1_dr_prediction_z3(dst, stride, bw, bh, above, left, upsample_left, dx,
+                         dy);
   } else if (angle == 90) {
     pred[V_PRED][tx_size](dst, stride, above, left);
   } else if (angle == 180) {
@@ -904,13 +882,10 @@ static void dr_predictor(uint8_t *dst, ptrdiff_t stride, TX_SIZE tx_size,
 }
 
 // Directional prediction, zone 1: 0 < angle < 90
-static void highbd_dr_prediction_z1(uint16_t *dst, ptrdiff_t stride, int bw,
-                                    int bh, const uint16_t *above,
-                                    const uint16_t *left,
-#if CONFIG_INTRA_EDGE
-                                    int upsample_above,
-#endif  // CONFIG_INTRA_EDGE
-                                    int dx, int dy, int bd) {
+void av1_highbd_dr_prediction_z1_c(uint16_t *dst, ptrdiff_t stride, int bw,
+                                   int bh, const uint16_t *above,
+                                   const uint16_t *left, int upsample_above,
+                                   int dx, int dy, int bd) {
   int r, c, x, base, shift, val;
 
   (void)left;
@@ -918,9 +893,6 @@ static void highbd_dr_prediction_z1(uint16_t *dst, ptrdiff_t stride, int bw,
   assert(dy == 1);
   assert(dx > 0);
 
-#if !CONFIG_INTRA_EDGE
-  const int upsample_above = 0;
-#endif  // !CONFIG_INTRA_EDGE
   const int max_base_x = ((bw + bh) - 1) << upsample_above;
 #if CONFIG_EXT_INTRA_MOD2
   const int frac_bits = 6 - upsample_above;
@@ -963,22 +935,15 @@ static void highbd_dr_prediction_z1(uint16_t *dst, ptrdiff_t stride, int bw,
 }
 
 // Directional prediction, zone 2: 90 < angle < 180
-static void highbd_dr_prediction_z2(uint16_t *dst, ptrdiff_t stride, int bw,
-                                    int bh, const uint16_t *above,
-                                    const uint16_t *left,
-#if CONFIG_INTRA_EDGE
-                                    int upsample_above, int upsample_left,
-#endif  // CONFIG_INTRA_EDGE
-                                    int dx, int dy, int bd) {
+void av1_highbd_dr_prediction_z2_c(uint16_t *dst, ptrdiff_t stride, int bw,
+                                   int bh, const uint16_t *above,
+                                   const uint16_t *left, int upsample_above,
+                                   int upsample_left, int dx, int dy, int bd) {
   int r, c, x, y, shift, val, base;
 
   assert(dx > 0);
   assert(dy > 0);
 
-#if !CONFIG_INTRA_EDGE
-  const int upsample_above = 0;
-  const int upsample_left = 0;
-#endif  // !CONFIG_INTRA_EDGE
   const int min_base_x = -(1 << upsample_above);
 #if CONFIG_EXT_INTRA_MOD2
   const int frac_bits_x = 6 - upsample_above;
@@ -1031,13 +996,10 @@ static void highbd_dr_prediction_z2(uint16_t *dst, ptrdiff_t stride, int bw,
 }
 
 // Directional prediction, zone 3: 180 < angle < 270
-static void highbd_dr_prediction_z3(uint16_t *dst, ptrdiff_t stride, int bw,
-                                    int bh, const uint16_t *above,
-                                    const uint16_t *left,
-#if CONFIG_INTRA_EDGE
-                                    int upsample_left,
-#endif  // CONFIG_INTRA_EDGE
-                                    int dx, int dy, int bd) {
+void av1_highbd_dr_prediction_z3_c(uint16_t *dst, ptrdiff_t stride, int bw,
+                                   int bh, const uint16_t *above,
+                                   const uint16_t *left, int upsample_left,
+                                   int dx, int dy, int bd) {
   int r, c, y, base, shift, val;
 
   (void)above;
@@ -1045,9 +1007,6 @@ static void highbd_dr_prediction_z3(uint16_t *dst, ptrdiff_t stride, int bw,
   assert(dx == 1);
   assert(dy > 0);
 
-#if !CONFIG_INTRA_EDGE
-  const int upsample_left = 0;
-#endif  // !CONFIG_INTRA_EDGE
   const int max_base_y = (bw + bh - 1) << upsample_left;
 #if CONFIG_EXT_INTRA_MOD2
   const int frac_bits = 6 - upsample_left;
@@ -1095,24 +1054,20 @@ static void highbd_dr_predictor(uint16_t *dst, ptrdiff_t stride,
   const int bh = tx_size_high[tx_size];
   assert(angle > 0 && angle < 270);
 
+#if !CONFIG_INTRA_EDGE
+  const int upsample_above = 0;
+  const int upsample_left = 0;
+#endif  // !CONFIG_INTRA_EDGE
+
   if (angle > 0 && angle < 90) {
-    highbd_dr_prediction_z1(dst, stride, bw, bh, above, left,
-#if CONFIG_INTRA_EDGE
-                            upsample_above,
-#endif  // CONFIG_INTRA_EDGE
-                            dx, dy, bd);
+    av1_highbd_dr_prediction_z1(dst, stride, bw, bh, above, left,
+                                upsample_above, dx, dy, bd);
   } else if (angle > 90 && angle < 180) {
-    highbd_dr_prediction_z2(dst, stride, bw, bh, above, left,
-#if CONFIG_INTRA_EDGE
-                            upsample_above, upsample_left,
-#endif  // CONFIG_INTRA_EDGE
-                            dx, dy, bd);
+    av1_highbd_dr_prediction_z2(dst, stride, bw, bh, above, left,
+                                upsample_above, upsample_left, dx, dy, bd);
   } else if (angle > 180 && angle < 270) {
-    highbd_dr_prediction_z3(dst, stride, bw, bh, above, left,
-#if CONFIG_INTRA_EDGE
-                            upsample_left,
-#endif  // CONFIG_INTRA_EDGE
-                            dx, dy, bd);
+    av1_highbd_dr_prediction_z3(dst, stride, bw, bh, above, left,
+                                upsample_left, dx, dy, bd);
   } else if (angle == 90) {
     pred_high[V_PRED][tx_size](dst, stride, above, left, bd);
   } else if (angle == 180) {
@@ -1121,7 +1076,7 @@ static void highbd_dr_predictor(uint16_t *dst, ptrdiff_t stride,
 }
 
 #if CONFIG_FILTER_INTRA
-static int filter_intra_taps_4x2procunit[FILTER_INTRA_MODES][8][7] = {
+const int av1_filter_intra_taps[FILTER_INTRA_MODES][8][7] = {
   {
       { -6, 10, 0, 0, 0, 12, 0 },
       { -5, 2, 10, 0, 0, 9, 0 },
@@ -1205,13 +1160,13 @@ static void filter_intra_predictor(uint8_t *dst, ptrdiff_t stride,
         int r_offset = k >> 2;
         int c_offset = k & 0x03;
         buffer[r + r_offset][c + c_offset] =
-            filter_intra_taps_4x2procunit[mode][k][0] * p0 +
-            filter_intra_taps_4x2procunit[mode][k][1] * p1 +
-            filter_intra_taps_4x2procunit[mode][k][2] * p2 +
-            filter_intra_taps_4x2procunit[mode][k][3] * p3 +
-            filter_intra_taps_4x2procunit[mode][k][4] * p4 +
-            filter_intra_taps_4x2procunit[mode][k][5] * p5 +
-            filter_intra_taps_4x2procunit[mode][k][6] * p6;
+            av1_filter_intra_taps[mode][k][0] * p0 +
+            av1_filter_intra_taps[mode][k][1] * p1 +
+            av1_filter_intra_taps[mode][k][2] * p2 +
+            av1_filter_intra_taps[mode][k][3] * p3 +
+            av1_filter_intra_taps[mode][k][4] * p4 +
+            av1_filter_intra_taps[mode][k][5] * p5 +
+            av1_filter_intra_taps[mode][k][6] * p6;
         buffer[r + r_offset][c + c_offset] =
             clip_pixel(ROUND_POWER_OF_TWO_SIGNED(
                 buffer[r + r_offset][c + c_offset], FILTER_INTRA_SCALE_BITS));
@@ -1308,13 +1263,13 @@ static void highbd_filter_intra_predictor(uint16_t *dst, ptrdiff_t stride,
         int r_offset = k >> 2;
         int c_offset = k & 0x03;
         buffer[r + r_offset][c + c_offset] =
-            filter_intra_taps_4x2procunit[mode][k][0] * p0 +
-            filter_intra_taps_4x2procunit[mode][k][1] * p1 +
-            filter_intra_taps_4x2procunit[mode][k][2] * p2 +
-            filter_intra_taps_4x2procunit[mode][k][3] * p3 +
-            filter_intra_taps_4x2procunit[mode][k][4] * p4 +
-            filter_intra_taps_4x2procunit[mode][k][5] * p5 +
-            filter_intra_taps_4x2procunit[mode][k][6] * p6;
+            av1_filter_intra_taps[mode][k][0] * p0 +
+            av1_filter_intra_taps[mode][k][1] * p1 +
+            av1_filter_intra_taps[mode][k][2] * p2 +
+            av1_filter_intra_taps[mode][k][3] * p3 +
+            av1_filter_intra_taps[mode][k][4] * p4 +
+            av1_filter_intra_taps[mode][k][5] * p5 +
+            av1_filter_intra_taps[mode][k][6] * p6;
         buffer[r + r_offset][c + c_offset] = clip_pixel_highbd(
             ROUND_POWER_OF_TWO_SIGNED(buffer[r + r_offset][c + c_offset],
                                       FILTER_INTRA_SCALE_BITS),
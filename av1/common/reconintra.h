@@ -43,6 +43,10 @@ static const INTERINTRA_MODE intra_to_interintra_mode[INTRA_MODES] = {
 
 #if CONFIG_FILTER_INTRA
 #define FILTER_INTRA_SCALE_BITS 4
+
+// Taps of the filter intra predictors. Each 4x2 block of a mode is predicted
+// from the 7 neighbouring pixels p0..p6, one row of taps per output pixel.
+extern const int av1_filter_intra_taps[FILTER_INTRA_MODES][8][7];
 #endif  // CONFIG_FILTER_INTRA
 
 #define CONFIG_USE_ANGLE_DELTA_SUB8X8 0
@@ -24,6 +24,7 @@
 #include "av1/common/resize.h"
 
 #include "./aom_scale_rtcd.h"
+#include "./av1_rtcd.h"
 
 // Filters for interpolation (0.5-band) - note this also filters integer pels.
 static const InterpKernel filteredinterp_filters500[(1 << RS_SUBPEL_BITS)] = {
@@ -265,21 +266,31 @@ static const InterpKernel *choose_interp_filter(int in_length, int out_length) {
     return filteredinterp_filters500;
 }
 
+// Returns the distance between output samples, in units of
+// 1 / (1 << RS_SCALE_SUBPEL_BITS) input samples.
+static int32_t get_interp_delta(int in_length, int out_length) {
+  return (((uint32_t)in_length << RS_SCALE_SUBPEL_BITS) + out_length / 2) /
+         out_length;
+}
+
+// Returns the position of the first output sample, in the same units.
+static int32_t get_interp_offset(int in_length, int out_length) {
+  return in_length > out_length
+             ? (((int32_t)(in_length - out_length)
+                 << (RS_SCALE_SUBPEL_BITS - 1)) +
+                out_length / 2) /
+                   out_length
+             : -(((int32_t)(out_length - in_length)
+                  << (RS_SCALE_SUBPEL_BITS - 1)) +
+                 out_length / 2) /
+                   out_length;
+}
+
 static void interpolate_core(const uint8_t *const input, int in_length,
                              uint8_t *output, int out_length,
                              const int16_t *interp_filters, int interp_taps) {
-  const int32_t delta =
-      (((uint32_t)in_length << RS_SCALE_SUBPEL_BITS) + out_length / 2) /
-      out_length;
-  const int32_t offset =
-      in_length > out_length
-          ? (((int32_t)(in_length - out_length) << (RS_SCALE_SUBPEL_BITS - 1)) +
-             out_length / 2) /
-                out_length
-          : -(((int32_t)(out_length - in_length)
-               << (RS_SCALE_SUBPEL_BITS - 1)) +
-              out_length / 2) /
-                out_length;
+  const int32_t delta = get_interp_delta(in_length, out_length);
+  const int32_t offset = get_interp_offset(in_length, out_length);
   uint8_t *optr = output;
   int x, x1, x2, sum, k, int_pel, sub_pel;
   int32_t y;
@@ -540,53 +551,194 @@ static void resize_multistep(const uint8_t *const input, int length,
   }
 }
 
-static void fill_col_to_arr(uint8_t *img, int stride, int len, uint8_t *arr) {
-  int i;
-  uint8_t *iptr = img;
-  uint8_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *aptr++ = *iptr;
+// The vertical pass of resize_plane() filters bands of this many adjacent
+// columns at a time.
+#define RESIZE_BAND_COLS 64
+
+// Returns the number of rows of scratch space needed by the vertical pass for
+// each column of a band.
+static int get_cols_tmp_rows(int height) {
+  return get_down2_length(height, 1) + get_down2_length(height, 2);
+}
+
+// Filters one output row of 'cols' pixels from the SUBPEL_TAPS input rows that
+// the filter taps fall on.
+void av1_resize_vert_8tap_c(const uint8_t *const *rows, const int16_t *filter,
+                            uint8_t *output, int cols) {
+  for (int c = 0; c < cols; ++c) {
+    int sum = 0;
+    for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][c];
+    output[c] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
   }
 }
 
-static void fill_arr_to_col(uint8_t *img, int stride, int len, uint8_t *arr) {
-  int i;
-  uint8_t *iptr = img;
-  uint8_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *iptr = *aptr++;
+// Column counterparts of interpolate(), down2_symeven() and down2_symodd().
+// Rather than gather each column into an array and filter it on its own, they
+// filter a band of 'cols' adjacent columns a whole row at a time, so the inner
+// loops run over contiguous pixels and can be vectorized. Taps outside the
+// column are clamped to its ends, which gives exactly the same results as the
+// 1-D versions. interpolate_cols() hands each output row to
+// av1_resize_vert_8tap(). The down2 versions take 'sum', which must hold
+// 'cols' accumulators. It is passed in rather than declared on the stack
+// because GCC stops vectorizing the inner loops once a local array is inlined
+// into the band loop of resize_plane_cols().
+static void interpolate_cols(const uint8_t *const input, int in_stride,
+                             int in_length, uint8_t *output, int out_stride,
+                             int out_length, int cols) {
+  const InterpKernel *interp_filters =
+      choose_interp_filter(in_length, out_length);
+  const int32_t delta = get_interp_delta(in_length, out_length);
+  int32_t y = get_interp_offset(in_length, out_length) + RS_SCALE_EXTRA_OFF;
+
+  for (int x = 0; x < out_length; ++x, y += delta) {
+    const int int_pel = y >> RS_SCALE_SUBPEL_BITS;
+    const int sub_pel = (y >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK;
+    const uint8_t *rows[SUBPEL_TAPS];
+    for (int k = 0; k < SUBPEL_TAPS; ++k) {
+      const int pk = clamp(int_pel - SUBPEL_TAPS / 2 + 1 + k, 0, in_length - 1);
+      rows[k] = input + pk * in_stride;
+    }
+    av1_resize_vert_8tap(rows, interp_filters[sub_pel],
+                         output + x * out_stride, cols);
+  }
+}
+
+static void down2_symeven_cols(const uint8_t *const input, int in_stride,
+                               int length, uint8_t *output, int out_stride,
+                               int cols, int *sum) {
+  const int16_t *filter = av1_down2_symeven_half_filter;
+  const int filter_len_half = sizeof(av1_down2_symeven_half_filter) / 2;
+
+  for (int i = 0; i < length; i += 2) {
+    uint8_t *const optr = output + (i >> 1) * out_stride;
+    for (int c = 0; c < cols; ++c) sum[c] = (1 << (FILTER_BITS - 1));
+    for (int j = 0; j < filter_len_half; ++j) {
+      const uint8_t *const iptr0 = input + AOMMAX(i - j, 0) * in_stride;
+      const uint8_t *const iptr1 =
+          input + AOMMIN(i + 1 + j, length - 1) * in_stride;
+      for (int c = 0; c < cols; ++c)
+        sum[c] += (iptr0[c] + iptr1[c]) * filter[j];
+    }
+    for (int c = 0; c < cols; ++c) optr[c] = clip_pixel(sum[c] >> FILTER_BITS);
+  }
+}
+
+static void down2_symodd_cols(const uint8_t *const input, int in_stride,
+                              int length, uint8_t *output, int out_stride,
+                              int cols, int *sum) {
+  const int16_t *filter = av1_down2_symodd_half_filter;
+  const int filter_len_half = sizeof(av1_down2_symodd_half_filter) / 2;
+
+  for (int i = 0; i < length; i += 2) {
+    const uint8_t *const iptr = input + i * in_stride;
+    uint8_t *const optr = output + (i >> 1) * out_stride;
+    for (int c = 0; c < cols; ++c)
+      sum[c] = (1 << (FILTER_BITS - 1)) + iptr[c] * filter[0];
+    for (int j = 1; j < filter_len_half; ++j) {
+      const uint8_t *const iptr0 = input + AOMMAX(i - j, 0) * in_stride;
+      const uint8_t *const iptr1 =
+          input + AOMMIN(i + j, length - 1) * in_stride;
+      for (int c = 0; c < cols; ++c)
+        sum[c] += (iptr0[c] + iptr1[c]) * filter[j];
+    }
+    for (int c = 0; c < cols; ++c) optr[c] = clip_pixel(sum[c] >> FILTER_BITS);
+  }
+}
+
+// Column counterpart of resize_multistep(). otmp must hold
+// get_cols_tmp_rows(length) rows of 'cols' pixels.
+static void resize_multistep_cols(const uint8_t *const input, int in_stride,
+                                  int length, uint8_t *output, int out_stride,
+                                  int olength, int cols, uint8_t *otmp,
+                                  int *sum) {
+  if (length == olength) {
+    for (int i = 0; i < length; ++i)
+      memcpy(output + i * out_stride, input + i * in_stride, cols);
+    return;
+  }
+  const int steps = get_down2_steps(length, olength);
+
+  if (steps > 0) {
+    const uint8_t *in = input;
+    int in_s = in_stride;
+    uint8_t *out = NULL;
+    int out_s = cols;
+    int filteredlength = length;
+
+    assert(otmp != NULL);
+    uint8_t *otmp2 = otmp + get_down2_length(length, 1) * cols;
+    for (int s = 0; s < steps; ++s) {
+      const int proj_filteredlength = get_down2_length(filteredlength, 1);
+      if (s == steps - 1 && proj_filteredlength == olength) {
+        out = output;
+        out_s = out_stride;
+      } else {
+        out = (s & 1 ? otmp2 : otmp);
+        out_s = cols;
+      }
+      if (filteredlength & 1)
+        down2_symodd_cols(in, in_s, filteredlength, out, out_s, cols, sum);
+      else
+        down2_symeven_cols(in, in_s, filteredlength, out, out_s, cols, sum);
+      filteredlength = proj_filteredlength;
+      in = out;
+      in_s = out_s;
+    }
+    if (filteredlength != olength) {
+      interpolate_cols(out, out_s, filteredlength, output, out_stride, olength,
+                       cols);
+    }
+  } else {
+    interpolate_cols(input, in_stride, length, output, out_stride, olength,
+                     cols);
+  }
+}
+
+// Resizes rows [row_start, row_end) of the input horizontally into intbuf.
+// tmpbuf must hold 'width' pixels.
+static void resize_plane_rows(const uint8_t *const input, int width,
+                              int in_stride, uint8_t *intbuf, int width2,
+                              int row_start, int row_end, uint8_t *tmpbuf) {
+  for (int i = row_start; i < row_end; ++i)
+    resize_multistep(input + in_stride * i, width, intbuf + width2 * i, width2,
+                     tmpbuf);
+}
+
+// Resizes columns [col_start, col_end) of intbuf vertically into the output.
+// tmpbuf must hold get_cols_tmp_rows(height) * RESIZE_BAND_COLS pixels and
+// sumbuf RESIZE_BAND_COLS accumulators.
+static void resize_plane_cols(const uint8_t *intbuf, int height, int width2,
+                              uint8_t *output, int height2, int out_stride,
+                              int col_start, int col_end, uint8_t *tmpbuf,
+                              int *sumbuf) {
+  for (int i = col_start; i < col_end; i += RESIZE_BAND_COLS) {
+    resize_multistep_cols(intbuf + i, width2, height, output + i, out_stride,
+                          height2, AOMMIN(RESIZE_BAND_COLS, col_end - i),
+                          tmpbuf, sumbuf);
   }
 }
 
 static void resize_plane(const uint8_t *const input, int height, int width,
                          int in_stride, uint8_t *output, int height2,
                          int width2, int out_stride) {
-  int i;
   uint8_t *intbuf = (uint8_t *)aom_malloc(sizeof(uint8_t) * width2 * height);
-  uint8_t *tmpbuf =
-      (uint8_t *)aom_malloc(sizeof(uint8_t) * AOMMAX(width, height));
-  uint8_t *arrbuf = (uint8_t *)aom_malloc(sizeof(uint8_t) * height);
-  uint8_t *arrbuf2 = (uint8_t *)aom_malloc(sizeof(uint8_t) * height2);
-  if (intbuf == NULL || tmpbuf == NULL || arrbuf == NULL || arrbuf2 == NULL)
-    goto Error;
+  uint8_t *tmpbuf = (uint8_t *)aom_malloc(
+      sizeof(uint8_t) *
+      AOMMAX(width, get_cols_tmp_rows(height) * RESIZE_BAND_COLS));
+  int *sumbuf = (int *)aom_malloc(sizeof(int) * RESIZE_BAND_COLS);
+  if (intbuf == NULL || tmpbuf == NULL || sumbuf == NULL) goto Error;
   assert(width > 0);
   assert(height > 0);
   assert(width2 > 0);
   assert(height2 > 0);
-  for (i = 0; i < height; ++i)
-    resize_multistep(input + in_stride * i, width, intbuf + width2 * i, width2,
-                     tmpbuf);
-  for (i = 0; i < width2; ++i) {
-    fill_col_to_arr(intbuf + i, width2, height, arrbuf);
-    resize_multistep(arrbuf, height, arrbuf2, height2, tmpbuf);
-    fill_arr_to_col(output + i, out_stride, height2, arrbuf2);
-  }
+  resize_plane_rows(input, width, in_stride, intbuf, width2, 0, height, tmpbuf);
+  resize_plane_cols(intbuf, height, width2, output, height2, out_stride, 0,
+                    width2, tmpbuf, sumbuf);
 
 Error:
   aom_free(intbuf);
   aom_free(tmpbuf);
-  aom_free(arrbuf);
-  aom_free(arrbuf2);
+  aom_free(sumbuf);
 }
 
 #if CONFIG_HORZONLY_FRAME_SUPERRES
@@ -654,18 +806,8 @@ static void highbd_interpolate_core(const uint16_t *const input, int in_length,
                                     uint16_t *output, int out_length, int bd,
                                     const int16_t *interp_filters,
                                     int interp_taps) {
-  const int32_t delta =
-      (((uint32_t)in_length << RS_SCALE_SUBPEL_BITS) + out_length / 2) /
-      out_length;
-  const int32_t offset =
-      in_length > out_length
-          ? (((int32_t)(in_length - out_length) << (RS_SCALE_SUBPEL_BITS - 1)) +
-             out_length / 2) /
-                out_length
-          : -(((int32_t)(out_length - in_length)
-               << (RS_SCALE_SUBPEL_BITS - 1)) +
-              out_length / 2) /
-                out_length;
+  const int32_t delta = get_interp_delta(in_length, out_length);
+  const int32_t offset = get_interp_offset(in_length, out_length);
   uint16_t *optr = output;
   int x, x1, x2, sum, k, int_pel, sub_pel;
   int32_t y;
@@ -888,23 +1030,151 @@ static void highbd_resize_multistep(const uint16_t *const input, int length,
   }
 }
 
-static void highbd_fill_col_to_arr(uint16_t *img, int stride, int len,
-                                   uint16_t *arr) {
-  int i;
-  uint16_t *iptr = img;
-  uint16_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *aptr++ = *iptr;
+static void highbd_interpolate_cols(const uint16_t *const input, int in_stride,
+                                    int in_length, uint16_t *output,
+                                    int out_stride, int out_length, int cols,
+                                    int *sum, int bd) {
+  const InterpKernel *interp_filters =
+      choose_interp_filter(in_length, out_length);
+  const int32_t delta = get_interp_delta(in_length, out_length);
+  int32_t y = get_interp_offset(in_length, out_length) + RS_SCALE_EXTRA_OFF;
+
+  for (int x = 0; x < out_length; ++x, y += delta) {
+    const int int_pel = y >> RS_SCALE_SUBPEL_BITS;
+    const int sub_pel = (y >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK;
+    const int16_t *filter = interp_filters[sub_pel];
+    uint16_t *const optr = output + x * out_stride;
+    for (int c = 0; c < cols; ++c) sum[c] = 0;
+    for (int k = 0; k < SUBPEL_TAPS; ++k) {
+      const int pk = clamp(int_pel - SUBPEL_TAPS / 2 + 1 + k, 0, in_length - 1);
+      const uint16_t *const iptr = input + pk * in_stride;
+      for (int c = 0; c < cols; ++c) sum[c] += filter[k] * iptr[c];
+    }
+    for (int c = 0; c < cols; ++c) {
+      optr[c] =
+          clip_pixel_highbd(ROUND_POWER_OF_TWO(sum[c], FILTER_BITS), bd);
+    }
   }
 }
 
-static void highbd_fill_arr_to_col(uint16_t *img, int stride, int len,
-                                   uint16_t *arr) {
-  int i;
-  uint16_t *iptr = img;
-  uint16_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *iptr = *aptr++;
+static void highbd_down2_symeven_cols(const uint16_t *const input,
+                                      int in_stride, int length,
+                                      uint16_t *output, int out_stride,
+                                      int cols, int *sum, int bd) {
+  const int16_t *filter = av1_down2_symeven_half_filter;
+  const int filter_len_half = sizeof(av1_down2_symeven_half_filter) / 2;
+
+  for (int i = 0; i < length; i += 2) {
+    uint16_t *const optr = output + (i >> 1) * out_stride;
+    for (int c = 0; c < cols; ++c) sum[c] = (1 << (FILTER_BITS - 1));
+    for (int j = 0; j < filter_len_half; ++j) {
+      const uint16_t *const iptr0 = input + AOMMAX(i - j, 0) * in_stride;
+      const uint16_t *const iptr1 =
+          input + AOMMIN(i + 1 + j, length - 1) * in_stride;
+      for (int c = 0; c < cols; ++c)
+        sum[c] += (iptr0[c] + iptr1[c]) * filter[j];
+    }
+    for (int c = 0; c < cols; ++c)
+      optr[c] = clip_pixel_highbd(sum[c] >> FILTER_BITS, bd);
+  }
+}
+
+static void highbd_down2_symodd_cols(const uint16_t *const input, int in_stride,
+                                     int length, uint16_t *output,
+                                     int out_stride, int cols, int *sum,
+                                     int bd) {
+  const int16_t *filter = av1_down2_symodd_half_filter;
+  const int filter_len_half = sizeof(av1_down2_symodd_half_filter) / 2;
+
+  for (int i = 0; i < length; i += 2) {
+    const uint16_t *const iptr = input + i * in_stride;
+    uint16_t *const optr = output + (i >> 1) * out_stride;
+    for (int c = 0; c < cols; ++c)
+      sum[c] = (1 << (FILTER_BITS - 1)) + iptr[c] * filter[0];
+    for (int j = 1; j < filter_len_half; ++j) {
+      const uint16_t *const iptr0 = input + AOMMAX(i - j, 0) * in_stride;
+      const uint16_t *const iptr1 =
+          input + AOMMIN(i + j, length - 1) * in_stride;
+      for (int c = 0; c < cols; ++c)
+        sum[c] += (iptr0[c] + iptr1[c]) * filter[j];
+    }
+    for (int c = 0; c < cols; ++c)
+      optr[c] = clip_pixel_highbd(sum[c] >> FILTER_BITS, bd);
+  }
+}
+
+static void highbd_resize_multistep_cols(const uint16_t *const input,
+                                         int in_stride, int length,
+                                         uint16_t *output, int out_stride,
+                                         int olength, int cols, uint16_t *otmp,
+                                         int *sum, int bd) {
+  if (length == olength) {
+    for (int i = 0; i < length; ++i) {
+      memcpy(output + i * out_stride, input + i * in_stride,
+             sizeof(output[0]) * cols);
+    }
+    return;
+  }
+  const int steps = get_down2_steps(length, olength);
+
+  if (steps > 0) {
+    const uint16_t *in = input;
+    int in_s = in_stride;
+    uint16_t *out = NULL;
+    int out_s = cols;
+    int filteredlength = length;
+
+    assert(otmp != NULL);
+    uint16_t *otmp2 = otmp + get_down2_length(length, 1) * cols;
+    for (int s = 0; s < steps; ++s) {
+      const int proj_filteredlength = get_down2_length(filteredlength, 1);
+      if (s == steps - 1 && proj_filteredlength == olength) {
+        out = output;
+        out_s = out_stride;
+      } else {
+        out = (s & 1 ? otmp2 : otmp);
+        out_s = cols;
+      }
+      if (filteredlength & 1)
+        highbd_down2_symodd_cols(in, in_s, filteredlength, out, out_s, cols,
+                                 sum, bd);
+      else
+        highbd_down2_symeven_cols(in, in_s, filteredlength, out, out_s, cols,
+                                  sum, bd);
+      filteredlength = proj_filteredlength;
+      in = out;
+      in_s = out_s;
+    }
+    if (filteredlength != olength) {
+      highbd_interpolate_cols(out, out_s, filteredlength, output, out_stride,
+                              olength, cols, sum, bd);
+    }
+  } else {
+    highbd_interpolate_cols(input, in_stride, length, output, out_stride,
+                            olength, cols, sum, bd);
+  }
+}
+
+static void highbd_resize_plane_rows(const uint8_t *const input, int width,
+                                     int in_stride, uint16_t *intbuf,
+                                     int width2, int row_start, int row_end,
+                                     uint16_t *tmpbuf, int bd) {
+  for (int i = row_start; i < row_end; ++i) {
+    highbd_resize_multistep(CONVERT_TO_SHORTPTR(input + in_stride * i), width,
+                            intbuf + width2 * i, width2, tmpbuf, bd);
+  }
+}
+
+static void highbd_resize_plane_cols(const uint16_t *intbuf, int height,
+                                     int width2, uint8_t *output, int height2,
+                                     int out_stride, int col_start,
+                                     int col_end, uint16_t *tmpbuf,
+                                     int *sumbuf, int bd) {
+  for (int i = col_start; i < col_end; i += RESIZE_BAND_COLS) {
+    highbd_resize_multistep_cols(
+        intbuf + i, width2, height, CONVERT_TO_SHORTPTR(output + i),
+        out_stride, height2, AOMMIN(RESIZE_BAND_COLS, col_end - i), tmpbuf,
+        sumbuf, bd);
   }
 }
 
@@ -912,30 +1182,21 @@ static void highbd_resize_plane(const uint8_t *const input, int height,
                                 int width, int in_stride, uint8_t *output,
                                 int height2, int width2, int out_stride,
                                 int bd) {
-  int i;
   uint16_t *intbuf = (uint16_t *)aom_malloc(sizeof(uint16_t) * width2 * height);
-  uint16_t *tmpbuf =
-      (uint16_t *)aom_malloc(sizeof(uint16_t) * AOMMAX(width, height));
-  uint16_t *arrbuf = (uint16_t *)aom_malloc(sizeof(uint16_t) * height);
-  uint16_t *arrbuf2 = (uint16_t *)aom_malloc(sizeof(uint16_t) * height2);
-  if (intbuf == NULL || tmpbuf == NULL || arrbuf == NULL || arrbuf2 == NULL)
-    goto Error;
-  for (i = 0; i < height; ++i) {
-    highbd_resize_multistep(CONVERT_TO_SHORTPTR(input + in_stride * i), width,
-                            intbuf + width2 * i, width2, tmpbuf, bd);
-  }
-  for (i = 0; i < width2; ++i) {
-    highbd_fill_col_to_arr(intbuf + i, width2, height, arrbuf);
-    highbd_resize_multistep(arrbuf, height, arrbuf2, height2, tmpbuf, bd);
-    highbd_fill_arr_to_col(CONVERT_TO_SHORTPTR(output + i), out_stride, height2,
-                           arrbuf2);
-  }
+  uint16_t *tmpbuf = (uint16_t *)aom_malloc(
+      sizeof(uint16_t) *
+      AOMMAX(width, get_cols_tmp_rows(height) * RESIZE_BAND_COLS));
+  int *sumbuf = (int *)aom_malloc(sizeof(int) * RESIZE_BAND_COLS);
+  if (intbuf == NULL || tmpbuf == NULL || sumbuf == NULL) goto Error;
+  highbd_resize_plane_rows(input, width, in_stride, intbuf, width2, 0, height,
+                           tmpbuf, bd);
+  highbd_resize_plane_cols(intbuf, height, width2, output, height2, out_stride,
+                           0, width2, tmpbuf, sumbuf, bd);
 
 Error:
   aom_free(intbuf);
   aom_free(tmpbuf);
-  aom_free(arrbuf);
-  aom_free(arrbuf2);
+  aom_free(sumbuf);
 }
 
 #if CONFIG_HORZONLY_FRAME_SUPERRES
@@ -1079,34 +1340,131 @@ void av1_highbd_resize_frame444(const uint8_t *const y, int y_stride,
                       ouv_stride, bd);
 }
 
+// Shared state of a multi-threaded av1_resize_and_extend_frame(). Each plane
+// is resized horizontally into intbuf in bands of rows, then, once all the
+// jobs are done, vertically into dst in bands of columns.
+typedef struct {
+  const YV12_BUFFER_CONFIG *src;
+  YV12_BUFFER_CONFIG *dst;
+  int bd;
+  int num_jobs;
+  int pass;
+  uint8_t *intbuf[MAX_MB_PLANE];
+} ResizeFrameData;
+
+typedef struct {
+  ResizeFrameData *frame;
+  int job;
+  uint8_t *tmpbuf;
+  int *sumbuf;
+} ResizeJobData;
+
+static int resize_frame_worker(ResizeJobData *const job_data, void *unused) {
+  const ResizeFrameData *const frame = job_data->frame;
+  const YV12_BUFFER_CONFIG *const src = frame->src;
+  YV12_BUFFER_CONFIG *const dst = frame->dst;
+  const int highbd = (src->flags & YV12_FLAG_HIGHBITDEPTH) != 0;
+  const int job = job_data->job;
+  const int num_jobs = frame->num_jobs;
+  (void)unused;
+
+  for (int i = 0; i < MAX_MB_PLANE; ++i) {
+    const int is_uv = (i > 0);
+    const int width = src->crop_widths[is_uv];
+    const int height = src->crop_heights[is_uv];
+    const int width2 = dst->crop_widths[is_uv];
+    if (frame->pass == 0) {
+      const int row_start = height * job / num_jobs;
+      const int row_end = height * (job + 1) / num_jobs;
+      if (highbd)
+        highbd_resize_plane_rows(src->buffers[i], width, src->strides[is_uv],
+                                 (uint16_t *)frame->intbuf[i], width2,
+                                 row_start, row_end,
+                                 (uint16_t *)job_data->tmpbuf, frame->bd);
+      else
+        resize_plane_rows(src->buffers[i], width, src->strides[is_uv],
+                          frame->intbuf[i], width2, row_start, row_end,
+                          job_data->tmpbuf);
+    } else {
+      // Split on band boundaries so that each band is filtered whole.
+      const int bands = (width2 + RESIZE_BAND_COLS - 1) / RESIZE_BAND_COLS;
+      const int col_start = bands * job / num_jobs * RESIZE_BAND_COLS;
+      const int col_end =
+          AOMMIN(width2, bands * (job + 1) / num_jobs * RESIZE_BAND_COLS);
+      if (highbd)
+        highbd_resize_plane_cols((const uint16_t *)frame->intbuf[i], height,
+                                 width2, dst->buffers[i],
+                                 dst->crop_heights[is_uv], dst->strides[is_uv],
+                                 col_start, col_end,
+                                 (uint16_t *)job_data->tmpbuf,
+                                 job_data->sumbuf, frame->bd);
+      else
+        resize_plane_cols(frame->intbuf[i], height, width2, dst->buffers[i],
+                          dst->crop_heights[is_uv], dst->strides[is_uv],
+                          col_start, col_end, job_data->tmpbuf,
+                          job_data->sumbuf);
+    }
+  }
+  return 1;
+}
+
 void av1_resize_and_extend_frame(const YV12_BUFFER_CONFIG *src,
-                                 YV12_BUFFER_CONFIG *dst, int bd) {
+                                 YV12_BUFFER_CONFIG *dst, int bd,
+                                 AVxWorker *workers, int num_workers) {
   // TODO(dkovalev): replace YV12_BUFFER_CONFIG with aom_image_t
+  const size_t pixel_size =
+      (src->flags & YV12_FLAG_HIGHBITDEPTH) ? sizeof(uint16_t) : 1;
+  // Every job gets at least one row of each plane in the horizontal pass.
+  int num_jobs = AOMMAX(1, AOMMIN(num_workers, src->uv_crop_height));
+  ResizeFrameData frame;
+  ResizeJobData single_job;
+  ResizeJobData *jobs = &single_job;
   int i;
-  const uint8_t *const srcs[3] = { src->y_buffer, src->u_buffer,
-                                   src->v_buffer };
-  const int src_strides[3] = { src->y_stride, src->uv_stride, src->uv_stride };
-  const int src_widths[3] = { src->y_crop_width, src->uv_crop_width,
-                              src->uv_crop_width };
-  const int src_heights[3] = { src->y_crop_height, src->uv_crop_height,
-                               src->uv_crop_height };
-  uint8_t *const dsts[3] = { dst->y_buffer, dst->u_buffer, dst->v_buffer };
-  const int dst_strides[3] = { dst->y_stride, dst->uv_stride, dst->uv_stride };
-  const int dst_widths[3] = { dst->y_crop_width, dst->uv_crop_width,
-                              dst->uv_crop_width };
-  const int dst_heights[3] = { dst->y_crop_height, dst->uv_crop_height,
-                               dst->uv_crop_height };
 
+  if (num_jobs > 1) {
+    jobs = (ResizeJobData *)aom_malloc(num_jobs * sizeof(*jobs));
+    // Fall back to resizing on this thread alone.
+    if (jobs == NULL) {
+      jobs = &single_job;
+      num_jobs = 1;
+    }
+  }
+  memset(&frame, 0, sizeof(frame));
+  memset(jobs, 0, num_jobs * sizeof(*jobs));
+  frame.src = src;
+  frame.dst = dst;
+  frame.bd = bd;
+  frame.num_jobs = num_jobs;
   for (i = 0; i < MAX_MB_PLANE; ++i) {
-    if (src->flags & YV12_FLAG_HIGHBITDEPTH)
-      highbd_resize_plane(srcs[i], src_heights[i], src_widths[i],
-                          src_strides[i], dsts[i], dst_heights[i],
-                          dst_widths[i], dst_strides[i], bd);
-    else
-      resize_plane(srcs[i], src_heights[i], src_widths[i], src_strides[i],
-                   dsts[i], dst_heights[i], dst_widths[i], dst_strides[i]);
+    const int is_uv = (i > 0);
+    frame.intbuf[i] = (uint8_t *)aom_malloc(
+        pixel_size * dst->crop_widths[is_uv] * src->crop_heights[is_uv]);
+    if (frame.intbuf[i] == NULL) goto Error;
+  }
+  for (i = 0; i < num_jobs; ++i) {
+    jobs[i].frame = &frame;
+    jobs[i].job = i;
+    jobs[i].tmpbuf = (uint8_t *)aom_malloc(
+        pixel_size * AOMMAX(src->y_crop_width,
+                            get_cols_tmp_rows(src->y_crop_height) *
+                                RESIZE_BAND_COLS));
+    jobs[i].sumbuf = (int *)aom_malloc(sizeof(int) * RESIZE_BAND_COLS);
+    if (jobs[i].tmpbuf == NULL || jobs[i].sumbuf == NULL) goto Error;
+  }
+
+  for (frame.pass = 0; frame.pass < 2; ++frame.pass) {
+    aom_run_worker_jobs((AVxWorkerHook)resize_frame_worker, jobs,
+                        sizeof(jobs[0]), num_jobs, workers);
   }
   aom_extend_frame_borders(dst);
+
+Error:
+  for (i = 0; i < MAX_MB_PLANE; ++i) aom_free(frame.intbuf[i]);
+  for (i = 0; i < num_jobs; ++i) {
+    aom_free(jobs[i].tmpbuf);
+    aom_free(jobs[i].sumbuf);
+  }
+  if (jobs != &single_job) aom_free(jobs);
 }
 
 #if CONFIG_HORZONLY_FRAME_SUPERRES
@@ -1180,15 +1538,66 @@ void av1_upscale_normative_rows(const AV1_COMMON *cm, const uint8_t *src,
   }
 }
 
-void av1_upscale_normative_and_extend_frame(const AV1_COMMON *cm,
-                                            const YV12_BUFFER_CONFIG *src,
-                                            YV12_BUFFER_CONFIG *dst) {
+// Each job of a multi-threaded av1_upscale_normative_and_extend_frame()
+// upscales its own band of rows of every plane. The rows are independent, and
+// the borders that av1_upscale_normative_rows() pads in the source are
+// restored before it returns, so no two jobs touch the same pixels.
+typedef struct {
+  const AV1_COMMON *cm;
+  const YV12_BUFFER_CONFIG *src;
+  YV12_BUFFER_CONFIG *dst;
+  int job;
+  int num_jobs;
+} UpscaleJobData;
+
+static int upscale_frame_worker(UpscaleJobData *const job_data, void *unused) {
+  const YV12_BUFFER_CONFIG *const src = job_data->src;
+  YV12_BUFFER_CONFIG *const dst = job_data->dst;
+  (void)unused;
+
   for (int i = 0; i < MAX_MB_PLANE; ++i) {
     const int is_uv = (i > 0);
-    av1_upscale_normative_rows(cm, src->buffers[i], src->strides[is_uv],
-                               dst->buffers[i], dst->strides[is_uv], i,
-                               src->crop_heights[is_uv]);
+    const int height = src->crop_heights[is_uv];
+    const int row_start = height * job_data->job / job_data->num_jobs;
+    const int row_end = height * (job_data->job + 1) / job_data->num_jobs;
+    const int src_stride = src->strides[is_uv];
+    const int dst_stride = dst->strides[is_uv];
+    av1_upscale_normative_rows(
+        job_data->cm, src->buffers[i] + row_start * src_stride, src_stride,
+        dst->buffers[i] + row_start * dst_stride, dst_stride, i,
+        row_end - row_start);
+  }
+  return 1;
+}
+
+void av1_upscale_normative_and_extend_frame(const AV1_COMMON *cm,
+                                            const YV12_BUFFER_CONFIG *src,
+                                            YV12_BUFFER_CONFIG *dst,
+                                            AVxWorker *workers,
+                                            int num_workers) {
+  // Every job gets at least one row of each plane.
+  int num_jobs = AOMMAX(1, AOMMIN(num_workers, src->uv_crop_height));
+  UpscaleJobData single_job;
+  UpscaleJobData *jobs = &single_job;
+
+  if (num_jobs > 1) {
+    jobs = (UpscaleJobData *)aom_malloc(num_jobs * sizeof(*jobs));
+    // Fall back to upscaling on this thread alone.
+    if (jobs == NULL) {
+      jobs = &single_job;
+      num_jobs = 1;
+    }
+  }
+  for (int i = 0; i < num_jobs; ++i) {
+    jobs[i].cm = cm;
+    jobs[i].src = src;
+    jobs[i].dst = dst;
+    jobs[i].job = i;
+    jobs[i].num_jobs = num_jobs;
   }
+  aom_run_worker_jobs((AVxWorkerHook)upscale_frame_worker, jobs,
+                      sizeof(jobs[0]), num_jobs, workers);
+  if (jobs != &single_job) aom_free(jobs);
 
   aom_extend_frame_borders(dst);
 }
@@ -1196,10 +1605,13 @@ void av1_upscale_normative_and_extend_frame(const AV1_COMMON *cm,
 
 YV12_BUFFER_CONFIG *av1_scale_if_required(AV1_COMMON *cm,
                                           YV12_BUFFER_CONFIG *unscaled,
-                                          YV12_BUFFER_CONFIG *scaled) {
+                                          YV12_BUFFER_CONFIG *scaled,
+                                          AVxWorker *workers,
+                                          int num_workers) {
   if (cm->width != unscaled->y_crop_width ||
       cm->height != unscaled->y_crop_height) {
-    av1_resize_and_extend_frame(unscaled, scaled, (int)cm->bit_depth);
+    av1_resize_and_extend_frame(unscaled, scaled, (int)cm->bit_depth, workers,
+                                num_workers);
     return scaled;
   } else {
     return unscaled;
@@ -1242,7 +1654,8 @@ void av1_calculate_unscaled_superres_size(int *width, int *height, int denom) {
 // TODO(afergs): Look for in-place upscaling
 // TODO(afergs): aom_ vs av1_ functions? Which can I use?
 // Upscale decoded image.
-void av1_superres_upscale(AV1_COMMON *cm, BufferPool *const pool) {
+void av1_superres_upscale(AV1_COMMON *cm, BufferPool *const pool,
+                          AVxWorker *workers, int num_workers) {
   if (av1_superres_unscaled(cm)) return;
 
   YV12_BUFFER_CONFIG copy_buffer;
@@ -1281,7 +1694,7 @@ void av1_superres_upscale(AV1_COMMON *cm, BufferPool *const pool) {
     if (aom_realloc_frame_buffer(frame_to_show, cm->superres_upscaled_width,
                                  cm->superres_upscaled_height,
                                  cm->subsampling_x, cm->subsampling_y,
-                                 cm->use_highbitdepth, AOM_BORDER_IN_PIXELS,
+                                 cm->use_highbitdepth, AOM_DEC_BORDER_IN_PIXELS,
                                  cm->byte_alignment, fb, cb, cb_priv))
       aom_internal_error(
           &cm->error, AOM_CODEC_MEM_ERROR,
@@ -1305,7 +1718,8 @@ void av1_superres_upscale(AV1_COMMON *cm, BufferPool *const pool) {
 
   // Scale up and back into frame_to_show.
   assert(frame_to_show->y_crop_width != cm->width);
-  av1_upscale_normative_and_extend_frame(cm, &copy_buffer, frame_to_show);
+  av1_upscale_normative_and_extend_frame(cm, &copy_buffer, frame_to_show,
+                                         workers, num_workers);
 
   // Free the copy buffer
   aom_free_frame_buffer(&copy_buffer);
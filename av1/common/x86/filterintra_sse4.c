@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <smmintrin.h>
+#include <string.h>
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_dsp/x86/synonyms.h"
+#include "av1/common/enums.h"
+#include "av1/common/reconintra.h"
+
+// Each 4x2 unit of the block is predicted from its 7 neighbours p0..p6. Lane k
+// of taps[i] holds the tap of output pixel k for neighbour i, so that the 8
+// outputs of a unit are the sum of taps[i] times a broadcast of p[i].
+static void load_taps16(__m128i *taps, int mode) {
+  for (int i = 0; i < 7; ++i) {
+    DECLARE_ALIGNED(16, int16_t, col[8]);
+    for (int k = 0; k < 8; ++k) col[k] = av1_filter_intra_taps[mode][k][i];
+    taps[i] = xx_load_128(col);
+  }
+}
+
+static void filter_intra_predictor(uint8_t *dst, ptrdiff_t stride,
+                                   TX_SIZE tx_size, const uint8_t *above,
+                                   const uint8_t *left, int mode) {
+  DECLARE_ALIGNED(16, uint8_t, buffer[33][36]);
+  const __m128i round = _mm_set1_epi16(1 << (FILTER_INTRA_SCALE_BITS - 1));
+  const int bw = tx_size_wide[tx_size];
+  const int bh = tx_size_high[tx_size];
+  __m128i taps[7];
+
+  assert(bw <= 32 && bh <= 32);
+  load_taps16(taps, mode);
+
+  for (int r = 0; r < bh; ++r) buffer[r + 1][0] = left[r];
+  memcpy(buffer[0], above - 1, (bw + 1) * sizeof(buffer[0][0]));
+
+  for (int r = 1; r < bh + 1; r += 2) {
+    for (int c = 1; c < bw + 1; c += 4) {
+      const uint8_t *const p = &buffer[r - 1][c - 1];
+      __m128i sum = _mm_mullo_epi16(taps[0], _mm_set1_epi16(p[0]));
+      for (int i = 1; i < 5; ++i) {
+        sum =
+            _mm_add_epi16(sum, _mm_mullo_epi16(taps[i], _mm_set1_epi16(p[i])));
+      }
+      sum = _mm_add_epi16(
+          sum, _mm_mullo_epi16(taps[5], _mm_set1_epi16(buffer[r][c - 1])));
+      sum = _mm_add_epi16(
+          sum, _mm_mullo_epi16(taps[6], _mm_set1_epi16(buffer[r + 1][c - 1])));
+      // Negative sums round towards zero in the C code, but they are clipped
+      // to 0 either way.
+      sum = _mm_srai_epi16(_mm_add_epi16(sum, round), FILTER_INTRA_SCALE_BITS);
+      sum = _mm_packus_epi16(sum, sum);
+      xx_storel_32(&buffer[r][c], sum);
+      xx_storel_32(&buffer[r + 1][c], _mm_srli_si128(sum, 4));
+    }
+  }
+
+  for (int r = 0; r < bh; ++r, dst += stride)
+    memcpy(dst, &buffer[r + 1][1], bw * sizeof(dst[0]));
+}
+
+static void highbd_filter_intra_predictor(uint16_t *dst, ptrdiff_t stride,
+                                          TX_SIZE tx_size,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int mode,
+                                          int bd) {
+  DECLARE_ALIGNED(16, uint16_t, buffer[33][36]);
+  const __m128i round = _mm_set1_epi32(1 << (FILTER_INTRA_SCALE_BITS - 1));
+  const __m128i max_val = _mm_set1_epi32((1 << bd) - 1);
+  const __m128i zero = _mm_setzero_si128();
+  const int bw = tx_size_wide[tx_size];
+  const int bh = tx_size_high[tx_size];
+  __m128i taps16[7], taps[7][2];
+
+  assert(bw <= 32 && bh <= 32);
+  load_taps16(taps16, mode);
+  for (int i = 0; i < 7; ++i) {
+    taps[i][0] = _mm_cvtepi16_epi32(taps16[i]);
+    taps[i][1] = _mm_cvtepi16_epi32(_mm_srli_si128(taps16[i], 8));
+  }
+
+  for (int r = 0; r < bh; ++r) buffer[r + 1][0] = left[r];
+  memcpy(buffer[0], above - 1, (bw + 1) * sizeof(buffer[0][0]));
+
+  for (int r = 1; r < bh + 1; r += 2) {
+    for (int c = 1; c < bw + 1; c += 4) {
+      const uint16_t *const p = &buffer[r - 1][c - 1];
+      const int pix[7] = { p[0], p[1], p[2], p[3],
+                           p[4], buffer[r][c - 1], buffer[r + 1][c - 1] };
+      __m128i sum0 = round, sum1 = round;
+      for (int i = 0; i < 7; ++i) {
+        const __m128i v = _mm_set1_epi32(pix[i]);
+        sum0 = _mm_add_epi32(sum0, _mm_mullo_epi32(taps[i][0], v));
+        sum1 = _mm_add_epi32(sum1, _mm_mullo_epi32(taps[i][1], v));
+      }
+      sum0 = _mm_srai_epi32(sum0, FILTER_INTRA_SCALE_BITS);
+      sum1 = _mm_srai_epi32(sum1, FILTER_INTRA_SCALE_BITS);
+      sum0 = _mm_min_epi32(_mm_max_epi32(sum0, zero), max_val);
+      sum1 = _mm_min_epi32(_mm_max_epi32(sum1, zero), max_val);
+      const __m128i out = _mm_packus_epi32(sum0, sum1);
+      xx_storel_64(&buffer[r][c], out);
+      xx_storel_64(&buffer[r + 1][c], _mm_srli_si128(out, 8));
+    }
+  }
+
+  for (int r = 0; r < bh; ++r, dst += stride)
+    memcpy(dst, &buffer[r + 1][1], bw * sizeof(dst[0]));
+}
+
+void av1_dc_filter_predictor_sse4_1(uint8_t *dst, ptrdiff_t stride,
+                                    TX_SIZE tx_size, const uint8_t *above,
+                                    const uint8_t *left) {
+  filter_intra_predictor(dst, stride, tx_size, above, left, FILTER_DC_PRED);
+}
+
+void av1_v_filter_predictor_sse4_1(uint8_t *dst, ptrdiff_t stride,
+                                   TX_SIZE tx_size, const uint8_t *above,
+                                   const uint8_t *left) {
+  filter_intra_predictor(dst, stride, tx_size, above, left, FILTER_V_PRED);
+}
+
+void av1_h_filter_predictor_sse4_1(uint8_t *dst, ptrdiff_t stride,
+                                   TX_SIZE tx_size, const uint8_t *above,
+                                   const uint8_t *left) {
+  filter_intra_predictor(dst, stride, tx_size, above, left, FILTER_H_PRED);
+}
+
+void av1_d153_filter_predictor_sse4_1(uint8_t *dst, ptrdiff_t stride,
+                                      TX_SIZE tx_size, const uint8_t *above,
+                                      const uint8_t *left) {
+  filter_intra_predictor(dst, stride, tx_size, above, left, FILTER_D153_PRED);
+}
+
+void av1_paeth_filter_predictor_sse4_1(uint8_t *dst, ptrdiff_t stride,
+                                       TX_SIZE tx_size, const uint8_t *above,
+                                       const uint8_t *left) {
+  filter_intra_predictor(dst, stride, tx_size, above, left, FILTER_PAETH_PRED);
+}
+
+void av1_highbd_dc_filter_predictor_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                           TX_SIZE tx_size,
+                                           const uint16_t *above,
+                                           const uint16_t *left, int bd) {
+  highbd_filter_intra_predictor(dst, stride, tx_size, above, left,
+                                FILTER_DC_PRED, bd);
+}
+
+void av1_highbd_v_filter_predictor_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                          TX_SIZE tx_size,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  highbd_filter_intra_predictor(dst, stride, tx_size, above, left,
+                                FILTER_V_PRED, bd);
+}
+
+void av1_highbd_h_filter_predictor_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                          TX_SIZE tx_size,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  highbd_filter_intra_predictor(dst, stride, tx_size, above, left,
+                                FILTER_H_PRED, bd);
+}
+
+void av1_highbd_d153_filter_predictor_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                             TX_SIZE tx_size,
+                                             const uint16_t *above,
+                                             const uint16_t *left, int bd) {
+  highbd_filter_intra_predictor(dst, stride, tx_size, above, left,
+                                FILTER_D153_PRED, bd);
+}
+
+void av1_highbd_paeth_filter_predictor_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                              TX_SIZE tx_size,
+                                              const uint16_t *above,
+                                              const uint16_t *left, int bd) {
+  highbd_filter_intra_predictor(dst, stride, tx_size, above, left,
+                                FILTER_PAETH_PRED, bd);
+}
@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <smmintrin.h>
+#include <string.h>
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/x86/synonyms.h"
+#include "aom_mem/aom_mem.h"
+#include "av1/common/enums.h"
+
+// The directional predictors interpolate between two neighbouring edge
+// samples a and b as (a * (W - s) + b * s + W / 2) / W. This equals
+// a + (((b - a) * s + W / 2) >> log2(W)), which _mm_mulhrs_epi16() computes
+// exactly in 16 bits when s is scaled by 2^15 / W, for both bit depths.
+#if CONFIG_EXT_INTRA_MOD2
+#define DR_FRAC_BITS 6
+#define DR_WEIGHT_BITS 5
+#else
+#define DR_FRAC_BITS 8
+#define DR_WEIGHT_BITS 8
+#endif  // CONFIG_EXT_INTRA_MOD2
+
+// Returns the weight of the second sample at position pos, as computed by the
+// C predictors.
+static INLINE int dr_shift(int pos, int upsample) {
+#if CONFIG_EXT_INTRA_MOD2
+  return ((pos * (1 << upsample)) & 0x3F) >> 1;
+#else
+  return (pos * (1 << upsample)) & 0xFF;
+#endif  // CONFIG_EXT_INTRA_MOD2
+}
+
+static INLINE int dr_interp(int a, int b, int shift) {
+  return ROUND_POWER_OF_TWO(a * ((1 << DR_WEIGHT_BITS) - shift) + b * shift,
+                            DR_WEIGHT_BITS);
+}
+
+static INLINE __m128i dr_interp8(__m128i a, __m128i b, __m128i w) {
+  return _mm_add_epi16(a, _mm_mulhrs_epi16(_mm_sub_epi16(b, a), w));
+}
+
+// Predicts n pixels along one edge, starting at sample base with a constant
+// weight. Without upsampling pixel c interpolates samples base + c and
+// base + c + 1, with upsampling samples base + 2 * c and base + 2 * c + 1.
+// Pixels at or beyond max_base take the value of that sample. Only the samples
+// used by the C code are read.
+static INLINE void dr_row(uint8_t *dst, int n, const uint8_t *edge, int base,
+                          int shift, int max_base, int upsample) {
+  const __m128i w = _mm_set1_epi16(shift << (15 - DR_WEIGHT_BITS));
+  const int inc = 1 << upsample;
+  int c = 0;
+
+  if (base >= max_base) {
+    memset(dst, edge[max_base], n);
+    return;
+  }
+  if (upsample) {
+    const __m128i even = _mm_set1_epi16(0xff);
+    for (; c + 8 <= n && base + 15 <= max_base; c += 8, base += 16) {
+      const __m128i v = xx_loadu_128(edge + base);
+      const __m128i p =
+          dr_interp8(_mm_and_si128(v, even), _mm_srli_epi16(v, 8), w);
+      xx_storel_64(dst + c, _mm_packus_epi16(p, p));
+    }
+  } else {
+    for (; c + 16 <= n && base + 16 <= max_base; c += 16, base += 16) {
+      const __m128i a = xx_loadu_128(edge + base);
+      const __m128i b = xx_loadu_128(edge + base + 1);
+      const __m128i lo =
+          dr_interp8(_mm_cvtepu8_epi16(a), _mm_cvtepu8_epi16(b), w);
+      const __m128i hi =
+          dr_interp8(_mm_cvtepu8_epi16(_mm_srli_si128(a, 8)),
+                     _mm_cvtepu8_epi16(_mm_srli_si128(b, 8)), w);
+      xx_storeu_128(dst + c, _mm_packus_epi16(lo, hi));
+    }
+    for (; c + 8 <= n && base + 8 <= max_base; c += 8, base += 8) {
+      const __m128i p =
+          dr_interp8(_mm_cvtepu8_epi16(xx_loadl_64(edge + base)),
+                     _mm_cvtepu8_epi16(xx_loadl_64(edge + base + 1)), w);
+      xx_storel_64(dst + c, _mm_packus_epi16(p, p));
+    }
+    for (; c + 4 <= n && base + 4 <= max_base; c += 4, base += 4) {
+      const __m128i p =
+          dr_interp8(_mm_cvtepu8_epi16(xx_loadl_32(edge + base)),
+                     _mm_cvtepu8_epi16(xx_loadl_32(edge + base + 1)), w);
+      xx_storel_32(dst + c, _mm_packus_epi16(p, p));
+    }
+  }
+  for (; c < n; ++c, base += inc) {
+    dst[c] = base < max_base ? dr_interp(edge[base], edge[base + 1], shift)
+                             : edge[max_base];
+  }
+}
+
+static INLINE void highbd_dr_row(uint16_t *dst, int n, const uint16_t *edge,
+                                 int base, int shift, int max_base,
+                                 int upsample) {
+  const __m128i w = _mm_set1_epi16(shift << (15 - DR_WEIGHT_BITS));
+  const int inc = 1 << upsample;
+  int c = 0;
+
+  if (base >= max_base) {
+    aom_memset16(dst, edge[max_base], n);
+    return;
+  }
+  if (upsample) {
+    const __m128i even = _mm_set1_epi32(0xffff);
+    for (; c + 8 <= n && base + 15 <= max_base; c += 8, base += 16) {
+      const __m128i v0 = xx_loadu_128(edge + base);
+      const __m128i v1 = xx_loadu_128(edge + base + 8);
+      const __m128i a = _mm_packus_epi32(_mm_and_si128(v0, even),
+                                         _mm_and_si128(v1, even));
+      const __m128i b =
+          _mm_packus_epi32(_mm_srli_epi32(v0, 16), _mm_srli_epi32(v1, 16));
+      xx_storeu_128(dst + c, dr_interp8(a, b, w));
+    }
+  } else {
+    for (; c + 8 <= n && base + 8 <= max_base; c += 8, base += 8) {
+      xx_storeu_128(dst + c, dr_interp8(xx_loadu_128(edge + base),
+                                        xx_loadu_128(edge + base + 1), w));
+    }
+    for (; c + 4 <= n && base + 4 <= max_base; c += 4, base += 4) {
+      xx_storel_64(dst + c, dr_interp8(xx_loadl_64(edge + base),
+                                       xx_loadl_64(edge + base + 1), w));
+    }
+  }
+  for (; c < n; ++c, base += inc) {
+    dst[c] = base < max_base ? dr_interp(edge[base], edge[base + 1], shift)
+                             : edge[max_base];
+  }
+}
+
+// Writes the transpose of src, which has bh rows of bw pixels, to dst.
+static void transpose(const uint8_t *src, int src_stride, uint8_t *dst,
+                      ptrdiff_t dst_stride, int bw, int bh) {
+  if ((bw | bh) & 7) {
+    for (int r = 0; r < bw; ++r)
+      for (int c = 0; c < bh; ++c)
+        dst[r * dst_stride + c] = src[c * src_stride + r];
+    return;
+  }
+  for (int r = 0; r < bh; r += 8) {
+    for (int c = 0; c < bw; c += 8) {
+      const uint8_t *s = src + r * src_stride + c;
+      uint8_t *d = dst + c * dst_stride + r;
+      const __m128i a0 = _mm_unpacklo_epi8(xx_loadl_64(s),
+                                           xx_loadl_64(s + src_stride));
+      const __m128i a1 = _mm_unpacklo_epi8(xx_loadl_64(s + 2 * src_stride),
+                                           xx_loadl_64(s + 3 * src_stride));
+      const __m128i a2 = _mm_unpacklo_epi8(xx_loadl_64(s + 4 * src_stride),
+                                           xx_loadl_64(s + 5 * src_stride));
+      const __m128i a3 = _mm_unpacklo_epi8(xx_loadl_64(s + 6 * src_stride),
+                                           xx_loadl_64(s + 7 * src_stride));
+      const __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+      const __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+      const __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+      const __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+      const __m128i out[4] = { _mm_unpacklo_epi32(b0, b2),
+                               _mm_unpackhi_epi32(b0, b2),
+                               _mm_unpacklo_epi32(b1, b3),
+                               _mm_unpackhi_epi32(b1, b3) };
+      for (int i = 0; i < 4; ++i) {
+        xx_storel_64(d + 2 * i * dst_stride, out[i]);
+        xx_storel_64(d + (2 * i + 1) * dst_stride, _mm_srli_si128(out[i], 8));
+      }
+    }
+  }
+}
+
+static void highbd_transpose(const uint16_t *src, int src_stride,
+                             uint16_t *dst, ptrdiff_t dst_stride, int bw,
+                             int bh) {
+  if ((bw | bh) & 7) {
+    for (int r = 0; r < bw; ++r)
+      for (int c = 0; c < bh; ++c)
+        dst[r * dst_stride + c] = src[c * src_stride + r];
+    return;
+  }
+  for (int r = 0; r < bh; r += 8) {
+    for (int c = 0; c < bw; c += 8) {
+      const uint16_t *s = src + r * src_stride + c;
+      uint16_t *d = dst + c * dst_stride + r;
+      __m128i a[8], b[8];
+      for (int i = 0; i < 8; i += 2) {
+        const __m128i r0 = xx_loadu_128(s + i * src_stride);
+        const __m128i r1 = xx_loadu_128(s + (i + 1) * src_stride);
+        a[i] = _mm_unpacklo_epi16(r0, r1);
+        a[i + 1] = _mm_unpackhi_epi16(r0, r1);
+      }
+      for (int i = 0; i < 8; i += 4) {
+        b[i] = _mm_unpacklo_epi32(a[i], a[i + 2]);
+        b[i + 1] = _mm_unpackhi_epi32(a[i], a[i + 2]);
+        b[i + 2] = _mm_unpacklo_epi32(a[i + 1], a[i + 3]);
+        b[i + 3] = _mm_unpackhi_epi32(a[i + 1], a[i + 3]);
+      }
+      for (int i = 0; i < 4; ++i) {
+        xx_storeu_128(d + 2 * i * dst_stride,
+                      _mm_unpacklo_epi64(b[i], b[i + 4]));
+        xx_storeu_128(d + (2 * i + 1) * dst_stride,
+                      _mm_unpackhi_epi64(b[i], b[i + 4]));
+      }
+    }
+  }
+}
+
+// Directional prediction, zone 1: 0 < angle < 90
+void av1_dr_prediction_z1_sse4_1(uint8_t *dst, ptrdiff_t stride, int bw,
+                                 int bh, const uint8_t *above,
+                                 const uint8_t *left, int upsample_above,
+                                 int dx, int dy) {
+  const int max_base_x = ((bw + bh) - 1) << upsample_above;
+  const int frac_bits = DR_FRAC_BITS - upsample_above;
+  int x = dx;
+
+  (void)left;
+  (void)dy;
+  assert(dy == 1);
+  assert(dx > 0);
+
+  // The C code is as fast for 4x4 blocks.
+  if (bw == 4 && bh == 4) {
+    av1_dr_prediction_z1_c(dst, stride, bw, bh, above, left, upsample_above, dx,
+                           dy);
+    return;
+  }
+
+  for (int r = 0; r < bh; ++r, dst += stride, x += dx) {
+    dr_row(dst, bw, above, x >> frac_bits, dr_shift(x, upsample_above),
+           max_base_x, upsample_above);
+  }
+}
+
+void av1_highbd_dr_prediction_z1_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                        int bw, int bh, const uint16_t *above,
+                                        const uint16_t *left,
+                                        int upsample_above, int dx, int dy,
+                                        int bd) {
+  const int max_base_x = ((bw + bh) - 1) << upsample_above;
+  const int frac_bits = DR_FRAC_BITS - upsample_above;
+  int x = dx;
+
+  (void)left;
+  (void)dy;
+  (void)bd;
+  assert(dy == 1);
+  assert(dx > 0);
+
+  if (bw == 4 && bh == 4) {
+    av1_highbd_dr_prediction_z1_c(dst, stride, bw, bh, above, left,
+                                  upsample_above, dx, dy, bd);
+    return;
+  }
+
+  for (int r = 0; r < bh; ++r, dst += stride, x += dx) {
+    highbd_dr_row(dst, bw, above, x >> frac_bits, dr_shift(x, upsample_above),
+                  max_base_x, upsample_above);
+  }
+}
+
+// Directional prediction, zone 2: 90 < angle < 180
+//
+// In each row the pixels right of column c0 project onto the above edge with
+// one weight and are predicted with dr_row(). The pixels left of c0 project
+// onto the left edge. Down a column those share one weight too, so they are
+// predicted column by column into a transposed buffer and copied out.
+void av1_dr_prediction_z2_sse4_1(uint8_t *dst, ptrdiff_t stride, int bw,
+                                 int bh, const uint8_t *above,
+                                 const uint8_t *left, int upsample_above,
+                                 int upsample_left, int dx, int dy) {
+  DECLARE_ALIGNED(16, uint8_t, buf[MAX_TX_SQUARE]);
+  const int min_base_x = -(1 << upsample_above);
+  const int frac_bits_x = DR_FRAC_BITS - upsample_above;
+  const int frac_bits_y = DR_FRAC_BITS - upsample_left;
+  const int inc_x = 1 << upsample_above;
+  int c0[MAX_TX_SIZE], max_c0 = 0;
+
+  assert(dx > 0);
+  assert(dy > 0);
+
+  if (bw == 4 && bh == 4) {
+    av1_dr_prediction_z2_c(dst, stride, bw, bh, above, left, upsample_above,
+                           upsample_left, dx, dy);
+    return;
+  }
+
+  // c0 never decreases down the block.
+  for (int r = 0; r < bh; ++r) {
+    const int base_x = (-(r + 1) * dx) >> frac_bits_x;
+    c0[r] = 0;
+    if (base_x < min_base_x)
+      c0[r] = AOMMIN(bw, (min_base_x - base_x + inc_x - 1) >> upsample_above);
+    max_c0 = c0[r];
+  }
+  for (int c = 0, r = 0; c < max_c0; ++c) {
+    while (c0[r] <= c) ++r;
+    const int y = (r << DR_FRAC_BITS) - (c + 1) * dy;
+    assert((y >> frac_bits_y) >= -(1 << upsample_left));
+    dr_row(buf + c * bh + r, bh - r, left, y >> frac_bits_y,
+           dr_shift(y, upsample_left), INT_MAX, upsample_left);
+  }
+
+  for (int r = 0; r < bh; ++r, dst += stride) {
+    const int x = -(r + 1) * dx;
+    for (int c = 0; c < c0[r]; ++c) dst[c] = buf[c * bh + r];
+    // There is no right-hand limit on the above edge in zone 2.
+    dr_row(dst + c0[r], bw - c0[r], above, (x >> frac_bits_x) + c0[r] * inc_x,
+           dr_shift(x, upsample_above), INT_MAX, upsample_above);
+  }
+}
+
+void av1_highbd_dr_prediction_z2_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                        int bw, int bh, const uint16_t *above,
+                                        const uint16_t *left,
+                                        int upsample_above, int upsample_left,
+                                        int dx, int dy, int bd) {
+  DECLARE_ALIGNED(16, uint16_t, buf[MAX_TX_SQUARE]);
+  const int min_base_x = -(1 << upsample_above);
+  const int frac_bits_x = DR_FRAC_BITS - upsample_above;
+  const int frac_bits_y = DR_FRAC_BITS - upsample_left;
+  const int inc_x = 1 << upsample_above;
+  int c0[MAX_TX_SIZE], max_c0 = 0;
+
+  (void)bd;
+  assert(dx > 0);
+  assert(dy > 0);
+
+  if (bw == 4 && bh == 4) {
+    av1_highbd_dr_prediction_z2_c(dst, stride, bw, bh, above, left,
+                                  upsample_above, upsample_left, dx, dy, bd);
+    return;
+  }
+
+  for (int r = 0; r < bh; ++r) {
+    const int base_x = (-(r + 1) * dx) >> frac_bits_x;
+    c0[r] = 0;
+    if (base_x < min_base_x)
+      c0[r] = AOMMIN(bw, (min_base_x - base_x + inc_x - 1) >> upsample_above);
+    max_c0 = c0[r];
+  }
+  for (int c = 0, r = 0; c < max_c0; ++c) {
+    while (c0[r] <= c) ++r;
+    const int y = (r << DR_FRAC_BITS) - (c + 1) * dy;
+    assert((y >> frac_bits_y) >= -(1 << upsample_left));
+    highbd_dr_row(buf + c * bh + r, bh - r, left, y >> frac_bits_y,
+                  dr_shift(y, upsample_left), INT_MAX, upsample_left);
+  }
+
+  for (int r = 0; r < bh; ++r, dst += stride) {
+    const int x = -(r + 1) * dx;
+    for (int c = 0; c < c0[r]; ++c) dst[c] = buf[c * bh + r];
+    highbd_dr_row(dst + c0[r], bw - c0[r], above,
+                  (x >> frac_bits_x) + c0[r] * inc_x,
+                  dr_shift(x, upsample_above), INT_MAX, upsample_above);
+  }
+}
+
+// Directional prediction, zone 3: 180 < angle < 270
+//
+// Each column is predicted from the left edge the way zone 1 predicts a row
+// from the above edge, into a transposed buffer.
+void av1_dr_prediction_z3_sse4_1(uint8_t *dst, ptrdiff_t stride, int bw,
+                                 int bh, const uint8_t *above,
+                                 const uint8_t *left, int upsample_left,
+                                 int dx, int dy) {
+  DECLARE_ALIGNED(16, uint8_t, buf[MAX_TX_SQUARE]);
+  const int max_base_y = (bw + bh - 1) << upsample_left;
+  const int frac_bits = DR_FRAC_BITS - upsample_left;
+  int y = dy;
+
+  (void)above;
+  (void)dx;
+  assert(dx == 1);
+  assert(dy > 0);
+
+  if (bw == 4 && bh == 4) {
+    av1_dr_prediction_z3_c(dst, stride, bw, bh, above, left, upsample_left, dx,
+                           dy);
+    return;
+  }
+
+  for (int c = 0; c < bw; ++c, y += dy) {
+    dr_row(buf + c * bh, bh, left, y >> frac_bits, dr_shift(y, upsample_left),
+           max_base_y, upsample_left);
+  }
+  transpose(buf, bh, dst, stride, bh, bw);
+}
+
+void av1_highbd_dr_prediction_z3_sse4_1(uint16_t *dst, ptrdiff_t stride,
+                                        int bw, int bh, const uint16_t *above,
+                                        const uint16_t *left,
+                                        int upsample_left, int dx, int dy,
+                                        int bd) {
+  DECLARE_ALIGNED(16, uint16_t, buf[MAX_TX_SQUARE]);
+  const int max_base_y = (bw + bh - 1) << upsample_left;
+  const int frac_bits = DR_FRAC_BITS - upsample_left;
+  int y = dy;
+
+  (void)above;
+  (void)dx;
+  (void)bd;
+  assert(dx == 1);
+  assert(dy > 0);
+
+  if (bw == 4 && bh == 4) {
+    av1_highbd_dr_prediction_z3_c(dst, stride, bw, bh, above, left,
+                                  upsample_left, dx, dy, bd);
+    return;
+  }
+
+  for (int c = 0; c < bw; ++c, y += dy) {
+    highbd_dr_row(buf + c * bh, bh, left, y >> frac_bits,
+                  dr_shift(y, upsample_left), max_base_y, upsample_left);
+  }
+  highbd_transpose(buf, bh, dst, stride, bh, bw);
+}
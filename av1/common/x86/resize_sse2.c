@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <emmintrin.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_filter.h"
+#include "aom_dsp/x86/synonyms.h"
+
+// Taps k and k + 1 are applied together: the two rows are interleaved so that
+// a single _mm_madd_epi16() adds both products to each pixel's sum.
+void av1_resize_vert_8tap_sse2(const uint8_t *const *rows,
+                               const int16_t *filter, uint8_t *output,
+                               int cols) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i round = _mm_set1_epi32(1 << (FILTER_BITS - 1));
+  __m128i coeffs[SUBPEL_TAPS / 2];
+  int c = 0;
+
+  for (int k = 0; k < SUBPEL_TAPS; k += 2) {
+    coeffs[k / 2] = _mm_set1_epi32((int32_t)(uint16_t)filter[k] |
+                                   ((int32_t)filter[k + 1] << 16));
+  }
+
+  for (; c + 8 <= cols; c += 8) {
+    __m128i sum_lo = round, sum_hi = round;
+    for (int k = 0; k < SUBPEL_TAPS; k += 2) {
+      const __m128i r0 = _mm_unpacklo_epi8(xx_loadl_64(rows[k] + c), zero);
+      const __m128i r1 = _mm_unpacklo_epi8(xx_loadl_64(rows[k + 1] + c), zero);
+      sum_lo = _mm_add_epi32(
+          sum_lo, _mm_madd_epi16(_mm_unpacklo_epi16(r0, r1), coeffs[k / 2]));
+      sum_hi = _mm_add_epi32(
+          sum_hi, _mm_madd_epi16(_mm_unpackhi_epi16(r0, r1), coeffs[k / 2]));
+    }
+    sum_lo = _mm_srai_epi32(sum_lo, FILTER_BITS);
+    sum_hi = _mm_srai_epi32(sum_hi, FILTER_BITS);
+    xx_storel_64(output + c,
+                 _mm_packus_epi16(_mm_packs_epi32(sum_lo, sum_hi), zero));
+  }
+
+  if (c < cols) {
+    const uint8_t *tail_rows[SUBPEL_TAPS];
+    for (int k = 0; k < SUBPEL_TAPS; ++k) tail_rows[k] = rows[k] + c;
+    av1_resize_vert_8tap_c(tail_rows, filter, output + c, cols - c);
+  }
+}
@@ -52,6 +52,26 @@ int aom_accounting_dictionary_lookup(Accounting *accounting, const char *str) {
   return dictionary->num_strs - 1;
 }
 
+static int aom_accounting_get_id(Accounting *accounting, const char *str) {
+  const int slot = (int)(((uintptr_t)str >> 2) % AOM_ACCOUNTING_ID_CACHE_SIZE);
+  if (accounting->id_cache_strs[slot] != str) {
+    accounting->id_cache_ids[slot] =
+        aom_accounting_dictionary_lookup(accounting, str);
+    accounting->id_cache_strs[slot] = str;
+  }
+  return accounting->id_cache_ids[slot];
+}
+
+static void aom_accounting_reserve(Accounting *accounting, int num_syms) {
+  if (num_syms <= accounting->num_syms_allocated) return;
+  while (accounting->num_syms_allocated < num_syms)
+    accounting->num_syms_allocated *= 2;
+  accounting->syms.syms =
+      realloc(accounting->syms.syms,
+              sizeof(AccountingSymbol) * accounting->num_syms_allocated);
+  assert(accounting->syms.syms != NULL);
+}
+
 void aom_accounting_init(Accounting *accounting) {
   int i;
   accounting->num_syms_allocated = 1000;
@@ -61,6 +81,8 @@ void aom_accounting_init(Accounting *accounting) {
   assert(AOM_ACCOUNTING_HASH_SIZE > 2 * MAX_SYMBOL_TYPES);
   for (i = 0; i < AOM_ACCOUNTING_HASH_SIZE; i++)
     accounting->hash_dictionary[i] = -1;
+  for (i = 0; i < AOM_ACCOUNTING_ID_CACHE_SIZE; i++)
+    accounting->id_cache_strs[i] = NULL;
   aom_accounting_reset(accounting);
 }
 
@@ -91,36 +113,46 @@ void aom_accounting_set_context(Accounting *accounting, int16_t x, int16_t y) {
 void aom_accounting_record(Accounting *accounting, const char *str,
                            uint32_t bits) {
   AccountingSymbol sym;
+  const uint32_t id = aom_accounting_get_id(accounting, str);
   // Reuse previous symbol if it has the same context and symbol id.
   if (accounting->syms.num_syms) {
     AccountingSymbol *last_sym;
     last_sym = &accounting->syms.syms[accounting->syms.num_syms - 1];
-    if (memcmp(&last_sym->context, &accounting->context,
+    if (id == last_sym->id &&
+        memcmp(&last_sym->context, &accounting->context,
                sizeof(AccountingSymbolContext)) == 0) {
-      uint32_t id;
-      id = aom_accounting_dictionary_lookup(accounting, str);
-      if (id == last_sym->id) {
-        last_sym->bits += bits;
-        last_sym->samples++;
-        return;
-      }
+      last_sym->bits += bits;
+      last_sym->samples++;
+      return;
     }
   }
   sym.context = accounting->context;
   sym.samples = 1;
   sym.bits = bits;
-  sym.id = aom_accounting_dictionary_lookup(accounting, str);
+  sym.id = id;
   assert(sym.id <= 255);
-  if (accounting->syms.num_syms == accounting->num_syms_allocated) {
-    accounting->num_syms_allocated *= 2;
-    accounting->syms.syms =
-        realloc(accounting->syms.syms,
-                sizeof(AccountingSymbol) * accounting->num_syms_allocated);
-    assert(accounting->syms.syms != NULL);
-  }
+  aom_accounting_reserve(accounting, accounting->syms.num_syms + 1);
   accounting->syms.syms[accounting->syms.num_syms++] = sym;
 }
 
+void aom_accounting_merge(Accounting *accounting, const Accounting *src) {
+  const AccountingDictionary *dictionary = &src->syms.dictionary;
+  uint32_t ids[MAX_SYMBOL_TYPES];
+  int i;
+  /* The two dictionaries were filled independently. */
+  for (i = 0; i < dictionary->num_strs; i++)
+    ids[i] = aom_accounting_dictionary_lookup(accounting, dictionary->strs[i]);
+  aom_accounting_reserve(accounting,
+                         accounting->syms.num_syms + src->syms.num_syms);
+  for (i = 0; i < src->syms.num_syms; i++) {
+    AccountingSymbol *sym = &accounting->syms.syms[accounting->syms.num_syms++];
+    *sym = src->syms.syms[i];
+    sym->id = ids[sym->id];
+  }
+  accounting->syms.num_multi_syms += src->syms.num_multi_syms;
+  accounting->syms.num_binary_syms += src->syms.num_binary_syms;
+}
+
 void aom_accounting_dump(Accounting *accounting) {
   int i;
   AccountingSymbol *sym;
@@ -27,6 +27,9 @@ extern "C" {
    3 => 1/8th bits.*/
 #define AOM_ACCT_BITRES (3)
 
+/* Number of entries of the symbol id cache. */
+#define AOM_ACCOUNTING_ID_CACHE_SIZE (256)
+
 typedef struct {
   int16_t x;
   int16_t y;
@@ -64,6 +67,11 @@ struct Accounting {
   /** Size allocated for symbols (not all may be used). */
   int num_syms_allocated;
   int16_t hash_dictionary[AOM_ACCOUNTING_HASH_SIZE];
+  /** Symbol names are string constants, so the id of a name is cached by
+      the address of the string and the dictionary is only searched for
+      addresses not seen before. */
+  const char *id_cache_strs[AOM_ACCOUNTING_ID_CACHE_SIZE];
+  int16_t id_cache_ids[AOM_ACCOUNTING_ID_CACHE_SIZE];
   AccountingSymbolContext context;
   uint32_t last_tell_frac;
 };
@@ -75,6 +83,8 @@ void aom_accounting_set_context(Accounting *accounting, int16_t x, int16_t y);
 int aom_accounting_dictionary_lookup(Accounting *accounting, const char *str);
 void aom_accounting_record(Accounting *accounting, const char *str,
                            uint32_t bits);
+/* Appends the symbols recorded in src, e.g. for one tile, to accounting. */
+void aom_accounting_merge(Accounting *accounting, const Accounting *src);
 void aom_accounting_dump(Accounting *accounting);
 #ifdef __cplusplus
 }  // extern "C"
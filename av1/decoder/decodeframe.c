@@ -138,47 +138,111 @@ static void inverse_transform_block(MACROBLOCKD *xd, int plane,
   memset(dqcoeff, 0, (scan_line + 1) * sizeof(dqcoeff[0]));
 }
 
-static void predict_and_reconstruct_intra_block(
-    AV1_COMMON *cm, MACROBLOCKD *const xd, aom_reader *const r,
-    MB_MODE_INFO *const mbmi, int plane, int row, int col, TX_SIZE tx_size) {
-  PLANE_TYPE plane_type = get_plane_type(plane);
-  av1_predict_intra_block_facade(cm, xd, plane, col, row, tx_size);
+typedef void (*tx_block_visitor)(AV1_COMMON *cm, MACROBLOCKD *const xd,
+                                 aom_reader *r, SbDecodeBuffer *sb_buf,
+                                 int plane, int row, int col, TX_SIZE tx_size);
+
+// Points the plane at the coefficients of the next transform block of the
+// superblock row and returns its eob slot.
+static EobInfo *next_tx_block(SbDecodeBuffer *sb_buf, MACROBLOCKD *const xd,
+                              int plane, TX_SIZE tx_size) {
+  assert(sb_buf->dqcoeff_offset[plane] + tx_size_2d[tx_size] <=
+         sb_buf->plane_size[plane]);
+  xd->plane[plane].dqcoeff =
+      sb_buf->dqcoeff[plane] + sb_buf->dqcoeff_offset[plane];
+  sb_buf->dqcoeff_offset[plane] += tx_size_2d[tx_size];
+  return &sb_buf->eob_data[plane][sb_buf->eob_offset[plane]++];
+}
+
+static void set_color_index_map(SbDecodeBuffer *sb_buf, MACROBLOCKD *const xd,
+                                int plane) {
+  int plane_width, plane_height;
+  av1_get_block_dimensions(xd->mi[0]->mbmi.sb_type, plane, xd, &plane_width,
+                           &plane_height, NULL, NULL);
+  assert(sb_buf->color_index_map_offset[plane] + plane_width * plane_height <=
+         sb_buf->plane_size[plane]);
+  xd->plane[plane].color_index_map =
+      sb_buf->color_index_map[plane] + sb_buf->color_index_map_offset[plane];
+  sb_buf->color_index_map_offset[plane] += plane_width * plane_height;
+}
 
-  if (!mbmi->skip) {
-    struct macroblockd_plane *const pd = &xd->plane[plane];
+static void read_coeffs_tx_block(AV1_COMMON *cm, MACROBLOCKD *const xd,
+                                 aom_reader *r, SbDecodeBuffer *sb_buf,
+                                 int plane, int row, int col,
+                                 TX_SIZE tx_size) {
+  EobInfo *const eob_info = next_tx_block(sb_buf, xd, plane, tx_size);
 #if TXCOEFF_TIMER
-    struct aom_usec_timer timer;
-    aom_usec_timer_start(&timer);
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
 #endif
 #if CONFIG_LV_MAP
-    int16_t max_scan_line = 0;
-    int eob;
-    av1_read_coeffs_txb_facade(cm, xd, r, row, col, plane, tx_size,
-                               &max_scan_line, &eob);
-    // tx_type will be read out in av1_read_coeffs_txb_facade
-    const TX_TYPE tx_type = av1_get_tx_type(plane_type, xd, row, col, tx_size);
+  int16_t max_scan_line = 0;
+  int eob;
+  av1_read_coeffs_txb_facade(cm, xd, r, row, col, plane, tx_size,
+                             &max_scan_line, &eob);
 #else   // CONFIG_LV_MAP
-    const TX_TYPE tx_type = av1_get_tx_type(plane_type, xd, row, col, tx_size);
-    const SCAN_ORDER *scan_order = get_scan(cm, tx_size, tx_type, mbmi);
-    int16_t max_scan_line = 0;
-    const int eob =
-        av1_decode_block_tokens(cm, xd, plane, scan_order, col, row, tx_size,
-                                tx_type, &max_scan_line, r, mbmi->segment_id);
+  const MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  const TX_TYPE tx_type =
+      av1_get_tx_type(get_plane_type(plane), xd, row, col, tx_size);
+  const SCAN_ORDER *scan_order = get_scan(cm, tx_size, tx_type, mbmi);
+  int16_t max_scan_line = 0;
+  const int eob =
+      av1_decode_block_tokens(cm, xd, plane, scan_order, col, row, tx_size,
+                              tx_type, &max_scan_line, r, mbmi->segment_id);
 #endif  // CONFIG_LV_MAP
 
 #if TXCOEFF_TIMER
-    aom_usec_timer_mark(&timer);
-    const int64_t elapsed_time = aom_usec_timer_elapsed(&timer);
-    cm->txcoeff_timer += elapsed_time;
-    ++cm->txb_count;
+  aom_usec_timer_mark(&timer);
+  const int64_t elapsed_time = aom_usec_timer_elapsed(&timer);
+  cm->txcoeff_timer += elapsed_time;
+  ++cm->txb_count;
 #endif
-    if (eob) {
-      uint8_t *dst =
-          &pd->dst.buf[(row * pd->dst.stride + col) << tx_size_wide_log2[0]];
-      inverse_transform_block(xd, plane, tx_type, tx_size, dst, pd->dst.stride,
-                              max_scan_line, eob, cm->reduced_tx_set_used);
-    }
+  eob_info->eob = eob;
+  eob_info->max_scan_line = max_scan_line;
+}
+
+static void inverse_transform_tx_block(AV1_COMMON *cm, MACROBLOCKD *const xd,
+                                       aom_reader *r, SbDecodeBuffer *sb_buf,
+                                       int plane, int row, int col,
+                                       TX_SIZE tx_size) {
+  (void)r;
+  const EobInfo *const eob_info = next_tx_block(sb_buf, xd, plane, tx_size);
+  struct macroblockd_plane *const pd = &xd->plane[plane];
+  uint8_t *dst =
+      &pd->dst.buf[(row * pd->dst.stride + col) << tx_size_wide_log2[0]];
+
+  if (eob_info->eob) {
+    // The transform type was read along with the coefficients.
+    const TX_TYPE tx_type =
+        av1_get_tx_type(get_plane_type(plane), xd, row, col, tx_size);
+    inverse_transform_block(xd, plane, tx_type, tx_size, dst, pd->dst.stride,
+                            eob_info->max_scan_line, eob_info->eob,
+                            cm->reduced_tx_set_used);
+  }
+#if CONFIG_MISMATCH_DEBUG
+  if (is_inter_block(&xd->mi[0]->mbmi)) {
+    const int mi_row = -xd->mb_to_top_edge >> (3 + MI_SIZE_LOG2);
+    const int mi_col = -xd->mb_to_left_edge >> (3 + MI_SIZE_LOG2);
+    int pixel_c, pixel_r;
+    BLOCK_SIZE bsize = txsize_to_bsize[tx_size];
+    int blk_w = block_size_wide[bsize];
+    int blk_h = block_size_high[bsize];
+    mi_to_pixel_loc(&pixel_c, &pixel_r, mi_col, mi_row, col, row,
+                    pd->subsampling_x, pd->subsampling_y);
+    mismatch_check_block_tx(dst, pd->dst.stride, plane, pixel_c, pixel_r, blk_w,
+                            blk_h);
   }
+#endif
+}
+
+static void predict_and_reconstruct_intra_block(
+    AV1_COMMON *cm, MACROBLOCKD *const xd, aom_reader *r,
+    SbDecodeBuffer *sb_buf, int plane, int row, int col, TX_SIZE tx_size) {
+  MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  av1_predict_intra_block_facade(cm, xd, plane, col, row, tx_size);
+
+  if (!mbmi->skip)
+    inverse_transform_tx_block(cm, xd, r, sb_buf, plane, row, col, tx_size);
 #if CONFIG_CFL
   if (plane == AOM_PLANE_Y && xd->cfl.store_y && is_cfl_allowed(mbmi)) {
     cfl_store_tx(xd, row, col, tx_size, mbmi->sb_type);
@@ -186,14 +250,56 @@ static void predict_and_reconstruct_intra_block(
 #endif  // CONFIG_CFL
 }
 
-static void decode_reconstruct_tx(AV1_COMMON *cm, MACROBLOCKD *const xd,
-                                  aom_reader *r, MB_MODE_INFO *const mbmi,
-                                  int plane, BLOCK_SIZE plane_bsize,
-                                  int blk_row, int blk_col, int block,
-                                  TX_SIZE tx_size, int *eob_total, int mi_row,
-                                  int mi_col) {
-  (void)mi_row;
-  (void)mi_col;
+// Visits the transform blocks of an intra block in coding order.
+static void visit_intra_tx_blocks(AV1_COMMON *cm, MACROBLOCKD *const xd,
+                                  aom_reader *r, SbDecodeBuffer *sb_buf,
+                                  int mi_row, int mi_col, BLOCK_SIZE bsize,
+                                  tx_block_visitor visit) {
+  const int num_planes = av1_num_planes(cm);
+  const struct macroblockd_plane *const y_pd = &xd->plane[0];
+  const BLOCK_SIZE plane_bsize = get_plane_block_size(bsize, y_pd);
+  int row, col;
+  const int max_blocks_wide = max_block_wide(xd, plane_bsize, 0);
+  const int max_blocks_high = max_block_high(xd, plane_bsize, 0);
+
+  const BLOCK_SIZE max_unit_bsize = get_plane_block_size(BLOCK_64X64, y_pd);
+  int mu_blocks_wide = block_size_wide[max_unit_bsize] >> tx_size_wide_log2[0];
+  int mu_blocks_high = block_size_high[max_unit_bsize] >> tx_size_high_log2[0];
+  mu_blocks_wide = AOMMIN(max_blocks_wide, mu_blocks_wide);
+  mu_blocks_high = AOMMIN(max_blocks_high, mu_blocks_high);
+
+  for (row = 0; row < max_blocks_high; row += mu_blocks_high) {
+    for (col = 0; col < max_blocks_wide; col += mu_blocks_wide) {
+      for (int plane = 0; plane < num_planes; ++plane) {
+        const struct macroblockd_plane *const pd = &xd->plane[plane];
+        if (!is_chroma_reference(mi_row, mi_col, bsize, pd->subsampling_x,
+                                 pd->subsampling_y))
+          continue;
+
+        const TX_SIZE tx_size = av1_get_tx_size(plane, xd);
+        const int stepr = tx_size_high_unit[tx_size];
+        const int stepc = tx_size_wide_unit[tx_size];
+
+        const int unit_height = ROUND_POWER_OF_TWO(
+            AOMMIN(mu_blocks_high + row, max_blocks_high), pd->subsampling_y);
+        const int unit_width = ROUND_POWER_OF_TWO(
+            AOMMIN(mu_blocks_wide + col, max_blocks_wide), pd->subsampling_x);
+
+        for (int blk_row = row >> pd->subsampling_y; blk_row < unit_height;
+             blk_row += stepr)
+          for (int blk_col = col >> pd->subsampling_x; blk_col < unit_width;
+               blk_col += stepc)
+            visit(cm, xd, r, sb_buf, plane, blk_row, blk_col, tx_size);
+      }
+    }
+  }
+}
+
+static void visit_vartx_block(AV1_COMMON *cm, MACROBLOCKD *const xd,
+                              aom_reader *r, SbDecodeBuffer *sb_buf,
+                              MB_MODE_INFO *const mbmi, int plane,
+                              BLOCK_SIZE plane_bsize, int blk_row, int blk_col,
+                              TX_SIZE tx_size, tx_block_visitor visit) {
   const struct macroblockd_plane *const pd = &xd->plane[plane];
   const int tx_row = blk_row >> (1 - pd->subsampling_y);
   const int tx_col = blk_col >> (1 - pd->subsampling_x);
@@ -207,59 +313,13 @@ static void decode_reconstruct_tx(AV1_COMMON *cm, MACROBLOCKD *const xd,
   if (blk_row >= max_blocks_high || blk_col >= max_blocks_wide) return;
 
   if (tx_size == plane_tx_size || plane) {
-    PLANE_TYPE plane_type = get_plane_type(plane);
-#if TXCOEFF_TIMER
-    struct aom_usec_timer timer;
-    aom_usec_timer_start(&timer);
-#endif
-#if CONFIG_LV_MAP
-    int16_t max_scan_line = 0;
-    int eob;
-    av1_read_coeffs_txb_facade(cm, xd, r, blk_row, blk_col, plane, tx_size,
-                               &max_scan_line, &eob);
-    // tx_type will be read out in av1_read_coeffs_txb_facade
-    const TX_TYPE tx_type =
-        av1_get_tx_type(plane_type, xd, blk_row, blk_col, tx_size);
-#else   // CONFIG_LV_MAP
-    const TX_TYPE tx_type =
-        av1_get_tx_type(plane_type, xd, blk_row, blk_col, tx_size);
-    const SCAN_ORDER *sc = get_scan(cm, tx_size, tx_type, mbmi);
-    int16_t max_scan_line = 0;
-    const int eob =
-        av1_decode_block_tokens(cm, xd, plane, sc, blk_col, blk_row, tx_size,
-                                tx_type, &max_scan_line, r, mbmi->segment_id);
-#endif  // CONFIG_LV_MAP
-
-#if TXCOEFF_TIMER
-    aom_usec_timer_mark(&timer);
-    const int64_t elapsed_time = aom_usec_timer_elapsed(&timer);
-    cm->txcoeff_timer += elapsed_time;
-    ++cm->txb_count;
-#endif
-
-    uint8_t *dst =
-        &pd->dst
-             .buf[(blk_row * pd->dst.stride + blk_col) << tx_size_wide_log2[0]];
-    inverse_transform_block(xd, plane, tx_type, tx_size, dst, pd->dst.stride,
-                            max_scan_line, eob, cm->reduced_tx_set_used);
-#if CONFIG_MISMATCH_DEBUG
-    int pixel_c, pixel_r;
-    BLOCK_SIZE bsize = txsize_to_bsize[tx_size];
-    int blk_w = block_size_wide[bsize];
-    int blk_h = block_size_high[bsize];
-    mi_to_pixel_loc(&pixel_c, &pixel_r, mi_col, mi_row, blk_col, blk_row,
-                    pd->subsampling_x, pd->subsampling_y);
-    mismatch_check_block_tx(dst, pd->dst.stride, plane, pixel_c, pixel_r, blk_w,
-                            blk_h);
-#endif
-    *eob_total += eob;
+    visit(cm, xd, r, sb_buf, plane, blk_row, blk_col, tx_size);
   } else {
     const TX_SIZE sub_txs = sub_tx_size_map[1][tx_size];
     assert(IMPLIES(tx_size <= TX_4X4, sub_txs == tx_size));
     assert(IMPLIES(tx_size > TX_4X4, sub_txs < tx_size));
     const int bsw = tx_size_wide_unit[sub_txs];
     const int bsh = tx_size_high_unit[sub_txs];
-    const int sub_step = bsw * bsh;
 
     assert(bsw > 0 && bsh > 0);
 
@@ -270,43 +330,80 @@ static void decode_reconstruct_tx(AV1_COMMON *cm, MACROBLOCKD *const xd,
 
         if (offsetr >= max_blocks_high || offsetc >= max_blocks_wide) continue;
 
-        decode_reconstruct_tx(cm, xd, r, mbmi, plane, plane_bsize, offsetr,
-                              offsetc, block, sub_txs, eob_total, mi_row,
-                              mi_col);
-        block += sub_step;
+        visit_vartx_block(cm, xd, r, sb_buf, mbmi, plane, plane_bsize, offsetr,
+                          offsetc, sub_txs, visit);
       }
     }
   }
 }
 
-static void set_offsets(AV1_COMMON *const cm, MACROBLOCKD *const xd,
-                        BLOCK_SIZE bsize, int mi_row, int mi_col, int bw,
-                        int bh, int x_mis, int y_mis) {
-  const int offset = mi_row * cm->mi_stride + mi_col;
+// Visits the transform blocks of an inter block in coding order.
+static void visit_inter_tx_blocks(AV1_COMMON *cm, MACROBLOCKD *const xd,
+                                  aom_reader *r, SbDecodeBuffer *sb_buf,
+                                  int mi_row, int mi_col, BLOCK_SIZE bsize,
+                                  tx_block_visitor visit) {
+  MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  const struct macroblockd_plane *const y_pd = &xd->plane[0];
+  const int max_blocks_wide = max_block_wide(xd, bsize, 0);
+  const int max_blocks_high = max_block_high(xd, bsize, 0);
+  int row, col;
+
+  const BLOCK_SIZE max_unit_bsize = get_plane_block_size(BLOCK_64X64, y_pd);
+  int mu_blocks_wide = block_size_wide[max_unit_bsize] >> tx_size_wide_log2[0];
+  int mu_blocks_high = block_size_high[max_unit_bsize] >> tx_size_high_log2[0];
+
+  mu_blocks_wide = AOMMIN(max_blocks_wide, mu_blocks_wide);
+  mu_blocks_high = AOMMIN(max_blocks_high, mu_blocks_high);
+
+  for (row = 0; row < max_blocks_high; row += mu_blocks_high) {
+    for (col = 0; col < max_blocks_wide; col += mu_blocks_wide) {
+      for (int plane = 0; plane < av1_num_planes(cm); ++plane) {
+        const struct macroblockd_plane *const pd = &xd->plane[plane];
+        if (!is_chroma_reference(mi_row, mi_col, bsize, pd->subsampling_x,
+                                 pd->subsampling_y))
+          continue;
+        const BLOCK_SIZE bsizec =
+            scale_chroma_bsize(bsize, pd->subsampling_x, pd->subsampling_y);
+        const BLOCK_SIZE plane_bsize = get_plane_block_size(bsizec, pd);
+
+        TX_SIZE max_tx_size = get_vartx_max_txsize(
+            xd, plane_bsize, pd->subsampling_x || pd->subsampling_y);
+        const int bh_var_tx = tx_size_high_unit[max_tx_size];
+        const int bw_var_tx = tx_size_wide_unit[max_tx_size];
+
+        int blk_row, blk_col;
+        const int unit_height = ROUND_POWER_OF_TWO(
+            AOMMIN(mu_blocks_high + row, max_blocks_high), pd->subsampling_y);
+        const int unit_width = ROUND_POWER_OF_TWO(
+            AOMMIN(mu_blocks_wide + col, max_blocks_wide), pd->subsampling_x);
+
+        for (blk_row = row >> pd->subsampling_y; blk_row < unit_height;
+             blk_row += bh_var_tx) {
+          for (blk_col = col >> pd->subsampling_x; blk_col < unit_width;
+               blk_col += bw_var_tx) {
+            visit_vartx_block(cm, xd, r, sb_buf, mbmi, plane, plane_bsize,
+                              blk_row, blk_col, max_tx_size, visit);
+          }
+        }
+      }
+    }
+  }
+}
+
+// Points xd at a block whose mode info is already in the mode info grid.
+// Unlike set_offsets() it writes nothing but xd, so that the reconstruction
+// stage can run alongside the parse stage.
+static void set_block_offsets(AV1_COMMON *const cm, MACROBLOCKD *const xd,
+                              BLOCK_SIZE bsize, int mi_row, int mi_col, int bw,
+                              int bh) {
   const TileInfo *const tile = &xd->tile;
 
-  xd->mi = cm->mi_grid_visible + offset;
-  xd->mi[0] = &cm->mi[offset];
-  // TODO(slavarnway): Generate sb_type based on bwl and bhl, instead of
-  // passing bsize from decode_partition().
-  xd->mi[0]->mbmi.sb_type = bsize;
-#if CONFIG_RD_DEBUG
-  xd->mi[0]->mbmi.mi_row = mi_row;
-  xd->mi[0]->mbmi.mi_col = mi_col;
-#endif
+  xd->mi = cm->mi_grid_visible + mi_row * cm->mi_stride + mi_col;
 #if CONFIG_CFL
   xd->cfl.mi_row = mi_row;
   xd->cfl.mi_col = mi_col;
 #endif
 
-  assert(x_mis && y_mis);
-  for (int x = 1; x < x_mis; ++x) xd->mi[x] = xd->mi[0];
-  int idx = cm->mi_stride;
-  for (int y = 1; y < y_mis; ++y) {
-    memcpy(&xd->mi[idx], &xd->mi[0], x_mis * sizeof(xd->mi[0]));
-    idx += cm->mi_stride;
-  }
-
   set_plane_n4(xd, bw, bh);
   set_skip_context(xd, mi_row, mi_col);
 
@@ -322,6 +419,32 @@ static void set_offsets(AV1_COMMON *const cm, MACROBLOCKD *const xd,
                        mi_col);
 }
 
+static void set_offsets(AV1_COMMON *const cm, MACROBLOCKD *const xd,
+                        BLOCK_SIZE bsize, int mi_row, int mi_col, int bw,
+                        int bh, int x_mis, int y_mis) {
+  const int offset = mi_row * cm->mi_stride + mi_col;
+  MODE_INFO **const mi = cm->mi_grid_visible + offset;
+
+  mi[0] = &cm->mi[offset];
+  // TODO(slavarnway): Generate sb_type based on bwl and bhl, instead of
+  // passing bsize from decode_partition().
+  mi[0]->mbmi.sb_type = bsize;
+#if CONFIG_RD_DEBUG
+  mi[0]->mbmi.mi_row = mi_row;
+  mi[0]->mbmi.mi_col = mi_col;
+#endif
+
+  assert(x_mis && y_mis);
+  for (int x = 1; x < x_mis; ++x) mi[x] = mi[0];
+  int idx = cm->mi_stride;
+  for (int y = 1; y < y_mis; ++y) {
+    memcpy(&mi[idx], &mi[0], x_mis * sizeof(mi[0]));
+    idx += cm->mi_stride;
+  }
+
+  set_block_offsets(cm, xd, bsize, mi_row, mi_col, bw, bh);
+}
+
 static void decode_mbmi_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
                               int mi_row, int mi_col, aom_reader *r,
 #if CONFIG_EXT_PARTITION_TYPES
@@ -335,7 +458,7 @@ static void decode_mbmi_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
   const int y_mis = AOMMIN(bh, cm->mi_rows - mi_row);
 
 #if CONFIG_ACCOUNTING
-  aom_accounting_set_context(&pbi->accounting, mi_col, mi_row);
+  if (r->accounting) aom_accounting_set_context(r->accounting, mi_col, mi_row);
 #endif
   set_offsets(cm, xd, bsize, mi_row, mi_col, bw, bh, x_mis, y_mis);
 #if CONFIG_EXT_PARTITION_TYPES
@@ -354,23 +477,14 @@ static void decode_mbmi_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
   aom_merge_corrupted_flag(&xd->corrupted, reader_corrupted_flag);
 }
 
-static void decode_token_and_recon_block(AV1Decoder *const pbi,
-                                         MACROBLOCKD *const xd, int mi_row,
-                                         int mi_col, aom_reader *r,
-                                         BLOCK_SIZE bsize) {
+// Parse stage: reads the palette maps and coefficients of a block into the
+// superblock row buffer.
+static void decode_token_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
+                               int mi_row, int mi_col, aom_reader *r,
+                               BLOCK_SIZE bsize) {
   AV1_COMMON *const cm = &pbi->common;
-  const int bw = mi_size_wide[bsize];
-  const int bh = mi_size_high[bsize];
-  const int x_mis = AOMMIN(bw, cm->mi_cols - mi_col);
-  const int y_mis = AOMMIN(bh, cm->mi_rows - mi_row);
-
-  set_offsets(cm, xd, bsize, mi_row, mi_col, bw, bh, x_mis, y_mis);
+  SbDecodeBuffer *const sb_buf = &pbi->sb_rows[pbi->cur_sb_row];
   MB_MODE_INFO *mbmi = &xd->mi[0]->mbmi;
-#if CONFIG_CFL
-  CFL_CTX *const cfl = &xd->cfl;
-  cfl->is_chroma_reference = is_chroma_reference(
-      mi_row, mi_col, bsize, cfl->subsampling_x, cfl->subsampling_y);
-#endif  // CONFIG_CFL
 
   if (cm->delta_q_present_flag) {
     for (int i = 0; i < MAX_SEGMENTS; i++) {
@@ -396,52 +510,49 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
   if (mbmi->skip) av1_reset_skip_context(xd, mi_row, mi_col, bsize);
 
   if (!is_inter_block(mbmi)) {
-    const int num_planes = av1_num_planes(cm);
-    for (int plane = 0; plane < AOMMIN(2, num_planes); ++plane) {
-      if (mbmi->palette_mode_info.palette_size[plane])
+    for (int plane = 0; plane < AOMMIN(2, av1_num_planes(cm)); ++plane) {
+      if (mbmi->palette_mode_info.palette_size[plane]) {
+        set_color_index_map(sb_buf, xd, plane);
         av1_decode_palette_tokens(xd, plane, r);
+      }
     }
+    if (!mbmi->skip)
+      visit_intra_tx_blocks(cm, xd, r, sb_buf, mi_row, mi_col, bsize,
+                            read_coeffs_tx_block);
+  } else if (!mbmi->skip) {
+    visit_inter_tx_blocks(cm, xd, r, sb_buf, mi_row, mi_col, bsize,
+                          read_coeffs_tx_block);
+  }
 
-    const struct macroblockd_plane *const y_pd = &xd->plane[0];
-    const BLOCK_SIZE plane_bsize = get_plane_block_size(bsize, y_pd);
-    int row, col;
-    const int max_blocks_wide = max_block_wide(xd, plane_bsize, 0);
-    const int max_blocks_high = max_block_high(xd, plane_bsize, 0);
-
-    const BLOCK_SIZE max_unit_bsize = get_plane_block_size(BLOCK_64X64, y_pd);
-    int mu_blocks_wide =
-        block_size_wide[max_unit_bsize] >> tx_size_wide_log2[0];
-    int mu_blocks_high =
-        block_size_high[max_unit_bsize] >> tx_size_high_log2[0];
-    mu_blocks_wide = AOMMIN(max_blocks_wide, mu_blocks_wide);
-    mu_blocks_high = AOMMIN(max_blocks_high, mu_blocks_high);
-
-    for (row = 0; row < max_blocks_high; row += mu_blocks_high) {
-      for (col = 0; col < max_blocks_wide; col += mu_blocks_wide) {
-        for (int plane = 0; plane < num_planes; ++plane) {
-          const struct macroblockd_plane *const pd = &xd->plane[plane];
-          if (!is_chroma_reference(mi_row, mi_col, bsize, pd->subsampling_x,
-                                   pd->subsampling_y))
-            continue;
-
-          const TX_SIZE tx_size = av1_get_tx_size(plane, xd);
-          const int stepr = tx_size_high_unit[tx_size];
-          const int stepc = tx_size_wide_unit[tx_size];
-
-          const int unit_height = ROUND_POWER_OF_TWO(
-              AOMMIN(mu_blocks_high + row, max_blocks_high), pd->subsampling_y);
-          const int unit_width = ROUND_POWER_OF_TWO(
-              AOMMIN(mu_blocks_wide + col, max_blocks_wide), pd->subsampling_x);
-
-          for (int blk_row = row >> pd->subsampling_y; blk_row < unit_height;
-               blk_row += stepr)
-            for (int blk_col = col >> pd->subsampling_x; blk_col < unit_width;
-                 blk_col += stepc)
-              predict_and_reconstruct_intra_block(cm, xd, r, mbmi, plane,
-                                                  blk_row, blk_col, tx_size);
-        }
-      }
+  int reader_corrupted_flag = aom_reader_has_error(r);
+  aom_merge_corrupted_flag(&xd->corrupted, reader_corrupted_flag);
+}
+
+// Reconstruction stage: predicts a block and adds the residual parsed into
+// the superblock row buffer.
+static void reconstruct_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
+                              SbDecodeBuffer *sb_buf, int mi_row, int mi_col,
+                              BLOCK_SIZE bsize) {
+  AV1_COMMON *const cm = &pbi->common;
+
+  set_block_offsets(cm, xd, bsize, mi_row, mi_col, mi_size_wide[bsize],
+                    mi_size_high[bsize]);
+  MB_MODE_INFO *mbmi = &xd->mi[0]->mbmi;
+#if CONFIG_CFL
+  CFL_CTX *const cfl = &xd->cfl;
+  cfl->is_chroma_reference = is_chroma_reference(
+      mi_row, mi_col, bsize, cfl->subsampling_x, cfl->subsampling_y);
+  // The parse stage has moved on to other blocks since reading the modes.
+  cfl->store_y = !cfl->is_chroma_reference || mbmi->uv_mode == UV_CFL_PRED;
+#endif  // CONFIG_CFL
+
+  if (!is_inter_block(mbmi)) {
+    for (int plane = 0; plane < AOMMIN(2, av1_num_planes(cm)); ++plane) {
+      if (mbmi->palette_mode_info.palette_size[plane])
+        set_color_index_map(sb_buf, xd, plane);
     }
+    visit_intra_tx_blocks(cm, xd, NULL, sb_buf, mi_row, mi_col, bsize,
+                          predict_and_reconstruct_intra_block);
   } else {
     for (int ref = 0; ref < 1 + has_second_ref(mbmi); ++ref) {
       const MV_REFERENCE_FRAME frame = mbmi->ref_frame[ref];
@@ -485,65 +596,9 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
     }
 #endif
 
-    // Reconstruction
-    if (!mbmi->skip) {
-      int eobtotal = 0;
-
-      const struct macroblockd_plane *const y_pd = &xd->plane[0];
-      const int max_blocks_wide = max_block_wide(xd, bsize, 0);
-      const int max_blocks_high = max_block_high(xd, bsize, 0);
-      int row, col;
-
-      const BLOCK_SIZE max_unit_bsize = get_plane_block_size(BLOCK_64X64, y_pd);
-      int mu_blocks_wide =
-          block_size_wide[max_unit_bsize] >> tx_size_wide_log2[0];
-      int mu_blocks_high =
-          block_size_high[max_unit_bsize] >> tx_size_high_log2[0];
-
-      mu_blocks_wide = AOMMIN(max_blocks_wide, mu_blocks_wide);
-      mu_blocks_high = AOMMIN(max_blocks_high, mu_blocks_high);
-
-      for (row = 0; row < max_blocks_high; row += mu_blocks_high) {
-        for (col = 0; col < max_blocks_wide; col += mu_blocks_wide) {
-          for (int plane = 0; plane < av1_num_planes(cm); ++plane) {
-            const struct macroblockd_plane *const pd = &xd->plane[plane];
-            if (!is_chroma_reference(mi_row, mi_col, bsize, pd->subsampling_x,
-                                     pd->subsampling_y))
-              continue;
-            const BLOCK_SIZE bsizec =
-                scale_chroma_bsize(bsize, pd->subsampling_x, pd->subsampling_y);
-            const BLOCK_SIZE plane_bsize = get_plane_block_size(bsizec, pd);
-
-            TX_SIZE max_tx_size = get_vartx_max_txsize(
-                xd, plane_bsize, pd->subsampling_x || pd->subsampling_y);
-            const int bh_var_tx = tx_size_high_unit[max_tx_size];
-            const int bw_var_tx = tx_size_wide_unit[max_tx_size];
-            int block = 0;
-            int step =
-                tx_size_wide_unit[max_tx_size] * tx_size_high_unit[max_tx_size];
-
-            int blk_row, blk_col;
-            const int unit_height = ROUND_POWER_OF_TWO(
-                AOMMIN(mu_blocks_high + row, max_blocks_high),
-                pd->subsampling_y);
-            const int unit_width = ROUND_POWER_OF_TWO(
-                AOMMIN(mu_blocks_wide + col, max_blocks_wide),
-                pd->subsampling_x);
-
-            for (blk_row = row >> pd->subsampling_y; blk_row < unit_height;
-                 blk_row += bh_var_tx) {
-              for (blk_col = col >> pd->subsampling_x; blk_col < unit_width;
-                   blk_col += bw_var_tx) {
-                decode_reconstruct_tx(cm, xd, r, mbmi, plane, plane_bsize,
-                                      blk_row, blk_col, block, max_tx_size,
-                                      &eobtotal, mi_row, mi_col);
-                block += step;
-              }
-            }
-          }
-        }
-      }
-    }
+    if (!mbmi->skip)
+      visit_inter_tx_blocks(cm, xd, NULL, sb_buf, mi_row, mi_col, bsize,
+                            inverse_transform_tx_block);
   }
 #if CONFIG_CFL
   if (mbmi->uv_mode != UV_CFL_PRED) {
@@ -553,9 +608,6 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
     }
   }
 #endif  // CONFIG_CFL
-
-  int reader_corrupted_flag = aom_reader_has_error(r);
-  aom_merge_corrupted_flag(&xd->corrupted, reader_corrupted_flag);
 }
 
 static void decode_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
@@ -564,13 +616,21 @@ static void decode_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
                          PARTITION_TYPE partition,
 #endif  // CONFIG_EXT_PARTITION_TYPES
                          BLOCK_SIZE bsize) {
+  SbDecodeBuffer *const sb_buf = &pbi->sb_rows[pbi->cur_sb_row];
+
   decode_mbmi_block(pbi, xd, mi_row, mi_col, r,
 #if CONFIG_EXT_PARTITION_TYPES
                     partition,
 #endif
                     bsize);
 
-  decode_token_and_recon_block(pbi, xd, mi_row, mi_col, r, bsize);
+  decode_token_block(pbi, xd, mi_row, mi_col, r, bsize);
+
+  assert(sb_buf->num_blocks < sb_buf->max_blocks);
+  SbBlockInfo *const block = &sb_buf->blocks[sb_buf->num_blocks++];
+  block->mi_row = mi_row;
+  block->mi_col = mi_col;
+  block->bsize = bsize;
 }
 
 static PARTITION_TYPE read_partition(MACROBLOCKD *xd, int mi_row, int mi_col,
@@ -733,6 +793,41 @@ static void decode_partition(AV1Decoder *const pbi, MACROBLOCKD *const xd,
 #endif  // CONFIG_EXT_PARTITION_TYPES
 }
 
+static void reset_sb_buffer_offsets(SbDecodeBuffer *sb_buf) {
+  av1_zero(sb_buf->dqcoeff_offset);
+  av1_zero(sb_buf->eob_offset);
+  av1_zero(sb_buf->color_index_map_offset);
+}
+
+// Reconstructs the blocks of the superblock row recon->sb_row. Errors are
+// caught here and flagged in recon->xd.corrupted; the parse stage raises them
+// once it has synchronized with the reconstruction.
+static int reconstruct_sb_row_worker(SbRowRecon *const recon, void *unused) {
+  SbDecodeBuffer *const sb_buf = recon->sb_row;
+  struct aom_usec_timer timer;
+  (void)unused;
+
+  if (setjmp(recon->error_info.jmp)) {
+    recon->error_info.setjmp = 0;
+    recon->xd.corrupted = 1;
+    return 0;
+  }
+  recon->error_info.setjmp = 1;
+
+  aom_usec_timer_start(&timer);
+  reset_sb_buffer_offsets(sb_buf);
+  for (int i = 0; i < sb_buf->num_blocks; ++i) {
+    const SbBlockInfo *const block = &sb_buf->blocks[i];
+    reconstruct_block(recon->pbi, &recon->xd, sb_buf, block->mi_row,
+                      block->mi_col, block->bsize);
+  }
+  aom_usec_timer_mark(&timer);
+  recon->elapsed += aom_usec_timer_elapsed(&timer);
+
+  recon->error_info.setjmp = 0;
+  return 1;
+}
+
 static void setup_bool_decoder(const uint8_t *data, const uint8_t *data_end,
                                const size_t read_size,
                                struct aom_internal_error_info *error_info,
@@ -1237,7 +1332,7 @@ static void setup_frame_size(AV1_COMMON *cm, struct aom_read_bit_buffer *rb) {
   lock_buffer_pool(pool);
   if (aom_realloc_frame_buffer(
           get_frame_new_buffer(cm), cm->width, cm->height, cm->subsampling_x,
-          cm->subsampling_y, cm->use_highbitdepth, AOM_BORDER_IN_PIXELS,
+          cm->subsampling_y, cm->use_highbitdepth, AOM_DEC_BORDER_IN_PIXELS,
           cm->byte_alignment,
           &pool->frame_bufs[cm->new_fb_idx].raw_frame_buffer, pool->get_fb_cb,
           pool->cb_priv)) {
@@ -1357,7 +1452,7 @@ static void setup_frame_size_with_refs(AV1_COMMON *cm,
   lock_buffer_pool(pool);
   if (aom_realloc_frame_buffer(
           get_frame_new_buffer(cm), cm->width, cm->height, cm->subsampling_x,
-          cm->subsampling_y, cm->use_highbitdepth, AOM_BORDER_IN_PIXELS,
+          cm->subsampling_y, cm->use_highbitdepth, AOM_DEC_BORDER_IN_PIXELS,
           cm->byte_alignment,
           &pool->frame_bufs[cm->new_fb_idx].raw_frame_buffer, pool->get_fb_cb,
           pool->cb_priv)) {
@@ -1912,6 +2007,280 @@ static void dec_setup_across_tile_boundary_info(
 }
 #endif  // CONFIG_LOOPFILTERING_ACROSS_TILES
 
+void av1_free_sb_rows(AV1Decoder *pbi) {
+  for (int i = 0; i < 2; ++i) {
+    SbDecodeBuffer *const sb_row = &pbi->sb_rows[i];
+    for (int plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      aom_free(sb_row->dqcoeff[plane]);
+      aom_free(sb_row->eob_data[plane]);
+    }
+    for (int plane = 0; plane < 2; ++plane)
+      aom_free(sb_row->color_index_map[plane]);
+    aom_free(sb_row->blocks);
+    av1_zero(*sb_row);
+  }
+  aom_free(pbi->sb_recon);
+  pbi->sb_recon = NULL;
+}
+
+// Sizes the superblock row buffers for a superblock row of the frame.
+static void alloc_sb_rows(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  const int sb_cols =
+      ALIGN_POWER_OF_TWO(cm->mi_cols, cm->mib_size_log2) >> cm->mib_size_log2;
+  const int sb_size_log2 = cm->mib_size_log2 + MI_SIZE_LOG2;
+  const int max_blocks = sb_cols * cm->mib_size * cm->mib_size;
+  int plane_size[MAX_MB_PLANE];
+  int fits = max_blocks <= pbi->sb_rows[0].max_blocks;
+
+  for (int plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    const int ss_x = plane ? cm->subsampling_x : 0;
+    const int ss_y = plane ? cm->subsampling_y : 0;
+    plane_size[plane] = sb_cols << (2 * sb_size_log2 - ss_x - ss_y);
+    fits &= plane_size[plane] <= pbi->sb_rows[0].plane_size[plane];
+  }
+
+  if (fits) {
+    if (pbi->sb_rows_dirty) {
+      for (int i = 0; i < 2; ++i) {
+        const SbDecodeBuffer *const sb_row = &pbi->sb_rows[i];
+        for (int plane = 0; plane < MAX_MB_PLANE; ++plane) {
+          memset(sb_row->dqcoeff[plane], 0,
+                 sb_row->plane_size[plane] * sizeof(*sb_row->dqcoeff[plane]));
+        }
+      }
+      pbi->sb_rows_dirty = 0;
+    }
+    return;
+  }
+
+  av1_free_sb_rows(pbi);
+  CHECK_MEM_ERROR(cm, pbi->sb_recon,
+                  aom_memalign(32, sizeof(*pbi->sb_recon)));
+  for (int i = 0; i < 2; ++i) {
+    SbDecodeBuffer *const sb_row = &pbi->sb_rows[i];
+    for (int plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      const int size = plane_size[plane];
+      // The reconstruction stage clears the coefficients it consumes.
+      CHECK_MEM_ERROR(cm, sb_row->dqcoeff[plane],
+                      aom_memalign(32, size * sizeof(*sb_row->dqcoeff[plane])));
+      memset(sb_row->dqcoeff[plane], 0,
+             size * sizeof(*sb_row->dqcoeff[plane]));
+      CHECK_MEM_ERROR(cm, sb_row->eob_data[plane],
+                      aom_malloc((size / (TX_SIZE_W_MIN * TX_SIZE_H_MIN)) *
+                                 sizeof(*sb_row->eob_data[plane])));
+      sb_row->plane_size[plane] = size;
+    }
+    for (int plane = 0; plane < 2; ++plane) {
+      CHECK_MEM_ERROR(cm, sb_row->color_index_map[plane],
+                      aom_malloc(plane_size[plane]));
+    }
+    CHECK_MEM_ERROR(cm, sb_row->blocks,
+                    aom_malloc(max_blocks * sizeof(*sb_row->blocks)));
+    sb_row->max_blocks = max_blocks;
+  }
+  pbi->sb_rows_dirty = 0;
+}
+
+// Parses the superblock rows of a tile and hands each of them over to the
+// reconstruction stage. With several threads the reconstruction runs on the
+// first tile worker, so a row is reconstructed while the next one is parsed.
+static void decode_tile_superblocks(AV1Decoder *pbi, TileData *const td,
+                                    const TileInfo *const tile_info) {
+  AV1_COMMON *const cm = &pbi->common;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  AVxWorker *const worker =
+      pbi->num_tile_workers > 1 ? &pbi->tile_workers[0] : NULL;
+  SbRowRecon *const recon = pbi->sb_recon;
+  struct aom_usec_timer timer;
+
+  recon->pbi = pbi;
+  recon->xd = td->xd;
+  recon->xd.error_info = &recon->error_info;
+  recon->xd.corrupted = 0;
+  recon->elapsed = 0;
+  av1_zero(recon->error_info);
+  if (worker) {
+    worker->hook = (AVxWorkerHook)reconstruct_sb_row_worker;
+    worker->data1 = recon;
+    worker->data2 = NULL;
+  }
+  pbi->cur_sb_row = 0;
+  pbi->sb_rows_dirty = 1;
+
+  for (int mi_row = tile_info->mi_row_start; mi_row < tile_info->mi_row_end;
+       mi_row += cm->mib_size) {
+    SbDecodeBuffer *const sb_row = &pbi->sb_rows[pbi->cur_sb_row];
+
+    aom_usec_timer_start(&timer);
+    av1_zero_left_context(&td->xd);
+    sb_row->num_blocks = 0;
+    reset_sb_buffer_offsets(sb_row);
+
+    for (int mi_col = tile_info->mi_col_start; mi_col < tile_info->mi_col_end;
+         mi_col += cm->mib_size) {
+#if CONFIG_SYMBOLRATE
+      av1_record_superblock(td->xd.counts);
+#endif
+      decode_partition(pbi, &td->xd, mi_row, mi_col, &td->bit_reader,
+                       cm->sb_size);
+    }
+    aom_usec_timer_mark(&timer);
+    pbi->stage_timing.tile_parse += aom_usec_timer_elapsed(&timer);
+    aom_merge_corrupted_flag(&pbi->mb.corrupted, td->xd.corrupted);
+    if (pbi->mb.corrupted)
+      aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
+                         "Failed to decode tile data");
+
+    // The previous row has to be reconstructed before this one, and its
+    // buffer is parsed into next.
+    if (worker) winterface->sync(worker);
+    if (recon->xd.corrupted) break;
+    recon->sb_row = sb_row;
+    if (worker) {
+      winterface->launch(worker);
+      pbi->cur_sb_row ^= 1;
+    } else {
+      reconstruct_sb_row_worker(recon, NULL);
+    }
+  }
+
+  if (worker) winterface->sync(worker);
+  if (recon->xd.corrupted) {
+    aom_internal_error(&cm->error, recon->error_info.error_code, "%s",
+                       recon->error_info.detail);
+  }
+  pbi->stage_timing.tile_recon += recon->elapsed;
+  pbi->sb_rows_dirty = 0;
+}
+
+#if CONFIG_EXT_TILE
+static const uint8_t *get_ls_data_end(AV1Decoder *pbi) {
+  const AV1_COMMON *const cm = &pbi->common;
+
+  if (cm->tile_rows * cm->tile_cols == 1) {
+    // Find the end of the single tile buffer
+    return aom_reader_find_end(&pbi->tile_data->bit_reader);
+  }
+  // Return the end of the last tile buffer
+  return pbi->tile_buffers[cm->tile_rows - 1][cm->tile_cols - 1].raw_data_end;
+}
+
+// Copies the decoded tile at (tile_row, tile_col) of the frame to the cell
+// (out_row, out_col) of the tile list output mosaic.
+static void copy_tile_to_mosaic(const AV1_COMMON *const cm,
+                                const YV12_BUFFER_CONFIG *const src,
+                                YV12_BUFFER_CONFIG *const dst, int tile_row,
+                                int tile_col, int out_row, int out_col) {
+  const int shift = (src->flags & YV12_FLAG_HIGHBITDEPTH) ? 1 : 0;
+
+  for (int plane = 0; plane < av1_num_planes(cm); ++plane) {
+    const int is_uv = plane > 0;
+    const int ss_x = is_uv ? cm->subsampling_x : 0;
+    const int ss_y = is_uv ? cm->subsampling_y : 0;
+    const int tile_w = (cm->tile_width << MI_SIZE_LOG2) >> ss_x;
+    const int tile_h = (cm->tile_height << MI_SIZE_LOG2) >> ss_y;
+    const int x = tile_col * tile_w;
+    const int y = tile_row * tile_h;
+    const int w = AOMMIN(tile_w, src->crop_widths[is_uv] - x);
+    const int h = AOMMIN(tile_h, src->crop_heights[is_uv] - y);
+    const int src_stride = src->strides[is_uv] << shift;
+    const int dst_stride = dst->strides[is_uv] << shift;
+    const uint8_t *src_buf = src->buffers[plane];
+    uint8_t *dst_buf = dst->buffers[plane];
+
+    if (shift) {
+      src_buf = (const uint8_t *)CONVERT_TO_SHORTPTR(src_buf);
+      dst_buf = (uint8_t *)CONVERT_TO_SHORTPTR(dst_buf);
+    }
+    src_buf += y * src_stride + (x << shift);
+    dst_buf += out_row * tile_h * dst_stride + ((out_col * tile_w) << shift);
+    for (int r = 0; r < h; ++r, src_buf += src_stride, dst_buf += dst_stride)
+      memcpy(dst_buf, src_buf, w << shift);
+  }
+}
+
+// Decodes the tiles of pbi->tile_list one after another into the new frame
+// buffer, each one predicted from its external reference in place of
+// LAST_FRAME, and gathers them in pbi->tile_list_outbuf. The tile buffers have
+// all been located beforehand.
+static void decode_tile_list(AV1Decoder *pbi, const uint8_t *data_end) {
+  AV1_COMMON *const cm = &pbi->common;
+  YV12_BUFFER_CONFIG *const cur_buf = get_frame_new_buffer(cm);
+  RefBuffer *const last_ref = &cm->frame_refs[LAST_FRAME - LAST_FRAME];
+  YV12_BUFFER_CONFIG *const last_buf = last_ref->buf;
+  const int out_cols = AOMMIN(AOMMAX(pbi->tile_list_cols, 1),
+                              pbi->tile_list_size);
+  const int out_rows = (pbi->tile_list_size + out_cols - 1) / out_cols;
+
+  if (!cm->single_tile_decoding)
+    aom_internal_error(&cm->error, AOM_CODEC_UNSUP_BITSTREAM,
+                       "Tile list decoding needs single tile decoding");
+
+  if (aom_realloc_frame_buffer(
+          &pbi->tile_list_outbuf,
+          out_cols * (cm->tile_width << MI_SIZE_LOG2),
+          out_rows * (cm->tile_height << MI_SIZE_LOG2), cm->subsampling_x,
+          cm->subsampling_y, cm->use_highbitdepth, 0, cm->byte_alignment,
+          NULL, NULL, NULL))
+    aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                       "Failed to allocate tile list output buffer");
+
+  for (int i = 0; i < pbi->tile_list_size; ++i) {
+    const aom_tile_list_entry_t *const entry = &pbi->tile_list[i];
+    const int tile_row = entry->tile_row;
+    const int tile_col = entry->tile_col;
+    TileData *const td = pbi->tile_data + cm->tile_cols * tile_row + tile_col;
+
+    if (tile_row < 0 || tile_row >= cm->tile_rows || tile_col < 0 ||
+        tile_col >= cm->tile_cols)
+      aom_internal_error(&cm->error, AOM_CODEC_INVALID_PARAM,
+                         "Tile list entry %d is outside the frame", i);
+
+    // Without external references the tiles use the decoder's own ones.
+    if (pbi->num_ext_refs > 0 && last_buf != NULL) {
+      YV12_BUFFER_CONFIG *ext_ref;
+      if (entry->ref_idx < 0 || entry->ref_idx >= pbi->num_ext_refs)
+        aom_internal_error(&cm->error, AOM_CODEC_INVALID_PARAM,
+                           "Tile list entry %d has no external reference", i);
+      ext_ref = &pbi->ext_refs[entry->ref_idx];
+      if (ext_ref->y_crop_width != last_buf->y_crop_width ||
+          ext_ref->y_crop_height != last_buf->y_crop_height ||
+          ((ext_ref->flags ^ last_buf->flags) & YV12_FLAG_HIGHBITDEPTH))
+        aom_internal_error(&cm->error, AOM_CODEC_INVALID_PARAM,
+                           "Incorrect external reference %d", entry->ref_idx);
+      last_ref->buf = ext_ref;
+    }
+
+    td->cm = cm;
+    td->xd = pbi->mb;
+    td->xd.corrupted = 0;
+    td->xd.counts = NULL;
+    av1_tile_init(&td->xd.tile, cm, tile_row, tile_col);
+    setup_bool_decoder(pbi->tile_buffers[tile_row][tile_col].data, data_end,
+                       pbi->tile_buffers[tile_row][tile_col].size, &cm->error,
+                       &td->bit_reader, 0);
+#if CONFIG_ACCOUNTING
+    td->bit_reader.accounting = NULL;
+#endif
+    av1_init_macroblockd(cm, &td->xd, NULL);
+    td->tctx = *cm->fc;
+    td->xd.tile_ctx = &td->tctx;
+
+    av1_zero_above_context(cm, td->xd.tile.mi_col_start,
+                           td->xd.tile.mi_col_end);
+#if CONFIG_LOOP_RESTORATION
+    av1_reset_loop_restoration(&td->xd);
+#endif  // CONFIG_LOOP_RESTORATION
+    decode_tile_superblocks(pbi, td, &td->xd.tile);
+    last_ref->buf = last_buf;
+
+    copy_tile_to_mosaic(cm, cur_buf, &pbi->tile_list_outbuf, tile_row,
+                        tile_col, i / out_cols, i % out_cols);
+  }
+}
+#endif  // CONFIG_EXT_TILE
+
 static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
                                    const uint8_t *data_end, int startTile,
                                    int endTile) {
@@ -1937,6 +2306,7 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
   int inv_row_order;
   int tile_row, tile_col;
   uint8_t allow_update_cdf;
+  struct aom_usec_timer timer;
 
 #if CONFIG_EXT_TILE
   if (cm->large_scale_tile) {
@@ -1992,16 +2362,38 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
     get_tile_buffers(pbi, data, data_end, tile_buffers, startTile, endTile);
 
   if (pbi->tile_data == NULL || n_tiles != pbi->allocated_tiles) {
+#if CONFIG_ACCOUNTING
+    for (int i = 0; i < pbi->allocated_tiles; ++i)
+      aom_accounting_clear(&pbi->tile_data[i].accounting);
+#endif
     aom_free(pbi->tile_data);
+    pbi->allocated_tiles = 0;
     CHECK_MEM_ERROR(cm, pbi->tile_data,
                     aom_memalign(32, n_tiles * (sizeof(*pbi->tile_data))));
     pbi->allocated_tiles = n_tiles;
+#if CONFIG_ACCOUNTING
+    for (int i = 0; i < n_tiles; ++i)
+      aom_accounting_init(&pbi->tile_data[i].accounting);
+#endif
   }
 #if CONFIG_ACCOUNTING
+  int acct_frame = 0;
   if (pbi->acct_enabled) {
     aom_accounting_reset(&pbi->accounting);
+    // Only every acct_interval-th frame is accounted.
+    if (startTile == 0) ++pbi->acct_frame_count;
+    acct_frame = (pbi->acct_frame_count - 1) % pbi->acct_interval == 0;
   }
 #endif
+  alloc_sb_rows(pbi);
+
+#if CONFIG_EXT_TILE
+  if (cm->large_scale_tile && pbi->tile_list_size > 0) {
+    decode_tile_list(pbi, data_end);
+    return get_ls_data_end(pbi);
+  }
+#endif  // CONFIG_EXT_TILE
+
   // Load all tile information into tile_data.
   for (tile_row = tile_rows_start; tile_row < tile_rows_end; ++tile_row) {
     for (tile_col = tile_cols_start; tile_col < tile_cols_end; ++tile_col) {
@@ -2019,24 +2411,23 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
           cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD
               ? &cm->counts
               : NULL;
-      av1_zero(td->dqcoeff);
       av1_tile_init(&td->xd.tile, td->cm, tile_row, tile_col);
       setup_bool_decoder(buf->data, data_end, buf->size, &cm->error,
                          &td->bit_reader, allow_update_cdf);
 #if CONFIG_ACCOUNTING
-      if (pbi->acct_enabled) {
-        td->bit_reader.accounting = &pbi->accounting;
+      // Each tile records its own symbols, they are merged once it is done.
+      if (acct_frame) {
+        aom_accounting_reset(&td->accounting);
+        td->bit_reader.accounting = &td->accounting;
       } else {
         td->bit_reader.accounting = NULL;
       }
 #endif
-      av1_init_macroblockd(cm, &td->xd, td->dqcoeff);
+      av1_init_macroblockd(cm, &td->xd, NULL);
 
       // Initialise the tile context from the frame context
       td->tctx = *cm->fc;
       td->xd.tile_ctx = &td->tctx;
-      td->xd.plane[0].color_index_map = td->color_index_map[0];
-      td->xd.plane[1].color_index_map = td->color_index_map[1];
     }
   }
 
@@ -2056,7 +2447,7 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
         continue;
 
 #if CONFIG_ACCOUNTING
-      if (pbi->acct_enabled) {
+      if (td->bit_reader.accounting) {
         td->bit_reader.accounting->last_tell_frac =
             aom_reader_tell_frac(&td->bit_reader);
       }
@@ -2082,23 +2473,12 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
       dec_setup_across_tile_boundary_info(cm, &tile_info);
 #endif  // CONFIG_LOOPFILTERING_ACROSS_TILES
 
-      for (mi_row = tile_info.mi_row_start; mi_row < tile_info.mi_row_end;
-           mi_row += cm->mib_size) {
-        av1_zero_left_context(&td->xd);
-
-        for (int mi_col = tile_info.mi_col_start; mi_col < tile_info.mi_col_end;
-             mi_col += cm->mib_size) {
-#if CONFIG_SYMBOLRATE
-          av1_record_superblock(td->xd.counts);
+      decode_tile_superblocks(pbi, td, &tile_info);
+      mi_row = tile_info.mi_row_end;
+#if CONFIG_ACCOUNTING
+      if (td->bit_reader.accounting)
+        aom_accounting_merge(&pbi->accounting, td->bit_reader.accounting);
 #endif
-          decode_partition(pbi, &td->xd, mi_row, mi_col, &td->bit_reader,
-                           cm->sb_size);
-        }
-        aom_merge_corrupted_flag(&pbi->mb.corrupted, td->xd.corrupted);
-        if (pbi->mb.corrupted)
-          aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
-                             "Failed to decode tile data");
-      }
     }
 
 #if !CONFIG_OBU
@@ -2115,6 +2495,7 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
   if (!(cm->allow_intrabc && NO_FILTER_FOR_IBC))
 #endif  // CONFIG_INTRABC
   {
+    aom_usec_timer_start(&timer);
     // Loopfilter the whole frame.
     if (endTile == cm->tile_rows * cm->tile_cols - 1)
 #if CONFIG_LOOPFILTER_LEVEL
@@ -2133,19 +2514,14 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
       av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
                             cm->lf.filter_level, 0, 0);
 #endif  // CONFIG_LOOPFILTER_LEVEL
+    aom_usec_timer_mark(&timer);
+    pbi->stage_timing.loop_filter += aom_usec_timer_elapsed(&timer);
   }
   if (cm->frame_parallel_decode)
     av1_frameworker_broadcast(pbi->cur_buf, INT_MAX);
 
 #if CONFIG_EXT_TILE
-  if (cm->large_scale_tile) {
-    if (n_tiles == 1) {
-      // Find the end of the single tile buffer
-      return aom_reader_find_end(&pbi->tile_data->bit_reader);
-    }
-    // Return the end of the last tile buffer
-    return tile_buffers[tile_rows - 1][tile_cols - 1].raw_data_end;
-  }
+  if (cm->large_scale_tile) return get_ls_data_end(pbi);
 #endif  // CONFIG_EXT_TILE
 
   TileData *const td = pbi->tile_data + endTile;
@@ -3232,7 +3608,7 @@ void superres_post_decode(AV1Decoder *pbi) {
   if (av1_superres_unscaled(cm)) return;
 
   lock_buffer_pool(pool);
-  av1_superres_upscale(cm, pool);
+  av1_superres_upscale(cm, pool, pbi->tile_workers, pbi->num_tile_workers);
   unlock_buffer_pool(pool);
 }
 #endif  // CONFIG_HORZONLY_FRAME_SUPERRES
@@ -3259,6 +3635,29 @@ static void dec_setup_frame_boundary_info(AV1_COMMON *const cm) {
   }
 }
 
+// Creates the workers that the frame-level jobs, such as the motion field
+// projection and the superres upscale, are split between. The last worker
+// runs its job on the decoding thread, so it does not get a thread of its own.
+static void init_tile_workers(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  const int num_workers = pbi->max_threads;
+
+  if (num_workers <= 1 || pbi->tile_workers != NULL) return;
+
+  CHECK_MEM_ERROR(cm, pbi->tile_workers,
+                  aom_malloc(num_workers * sizeof(*pbi->tile_workers)));
+  for (int i = 0; i < num_workers; ++i) {
+    AVxWorker *const worker = &pbi->tile_workers[i];
+    winterface->init(worker);
+    if (i < num_workers - 1 && !winterface->reset(worker)) {
+      aom_internal_error(&cm->error, AOM_CODEC_ERROR,
+                         "Tile decoder thread creation failed");
+    }
+    ++pbi->num_tile_workers;
+  }
+}
+
 int av1_decode_frame_headers_and_setup(AV1Decoder *pbi, const uint8_t *data,
                                        const uint8_t *data_end,
                                        const uint8_t **p_data_end) {
@@ -3284,8 +3683,9 @@ int av1_decode_frame_headers_and_setup(AV1Decoder *pbi, const uint8_t *data,
 
 #if CONFIG_EXT_TILE
   // If cm->single_tile_decoding = 0, the independent decoding of a single tile
-  // or a section of a frame is not allowed.
-  if (!cm->single_tile_decoding &&
+  // or a section of a frame is not allowed. A tile list may pick any tile, so
+  // all the tile buffers are located for it.
+  if ((!cm->single_tile_decoding || pbi->tile_list_size > 0) &&
       (pbi->dec_tile_row >= 0 || pbi->dec_tile_col >= 0)) {
     pbi->dec_tile_row = -1;
     pbi->dec_tile_col = -1;
@@ -3329,13 +3729,14 @@ int av1_decode_frame_headers_and_setup(AV1Decoder *pbi, const uint8_t *data,
   }
 
   cm->setup_mi(cm);
+  init_tile_workers(pbi);
 
 #if CONFIG_SEGMENT_PRED_LAST
   cm->current_frame_seg_map = cm->cur_frame->seg_map;
 #endif
 
 #if CONFIG_MFMV
-  av1_setup_motion_field(cm);
+  av1_setup_motion_field(cm, pbi->tile_workers, pbi->num_tile_workers);
 #endif  // CONFIG_MFMV
 
   av1_setup_block_planes(xd, cm->subsampling_x, cm->subsampling_y);
@@ -3411,6 +3812,7 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                     int endTile, int initialize_flag) {
   AV1_COMMON *const cm = &pbi->common;
   MACROBLOCKD *const xd = &pbi->mb;
+  struct aom_usec_timer timer;
 
   if (initialize_flag) setup_frame_info(pbi);
 
@@ -3450,21 +3852,30 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
 #endif  // CONFIG_INTRABC
       !cm->all_lossless &&
       (cm->cdef_bits || cm->cdef_strengths[0] || cm->cdef_uv_strengths[0])) {
+    aom_usec_timer_start(&timer);
     av1_cdef_frame(&pbi->cur_buf->buf, cm, &pbi->mb);
+    aom_usec_timer_mark(&timer);
+    pbi->stage_timing.cdef += aom_usec_timer_elapsed(&timer);
   }
 
 #if CONFIG_HORZONLY_FRAME_SUPERRES
+  aom_usec_timer_start(&timer);
   superres_post_decode(pbi);
+  aom_usec_timer_mark(&timer);
+  pbi->stage_timing.superres += aom_usec_timer_elapsed(&timer);
 #endif  // CONFIG_HORZONLY_FRAME_SUPERRES
 
 #if CONFIG_LOOP_RESTORATION
   if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
       cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
       cm->rst_info[2].frame_restoration_type != RESTORE_NONE) {
+    aom_usec_timer_start(&timer);
 #if CONFIG_STRIPED_LOOP_RESTORATION
     av1_loop_restoration_save_boundary_lines(&pbi->cur_buf->buf, cm, 1);
 #endif
     av1_loop_restoration_filter_frame((YV12_BUFFER_CONFIG *)xd->cur_buf, cm);
+    aom_usec_timer_mark(&timer);
+    pbi->stage_timing.loop_restoration += aom_usec_timer_elapsed(&timer);
   }
 #endif  // CONFIG_LOOP_RESTORATION
 
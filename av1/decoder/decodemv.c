@@ -39,18 +39,18 @@ static PREDICTION_MODE read_intra_mode(aom_reader *r, aom_cdf_prob *cdf) {
   return (PREDICTION_MODE)aom_read_symbol(r, cdf, INTRA_MODES, ACCT_STR);
 }
 
-static void read_cdef(AV1_COMMON *cm, aom_reader *r, MB_MODE_INFO *const mbmi,
-                      int mi_col, int mi_row) {
+static void read_cdef(AV1_COMMON *cm, MACROBLOCKD *const xd, aom_reader *r,
+                      MB_MODE_INFO *const mbmi, int mi_col, int mi_row) {
   if (cm->all_lossless) return;
 
   const int m = ~((1 << (6 - MI_SIZE_LOG2)) - 1);
   if (!(mi_col & (cm->mib_size - 1)) &&
       !(mi_row & (cm->mib_size - 1))) {  // Top left?
 #if CONFIG_EXT_PARTITION
-    cm->cdef_preset[0] = cm->cdef_preset[1] = cm->cdef_preset[2] =
-        cm->cdef_preset[3] = -1;
+    xd->cdef_preset[0] = xd->cdef_preset[1] = xd->cdef_preset[2] =
+        xd->cdef_preset[3] = -1;
 #else
-    cm->cdef_preset = -1;
+    xd->cdef_preset = -1;
 #endif
   }
 // Read CDEF param at first a non-skip coding block
@@ -60,16 +60,16 @@ static void read_cdef(AV1_COMMON *cm, aom_reader *r, MB_MODE_INFO *const mbmi,
                         ? !!(mi_col & mask) + 2 * !!(mi_row & mask)
                         : 0;
   cm->mi_grid_visible[(mi_row & m) * cm->mi_stride + (mi_col & m)]
-      ->mbmi.cdef_strength = cm->cdef_preset[index] =
-      cm->cdef_preset[index] == -1 && !mbmi->skip
+      ->mbmi.cdef_strength = xd->cdef_preset[index] =
+      xd->cdef_preset[index] == -1 && !mbmi->skip
           ? aom_read_literal(r, cm->cdef_bits, ACCT_STR)
-          : cm->cdef_preset[index];
+          : xd->cdef_preset[index];
 #else
   cm->mi_grid_visible[(mi_row & m) * cm->mi_stride + (mi_col & m)]
-      ->mbmi.cdef_strength = cm->cdef_preset =
-      cm->cdef_preset == -1 && !mbmi->skip
+      ->mbmi.cdef_strength = xd->cdef_preset =
+      xd->cdef_preset == -1 && !mbmi->skip
           ? aom_read_literal(r, cm->cdef_bits, ACCT_STR)
-          : cm->cdef_preset;
+          : xd->cdef_preset;
 #endif
 }
 
@@ -1053,7 +1053,7 @@ static void read_intra_frame_mode_info(AV1_COMMON *const cm,
         read_intra_segment_id(cm, xd, mi_row, mi_col, bsize, r, mbmi->skip);
 #endif
 
-  read_cdef(cm, r, mbmi, mi_col, mi_row);
+  read_cdef(cm, xd, r, mbmi, mi_col, mi_row);
 
   if (cm->delta_q_present_flag) {
     xd->current_qindex =
@@ -2181,7 +2181,7 @@ static void read_inter_frame_mode_info(AV1Decoder *const pbi,
   mbmi->segment_id = read_inter_segment_id(cm, xd, mi_row, mi_col, 0, r);
 #endif
 
-  read_cdef(cm, r, mbmi, mi_col, mi_row);
+  read_cdef(cm, xd, r, mbmi, mi_col, mi_row);
 
   if (cm->delta_q_present_flag) {
     xd->current_qindex =
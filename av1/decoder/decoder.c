@@ -116,6 +116,10 @@ AV1Decoder *av1_decoder_create(BufferPool *const pool) {
   cm->bit_depth = AOM_BITS_8;
   cm->dequant_bit_depth = AOM_BITS_8;
 
+  // Reference frames are allocated without extended borders.
+  pbi->mb.mc_buf[0] = (uint8_t *)pbi->mc_buf[0];
+  pbi->mb.mc_buf[1] = (uint8_t *)pbi->mc_buf[1];
+
   cm->alloc_mi = av1_dec_alloc_mi;
   cm->free_mi = av1_dec_free_mi;
   cm->setup_mi = av1_dec_setup_mi;
@@ -130,6 +134,7 @@ AV1Decoder *av1_decoder_create(BufferPool *const pool) {
 #endif  // CONFIG_LOOP_RESTORATION
 #if CONFIG_ACCOUNTING
   pbi->acct_enabled = 1;
+  pbi->acct_interval = 1;
   aom_accounting_init(&pbi->accounting);
 #endif
 
@@ -147,6 +152,10 @@ void av1_decoder_remove(AV1Decoder *pbi) {
 
   aom_get_worker_interface()->end(&pbi->lf_worker);
   aom_free(pbi->lf_worker.data1);
+#if CONFIG_ACCOUNTING
+  for (i = 0; i < pbi->allocated_tiles; ++i)
+    aom_accounting_clear(&pbi->tile_data[i].accounting);
+#endif
   aom_free(pbi->tile_data);
   for (i = 0; i < pbi->num_tile_workers; ++i) {
     AVxWorker *const worker = &pbi->tile_workers[i];
@@ -154,6 +163,7 @@ void av1_decoder_remove(AV1Decoder *pbi) {
   }
   aom_free(pbi->tile_worker_info);
   aom_free(pbi->tile_workers);
+  av1_free_sb_rows(pbi);
 
   if (pbi->num_tile_workers > 0) {
     av1_loop_filter_dealloc(&pbi->lf_row_sync);
@@ -162,6 +172,9 @@ void av1_decoder_remove(AV1Decoder *pbi) {
 #if CONFIG_ACCOUNTING
   aom_accounting_clear(&pbi->accounting);
 #endif
+#if CONFIG_EXT_TILE
+  aom_free_frame_buffer(&pbi->tile_list_outbuf);
+#endif
 
   aom_free(pbi);
 }
@@ -389,6 +402,7 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
 
 #if TXCOEFF_TIMER
   cm->cum_txcoeff_timer += cm->txcoeff_timer;
+  pbi->stage_timing.coeff_read += cm->txcoeff_timer;
   fprintf(stderr,
           "txb coeff block number: %d, frame time: %ld, cum time %ld in us\n",
           cm->txb_count, cm->txcoeff_timer, cm->cum_txcoeff_timer);
@@ -398,16 +412,9 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
 
   swap_frame_buffers(pbi);
 
-#if CONFIG_EXT_TILE
-  // For now, we only extend the frame borders when the whole frame is decoded.
-  // Later, if needed, extend the border for the decoded tile on the frame
-  // border.
-  if (pbi->dec_tile_row == -1 && pbi->dec_tile_col == -1)
-#endif  // CONFIG_EXT_TILE
-    // TODO(debargha): Fix encoder side mv range, so that we can use the
-    // inner border extension. As of now use the larger extension.
-    // aom_extend_frame_inner_borders(cm->frame_to_show);
-    aom_extend_frame_borders(cm->frame_to_show);
+  // The frame borders are not extended: inter prediction rebuilds the edges
+  // of reference blocks that reach outside the frame.
+  ++pbi->stage_timing.frames;
 
   aom_clear_system_state();
 
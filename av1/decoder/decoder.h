@@ -15,12 +15,14 @@
 #include "./aom_config.h"
 
 #include "aom/aom_codec.h"
+#include "aom/aomdx.h"
 #include "aom_dsp/bitreader.h"
 #include "aom_scale/yv12config.h"
 #include "aom_util/aom_thread.h"
 
 #include "av1/common/thread_common.h"
 #include "av1/common/onyxc_int.h"
+#include "av1/common/reconinter.h"
 #include "av1/decoder/dthread.h"
 #if CONFIG_ACCOUNTING
 #include "av1/decoder/accounting.h"
@@ -37,12 +39,53 @@ typedef struct TileData {
   AV1_COMMON *cm;
   aom_reader bit_reader;
   DECLARE_ALIGNED(16, MACROBLOCKD, xd);
-  /* dqcoeff are shared by all the planes. So planes must be decoded serially */
-  DECLARE_ALIGNED(16, tran_low_t, dqcoeff[MAX_TX_SQUARE]);
   DECLARE_ALIGNED(16, FRAME_CONTEXT, tctx);
-  DECLARE_ALIGNED(16, uint8_t, color_index_map[2][MAX_PALETTE_SQUARE]);
+#if CONFIG_ACCOUNTING
+  Accounting accounting;
+#endif
 } TileData;
 
+typedef struct EobInfo {
+  uint16_t eob;
+  int16_t max_scan_line;
+} EobInfo;
+
+typedef struct SbBlockInfo {
+  int mi_row;
+  int mi_col;
+  BLOCK_SIZE bsize;
+} SbBlockInfo;
+
+// Tiles are decoded one superblock row at a time in two stages. The parse
+// stage entropy decodes the modes, coefficients and palette maps of all the
+// blocks of a superblock row, and the reconstruction stage then predicts and
+// inverse transforms them. This buffer carries the coefficients and palette
+// maps from one stage to the other; both stages walk the blocks and transform
+// blocks in the same order and consume it sequentially. The arrays are sized
+// for a superblock row of the frame, see plane_size.
+typedef struct SbDecodeBuffer {
+  tran_low_t *dqcoeff[MAX_MB_PLANE];
+  EobInfo *eob_data[MAX_MB_PLANE];
+  uint8_t *color_index_map[2];
+  SbBlockInfo *blocks;
+  int plane_size[MAX_MB_PLANE];  // Allocated samples of each plane.
+  int max_blocks;
+  int num_blocks;
+  int dqcoeff_offset[MAX_MB_PLANE];
+  int eob_offset[MAX_MB_PLANE];
+  int color_index_map_offset[2];
+} SbDecodeBuffer;
+
+// The reconstruction stage of the tile being decoded. With several threads it
+// runs on the first tile worker, one superblock row behind the parse stage.
+typedef struct SbRowRecon {
+  struct AV1Decoder *pbi;
+  SbDecodeBuffer *sb_row;  // The superblock row to reconstruct.
+  DECLARE_ALIGNED(16, MACROBLOCKD, xd);
+  struct aom_internal_error_info error_info;
+  int64_t elapsed;  // Time spent reconstructing the tile, in microseconds.
+} SbRowRecon;
+
 typedef struct TileBufferDec {
   const uint8_t *data;
   size_t size;
@@ -73,6 +116,17 @@ typedef struct AV1Decoder {
   TileData *tile_data;
   int allocated_tiles;
 
+  // Edge emulation scratch for inter prediction, see MACROBLOCKD::mc_buf.
+  // Tiles are decoded one after another, so they all share it.
+  DECLARE_ALIGNED(16, uint16_t, mc_buf[2][MC_BORDER_BUF_SIZE]);
+
+  // Also shared by the tiles. The parse stage fills one superblock row while
+  // the reconstruction stage consumes the other.
+  SbDecodeBuffer sb_rows[2];
+  int cur_sb_row;     // The row being parsed.
+  int sb_rows_dirty;  // A failed tile may have left coefficients behind.
+  SbRowRecon *sb_recon;
+
   TileBufferDec tile_buffers[MAX_TILE_ROWS][MAX_TILE_COLS];
 
   AV1LfSync lf_row_sync;
@@ -87,9 +141,19 @@ typedef struct AV1Decoder {
 #if CONFIG_EXT_TILE
   int tile_col_size_bytes;
   int dec_tile_row, dec_tile_col;  // always -1 for non-VR tile encoding
-#endif                             // CONFIG_EXT_TILE
+  // Tile list decoding, see AV1D_SET_TILE_LIST. The external references and
+  // the list are owned by the codec interface.
+  YV12_BUFFER_CONFIG *ext_refs;
+  int num_ext_refs;
+  const aom_tile_list_entry_t *tile_list;
+  int tile_list_size;
+  int tile_list_cols;
+  YV12_BUFFER_CONFIG tile_list_outbuf;  // Output mosaic of the tile list.
+#endif                                  // CONFIG_EXT_TILE
 #if CONFIG_ACCOUNTING
   int acct_enabled;
+  int acct_interval;     // Account every acct_interval-th frame only.
+  int acct_frame_count;  // Frames decoded with acct_enabled.
   Accounting accounting;
 #endif
   size_t uncomp_hdr_size;  // Size of the uncompressed header
@@ -100,6 +164,7 @@ typedef struct AV1Decoder {
   aom_inspect_cb inspect_cb;
   void *inspect_ctx;
 #endif
+  aom_dec_stage_timing_t stage_timing;  // Accumulated per-stage decode time
 } AV1Decoder;
 
 int av1_receive_compressed_data(struct AV1Decoder *pbi, size_t size,
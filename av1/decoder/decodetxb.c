@@ -19,7 +19,8 @@
 
 #define ACCT_STR __func__
 
-static int read_golomb(MACROBLOCKD *xd, aom_reader *r, FRAME_COUNTS *counts) {
+static INLINE int read_golomb(MACROBLOCKD *xd, aom_reader *r,
+                              FRAME_COUNTS *counts) {
 #if !CONFIG_SYMBOLRATE
   (void)counts;
 #endif
@@ -53,24 +54,24 @@ static INLINE int rec_eob_pos(const int eob_token, const int extra) {
   return eob;
 }
 
-uint8_t av1_read_coeffs_txb(const AV1_COMMON *const cm, MACROBLOCKD *const xd,
-                            aom_reader *const r, const int blk_row,
-                            const int blk_col, const int plane,
+// Reads the coefficients of one transform block. This is always inlined into
+// av1_read_coeffs_txb() once with the tile's counts and once with a constant
+// NULL, so that the common case, where no FRAME_COUNTS are gathered, compiles
+// to a reader with none of the per-symbol counting branches.
+static AOM_FORCE_INLINE uint8_t read_coeffs_txb(
+    const AV1_COMMON *const cm, MACROBLOCKD *const xd, aom_reader *const r,
+    const int blk_row, const int blk_col, const int plane,
 #if CONFIG_NEW_QUANT
 #if CONFIG_AOM_QM
-                            int dq_profile,
+    int dq_profile,
 #else
-                            dequant_val_type_nuq *dq_val,
+    dequant_val_type_nuq *dq_val,
 #endif  // CONFIG_AOM_QM
 #endif  // CONFIG_NEW_QUANT
-                            const TXB_CTX *const txb_ctx, const TX_SIZE tx_size,
-                            int16_t *const max_scan_line, int *const eob) {
+    const TXB_CTX *const txb_ctx, const TX_SIZE tx_size,
+    int16_t *const max_scan_line, int *const eob,
+    FRAME_COUNTS *const counts) {
   FRAME_CONTEXT *const ec_ctx = xd->tile_ctx;
-#if TXCOEFF_TIMER
-  FRAME_COUNTS *const counts = NULL;
-#else
-  FRAME_COUNTS *const counts = xd->counts;
-#endif
   const int32_t max_value = (1 << (7 + xd->bd)) - 1;
   const int32_t min_value = -(1 << (7 + xd->bd));
   const TX_SIZE txs_ctx = get_txsize_entropy_ctx(tx_size);
@@ -393,6 +394,47 @@ uint8_t av1_read_coeffs_txb(const AV1_COMMON *const cm, MACROBLOCKD *const xd,
   return cul_level;
 }
 
+uint8_t av1_read_coeffs_txb(const AV1_COMMON *const cm, MACROBLOCKD *const xd,
+                            aom_reader *const r, const int blk_row,
+                            const int blk_col, const int plane,
+#if CONFIG_NEW_QUANT
+#if CONFIG_AOM_QM
+                            int dq_profile,
+#else
+                            dequant_val_type_nuq *dq_val,
+#endif  // CONFIG_AOM_QM
+#endif  // CONFIG_NEW_QUANT
+                            const TXB_CTX *const txb_ctx, const TX_SIZE tx_size,
+                            int16_t *const max_scan_line, int *const eob) {
+#if TXCOEFF_TIMER
+  FRAME_COUNTS *const counts = NULL;
+#else
+  FRAME_COUNTS *const counts = xd->counts;
+#endif
+  // xd->counts is fixed for the whole tile, so this branch is always
+  // predicted and selects the same specialization for every block.
+  if (counts) {
+    return read_coeffs_txb(cm, xd, r, blk_row, blk_col, plane,
+#if CONFIG_NEW_QUANT
+#if CONFIG_AOM_QM
+                           dq_profile,
+#else
+                           dq_val,
+#endif  // CONFIG_AOM_QM
+#endif  // CONFIG_NEW_QUANT
+                           txb_ctx, tx_size, max_scan_line, eob, counts);
+  }
+  return read_coeffs_txb(cm, xd, r, blk_row, blk_col, plane,
+#if CONFIG_NEW_QUANT
+#if CONFIG_AOM_QM
+                         dq_profile,
+#else
+                         dq_val,
+#endif  // CONFIG_AOM_QM
+#endif  // CONFIG_NEW_QUANT
+                         txb_ctx, tx_size, max_scan_line, eob, NULL);
+}
+
 uint8_t av1_read_coeffs_txb_facade(const AV1_COMMON *const cm,
                                    MACROBLOCKD *const xd, aom_reader *const r,
                                    const int row, const int col,
@@ -45,6 +45,7 @@
 #if CONFIG_LV_MAP
 #include "av1/encoder/encodetxb.h"
 #endif  // CONFIG_LV_MAP
+#include "av1/encoder/ethread.h"
 #include "av1/encoder/mcomp.h"
 #include "av1/encoder/palette.h"
 #include "av1/encoder/segmentation.h"
@@ -587,12 +588,12 @@ static int neg_interleave(int x, int ref, int max) {
   }
 }
 
-static void write_segment_id(AV1_COMP *cpi, const MB_MODE_INFO *const mbmi,
-                             aom_writer *w, const struct segmentation *seg,
+static void write_segment_id(AV1_COMP *cpi, const MACROBLOCKD *const xd,
+                             const MB_MODE_INFO *const mbmi, aom_writer *w,
+                             const struct segmentation *seg,
                              struct segmentation_probs *segp, int mi_row,
                              int mi_col, int skip) {
   AV1_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
   int prev_ul = -1; /* Top left segment_id */
   int prev_l = -1;  /* Current left segment_id */
   int prev_u = -1;  /* Current top segment_id */
@@ -807,9 +808,10 @@ static void write_intra_angle_info(const MACROBLOCKD *xd,
   }
 }
 
-static void write_mb_interp_filter(AV1_COMP *cpi, const MACROBLOCKD *xd,
+static void write_mb_interp_filter(AV1_COMP *cpi, ThreadData *const td,
                                    aom_writer *w) {
   AV1_COMMON *const cm = &cpi->common;
+  const MACROBLOCKD *const xd = &td->mb.e_mbd;
   const MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
   FRAME_CONTEXT *ec_ctx = xd->tile_ctx;
 
@@ -831,7 +833,7 @@ static void write_mb_interp_filter(AV1_COMP *cpi, const MACROBLOCKD *xd,
             av1_extract_interp_filter(mbmi->interp_filters, dir);
         aom_write_symbol(w, filter, ec_ctx->switchable_interp_cdf[ctx],
                          SWITCHABLE_FILTERS);
-        ++cpi->interp_filter_selected[0][filter];
+        ++td->interp_filter_selected[filter];
       } else {
         assert(av1_extract_interp_filter(mbmi->interp_filters, dir) ==
                EIGHTTAP_REGULAR);
@@ -843,7 +845,7 @@ static void write_mb_interp_filter(AV1_COMP *cpi, const MACROBLOCKD *xd,
       InterpFilter filter = av1_extract_interp_filter(mbmi->interp_filters, 0);
       aom_write_symbol(w, filter, ec_ctx->switchable_interp_cdf[ctx],
                        SWITCHABLE_FILTERS);
-      ++cpi->interp_filter_selected[0][filter];
+      ++td->interp_filter_selected[filter];
     }
 #endif  // CONFIG_DUAL_FILTER
   }
@@ -1112,8 +1114,8 @@ static void write_cfl_alphas(FRAME_CONTEXT *const ec_ctx, int idx,
 }
 #endif
 
-static void write_cdef(AV1_COMMON *cm, aom_writer *w, int skip, int mi_col,
-                       int mi_row) {
+static void write_cdef(AV1_COMMON *cm, MACROBLOCKD *const xd, aom_writer *w,
+                       int skip, int mi_col, int mi_row) {
   if (cm->all_lossless) return;
 
   const int m = ~((1 << (6 - MI_SIZE_LOG2)) - 1);
@@ -1123,10 +1125,10 @@ static void write_cdef(AV1_COMMON *cm, aom_writer *w, int skip, int mi_col,
   if (!(mi_row & (cm->mib_size - 1)) &&
       !(mi_col & (cm->mib_size - 1))) {  // Top left?
 #if CONFIG_EXT_PARTITION
-    cm->cdef_preset[0] = cm->cdef_preset[1] = cm->cdef_preset[2] =
-        cm->cdef_preset[3] = -1;
+    xd->cdef_preset[0] = xd->cdef_preset[1] = xd->cdef_preset[2] =
+        xd->cdef_preset[3] = -1;
 #else
-    cm->cdef_preset = -1;
+    xd->cdef_preset = -1;
 #endif
   }
 
@@ -1136,24 +1138,24 @@ static void write_cdef(AV1_COMMON *cm, aom_writer *w, int skip, int mi_col,
   const int index = cm->sb_size == BLOCK_128X128
                         ? !!(mi_col & mask) + 2 * !!(mi_row & mask)
                         : 0;
-  if (cm->cdef_preset[index] == -1 && !skip) {
+  if (xd->cdef_preset[index] == -1 && !skip) {
     aom_write_literal(w, mbmi->cdef_strength, cm->cdef_bits);
-    cm->cdef_preset[index] = mbmi->cdef_strength;
+    xd->cdef_preset[index] = mbmi->cdef_strength;
   }
 #else
-  if (cm->cdef_preset == -1 && !skip) {
+  if (xd->cdef_preset == -1 && !skip) {
     aom_write_literal(w, mbmi->cdef_strength, cm->cdef_bits);
-    cm->cdef_preset = mbmi->cdef_strength;
+    xd->cdef_preset = mbmi->cdef_strength;
   }
 #endif
 }
 
-static void write_inter_segment_id(AV1_COMP *cpi, aom_writer *w,
+static void write_inter_segment_id(AV1_COMP *cpi, const MACROBLOCKD *const xd,
+                                   aom_writer *w,
                                    const struct segmentation *const seg,
                                    struct segmentation_probs *const segp,
                                    int mi_row, int mi_col, int skip,
                                    int preskip) {
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
   const MODE_INFO *mi = xd->mi[0];
   const MB_MODE_INFO *const mbmi = &mi->mbmi;
 #if CONFIG_SPATIAL_SEGMENTATION
@@ -1172,7 +1174,7 @@ static void write_inter_segment_id(AV1_COMP *cpi, aom_writer *w,
     } else {
       if (cm->preskip_segid) return;
       if (skip) {
-        write_segment_id(cpi, mbmi, w, seg, segp, mi_row, mi_col, 1);
+        write_segment_id(cpi, xd, mbmi, w, seg, segp, mi_row, mi_col, 1);
         if (seg->temporal_update) ((MB_MODE_INFO *)mbmi)->seg_id_predicted = 0;
         return;
       }
@@ -1184,7 +1186,7 @@ static void write_inter_segment_id(AV1_COMP *cpi, aom_writer *w,
       aom_write_symbol(w, pred_flag, pred_cdf, 2);
       if (!pred_flag) {
 #if CONFIG_SPATIAL_SEGMENTATION
-        write_segment_id(cpi, mbmi, w, seg, segp, mi_row, mi_col, 0);
+        write_segment_id(cpi, xd, mbmi, w, seg, segp, mi_row, mi_col, 0);
 #else
         write_segment_id(w, seg, segp, mbmi->segment_id);
 #endif
@@ -1197,7 +1199,7 @@ static void write_inter_segment_id(AV1_COMP *cpi, aom_writer *w,
 #endif
     } else {
 #if CONFIG_SPATIAL_SEGMENTATION
-      write_segment_id(cpi, mbmi, w, seg, segp, mi_row, mi_col, 0);
+      write_segment_id(cpi, xd, mbmi, w, seg, segp, mi_row, mi_col, 0);
 #else
       write_segment_id(w, seg, segp, mbmi->segment_id);
 #endif
@@ -1205,10 +1207,11 @@ static void write_inter_segment_id(AV1_COMP *cpi, aom_writer *w,
   }
 }
 
-static void pack_inter_mode_mvs(AV1_COMP *cpi, const int mi_row,
-                                const int mi_col, aom_writer *w) {
+static void pack_inter_mode_mvs(AV1_COMP *cpi, ThreadData *const td,
+                                const int mi_row, const int mi_col,
+                                aom_writer *w) {
   AV1_COMMON *const cm = &cpi->common;
-  MACROBLOCK *const x = &cpi->td.mb;
+  MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   FRAME_CONTEXT *ec_ctx = xd->tile_ctx;
   const MODE_INFO *mi = xd->mi[0];
@@ -1227,7 +1230,7 @@ static void pack_inter_mode_mvs(AV1_COMP *cpi, const int mi_row,
   (void)mi_row;
   (void)mi_col;
 
-  write_inter_segment_id(cpi, w, seg, segp, mi_row, mi_col, 0, 1);
+  write_inter_segment_id(cpi, xd, w, seg, segp, mi_row, mi_col, 0, 1);
 
 #if CONFIG_EXT_SKIP
   write_skip_mode(cm, xd, segment_id, mi, w);
@@ -1243,10 +1246,10 @@ static void pack_inter_mode_mvs(AV1_COMP *cpi, const int mi_row,
 #endif  // CONFIG_EXT_SKIP
 
 #if CONFIG_SPATIAL_SEGMENTATION
-  write_inter_segment_id(cpi, w, seg, segp, mi_row, mi_col, skip, 0);
+  write_inter_segment_id(cpi, xd, w, seg, segp, mi_row, mi_col, skip, 0);
 #endif
 
-  write_cdef(cm, w, skip, mi_col, mi_row);
+  write_cdef(cm, xd, w, skip, mi_col, mi_row);
 
   if (cm->delta_q_present_flag) {
     int super_block_upper_left = ((mi_row & (cm->mib_size - 1)) == 0) &&
@@ -1485,7 +1488,7 @@ static void pack_inter_mode_mvs(AV1_COMP *cpi, const int mi_row,
     }
 #endif  // CONFIG_JNT_COMP
 
-    write_mb_interp_filter(cpi, xd, w);
+    write_mb_interp_filter(cpi, td, w);
   }
 
 #if !CONFIG_TXK_SEL
@@ -1549,7 +1552,7 @@ static void write_mb_modes_kf(AV1_COMP *cpi, MACROBLOCKD *xd,
 
 #if CONFIG_SPATIAL_SEGMENTATION
   if (cm->preskip_segid && seg->update_map)
-    write_segment_id(cpi, mbmi, w, seg, segp, mi_row, mi_col, 0);
+    write_segment_id(cpi, xd, mbmi, w, seg, segp, mi_row, mi_col, 0);
 #else
   if (seg->update_map) write_segment_id(w, seg, segp, mbmi->segment_id);
 #endif
@@ -1558,10 +1561,10 @@ static void write_mb_modes_kf(AV1_COMP *cpi, MACROBLOCKD *xd,
 
 #if CONFIG_SPATIAL_SEGMENTATION
   if (!cm->preskip_segid && seg->update_map)
-    write_segment_id(cpi, mbmi, w, seg, segp, mi_row, mi_col, skip);
+    write_segment_id(cpi, xd, mbmi, w, seg, segp, mi_row, mi_col, skip);
 #endif
 
-  write_cdef(cm, w, skip, mi_col, mi_row);
+  write_cdef(cm, xd, w, skip, mi_col, mi_row);
 
   if (cm->delta_q_present_flag) {
     int super_block_upper_left = ((mi_row & (cm->mib_size - 1)) == 0) &&
@@ -1683,9 +1686,10 @@ static int rd_token_stats_mismatch(RD_STATS *rd_stats, TOKEN_STATS *token_stats,
 #endif
 
 #if ENC_MISMATCH_DEBUG
-static void enc_dump_logs(AV1_COMP *cpi, int mi_row, int mi_col) {
+static void enc_dump_logs(AV1_COMP *cpi, ThreadData *const td, int mi_row,
+                          int mi_col) {
   AV1_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  MACROBLOCKD *const xd = &td->mb.e_mbd;
   MODE_INFO *m;
   xd->mi = cm->mi_grid_visible + (mi_row * cm->mi_stride + mi_col);
   m = xd->mi[0];
@@ -1706,7 +1710,7 @@ static void enc_dump_logs(AV1_COMP *cpi, int mi_row, int mi_col) {
         mv[1].as_int = 0;
       }
 
-      MACROBLOCK *const x = &cpi->td.mb;
+      MACROBLOCK *const x = &td->mb;
       const MB_MODE_INFO_EXT *const mbmi_ext = x->mbmi_ext;
       const int16_t mode_ctx =
           is_comp_ref ? mbmi_ext->compound_mode_context[mbmi->ref_frame[0]]
@@ -1760,10 +1764,11 @@ static void enc_dump_logs(AV1_COMP *cpi, int mi_row, int mi_col) {
 }
 #endif  // ENC_MISMATCH_DEBUG
 
-static void write_mbmi_b(AV1_COMP *cpi, const TileInfo *const tile,
-                         aom_writer *w, int mi_row, int mi_col) {
+static void write_mbmi_b(AV1_COMP *cpi, ThreadData *const td,
+                         const TileInfo *const tile, aom_writer *w, int mi_row,
+                         int mi_col) {
   AV1_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  MACROBLOCKD *const xd = &td->mb.e_mbd;
   MODE_INFO *m;
   int bh, bw;
   xd->mi = cm->mi_grid_visible + (mi_row * cm->mi_stride + mi_col);
@@ -1775,7 +1780,7 @@ static void write_mbmi_b(AV1_COMP *cpi, const TileInfo *const tile,
   bh = mi_size_high[m->mbmi.sb_type];
   bw = mi_size_wide[m->mbmi.sb_type];
 
-  cpi->td.mb.mbmi_ext = cpi->mbmi_ext_base + (mi_row * cm->mi_cols + mi_col);
+  td->mb.mbmi_ext = cpi->mbmi_ext_base + (mi_row * cm->mi_cols + mi_col);
 
   set_mi_row_col(xd, tile, mi_row, bh, mi_col, bw,
 #if CONFIG_DEPENDENT_HORZTILES
@@ -1794,7 +1799,7 @@ static void write_mbmi_b(AV1_COMP *cpi, const TileInfo *const tile,
 #endif  // CONFIG_INTRABC
     write_mb_modes_kf(cpi, xd,
 #if CONFIG_INTRABC
-                      cpi->td.mb.mbmi_ext,
+                      td->mb.mbmi_ext,
 #endif  // CONFIG_INTRABC
                       mi_row, mi_col, w);
   } else {
@@ -1808,10 +1813,10 @@ static void write_mbmi_b(AV1_COMP *cpi, const TileInfo *const tile,
     set_ref_ptrs(cm, xd, m->mbmi.ref_frame[0], m->mbmi.ref_frame[1]);
 
 #if ENC_MISMATCH_DEBUG
-    enc_dump_logs(cpi, mi_row, mi_col);
+    enc_dump_logs(cpi, td, mi_row, mi_col);
 #endif  // ENC_MISMATCH_DEBUG
 
-    pack_inter_mode_mvs(cpi, mi_row, mi_col, w);
+    pack_inter_mode_mvs(cpi, td, mi_row, mi_col, w);
   }
 }
 
@@ -1864,18 +1869,19 @@ static void write_inter_txb_coeff(AV1_COMMON *const cm, MACROBLOCK *const x,
   }
 }
 
-static void write_tokens_b(AV1_COMP *cpi, const TileInfo *const tile,
-                           aom_writer *w, const TOKENEXTRA **tok,
+static void write_tokens_b(AV1_COMP *cpi, ThreadData *const td,
+                           const TileInfo *const tile, aom_writer *w,
+                           const TOKENEXTRA **tok,
                            const TOKENEXTRA *const tok_end, int mi_row,
                            int mi_col) {
   AV1_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  MACROBLOCKD *const xd = &td->mb.e_mbd;
   const int mi_offset = mi_row * cm->mi_stride + mi_col;
   MODE_INFO *const m = *(cm->mi_grid_visible + mi_offset);
   MB_MODE_INFO *const mbmi = &m->mbmi;
   int plane;
   int bh, bw;
-  MACROBLOCK *const x = &cpi->td.mb;
+  MACROBLOCK *const x = &td->mb;
 #if CONFIG_LV_MAP
   (void)tok;
   (void)tok_end;
@@ -1887,7 +1893,7 @@ static void write_tokens_b(AV1_COMP *cpi, const TileInfo *const tile,
 
   bh = mi_size_high[mbmi->sb_type];
   bw = mi_size_wide[mbmi->sb_type];
-  cpi->td.mb.mbmi_ext = cpi->mbmi_ext_base + (mi_row * cm->mi_cols + mi_col);
+  td->mb.mbmi_ext = cpi->mbmi_ext_base + (mi_row * cm->mi_cols + mi_col);
 
   set_mi_row_col(xd, tile, mi_row, bh, mi_col, bw,
 #if CONFIG_DEPENDENT_HORZTILES
@@ -1974,13 +1980,14 @@ static void write_tokens_b(AV1_COMP *cpi, const TileInfo *const tile,
   }
 }
 
-static void write_modes_b(AV1_COMP *cpi, const TileInfo *const tile,
-                          aom_writer *w, const TOKENEXTRA **tok,
+static void write_modes_b(AV1_COMP *cpi, ThreadData *const td,
+                          const TileInfo *const tile, aom_writer *w,
+                          const TOKENEXTRA **tok,
                           const TOKENEXTRA *const tok_end, int mi_row,
                           int mi_col) {
-  write_mbmi_b(cpi, tile, w, mi_row, mi_col);
+  write_mbmi_b(cpi, td, tile, w, mi_row, mi_col);
 
-  write_tokens_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+  write_tokens_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col);
 }
 
 static void write_partition(const AV1_COMMON *const cm,
@@ -2020,12 +2027,13 @@ static void write_partition(const AV1_COMMON *const cm,
   }
 }
 
-static void write_modes_sb(AV1_COMP *const cpi, const TileInfo *const tile,
-                           aom_writer *const w, const TOKENEXTRA **tok,
+static void write_modes_sb(AV1_COMP *const cpi, ThreadData *const td,
+                           const TileInfo *const tile, aom_writer *const w,
+                           const TOKENEXTRA **tok,
                            const TOKENEXTRA *const tok_end, int mi_row,
                            int mi_col, BLOCK_SIZE bsize) {
   const AV1_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  MACROBLOCKD *const xd = &td->mb.e_mbd;
   const int hbs = mi_size_wide[bsize] / 2;
 #if CONFIG_EXT_PARTITION_TYPES
   const int quarter_step = mi_size_wide[bsize] / 4;
@@ -2058,52 +2066,54 @@ static void write_modes_sb(AV1_COMP *const cpi, const TileInfo *const tile,
   write_partition(cm, xd, hbs, mi_row, mi_col, partition, bsize, w);
   switch (partition) {
     case PARTITION_NONE:
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col);
       break;
     case PARTITION_HORZ:
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col);
       if (mi_row + hbs < cm->mi_rows)
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row + hbs, mi_col);
+        write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row + hbs, mi_col);
       break;
     case PARTITION_VERT:
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col);
       if (mi_col + hbs < cm->mi_cols)
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col + hbs);
+        write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col + hbs);
       break;
     case PARTITION_SPLIT:
-      write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col, subsize);
-      write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col + hbs, subsize);
-      write_modes_sb(cpi, tile, w, tok, tok_end, mi_row + hbs, mi_col, subsize);
-      write_modes_sb(cpi, tile, w, tok, tok_end, mi_row + hbs, mi_col + hbs,
+      write_modes_sb(cpi, td, tile, w, tok, tok_end, mi_row, mi_col, subsize);
+      write_modes_sb(cpi, td, tile, w, tok, tok_end, mi_row, mi_col + hbs,
+                     subsize);
+      write_modes_sb(cpi, td, tile, w, tok, tok_end, mi_row + hbs, mi_col,
+                     subsize);
+      write_modes_sb(cpi, td, tile, w, tok, tok_end, mi_row + hbs, mi_col + hbs,
                      subsize);
       break;
 #if CONFIG_EXT_PARTITION_TYPES
     case PARTITION_HORZ_A:
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col + hbs);
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row + hbs, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col + hbs);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row + hbs, mi_col);
       break;
     case PARTITION_HORZ_B:
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row + hbs, mi_col);
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row + hbs, mi_col + hbs);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row + hbs, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row + hbs, mi_col + hbs);
       break;
     case PARTITION_VERT_A:
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row + hbs, mi_col);
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col + hbs);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row + hbs, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col + hbs);
       break;
     case PARTITION_VERT_B:
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col + hbs);
-      write_modes_b(cpi, tile, w, tok, tok_end, mi_row + hbs, mi_col + hbs);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, mi_col + hbs);
+      write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row + hbs, mi_col + hbs);
       break;
     case PARTITION_HORZ_4:
       for (i = 0; i < 4; ++i) {
         int this_mi_row = mi_row + i * quarter_step;
         if (i > 0 && this_mi_row >= cm->mi_rows) break;
 
-        write_modes_b(cpi, tile, w, tok, tok_end, this_mi_row, mi_col);
+        write_modes_b(cpi, td, tile, w, tok, tok_end, this_mi_row, mi_col);
       }
       break;
     case PARTITION_VERT_4:
@@ -2111,7 +2121,7 @@ static void write_modes_sb(AV1_COMP *const cpi, const TileInfo *const tile,
         int this_mi_col = mi_col + i * quarter_step;
         if (i > 0 && this_mi_col >= cm->mi_cols) break;
 
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, this_mi_col);
+        write_modes_b(cpi, td, tile, w, tok, tok_end, mi_row, this_mi_col);
       }
       break;
 #endif  // CONFIG_EXT_PARTITION_TYPES
@@ -2128,11 +2138,12 @@ static void write_modes_sb(AV1_COMP *const cpi, const TileInfo *const tile,
 #endif  // CONFIG_EXT_PARTITION_TYPES
 }
 
-static void write_modes(AV1_COMP *const cpi, const TileInfo *const tile,
-                        aom_writer *const w, const TOKENEXTRA **tok,
+static void write_modes(AV1_COMP *const cpi, ThreadData *const td,
+                        const TileInfo *const tile, aom_writer *const w,
+                        const TOKENEXTRA **tok,
                         const TOKENEXTRA *const tok_end) {
   AV1_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  MACROBLOCKD *const xd = &td->mb.e_mbd;
   const int mi_row_start = tile->mi_row_start;
   const int mi_row_end = tile->mi_row_end;
   const int mi_col_start = tile->mi_col_start;
@@ -2164,7 +2175,8 @@ static void write_modes(AV1_COMP *const cpi, const TileInfo *const tile,
     av1_zero_left_context(xd);
 
     for (mi_col = mi_col_start; mi_col < mi_col_end; mi_col += cm->mib_size) {
-      write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col, cm->sb_size);
+      write_modes_sb(cpi, td, tile, w, tok, tok_end, mi_row, mi_col,
+                     cm->sb_size);
     }
   }
 }
@@ -2796,6 +2808,14 @@ static INLINE int find_identical_tile(
 }
 #endif  // CONFIG_EXT_TILE
 
+static void accumulate_interp_filter_selected(AV1_COMP *const cpi,
+                                              ThreadData *const td) {
+  for (int i = 0; i < SWITCHABLE; ++i) {
+    cpi->interp_filter_selected[0][i] += td->interp_filter_selected[i];
+    td->interp_filter_selected[i] = 0;
+  }
+}
+
 #if !CONFIG_OBU
 static uint32_t write_tiles(AV1_COMP *const cpi, uint8_t *const dst,
                             unsigned int *max_tile_size,
@@ -2876,7 +2896,7 @@ static uint32_t write_tiles(AV1_COMP *const cpi, uint8_t *const dst,
 #endif  // CONFIG_LOOP_RESTORATION
 
         aom_start_encode(&mode_bc, buf->data + data_offset);
-        write_modes(cpi, &tile_info, &mode_bc, &tok, tok_end);
+        write_modes(cpi, &cpi->td, &tile_info, &mode_bc, &tok, tok_end);
         assert(tok == tok_end);
         aom_stop_encode(&mode_bc);
         tile_size = mode_bc.pos;
@@ -3033,7 +3053,7 @@ static uint32_t write_tiles(AV1_COMP *const cpi, uint8_t *const dst,
 #endif  // CONFIG_LOOP_RESTORATION
 
         aom_start_encode(&mode_bc, dst + total_size);
-        write_modes(cpi, &tile_info, &mode_bc, &tok, tok_end);
+        write_modes(cpi, &cpi->td, &tile_info, &mode_bc, &tok, tok_end);
 #if !CONFIG_LV_MAP
         assert(tok == tok_end);
 #endif  // !CONFIG_LV_MAP
@@ -3076,6 +3096,7 @@ static uint32_t write_tiles(AV1_COMP *const cpi, uint8_t *const dst,
 #if CONFIG_EXT_TILE
   }
 #endif  // CONFIG_EXT_TILE
+  accumulate_interp_filter_selected(cpi, &cpi->td);
   return (uint32_t)total_size;
 }
 #endif
@@ -4394,6 +4415,85 @@ static uint32_t write_tile_group_header(uint8_t *const dst, int startTile,
   return size;
 }
 
+// Codes the modes and coefficients of one tile into the writer in its
+// TileDataEnc. The writer is left open, since where the payload goes in the
+// output depends on the sizes of the tiles before it.
+static void write_tile_payload(AV1_COMP *const cpi, ThreadData *const td,
+                               int tile_row, int tile_col) {
+  AV1_COMMON *const cm = &cpi->common;
+  TileDataEnc *const this_tile =
+      &cpi->tile_data[tile_row * cm->tile_cols + tile_col];
+  aom_writer *const mode_bc = &this_tile->mode_bc;
+  const TOKENEXTRA *tok = cpi->tile_tok[tile_row][tile_col];
+  const TOKENEXTRA *const tok_end = tok + cpi->tok_count[tile_row][tile_col];
+  TileInfo tile_info;
+
+  av1_tile_set_row(&tile_info, cm, tile_row);
+  av1_tile_set_col(&tile_info, cm, tile_col);
+#if CONFIG_DEPENDENT_HORZTILES
+  av1_tile_set_tg_boundary(&tile_info, cm, tile_row, tile_col);
+#endif
+
+  // Initialise tile context from the frame context
+  this_tile->tctx = *cm->fc;
+  td->mb.e_mbd.tile_ctx = &this_tile->tctx;
+#if CONFIG_LOOP_RESTORATION
+  av1_reset_loop_restoration(&td->mb.e_mbd);
+#endif  // CONFIG_LOOP_RESTORATION
+
+  aom_start_encode(mode_bc, NULL);
+  mode_bc->allow_update_cdf = 1;
+  write_modes(cpi, td, &tile_info, mode_bc, &tok, tok_end);
+#if !CONFIG_LV_MAP
+  assert(tok == tok_end);
+#endif  // !CONFIG_LV_MAP
+}
+
+static int write_tile_payloads_worker(EncWorkerData *const thread_data,
+                                      void *data2) {
+  AV1_COMP *const cpi = thread_data->cpi;
+  const AV1_COMMON *const cm = &cpi->common;
+  const int num_workers = *(const int *)data2;
+  int tile_row, tile_col;
+
+  // Each worker owns whole tile columns, so the tiles sharing a stretch of
+  // the above context arrays in cm are always coded in order by one worker.
+  for (tile_col = thread_data->start; tile_col < cm->tile_cols;
+       tile_col += num_workers) {
+    for (tile_row = 0; tile_row < cm->tile_rows; ++tile_row)
+      write_tile_payload(cpi, thread_data->td, tile_row, tile_col);
+  }
+  return 1;
+}
+
+// Codes the payloads of all tiles, spreading the tile columns over the encoder
+// workers when the frame was set up for multithreading.
+static void write_tile_payloads(AV1_COMP *const cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  int num_workers = AOMMIN(cpi->oxcf.max_threads, cm->tile_cols);
+  int tile_row, tile_col, i;
+
+  if (cpi->num_workers > 0) num_workers = AOMMIN(num_workers, cpi->num_workers);
+#if CONFIG_BITSTREAM_DEBUG
+  // The symbol queue used for debugging must be filled in bitstream order.
+  num_workers = 1;
+#endif  // CONFIG_BITSTREAM_DEBUG
+
+  if (num_workers > 1) {
+    av1_run_tile_workers(cpi, num_workers,
+                         (AVxWorkerHook)write_tile_payloads_worker,
+                         &num_workers);
+    for (i = 0; i < num_workers; ++i)
+      accumulate_interp_filter_selected(cpi, cpi->tile_thr_data[i].td);
+  } else {
+    for (tile_row = 0; tile_row < cm->tile_rows; ++tile_row) {
+      for (tile_col = 0; tile_col < cm->tile_cols; ++tile_col)
+        write_tile_payload(cpi, &cpi->td, tile_row, tile_col);
+    }
+    accumulate_interp_filter_selected(cpi, &cpi->td);
+  }
+}
+
 static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
                                        unsigned int *max_tile_size,
                                        unsigned int *max_tile_col_size,
@@ -4404,9 +4504,7 @@ static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
 #endif
                                        int insert_frame_header_obu_flag) {
   AV1_COMMON *const cm = &cpi->common;
-  aom_writer mode_bc;
   int tile_row, tile_col;
-  TOKENEXTRA *(*const tok_buffers)[MAX_TILE_COLS] = cpi->tile_tok;
   TileBufferEnc(*const tile_buffers)[MAX_TILE_COLS] = cpi->tile_buffers;
   uint32_t total_size = 0;
   const int tile_cols = cm->tile_cols;
@@ -4436,6 +4534,8 @@ static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
 
 #if CONFIG_EXT_TILE
   if (cm->large_scale_tile) {
+    aom_writer mode_bc;
+    TOKENEXTRA *(*const tok_buffers)[MAX_TILE_COLS] = cpi->tile_tok;
     uint32_t tg_hdr_size =
         write_obu_header(OBU_TILE_GROUP, 0, data + PRE_OBU_SIZE_BYTES);
     tg_hdr_size += PRE_OBU_SIZE_BYTES;
@@ -4473,7 +4573,7 @@ static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
         cpi->td.mb.e_mbd.tile_ctx = &this_tile->tctx;
         mode_bc.allow_update_cdf = !cm->large_scale_tile;
         aom_start_encode(&mode_bc, buf->data + data_offset);
-        write_modes(cpi, &tile_info, &mode_bc, &tok, tok_end);
+        write_modes(cpi, &cpi->td, &tile_info, &mode_bc, &tok, tok_end);
         assert(tok == tok_end);
         aom_stop_encode(&mode_bc);
         tile_size = mode_bc.pos;
@@ -4541,17 +4641,15 @@ static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
   } else {
 #endif  // CONFIG_EXT_TILE
 
+    write_tile_payloads(cpi);
+
     for (tile_row = 0; tile_row < tile_rows; tile_row++) {
-      TileInfo tile_info;
       const int is_last_row = (tile_row == tile_rows - 1);
-      av1_tile_set_row(&tile_info, cm, tile_row);
 
       for (tile_col = 0; tile_col < tile_cols; tile_col++) {
         const int tile_idx = tile_row * tile_cols + tile_col;
         TileBufferEnc *const buf = &tile_buffers[tile_row][tile_col];
-        TileDataEnc *this_tile = &cpi->tile_data[tile_idx];
-        const TOKENEXTRA *tok = tok_buffers[tile_row][tile_col];
-        const TOKENEXTRA *tok_end = tok + cpi->tok_count[tile_row][tile_col];
+        aom_writer *const mode_bc = &cpi->tile_data[tile_idx].mode_bc;
         const int is_last_col = (tile_col == tile_cols - 1);
         const int is_last_tile = is_last_col && is_last_row;
         int is_last_tile_in_tg = 0;
@@ -4580,7 +4678,6 @@ static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
           tile_count = 0;
         }
         tile_count++;
-        av1_tile_set_col(&tile_info, cm, tile_col);
 
         if (tile_count == tg_size || tile_idx == (tile_cols * tile_rows - 1)) {
           is_last_tile_in_tg = 1;
@@ -4589,29 +4686,15 @@ static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
           is_last_tile_in_tg = 0;
         }
 
-#if CONFIG_DEPENDENT_HORZTILES
-        av1_tile_set_tg_boundary(&tile_info, cm, tile_row, tile_col);
-#endif
         buf->data = dst + total_size;
 
         // The last tile of the tile group does not have a header.
         if (!is_last_tile_in_tg) total_size += 4;
 
-        // Initialise tile context from the frame context
-        this_tile->tctx = *cm->fc;
-        cpi->td.mb.e_mbd.tile_ctx = &this_tile->tctx;
-        mode_bc.allow_update_cdf = 1;
-#if CONFIG_LOOP_RESTORATION
-        av1_reset_loop_restoration(&cpi->td.mb.e_mbd);
-#endif  // CONFIG_LOOP_RESTORATION
-
-        aom_start_encode(&mode_bc, dst + total_size);
-        write_modes(cpi, &tile_info, &mode_bc, &tok, tok_end);
-#if !CONFIG_LV_MAP
-        assert(tok == tok_end);
-#endif  // !CONFIG_LV_MAP
-        aom_stop_encode(&mode_bc);
-        tile_size = mode_bc.pos;
+        // The payload was coded by write_tile_payloads(); flush it into place.
+        mode_bc->buffer = dst + total_size;
+        aom_stop_encode(mode_bc);
+        tile_size = mode_bc->pos;
         assert(tile_size > 0);
 
         curr_tg_data_size += (tile_size + (is_last_tile_in_tg ? 0 : 4));
@@ -4637,6 +4720,7 @@ static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
 #if CONFIG_EXT_TILE
   }
 #endif  // CONFIG_EXT_TILE
+  accumulate_interp_filter_selected(cpi, &cpi->td);
   return (uint32_t)total_size;
 }
 
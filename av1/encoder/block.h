@@ -106,7 +106,7 @@ typedef struct {
 
 typedef struct {
   uint8_t best_palette_color_map[MAX_PALETTE_SQUARE];
-  int kmeans_data_buf[2 * MAX_PALETTE_SQUARE];
+  int16_t kmeans_data_buf[2 * MAX_PALETTE_SQUARE];
 } PALETTE_BUFFER;
 
 typedef struct {
@@ -197,6 +197,11 @@ struct macroblock {
 
   unsigned int txb_split_count;
 
+  // Per-stage timings and counters gathered while encoding the current frame.
+  // The timings are only collected when collect_stage_stats is set.
+  aom_enc_stage_stats_t stage_stats;
+  int collect_stage_stats;
+
   // These are set to their default values at the beginning, and then adjusted
   // further in the encoding process.
   BLOCK_SIZE min_partition_size;
@@ -221,6 +226,15 @@ struct macroblock {
   uint8_t *left_pred_buf;
 
   PALETTE_BUFFER *palette_buffer;
+#if CONFIG_HASH_ME
+  block_hash_buffer *hash_value_buffer;
+#endif
+
+  // The CDFs the rate tables below were last filled from, used to refill only
+  // the tables whose CDFs have changed since. Only meaningful while
+  // cost_fc_valid is set.
+  FRAME_CONTEXT *cost_fc;
+  int cost_fc_valid;
 
   // These define limits to motion vector components to prevent them
   // from extending outside the UMV borders
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "./aom_scale_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_mem/aom_mem.h"
+#include "av1/encoder/denoise.h"
+
+#define DENOISE_RADIUS 2
+#define DENOISE_WINDOW (2 * DENOISE_RADIUS + 1)
+
+static int fit_noise_model(void *arg1, void *unused) {
+  AV1Denoiser *const denoiser = (AV1Denoiser *)arg1;
+  const YV12_BUFFER_CONFIG *const raw = &denoiser->raw;
+  const YV12_BUFFER_CONFIG *const denoised = &denoiser->denoised;
+  // aom_noise_model_update() samples chroma on the luma grid, so the chroma
+  // curves can only be fitted when chroma is not subsampled.
+  const int num_planes = (raw->subsampling_x || raw->subsampling_y) ? 1 : 3;
+  const uint8_t *const data[3] = { raw->y_buffer,
+                                   num_planes > 1 ? raw->u_buffer : NULL,
+                                   num_planes > 1 ? raw->v_buffer : NULL };
+  const uint8_t *const denoised_data[3] = {
+    denoised->y_buffer, num_planes > 1 ? denoised->u_buffer : NULL,
+    num_planes > 1 ? denoised->v_buffer : NULL
+  };
+  int strides[3] = { raw->y_stride, raw->uv_stride, raw->uv_stride };
+  int chroma_sub[2] = { raw->subsampling_x, raw->subsampling_y };
+  aom_noise_status_t status;
+  int plane;
+  (void)unused;
+
+  assert(raw->y_stride == denoised->y_stride &&
+         raw->uv_stride == denoised->uv_stride);
+
+  // Keep the previous curves when there is too little flat area to measure
+  // the noise on.
+  if (aom_flat_block_finder_run(&denoiser->block_finder, raw->y_buffer,
+                                raw->y_crop_width, raw->y_crop_height,
+                                raw->y_stride, denoiser->flat_blocks,
+                                denoiser->row_workers,
+                                denoiser->num_row_workers) <= 1)
+    return 1;
+
+  status = aom_noise_model_update(
+      &denoiser->noise_model, data, denoised_data, raw->y_crop_width,
+      raw->y_crop_height, strides, chroma_sub, denoiser->flat_blocks,
+      denoiser->block_size, denoiser->row_workers, denoiser->num_row_workers);
+  if (status != AOM_NOISE_STATUS_OK &&
+      status != AOM_NOISE_STATUS_DIFFERENT_NOISE_TYPE)
+    return 1;
+
+  for (plane = 0; plane < num_planes; ++plane) {
+    aom_noise_strength_lut_free(&denoiser->strength_lut[plane]);
+    if (!aom_noise_strength_solver_fit_piecewise(
+            &denoiser->noise_model.latest_state[plane].strength_solver,
+            &denoiser->strength_lut[plane])) {
+      denoiser->num_strength_luts = 0;
+      return 0;
+    }
+  }
+  denoiser->num_strength_luts = num_planes;
+  return 1;
+}
+
+void av1_denoiser_init(AV1Denoiser *denoiser, AV1_COMMON *cm, int block_size,
+                       int num_workers) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  const aom_noise_model_params_t params = { AOM_NOISE_SHAPE_SQUARE, 3 };
+  int i;
+
+  memset(denoiser, 0, sizeof(*denoiser));
+  if (!aom_flat_block_finder_init(&denoiser->block_finder, block_size) ||
+      !aom_noise_model_init(&denoiser->noise_model, params))
+    aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                       "Failed to allocate noise model");
+  denoiser->block_size = block_size;
+
+  // With a single thread the fit runs inline and the worker has no thread.
+  num_workers = AOMMAX(num_workers, 1);
+  winterface->init(&denoiser->worker);
+  denoiser->worker.hook = (AVxWorkerHook)fit_noise_model;
+  denoiser->worker.data1 = denoiser;
+  if (num_workers > 1 && !winterface->reset(&denoiser->worker))
+    aom_internal_error(&cm->error, AOM_CODEC_ERROR,
+                       "Noise model thread creation failed");
+
+  CHECK_MEM_ERROR(
+      cm, denoiser->row_workers,
+      aom_calloc(num_workers, sizeof(*denoiser->row_workers)));
+  for (i = 0; i < num_workers; ++i) {
+    AVxWorker *const worker = &denoiser->row_workers[i];
+    ++denoiser->num_row_workers;
+    winterface->init(worker);
+    if (i < num_workers - 1 && !winterface->reset(worker))
+      aom_internal_error(&cm->error, AOM_CODEC_ERROR,
+                         "Noise model thread creation failed");
+  }
+}
+
+void av1_denoiser_free(AV1Denoiser *denoiser) {
+  int plane, i;
+  if (denoiser->block_size == 0) return;
+
+  aom_get_worker_interface()->end(&denoiser->worker);
+  for (i = 0; i < denoiser->num_row_workers; ++i)
+    aom_get_worker_interface()->end(&denoiser->row_workers[i]);
+  aom_free(denoiser->row_workers);
+  aom_flat_block_finder_free(&denoiser->block_finder);
+  aom_noise_model_free(&denoiser->noise_model);
+  for (plane = 0; plane < 3; ++plane)
+    aom_noise_strength_lut_free(&denoiser->strength_lut[plane]);
+  aom_free(denoiser->flat_blocks);
+  aom_free(denoiser->col_sums);
+  aom_free_frame_buffer(&denoiser->raw);
+  aom_free_frame_buffer(&denoiser->denoised);
+  memset(denoiser, 0, sizeof(*denoiser));
+}
+
+static void set_noise_var(const aom_noise_strength_lut_t *lut,
+                          int noise_level, float *noise_var) {
+  int i;
+  for (i = 0; i < 256; ++i) {
+    const double sigma =
+        lut ? AOMMAX(aom_noise_strength_lut_eval(lut, i), 0.0) : noise_level;
+    noise_var[i] = (float)(sigma * sigma);
+  }
+}
+
+// Local Wiener filter over a DENOISE_WINDOW square: each pixel is pulled
+// towards the window mean by the share of the window variance that is noise.
+// The noise variance is looked up by the intensity of the co-located luma
+// pixel in guide. src must be extended by at least DENOISE_RADIUS pixels.
+static void denoise_plane(const uint8_t *src, int src_stride, uint8_t *dst,
+                          int dst_stride, int width, int height,
+                          const uint8_t *guide, int guide_stride, int ss_x,
+                          int ss_y, const float *noise_var, int32_t *col_sum,
+                          int32_t *col_sqr) {
+  const float norm = 1.0f / (DENOISE_WINDOW * DENOISE_WINDOW);
+  int x, y, k;
+
+  for (y = 0; y < height; ++y) {
+    const uint8_t *const src_row = src + y * src_stride;
+    const uint8_t *const guide_row = guide + (y << ss_y) * guide_stride;
+    int32_t sum = 0, sqr = 0;
+
+    for (x = 0; x < width + 2 * DENOISE_RADIUS; ++x) {
+      const uint8_t *p = src_row - DENOISE_RADIUS * src_stride + x -
+                         DENOISE_RADIUS;
+      col_sum[x] = col_sqr[x] = 0;
+      for (k = 0; k < DENOISE_WINDOW; ++k, p += src_stride) {
+        col_sum[x] += p[0];
+        col_sqr[x] += p[0] * p[0];
+      }
+    }
+    for (x = 0; x < DENOISE_WINDOW - 1; ++x) {
+      sum += col_sum[x];
+      sqr += col_sqr[x];
+    }
+
+    for (x = 0; x < width; ++x) {
+      float mean, var, gain;
+      sum += col_sum[x + DENOISE_WINDOW - 1];
+      sqr += col_sqr[x + DENOISE_WINDOW - 1];
+      mean = sum * norm;
+      var = sqr * norm - mean * mean;
+      gain = 0;
+      if (var > noise_var[guide_row[x << ss_x]])
+        gain = (var - noise_var[guide_row[x << ss_x]]) / var;
+      dst[y * dst_stride + x] =
+          clip_pixel((int)(mean + gain * (src_row[x] - mean) + 0.5f));
+      sum -= col_sum[x];
+      sqr -= col_sqr[x];
+    }
+  }
+}
+
+static void copy_plane(const uint8_t *src, int src_stride, uint8_t *dst,
+                       int dst_stride, int width, int height) {
+  int y;
+  for (y = 0; y < height; ++y)
+    memcpy(dst + y * dst_stride, src + y * src_stride, width);
+}
+
+YV12_BUFFER_CONFIG *av1_denoiser_run(AV1Denoiser *denoiser, AV1_COMMON *cm,
+                                     const YV12_BUFFER_CONFIG *sd,
+                                     int noise_level) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  YV12_BUFFER_CONFIG *const raw = &denoiser->raw;
+  YV12_BUFFER_CONFIG *const denoised = &denoiser->denoised;
+  const int width = sd->y_crop_width;
+  const int height = sd->y_crop_height;
+  const int num_blocks = ((width + denoiser->block_size - 1) /
+                          denoiser->block_size) *
+                         ((height + denoiser->block_size - 1) /
+                          denoiser->block_size);
+  const int col_sums_size = 2 * (width + 2 * DENOISE_RADIUS);
+  float noise_var[3][256];
+  int plane;
+
+  assert(!(sd->flags & YV12_FLAG_HIGHBITDEPTH));
+
+  // The worker may still be fitting the model on the previous frame.
+  winterface->sync(&denoiser->worker);
+
+  if (aom_realloc_frame_buffer(raw, width, height, sd->subsampling_x,
+                               sd->subsampling_y, 0, AOM_BORDER_IN_PIXELS,
+                               cm->byte_alignment, NULL, NULL, NULL) ||
+      aom_realloc_frame_buffer(denoised, width, height, sd->subsampling_x,
+                               sd->subsampling_y, 0, AOM_BORDER_IN_PIXELS,
+                               cm->byte_alignment, NULL, NULL, NULL))
+    aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                       "Failed to allocate denoiser buffers");
+  if (denoiser->flat_blocks_size < num_blocks) {
+    aom_free(denoiser->flat_blocks);
+    denoiser->flat_blocks_size = 0;
+    CHECK_MEM_ERROR(cm, denoiser->flat_blocks, aom_malloc(num_blocks));
+    denoiser->flat_blocks_size = num_blocks;
+  }
+  if (denoiser->col_sums_size < col_sums_size) {
+    aom_free(denoiser->col_sums);
+    denoiser->col_sums_size = 0;
+    CHECK_MEM_ERROR(
+        cm, denoiser->col_sums,
+        aom_malloc(col_sums_size * sizeof(*denoiser->col_sums)));
+    denoiser->col_sums_size = col_sums_size;
+  }
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int is_uv = plane > 0;
+    const aom_noise_strength_lut_t *lut = NULL;
+    if (denoiser->num_strength_luts > plane)
+      lut = &denoiser->strength_lut[plane];
+    else if (denoiser->num_strength_luts > 0)
+      lut = &denoiser->strength_lut[0];
+    set_noise_var(lut, noise_level, noise_var[plane]);
+    copy_plane(sd->buffers[plane], sd->strides[is_uv], raw->buffers[plane],
+               raw->strides[is_uv], raw->crop_widths[is_uv],
+               raw->crop_heights[is_uv]);
+  }
+  aom_extend_frame_borders(raw);
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int is_uv = plane > 0;
+    denoise_plane(raw->buffers[plane], raw->strides[is_uv],
+                  denoised->buffers[plane], denoised->strides[is_uv],
+                  raw->crop_widths[is_uv], raw->crop_heights[is_uv],
+                  raw->y_buffer, raw->y_stride,
+                  is_uv ? raw->subsampling_x : 0,
+                  is_uv ? raw->subsampling_y : 0, noise_var[plane],
+                  denoiser->col_sums, denoiser->col_sums + col_sums_size / 2);
+  }
+  aom_extend_frame_borders(denoised);
+
+  if (denoiser->num_row_workers > 1)
+    winterface->launch(&denoiser->worker);
+  else
+    winterface->execute(&denoiser->worker);
+  return denoised;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_DENOISE_H_
+#define AV1_ENCODER_DENOISE_H_
+
+#include "aom_dsp/noise_model.h"
+#include "aom_scale/yv12config.h"
+#include "aom_util/aom_thread.h"
+#include "av1/common/onyxc_int.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Denoising pre-pass for noisy (film grain) sources. Each source frame is
+// denoised with a local Wiener filter before it enters the lookahead, so that
+// motion search and RD decisions see the signal rather than the grain. The
+// noise strength removed from a pixel is looked up by intensity in the
+// strength curve fitted by aom_noise_model_update() on the previous frames.
+// With several threads, fitting the model on a frame runs on a worker thread,
+// overlapped with the encoding of that frame, which splits the fit between its
+// row workers. With one it runs inline once the frame has been denoised. The
+// fitted curves are kept for resynthesizing the grain after decoding.
+typedef struct AV1Denoiser {
+  int block_size;  // 0 until av1_denoiser_init() has been called
+  aom_flat_block_finder_t block_finder;
+  aom_noise_model_t noise_model;
+  uint8_t *flat_blocks;
+  int flat_blocks_size;
+  int32_t *col_sums;  // Per column window sums for denoise_plane()
+  int col_sums_size;
+  YV12_BUFFER_CONFIG raw;       // Copy of the source the model is fitted on
+  YV12_BUFFER_CONFIG denoised;  // Denoised source passed to the lookahead
+  // Noise strength as a function of intensity, per plane. Only the luma
+  // curve is fitted for subsampled sources, and chroma reuses it.
+  aom_noise_strength_lut_t strength_lut[3];
+  int num_strength_luts;
+  AVxWorker worker;
+  // Workers the fit is split between. The last one is run on the thread of
+  // worker and has no thread of its own.
+  AVxWorker *row_workers;
+  int num_row_workers;
+} AV1Denoiser;
+
+void av1_denoiser_init(AV1Denoiser *denoiser, AV1_COMMON *cm, int block_size,
+                       int num_workers);
+
+// Returns the denoised copy of the 8-bit source sd. noise_level is the noise
+// standard deviation assumed until a strength curve has been fitted. The
+// model is then fitted on sd, on the denoiser's worker if it has a thread.
+YV12_BUFFER_CONFIG *av1_denoiser_run(AV1Denoiser *denoiser, AV1_COMMON *cm,
+                                     const YV12_BUFFER_CONFIG *sd,
+                                     int noise_level);
+
+void av1_denoiser_free(AV1Denoiser *denoiser);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_DENOISE_H_
@@ -56,6 +56,7 @@
 #endif
 #include "av1/encoder/ethread.h"
 #include "av1/encoder/extend.h"
+#include "av1/encoder/partition_model_weights.h"
 #include "av1/encoder/rd.h"
 #include "av1/encoder/rdopt.h"
 #include "av1/encoder/segmentation.h"
@@ -635,6 +636,8 @@ static void rd_pick_sb_modes(const AV1_COMP *const cpi, TileDataEnc *tile_data,
 
   aom_clear_system_state();
 
+  ++x->stage_stats.blocks_evaluated;
+
   set_offsets(cpi, tile_info, x, mi_row, mi_col, bsize);
   mbmi = &xd->mi[0]->mbmi;
   mbmi->sb_type = bsize;
@@ -704,6 +707,9 @@ static void rd_pick_sb_modes(const AV1_COMP *const cpi, TileDataEnc *tile_data,
     if (segfeature_active(&cm->seg, mbmi->segment_id, SEG_LVL_SKIP)) {
       av1_rd_pick_inter_mode_sb_seg_skip(cpi, tile_data, x, mi_row, mi_col,
                                          rd_cost, bsize, ctx, best_rd);
+    } else if (cpi->sf.use_nonrd_pick_mode) {
+      av1_nonrd_pick_inter_mode_sb(cpi, tile_data, x, mi_row, mi_col, rd_cost,
+                                   bsize, ctx, best_rd);
     } else {
       av1_rd_pick_inter_mode_sb(cpi, tile_data, x, mi_row, mi_col, rd_cost,
                                 bsize, ctx, best_rd);
@@ -1693,6 +1699,169 @@ static void set_fixed_partitioning(AV1_COMP *cpi, const TileInfo *const tile,
   }
 }
 
+// Variance-based partitioning picks the partitioning of a superblock from the
+// variance of its source against a cheap prediction, without any
+// rate-distortion search. Inter frames predict from the co-located block of
+// LAST_FRAME and intra-only frames from a flat block. A block is kept whole
+// when its variance is below a threshold that grows with the quantizer.
+typedef struct {
+  int64_t sse;
+  int64_t sum;
+  int count;
+} VAR_PART_STATS;
+
+#define VAR_PART_GRID (MAX_SB_SIZE >> 3)
+
+typedef struct {
+  VAR_PART_STATS grid[VAR_PART_GRID][VAR_PART_GRID];
+  int sb_mi_row;
+  int sb_mi_col;
+  int64_t thresh;
+} VAR_PART_TREE;
+
+static void fill_var_part_grid(const AV1_COMP *const cpi, MACROBLOCK *const x,
+                               int mi_row, int mi_col, VAR_PART_TREE *vt) {
+  const AV1_COMMON *const cm = &cpi->common;
+  MACROBLOCKD *const xd = &x->e_mbd;
+  const int is_hbd = (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) != 0;
+  const int sb_8x8 = mi_size_wide[cm->sb_size] >> 1;
+  const YV12_BUFFER_CONFIG *last = NULL;
+  const uint8_t *ref;
+  int ref_stride;
+  void (*get8x8var)(const uint8_t *, int, const uint8_t *, int, unsigned int *,
+                    int *) = aom_get8x8var;
+
+  if (!frame_is_intra_only(cm)) last = get_ref_frame_buffer(cpi, LAST_FRAME);
+  if (last != NULL && last->y_crop_width == cm->width &&
+      last->y_crop_height == cm->height) {
+    ref_stride = last->y_stride;
+    ref = last->y_buffer + mi_row * MI_SIZE * ref_stride + mi_col * MI_SIZE;
+  } else {
+    ref_stride = 0;
+    ref = AV1_VAR_OFFS;
+    if (is_hbd) {
+      const uint16_t *const offs = xd->bd == 12 ? AV1_HIGH_VAR_OFFS_12
+                                   : xd->bd == 10 ? AV1_HIGH_VAR_OFFS_10
+                                                  : AV1_HIGH_VAR_OFFS_8;
+      ref = CONVERT_TO_BYTEPTR(offs);
+    }
+  }
+  if (is_hbd) {
+    get8x8var = xd->bd == 12 ? aom_highbd_12_get8x8var
+                             : xd->bd == 10 ? aom_highbd_10_get8x8var
+                                            : aom_highbd_8_get8x8var;
+  }
+
+  for (int r = 0; r < sb_8x8; ++r) {
+    for (int c = 0; c < sb_8x8; ++c) {
+      VAR_PART_STATS *const v = &vt->grid[r][c];
+      unsigned int sse = 0;
+      int sum = 0;
+      v->sse = v->sum = v->count = 0;
+      if (mi_row + 2 * r >= cm->mi_rows || mi_col + 2 * c >= cm->mi_cols)
+        continue;
+      get8x8var(x->plane[0].src.buf + 8 * (r * x->plane[0].src.stride + c),
+                x->plane[0].src.stride, ref + 8 * (r * ref_stride + c),
+                ref_stride, &sse, &sum);
+      v->sse = sse;
+      v->sum = sum;
+      v->count = 64;
+    }
+  }
+}
+
+// Returns the per-pixel variance of the w8 x h8 8x8 blocks at (r8, c8).
+static int64_t get_var_part_variance(const VAR_PART_TREE *vt, int r8, int c8,
+                                     int h8, int w8) {
+  VAR_PART_STATS s = { 0, 0, 0 };
+  for (int r = r8; r < r8 + h8; ++r) {
+    for (int c = c8; c < c8 + w8; ++c) {
+      s.sse += vt->grid[r][c].sse;
+      s.sum += vt->grid[r][c].sum;
+      s.count += vt->grid[r][c].count;
+    }
+  }
+  if (s.count == 0) return 0;
+  return (s.sse - s.sum * s.sum / s.count) / s.count;
+}
+
+static void set_var_part_block(const AV1_COMMON *const cm, int mi_row,
+                               int mi_col, BLOCK_SIZE bsize) {
+  const int offset = mi_row * cm->mi_stride + mi_col;
+  MODE_INFO **const mib = cm->mi_grid_visible + offset;
+  mib[0] = cm->mi + offset;
+  mib[0]->mbmi.sb_type = bsize;
+}
+
+// Keeps the block whole, halves it or splits it, in that order of preference.
+// At the right and bottom frame edges only the partitions the bitstream
+// allows there are tried. 8x8 blocks are only split when they straddle an
+// edge.
+static void set_var_based_partitioning(const AV1_COMMON *const cm,
+                                       const VAR_PART_TREE *vt, int mi_row,
+                                       int mi_col, BLOCK_SIZE bsize) {
+  if (mi_row >= cm->mi_rows || mi_col >= cm->mi_cols) return;
+  if (bsize < BLOCK_8X8) {
+    set_var_part_block(cm, mi_row, mi_col, bsize);
+    return;
+  }
+
+  const int hbs = mi_size_wide[bsize] / 2;
+  const int has_rows = mi_row + hbs < cm->mi_rows;
+  const int has_cols = mi_col + hbs < cm->mi_cols;
+  const int r8 = (mi_row - vt->sb_mi_row) >> 1;
+  const int c8 = (mi_col - vt->sb_mi_col) >> 1;
+  const int h8 = AOMMAX(hbs >> 1, 1);
+  const int force = bsize == BLOCK_8X8;
+
+  if (has_rows && has_cols &&
+      (force || get_var_part_variance(vt, r8, c8, 2 * h8, 2 * h8) <
+                    vt->thresh)) {
+    set_var_part_block(cm, mi_row, mi_col, bsize);
+    return;
+  }
+  if (has_cols &&
+      (force || (get_var_part_variance(vt, r8, c8, h8, 2 * h8) < vt->thresh &&
+                 (!has_rows || get_var_part_variance(vt, r8 + h8, c8, h8,
+                                                     2 * h8) < vt->thresh)))) {
+    const BLOCK_SIZE subsize = get_subsize(bsize, PARTITION_HORZ);
+    set_var_part_block(cm, mi_row, mi_col, subsize);
+    if (has_rows) set_var_part_block(cm, mi_row + hbs, mi_col, subsize);
+    return;
+  }
+  if (has_rows &&
+      (force || (get_var_part_variance(vt, r8, c8, 2 * h8, h8) < vt->thresh &&
+                 (!has_cols || get_var_part_variance(vt, r8, c8 + h8, 2 * h8,
+                                                     h8) < vt->thresh)))) {
+    const BLOCK_SIZE subsize = get_subsize(bsize, PARTITION_VERT);
+    set_var_part_block(cm, mi_row, mi_col, subsize);
+    if (has_cols) set_var_part_block(cm, mi_row, mi_col + hbs, subsize);
+    return;
+  }
+
+  const BLOCK_SIZE subsize = get_subsize(bsize, PARTITION_SPLIT);
+  set_var_based_partitioning(cm, vt, mi_row, mi_col, subsize);
+  set_var_based_partitioning(cm, vt, mi_row, mi_col + hbs, subsize);
+  set_var_based_partitioning(cm, vt, mi_row + hbs, mi_col, subsize);
+  set_var_based_partitioning(cm, vt, mi_row + hbs, mi_col + hbs, subsize);
+}
+
+static void choose_var_based_partitioning(const AV1_COMP *const cpi,
+                                          MACROBLOCK *const x, int mi_row,
+                                          int mi_col) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const int dc_quant = av1_dc_quant_Q3(cm->base_qindex, 0, AOM_BITS_8);
+  VAR_PART_TREE vt;
+
+  fill_var_part_grid(cpi, x, mi_row, mi_col, &vt);
+  vt.sb_mi_row = mi_row;
+  vt.sb_mi_col = mi_col;
+  // The variances are per pixel, with high bitdepth ones scaled to 8 bits, so
+  // the threshold follows the 8-bit DC quantizer.
+  vt.thresh = dc_quant >> 1;
+  set_var_based_partitioning(cm, &vt, mi_row, mi_col, cm->sb_size);
+}
+
 static void rd_use_partition(AV1_COMP *cpi, ThreadData *td,
                              TileDataEnc *tile_data, MODE_INFO **mib,
                              TOKENEXTRA **tp, int mi_row, int mi_col,
@@ -1959,6 +2128,9 @@ static void rd_use_partition(AV1_COMP *cpi, ThreadData *td,
 
   if (do_recon) {
     if (bsize == cm->sb_size) {
+#if CONFIG_LV_MAP
+      x->cb_offset = 0;
+#endif
       // NOTE: To get estimate for rate due to the tokens, use:
       // int rate_coeffs = 0;
       // encode_sb(cpi, td, tile_data, tp, mi_row, mi_col, DRY_RUN_COSTCOEFFS,
@@ -2126,6 +2298,44 @@ static void rd_auto_partition_range(AV1_COMP *cpi, const TileInfo *const tile,
   *max_block_size = AOMMIN(max_size, cm->sb_size);
 }
 
+// Bound the partition search of a superblock by the block sizes it chose in
+// the previous recode iteration. Returns 0 if there is nothing to reuse.
+static int recode_partition_range(const AV1_COMP *const cpi,
+                                  const TileInfo *const tile, int mi_row,
+                                  int mi_col, BLOCK_SIZE *min_block_size,
+                                  BLOCK_SIZE *max_block_size) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const int row_end = AOMMIN(mi_row + cm->mib_size, cm->mi_rows);
+  const int col_end = AOMMIN(mi_col + cm->mib_size, cm->mi_cols);
+  BLOCK_SIZE min_size = BLOCK_LARGEST;
+  BLOCK_SIZE max_size = BLOCK_4X4;
+  int bh, bw, r, c;
+
+  if (!av1_get_recode_mi_info(cpi, mi_row, mi_col)) return 0;
+
+  for (r = mi_row; r < row_end; ++r) {
+    for (c = mi_col; c < col_end; ++c) {
+      const BLOCK_SIZE sb_type = av1_get_recode_mi_info(cpi, r, c)->sb_type;
+      min_size = AOMMIN(min_size, sb_type);
+      max_size = AOMMAX(max_size, sb_type);
+    }
+  }
+
+  // The quantizer changed between iterations, so allow one size either way.
+  min_size = min_partition_size[min_size];
+  max_size = max_partition_size[max_size];
+  max_size = find_partition_size(max_size, tile->mi_row_end - mi_row,
+                                 tile->mi_col_end - mi_col, &bh, &bw);
+  min_size = AOMMIN(min_size, max_size);
+  if (av1_active_edge_sb(cpi, mi_row, mi_col)) min_size = BLOCK_4X4;
+  if (cpi->sf.use_square_partition_only)
+    min_size = AOMMIN(min_size, next_square_size[max_size]);
+
+  *min_block_size = AOMMIN(min_size, cm->sb_size);
+  *max_block_size = AOMMIN(max_size, cm->sb_size);
+  return 1;
+}
+
 // TODO(jingning) refactor functions setting partition search range
 static void set_partition_range(const AV1_COMMON *const cm,
                                 const MACROBLOCKD *const xd, int mi_row,
@@ -2382,6 +2592,82 @@ static int64_t dist_8x8_yuv(const AV1_COMP *const cpi, MACROBLOCK *const x,
 }
 #endif  // CONFIG_DIST_8X8
 
+// Set to 1 to append the partition pruning features of every square block,
+// together with the partition finally chosen for it, to partition_stats.txt.
+// The learned pruning is bypassed while collecting so that the labels come
+// from the full search.
+#define COLLECT_PARTITION_STATS 0
+
+// Returns how many levels deeper the neighbouring block is partitioned than
+// bsize along one dimension, or 0 if the neighbour is not available.
+static float get_neighbor_depth_diff(const MODE_INFO *mi, int log2_bsize,
+                                     int use_width) {
+  if (mi == NULL) return 0.0f;
+  const BLOCK_SIZE nb_bsize = mi->mbmi.sb_type;
+  const int log2_nb_size = use_width ? b_width_log2_lookup[nb_bsize]
+                                     : b_height_log2_lookup[nb_bsize];
+  return (float)(log2_bsize - log2_nb_size);
+}
+
+// Collects the features used by the partition pruning models once
+// PARTITION_NONE has been evaluated for a square block.
+static void get_partition_prune_features(const AV1_COMMON *const cm,
+                                         const MACROBLOCK *const x,
+                                         BLOCK_SIZE bsize,
+                                         const RD_STATS *none_rdc,
+                                         int none_skippable, float *features) {
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const int log2_bsize = b_width_log2_lookup[bsize];
+  const int num_pels = block_size_wide[bsize] * block_size_high[bsize];
+  const int dist_shift = 2 * (xd->bd - 8);
+  int f = 0;
+
+  aom_clear_system_state();
+  features[f++] = (float)log2_bsize;
+  features[f++] = (float)cm->base_qindex;
+  features[f++] = logf(1.0f + (float)x->source_variance);
+  features[f++] = logf(1.0f + (float)none_rdc->rate / num_pels);
+  features[f++] =
+      logf(1.0f + (float)(none_rdc->dist >> dist_shift) / num_pels);
+  features[f++] = get_neighbor_depth_diff(xd->above_mi, log2_bsize, 1);
+  features[f++] = get_neighbor_depth_diff(xd->left_mi, log2_bsize, 0);
+  features[f++] = (float)none_skippable;
+  assert(f == PARTITION_PRUNE_FEATURES);
+}
+
+// Evaluates a two layer fully connected network with ReLU activations in the
+// hidden layer. The weights are laid out as in partition_model_weights.h.
+static float compute_partition_prune_score(const float *features,
+                                           const float *weights,
+                                           int num_hidden_units) {
+  const float *fc1 = weights;
+  const float *b1 = fc1 + num_hidden_units * PARTITION_PRUNE_FEATURES;
+  const float *fc2 = b1 + num_hidden_units;
+  const float b2 = fc2[num_hidden_units];
+  float score = b2;
+
+  for (int i = 0; i < num_hidden_units; ++i) {
+    const float *cur_coef = fc1 + i * PARTITION_PRUNE_FEATURES;
+    float hidden = b1[i];
+    for (int j = 0; j < PARTITION_PRUNE_FEATURES; ++j)
+      hidden += cur_coef[j] * features[j];
+    score += fc2[i] * AOMMAX(hidden, 0.0f);
+  }
+  return score;
+}
+
+#if COLLECT_PARTITION_STATS
+static void write_partition_stats(const float *features,
+                                  PARTITION_TYPE partition) {
+  FILE *f = fopen("partition_stats.txt", "a");
+  if (f == NULL) return;
+  for (int i = 0; i < PARTITION_PRUNE_FEATURES; ++i)
+    fprintf(f, "%f ", features[i]);
+  fprintf(f, "%d\n", partition);
+  fclose(f);
+}
+#endif  // COLLECT_PARTITION_STATS
+
 // TODO(jingning,jimbankoski,rbultje): properly skip partition types that are
 // unlikely to be selected depending on previous rate-distortion optimization
 // results, for encoding speed-up.
@@ -2410,6 +2696,10 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
       pl >= 0 ? x->partition_cost[pl] : x->partition_cost[0];
 
   int do_rectangular_split = 1;
+  float prune_features[PARTITION_PRUNE_FEATURES];
+#if COLLECT_PARTITION_STATS
+  int collect_partition_stats = 0;
+#endif  // COLLECT_PARTITION_STATS
 #if CONFIG_EXT_PARTITION_TYPES
   int64_t split_rd[4] = { 0, 0, 0, 0 };
   int64_t horz_rd[2] = { 0, 0 };
@@ -2498,7 +2788,8 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
 
   // Determine partition types in search according to the speed features.
   // The threshold set here has to be of square block size.
-  if (cpi->sf.auto_min_max_partition_size) {
+  if (cpi->sf.auto_min_max_partition_size ||
+      av1_get_recode_mi_info(cpi, mi_row, mi_col)) {
     const int no_partition_allowed = (bsize <= max_size && bsize >= min_size);
     // Note: Further partitioning is NOT allowed when bsize == min_size already.
     const int partition_allowed = (bsize <= max_size && bsize > min_size);
@@ -2615,6 +2906,7 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
              best_rdc.rate < rate_breakout_thr)) {
           do_square_split = 0;
           do_rectangular_split = 0;
+          ++x->stage_stats.early_terminations;
         }
 
 #if CONFIG_FP_MB_STATS
@@ -2663,6 +2955,27 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
         }
 #endif
       }
+
+      if ((COLLECT_PARTITION_STATS || cpi->sf.ml_prune_partition) &&
+          bsize_at_least_8x8 && has_rows && has_cols &&
+          (do_square_split || do_rectangular_split)) {
+        get_partition_prune_features(cm, x, bsize, &this_rdc,
+                                     ctx_none->skippable, prune_features);
+#if COLLECT_PARTITION_STATS
+        collect_partition_stats = 1;
+#else
+        if (compute_partition_prune_score(
+                prune_features, av1_partition_prune_split_weights,
+                AV1_PARTITION_PRUNE_HIDDEN_UNITS) <
+            av1_partition_prune_split_thresh)
+          do_square_split = 0;
+        if (compute_partition_prune_score(
+                prune_features, av1_partition_prune_rect_weights,
+                AV1_PARTITION_PRUNE_HIDDEN_UNITS) <
+            av1_partition_prune_rect_thresh)
+          do_rectangular_split = 0;
+#endif  // COLLECT_PARTITION_STATS
+      }
     }
 
     restore_context(x, &x_ctx, mi_row, mi_col, bsize);
@@ -3092,6 +3405,11 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
   (void)best_rd;
   *rd_cost = best_rdc;
 
+#if COLLECT_PARTITION_STATS
+  if (collect_partition_stats && best_rdc.rate < INT_MAX)
+    write_partition_stats(prune_features, pc_tree->partitioning);
+#endif  // COLLECT_PARTITION_STATS
+
   if (best_rdc.rate < INT_MAX && best_rdc.dist < INT64_MAX &&
       pc_tree->index != 3) {
     if (bsize == cm->sb_size) {
@@ -3181,6 +3499,7 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
                                   x->e_mbd.tile_ctx->coef_tail_cdfs);
 #endif
     av1_fill_mode_rates(cm, x, xd->tile_ctx);
+    x->cost_fc_valid = 1;
 
     if (sf->adaptive_pred_interp_filter) {
       for (i = 0; i < leaf_nodes; ++i) {
@@ -3266,6 +3585,9 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
 #endif  // CONFIG_EXT_DELTA_Q
     }
 
+    struct aom_usec_timer timer;
+    av1_stage_timer_start(x->collect_stage_stats, &timer);
+
     x->source_variance = UINT_MAX;
     if (sf->partition_search_type == FIXED_PARTITION || seg_skip) {
       BLOCK_SIZE bsize;
@@ -3274,6 +3596,11 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
       set_fixed_partitioning(cpi, tile_info, mi, mi_row, mi_col, bsize);
       rd_use_partition(cpi, td, tile_data, mi, tp, mi_row, mi_col, cm->sb_size,
                        &dummy_rate, &dummy_dist, 1, pc_root);
+    } else if (sf->partition_search_type == VAR_BASED_PARTITION) {
+      set_offsets(cpi, tile_info, x, mi_row, mi_col, cm->sb_size);
+      choose_var_based_partitioning(cpi, x, mi_row, mi_col);
+      rd_use_partition(cpi, td, tile_data, mi, tp, mi_row, mi_col, cm->sb_size,
+                       &dummy_rate, &dummy_dist, 1, pc_root);
     } else if (cpi->partition_search_skippable_frame) {
       BLOCK_SIZE bsize;
       set_offsets(cpi, tile_info, x, mi_row, mi_col, cm->sb_size);
@@ -3283,7 +3610,10 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
                        &dummy_rate, &dummy_dist, 1, pc_root);
     } else {
       // If required set upper and lower partition size limits
-      if (sf->auto_min_max_partition_size) {
+      if (!recode_partition_range(cpi, tile_info, mi_row, mi_col,
+                                  &x->min_partition_size,
+                                  &x->max_partition_size) &&
+          sf->auto_min_max_partition_size) {
         set_offsets(cpi, tile_info, x, mi_row, mi_col, cm->sb_size);
         rd_auto_partition_range(cpi, tile_info, xd, mi_row, mi_col,
                                 &x->min_partition_size, &x->max_partition_size);
@@ -3291,6 +3621,9 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
       rd_pick_partition(cpi, td, tile_data, tp, mi_row, mi_col, cm->sb_size,
                         &dummy_rdc, INT64_MAX, pc_root, NULL);
     }
+
+    av1_stage_timer_accumulate(x->collect_stage_stats, &timer,
+                               &x->stage_stats.partition_search);
   }
 }
 
@@ -3419,6 +3752,7 @@ void av1_encode_tile(AV1_COMP *cpi, ThreadData *td, int tile_row,
   td->mb.ex_search_count_ptr = &this_tile->ex_search_count;
   this_tile->tctx = *cm->fc;
   td->mb.e_mbd.tile_ctx = &this_tile->tctx;
+  td->mb.cost_fc_valid = 0;
 
 #if CONFIG_CFL
   cfl_init(&td->mb.e_mbd.cfl, cm);
@@ -4041,9 +4375,11 @@ static void encode_frame_internal(AV1_COMP *cpi) {
 
   x->txb_split_count = 0;
   av1_zero(x->blk_skip_drl);
+  av1_zero(x->stage_stats);
+  x->collect_stage_stats = cpi->oxcf.enable_stage_stats;
 
 #if CONFIG_MFMV
-  av1_setup_motion_field(cm);
+  av1_setup_motion_field(cm, cpi->workers, cpi->num_workers);
 #endif  // CONFIG_MFMV
 
 #if CONFIG_FRAME_MARKER
@@ -4081,6 +4417,8 @@ static void encode_frame_internal(AV1_COMP *cpi) {
     cpi->time_encode_sb_row += aom_usec_timer_elapsed(&emr_timer);
   }
 
+  av1_accumulate_stage_stats(&cpi->stage_stats, &x->stage_stats);
+
 #if CONFIG_INTRABC
   // If intrabc is allowed but never selected, reset the allow_intrabc flag.
   if (cm->allow_intrabc && !cpi->intrabc_used) cm->allow_intrabc = 0;
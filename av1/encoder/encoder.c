@@ -497,6 +497,11 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
   aom_free(cpi->active_map.map);
   cpi->active_map.map = NULL;
 
+  aom_free(cpi->recode_cache.mi);
+  cpi->recode_cache.mi = NULL;
+  cpi->recode_cache.alloc_size = 0;
+  cpi->recode_cache.valid = 0;
+
   aom_free(cpi->td.mb.above_pred_buf);
   cpi->td.mb.above_pred_buf = NULL;
 
@@ -509,6 +514,9 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
   aom_free(cpi->td.mb.mask_buf);
   cpi->td.mb.mask_buf = NULL;
 
+  aom_free(cpi->td.mb.cost_fc);
+  cpi->td.mb.cost_fc = NULL;
+
 #if CONFIG_MFMV
   aom_free(cm->tpl_mvs);
   cm->tpl_mvs = NULL;
@@ -529,6 +537,7 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
   aom_free_frame_buffer(&cpi->scaled_last_source);
   aom_free_frame_buffer(&cpi->alt_ref_buffer);
   av1_lookahead_destroy(cpi->lookahead);
+  av1_denoiser_free(&cpi->denoiser);
 
   aom_free(cpi->tile_tok[0][0]);
   cpi->tile_tok[0][0] = 0;
@@ -536,6 +545,9 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
   av1_free_pc_tree(&cpi->td);
 
   aom_free(cpi->td.mb.palette_buffer);
+#if CONFIG_HASH_ME
+  aom_free(cpi->td.mb.hash_value_buffer);
+#endif
 }
 
 static void save_coding_context(AV1_COMP *cpi) {
@@ -829,6 +841,31 @@ void av1_new_framerate(AV1_COMP *cpi, double framerate) {
   av1_rc_update_framerate(cpi, cpi->common.width, cpi->common.height);
 }
 
+void av1_accumulate_stage_stats(aom_enc_stage_stats_t *dst,
+                                const aom_enc_stage_stats_t *src) {
+  dst->partition_search += src->partition_search;
+  dst->motion_search += src->motion_search;
+  dst->tx_search += src->tx_search;
+  dst->temporal_filter += src->temporal_filter;
+  dst->loop_filter_search += src->loop_filter_search;
+  dst->cdef_search += src->cdef_search;
+  dst->restoration_search += src->restoration_search;
+  dst->pack_bitstream += src->pack_bitstream;
+  dst->blocks_evaluated += src->blocks_evaluated;
+  dst->early_terminations += src->early_terminations;
+  dst->tx_cache_hits += src->tx_cache_hits;
+  dst->frames += src->frames;
+}
+
+// Packs the bitstream, accounting the time spent to the pack_bitstream stage.
+static void pack_bitstream(AV1_COMP *cpi, uint8_t *dest, size_t *size) {
+  struct aom_usec_timer timer;
+  av1_stage_timer_start(cpi->oxcf.enable_stage_stats, &timer);
+  av1_pack_bitstream(cpi, dest, size);
+  av1_stage_timer_accumulate(cpi->oxcf.enable_stage_stats, &timer,
+                             &cpi->stage_stats.pack_bitstream);
+}
+
 #if CONFIG_MAX_TILE
 
 static void set_tile_info_max_tile(AV1_COMP *cpi) {
@@ -3131,6 +3168,12 @@ void av1_change_config(struct AV1_COMP *cpi, const AV1EncoderConfig *oxcf) {
     CHECK_MEM_ERROR(cm, x->palette_buffer,
                     aom_memalign(16, sizeof(*x->palette_buffer)));
   }
+#if CONFIG_HASH_ME
+  if (x->hash_value_buffer == NULL) {
+    CHECK_MEM_ERROR(cm, x->hash_value_buffer,
+                    aom_malloc(sizeof(*x->hash_value_buffer)));
+  }
+#endif
   set_compound_tools(cm);
   av1_reset_segment_features(cm);
 #if CONFIG_AMVR
@@ -3237,6 +3280,9 @@ AV1_COMP *av1_create_compressor(AV1EncoderConfig *oxcf,
   cpi->resize_state = 0;
   cpi->resize_avg_qp = 0;
   cpi->resize_buffer_underflow = 0;
+  // Choose arbitrary random numbers
+  cpi->resize_seed = 56789;
+  cpi->superres_seed = 34567;
 
   cpi->common.buffer_pool = pool;
 
@@ -3382,6 +3428,9 @@ AV1_COMP *av1_create_compressor(AV1EncoderConfig *oxcf,
                   (int32_t *)aom_memalign(
                       16, MAX_SB_SQUARE * sizeof(*cpi->td.mb.mask_buf)));
 
+  CHECK_MEM_ERROR(cm, cpi->td.mb.cost_fc,
+                  aom_malloc(sizeof(*cpi->td.mb.cost_fc)));
+
   av1_set_speed_features_framesize_independent(cpi);
   av1_set_speed_features_framesize_dependent(cpi);
 
@@ -3888,10 +3937,14 @@ void av1_remove_compressor(AV1_COMP *cpi) {
     // Deallocate allocated thread data.
     if (t < cpi->num_workers - 1) {
       aom_free(thread_data->td->palette_buffer);
+#if CONFIG_HASH_ME
+      aom_free(thread_data->td->hash_value_buffer);
+#endif
       aom_free(thread_data->td->above_pred_buf);
       aom_free(thread_data->td->left_pred_buf);
       aom_free(thread_data->td->wsrc_buf);
       aom_free(thread_data->td->mask_buf);
+      aom_free(thread_data->td->cost_fc);
       aom_free(thread_data->td->counts);
       av1_free_pc_tree(thread_data->td);
       aom_free(thread_data->td);
@@ -4581,7 +4634,8 @@ static void scale_references(AV1_COMP *cpi) {
             aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
                                "Failed to allocate frame buffer");
           av1_resize_and_extend_frame(ref, &new_fb_ptr->buf,
-                                      (int)cm->bit_depth);
+                                      (int)cm->bit_depth, cpi->workers,
+                                      cpi->num_workers);
           cpi->scaled_ref_idx[ref_frame - 1] = new_fb;
           alloc_frame_mvs(cm, new_fb);
         }
@@ -4941,9 +4995,7 @@ static void set_frame_size(AV1_COMP *cpi, int width, int height) {
   set_ref_ptrs(cm, xd, LAST_FRAME, LAST_FRAME);
 }
 
-static uint8_t calculate_next_resize_scale(const AV1_COMP *cpi) {
-  // Choose an arbitrary random number
-  static unsigned int seed = 56789;
+static uint8_t calculate_next_resize_scale(AV1_COMP *cpi) {
   const AV1EncoderConfig *oxcf = &cpi->oxcf;
   if (oxcf->pass == 1) return SCALE_NUMERATOR;
   uint8_t new_denom = SCALE_NUMERATOR;
@@ -4956,7 +5008,9 @@ static uint8_t calculate_next_resize_scale(const AV1_COMP *cpi) {
       else
         new_denom = oxcf->resize_scale_denominator;
       break;
-    case RESIZE_RANDOM: new_denom = lcg_rand16(&seed) % 9 + 8; break;
+    case RESIZE_RANDOM:
+      new_denom = lcg_rand16(&cpi->resize_seed) % 9 + 8;
+      break;
     default: assert(0);
   }
   return new_denom;
@@ -4965,8 +5019,6 @@ static uint8_t calculate_next_resize_scale(const AV1_COMP *cpi) {
 #if CONFIG_HORZONLY_FRAME_SUPERRES
 
 static uint8_t calculate_next_superres_scale(AV1_COMP *cpi) {
-  // Choose an arbitrary random number
-  static unsigned int seed = 34567;
   const AV1EncoderConfig *oxcf = &cpi->oxcf;
   if (oxcf->pass == 1) return SCALE_NUMERATOR;
   uint8_t new_denom = SCALE_NUMERATOR;
@@ -4980,7 +5032,9 @@ static uint8_t calculate_next_superres_scale(AV1_COMP *cpi) {
       else
         new_denom = oxcf->superres_scale_denominator;
       break;
-    case SUPERRES_RANDOM: new_denom = lcg_rand16(&seed) % 9 + 8; break;
+    case SUPERRES_RANDOM:
+      new_denom = lcg_rand16(&cpi->superres_seed) % 9 + 8;
+      break;
     case SUPERRES_QTHRESH:
       qthresh = (cpi->common.frame_type == KEY_FRAME ? oxcf->superres_kf_qthresh
                                                      : oxcf->superres_qthresh);
@@ -5126,7 +5180,7 @@ static void superres_post_encode(AV1_COMP *cpi) {
 
   if (av1_superres_unscaled(cm)) return;
 
-  av1_superres_upscale(cm, NULL);
+  av1_superres_upscale(cm, NULL, cpi->workers, cpi->num_workers);
 
   // If regular resizing is occurring the source will need to be downscaled to
   // match the upscaled superres resolution. Otherwise the original source is
@@ -5149,7 +5203,8 @@ static void superres_post_encode(AV1_COMP *cpi) {
     assert(cpi->scaled_source.y_crop_width == cm->superres_upscaled_width);
     assert(cpi->scaled_source.y_crop_height == cm->superres_upscaled_height);
     av1_resize_and_extend_frame(cpi->unscaled_source, &cpi->scaled_source,
-                                (int)cm->bit_depth);
+                                (int)cm->bit_depth, cpi->workers,
+                                cpi->num_workers);
     cpi->source = &cpi->scaled_source;
   }
 }
@@ -5207,6 +5262,8 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
 
     aom_usec_timer_mark(&timer);
     cpi->time_pick_lpf += aom_usec_timer_elapsed(&timer);
+    if (cpi->oxcf.enable_stage_stats)
+      cpi->stage_stats.loop_filter_search += aom_usec_timer_elapsed(&timer);
   }
 
 #if CONFIG_LOOPFILTER_LEVEL
@@ -5239,9 +5296,14 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
     cm->nb_cdef_strengths = 1;
     cm->cdef_uv_strengths[0] = 0;
   } else {
+    struct aom_usec_timer timer;
+
     // Find CDEF parameters
+    av1_stage_timer_start(cpi->oxcf.enable_stage_stats, &timer);
     av1_cdef_search(cm->frame_to_show, cpi->source, cm, xd,
                     cpi->sf.fast_cdef_search);
+    av1_stage_timer_accumulate(cpi->oxcf.enable_stage_stats, &timer,
+                               &cpi->stage_stats.cdef_search);
 
     // Apply the filter
     av1_cdef_frame(cm->frame_to_show, cm, xd);
@@ -5257,10 +5319,14 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
     cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
     cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
   } else {
+    struct aom_usec_timer timer;
 #if CONFIG_STRIPED_LOOP_RESTORATION
     av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
 #endif
+    av1_stage_timer_start(cpi->oxcf.enable_stage_stats, &timer);
     av1_pick_filter_restoration(cpi->source, cpi);
+    av1_stage_timer_accumulate(cpi->oxcf.enable_stage_stats, &timer,
+                               &cpi->stage_stats.restoration_search);
     if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
         cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
         cm->rst_info[2].frame_restoration_type != RESTORE_NONE) {
@@ -5288,11 +5354,13 @@ static void encode_without_recode_loop(AV1_COMP *cpi) {
 
   set_size_dependent_vars(cpi, &q, &bottom_index, &top_index);
 
-  cpi->source =
-      av1_scale_if_required(cm, cpi->unscaled_source, &cpi->scaled_source);
+  cpi->source = av1_scale_if_required(cm, cpi->unscaled_source,
+                                      &cpi->scaled_source, cpi->workers,
+                                      cpi->num_workers);
   if (cpi->unscaled_last_source != NULL)
-    cpi->last_source = av1_scale_if_required(cm, cpi->unscaled_last_source,
-                                             &cpi->scaled_last_source);
+    cpi->last_source = av1_scale_if_required(
+        cm, cpi->unscaled_last_source, &cpi->scaled_last_source, cpi->workers,
+        cpi->num_workers);
   cpi->source->buf_8bit_valid = 0;
   if (frame_is_intra_only(cm) == 0) {
     scale_references(cpi);
@@ -5328,6 +5396,45 @@ static void encode_without_recode_loop(AV1_COMP *cpi) {
   aom_clear_system_state();
 }
 
+// Keeps the block decisions of the current recode iteration so that the next
+// iteration can seed its searches from them.
+static void save_recode_decisions(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  RecodeCache *const cache = &cpi->recode_cache;
+  const int size = cm->mi_rows * cm->mi_cols;
+  int mi_row, mi_col;
+
+  if (!cpi->sf.reuse_recode_decisions) return;
+
+  if (cache->alloc_size < size) {
+    aom_free(cache->mi);
+    cache->alloc_size = 0;
+    CHECK_MEM_ERROR(cm, cache->mi, aom_malloc(size * sizeof(*cache->mi)));
+    cache->alloc_size = size;
+  }
+
+  for (mi_row = 0; mi_row < cm->mi_rows; ++mi_row) {
+    for (mi_col = 0; mi_col < cm->mi_cols; ++mi_col) {
+      const MODE_INFO *const mi =
+          cm->mi_grid_visible[mi_row * cm->mi_stride + mi_col];
+      RecodeMiInfo *const info = &cache->mi[mi_row * cm->mi_cols + mi_col];
+      if (mi) {
+        info->mv = mi->mbmi.mv[0];
+        info->ref_frame = mi->mbmi.ref_frame[0];
+        info->sb_type = mi->mbmi.sb_type;
+      } else {
+        info->mv.as_int = 0;
+        info->ref_frame = NONE_FRAME;
+        info->sb_type = BLOCK_4X4;
+      }
+    }
+  }
+
+  cache->mi_rows = cm->mi_rows;
+  cache->mi_cols = cm->mi_cols;
+  cache->valid = 1;
+}
+
 static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
                                     uint8_t *dest) {
   AV1_COMMON *const cm = &cpi->common;
@@ -5345,6 +5452,7 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
   set_size_independent_vars(cpi);
 
   cpi->source->buf_8bit_valid = 0;
+  cpi->recode_cache.valid = 0;
 
   aom_clear_system_state();
   setup_frame_size(cpi);
@@ -5377,11 +5485,13 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
       if (cpi->source->y_crop_width != cm->width ||
           cpi->source->y_crop_height != cm->height)
         cpi->global_motion_search_done = 0;
-    cpi->source =
-        av1_scale_if_required(cm, cpi->unscaled_source, &cpi->scaled_source);
+    cpi->source = av1_scale_if_required(cm, cpi->unscaled_source,
+                                        &cpi->scaled_source, cpi->workers,
+                                        cpi->num_workers);
     if (cpi->unscaled_last_source != NULL)
-      cpi->last_source = av1_scale_if_required(cm, cpi->unscaled_last_source,
-                                               &cpi->scaled_last_source);
+      cpi->last_source = av1_scale_if_required(
+          cm, cpi->unscaled_last_source, &cpi->scaled_last_source,
+          cpi->workers, cpi->num_workers);
 
     if (frame_is_intra_only(cm) == 0) {
       if (loop_count > 0) {
@@ -5423,7 +5533,7 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
     // to recode.
     if (cpi->sf.recode_loop >= ALLOW_RECODE_KFARFGF) {
       restore_coding_context(cpi);
-      av1_pack_bitstream(cpi, dest, size);
+      pack_bitstream(cpi, dest, size);
 
       rc->projected_frame_size = (int)(*size) << 3;
       restore_coding_context(cpi);
@@ -5570,12 +5680,15 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
     if (loop) {
       ++loop_count;
       ++loop_at_this_size;
+      save_recode_decisions(cpi);
 
 #if CONFIG_INTERNAL_STATS
       ++cpi->tot_recode_hits;
 #endif
     }
   } while (loop);
+
+  cpi->recode_cache.valid = 0;
 }
 
 static int get_ref_frame_flags(const AV1_COMP *cpi) {
@@ -5921,7 +6034,8 @@ static void encode_frame_to_data_rate(AV1_COMP *cpi, size_t *size,
     restore_coding_context(cpi);
 
     // Build the bitstream
-    av1_pack_bitstream(cpi, dest, size);
+    pack_bitstream(cpi, dest, size);
+    ++cpi->stage_stats.frames;
 
     // Set up frame to show to get ready for stats collection.
     cm->frame_to_show = get_frame_new_buffer(cm);
@@ -6138,7 +6252,8 @@ static void encode_frame_to_data_rate(AV1_COMP *cpi, size_t *size,
 #endif
 
   // Build the bitstream
-  av1_pack_bitstream(cpi, dest, size);
+  pack_bitstream(cpi, dest, size);
+  ++cpi->stage_stats.frames;
 
   if (skip_adapt) {
     aom_free(tile_ctxs);
@@ -6321,6 +6436,18 @@ int av1_receive_raw_frame(AV1_COMP *cpi, aom_enc_frame_flags_t frame_flags,
 
   aom_usec_timer_start(&timer);
 
+  // The noise model only handles 8-bit sources.
+  if (cpi->oxcf.denoise_noise_level > 0 && !use_highbitdepth) {
+    if (cpi->denoiser.block_size != (int)cpi->oxcf.denoise_block_size ||
+        cpi->denoiser.num_row_workers != AOMMAX(cpi->oxcf.max_threads, 1)) {
+      av1_denoiser_free(&cpi->denoiser);
+      av1_denoiser_init(&cpi->denoiser, cm, cpi->oxcf.denoise_block_size,
+                        cpi->oxcf.max_threads);
+    }
+    sd = av1_denoiser_run(&cpi->denoiser, cm, sd,
+                          cpi->oxcf.denoise_noise_level);
+  }
+
   if (av1_lookahead_push(cpi->lookahead, sd, time_stamp, end_time,
                          use_highbitdepth, frame_flags))
     res = -1;
@@ -6653,7 +6780,8 @@ static int is_integer_mv(AV1_COMP *cpi, const YV12_BUFFER_CONFIG *cur_picture,
 
       av1_get_block_hash_value(
           cur_picture->y_buffer + y_pos * stride_cur + x_pos, stride_cur,
-          block_size, &hash_value_1, &hash_value_2);
+          block_size, &hash_value_1, &hash_value_2,
+          cpi->td.mb.hash_value_buffer);
 
       if (av1_has_exact_match(last_hash_table, hash_value_1, hash_value_2)) {
         M++;
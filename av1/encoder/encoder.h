@@ -25,6 +25,7 @@
 #include "av1/encoder/aq_cyclicrefresh.h"
 #include "av1/encoder/av1_quantize.h"
 #include "av1/encoder/context_tree.h"
+#include "av1/encoder/denoise.h"
 #include "av1/encoder/encodemb.h"
 #include "av1/encoder/firstpass.h"
 #include "av1/encoder/lookahead.h"
@@ -40,6 +41,7 @@
 #endif
 #include "aom_dsp/variance.h"
 #include "aom/internal/aom_codec_internal.h"
+#include "aom_ports/aom_timer.h"
 #include "aom_util/aom_thread.h"
 
 #ifdef __cplusplus
@@ -86,7 +88,11 @@ typedef enum {
 typedef enum {
   // Good Quality Fast Encoding. The encoder balances quality with the amount of
   // time it takes to encode the output. Speed setting controls how fast.
-  GOOD
+  GOOD,
+  // Realtime Fast Encoding. Will force some restrictions on bitrate
+  // constraints and trades quality for the encoding speed needed by live
+  // sources such as video conferencing.
+  REALTIME
 } MODE;
 
 typedef enum {
@@ -307,6 +313,9 @@ typedef struct AV1EncoderConfig {
 #endif  // CONFIG_MONO_VIDEO
 
   unsigned int motion_vector_unit_test;
+  unsigned int enable_stage_stats;
+  unsigned int denoise_noise_level;  // 0 disables the denoising pre-pass
+  unsigned int denoise_block_size;
 } AV1EncoderConfig;
 
 static INLINE int is_lossless_requested(const AV1EncoderConfig *cfg) {
@@ -325,6 +334,9 @@ typedef struct TileDataEnc {
 #endif
   DECLARE_ALIGNED(16, FRAME_CONTEXT, tctx);
   uint8_t allow_update_cdf;
+  // Writer for the tile payload, left open by the bitstream packer until the
+  // payload's position in the output is known.
+  aom_writer mode_bc;
 } TileDataEnc;
 
 typedef struct RD_COUNTS {
@@ -348,6 +360,11 @@ typedef struct ThreadData {
   uint8_t *above_pred_buf;
   uint8_t *left_pred_buf;
   PALETTE_BUFFER *palette_buffer;
+#if CONFIG_HASH_ME
+  block_hash_buffer *hash_value_buffer;
+#endif
+  FRAME_CONTEXT *cost_fc;
+  int interp_filter_selected[SWITCHABLE];
 #if CONFIG_INTRABC
   int intrabc_used_this_tile;
 #endif  // CONFIG_INTRABC
@@ -355,6 +372,24 @@ typedef struct ThreadData {
 
 struct EncWorkerData;
 
+// Decisions made for one mode info unit by the previous iteration of the
+// recode loop.
+typedef struct RecodeMiInfo {
+  int_mv mv;
+  MV_REFERENCE_FRAME ref_frame;
+  BLOCK_SIZE sb_type;
+} RecodeMiInfo;
+
+// Block decisions kept across recode loop iterations of the same frame.
+typedef struct RecodeCache {
+  RecodeMiInfo *mi;
+  int mi_rows;
+  int mi_cols;
+  int alloc_size;
+  // Set when mi holds the decisions of the previous iteration.
+  int valid;
+} RecodeCache;
+
 typedef struct ActiveMap {
   int enabled;
   int update;
@@ -392,6 +427,7 @@ typedef struct AV1_COMP {
   AV1EncoderConfig oxcf;
   struct lookahead_ctx *lookahead;
   struct lookahead_entry *alt_ref_source;
+  AV1Denoiser denoiser;
 
   YV12_BUFFER_CONFIG *source;
   YV12_BUFFER_CONFIG *last_source;  // NULL for first frame and alt_ref frames
@@ -495,6 +531,8 @@ typedef struct AV1_COMP {
   CYCLIC_REFRESH *cyclic_refresh;
   ActiveMap active_map;
 
+  RecodeCache recode_cache;
+
   fractional_mv_step_fp *find_fractional_mv_step;
   av1_full_search_fn_t full_search_sad;  // It is currently unused.
   av1_diamond_search_fn_t diamond_search_sad;
@@ -503,6 +541,7 @@ typedef struct AV1_COMP {
   uint64_t time_compress_data;
   uint64_t time_pick_lpf;
   uint64_t time_encode_sb_row;
+  aom_enc_stage_stats_t stage_stats;
 
 #if CONFIG_FP_MB_STATS
   int use_fp_mb_stats;
@@ -579,6 +618,12 @@ typedef struct AV1_COMP {
   int resize_buffer_underflow;
   int resize_count;
 
+  // States of the random number generators of RESIZE_RANDOM and
+  // SUPERRES_RANDOM. They belong to the encoder instance, so that encoders
+  // running side by side stay deterministic.
+  unsigned int resize_seed;
+  unsigned int superres_seed;
+
   // VARIANCE_AQ segment map refresh
   int vaq_refresh;
 
@@ -817,6 +862,38 @@ static INLINE int av1_frame_unscaled(const AV1_COMMON *cm) {
 #endif  // CONFIG_HORZONLY_FRAME_SUPERRES
 }
 
+// Returns the decisions of the previous recode iteration at the given
+// position, or NULL if there are none to reuse.
+static INLINE const RecodeMiInfo *av1_get_recode_mi_info(const AV1_COMP *cpi,
+                                                         int mi_row,
+                                                         int mi_col) {
+  const RecodeCache *const cache = &cpi->recode_cache;
+  if (!cpi->sf.reuse_recode_decisions || !cache->valid ||
+      cache->mi_rows != cpi->common.mi_rows ||
+      cache->mi_cols != cpi->common.mi_cols)
+    return NULL;
+  return &cache->mi[mi_row * cache->mi_cols + mi_col];
+}
+
+void av1_accumulate_stage_stats(aom_enc_stage_stats_t *dst,
+                                const aom_enc_stage_stats_t *src);
+
+// Starts timing an encoder stage when stage statistics are enabled.
+static INLINE void av1_stage_timer_start(int enabled,
+                                         struct aom_usec_timer *timer) {
+  if (enabled) aom_usec_timer_start(timer);
+}
+
+// Adds the time elapsed since av1_stage_timer_start() to *stage_time.
+static INLINE void av1_stage_timer_accumulate(int enabled,
+                                              struct aom_usec_timer *timer,
+                                              int64_t *stage_time) {
+  if (enabled) {
+    aom_usec_timer_mark(timer);
+    *stage_time += aom_usec_timer_elapsed(timer);
+  }
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
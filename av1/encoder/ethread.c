@@ -9,6 +9,8 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <assert.h>
+
 #include "av1/encoder/encodeframe.h"
 #include "av1/encoder/encoder.h"
 #include "av1/encoder/ethread.h"
@@ -49,15 +51,11 @@ static int enc_worker_hook(EncWorkerData *const thread_data, void *unused) {
   return 0;
 }
 
-void av1_encode_tiles_mt(AV1_COMP *cpi) {
+static void create_enc_workers(AV1_COMP *cpi, int num_workers) {
   AV1_COMMON *const cm = &cpi->common;
-  const int tile_cols = cm->tile_cols;
   const AVxWorkerInterface *const winterface = aom_get_worker_interface();
-  const int num_workers = AOMMIN(cpi->oxcf.max_threads, tile_cols);
   int i;
 
-  av1_init_tile_data(cpi);
-
   // Only run once to create threads and allocate thread data.
   if (cpi->num_workers == 0) {
     CHECK_MEM_ERROR(cm, cpi->workers,
@@ -104,6 +102,8 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
             cm, thread_data->td->mask_buf,
             (int32_t *)aom_memalign(
                 16, MAX_SB_SQUARE * sizeof(*thread_data->td->mask_buf)));
+        CHECK_MEM_ERROR(cm, thread_data->td->cost_fc,
+                        aom_malloc(sizeof(*thread_data->td->cost_fc)));
         // Allocate frame counters in thread data.
         CHECK_MEM_ERROR(cm, thread_data->td->counts,
                         aom_calloc(1, sizeof(*thread_data->td->counts)));
@@ -112,6 +112,11 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
         CHECK_MEM_ERROR(
             cm, thread_data->td->palette_buffer,
             aom_memalign(16, sizeof(*thread_data->td->palette_buffer)));
+#if CONFIG_HASH_ME
+        CHECK_MEM_ERROR(
+            cm, thread_data->td->hash_value_buffer,
+            aom_malloc(sizeof(*thread_data->td->hash_value_buffer)));
+#endif
 
         // Create threads
         if (!winterface->reset(worker))
@@ -125,6 +130,33 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
       winterface->sync(worker);
     }
   }
+}
+
+// Gives a worker a copy of the main thread's MACROBLOCK that points at the
+// worker's own scratch buffers.
+static void setup_worker_mb(AV1_COMP *cpi, EncWorkerData *thread_data) {
+  if (thread_data->td == &cpi->td) return;
+  thread_data->td->mb = cpi->td.mb;
+  thread_data->td->mb.above_pred_buf = thread_data->td->above_pred_buf;
+  thread_data->td->mb.left_pred_buf = thread_data->td->left_pred_buf;
+  thread_data->td->mb.wsrc_buf = thread_data->td->wsrc_buf;
+  thread_data->td->mb.mask_buf = thread_data->td->mask_buf;
+  thread_data->td->mb.cost_fc = thread_data->td->cost_fc;
+  thread_data->td->mb.palette_buffer = thread_data->td->palette_buffer;
+#if CONFIG_HASH_ME
+  thread_data->td->mb.hash_value_buffer = thread_data->td->hash_value_buffer;
+#endif
+}
+
+void av1_encode_tiles_mt(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  const int tile_cols = cm->tile_cols;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  const int num_workers = AOMMIN(cpi->oxcf.max_threads, tile_cols);
+  int i;
+
+  av1_init_tile_data(cpi);
+  create_enc_workers(cpi, num_workers);
 
   for (i = 0; i < num_workers; i++) {
     AVxWorker *const worker = &cpi->workers[i];
@@ -136,21 +168,13 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
     thread_data = (EncWorkerData *)worker->data1;
 
     // Before encoding a frame, copy the thread data from cpi.
-    if (thread_data->td != &cpi->td) {
-      thread_data->td->mb = cpi->td.mb;
+    setup_worker_mb(cpi, thread_data);
+    if (thread_data->td != &cpi->td)
       thread_data->td->rd_counts = cpi->td.rd_counts;
-      thread_data->td->mb.above_pred_buf = thread_data->td->above_pred_buf;
-      thread_data->td->mb.left_pred_buf = thread_data->td->left_pred_buf;
-      thread_data->td->mb.wsrc_buf = thread_data->td->wsrc_buf;
-      thread_data->td->mb.mask_buf = thread_data->td->mask_buf;
-    }
     if (thread_data->td->counts != &cpi->common.counts) {
       memcpy(thread_data->td->counts, &cpi->common.counts,
              sizeof(cpi->common.counts));
     }
-
-    if (i < num_workers - 1)
-      thread_data->td->mb.palette_buffer = thread_data->td->palette_buffer;
   }
 
   // Encode a frame
@@ -184,6 +208,38 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
       av1_accumulate_frame_counts(&cm->counts, thread_data->td->counts);
       accumulate_rd_opt(&cpi->td, thread_data->td);
       cpi->td.mb.txb_split_count += thread_data->td->mb.txb_split_count;
+      av1_accumulate_stage_stats(&cpi->td.mb.stage_stats,
+                                 &thread_data->td->mb.stage_stats);
     }
   }
 }
+
+void av1_run_tile_workers(AV1_COMP *cpi, int num_workers, AVxWorkerHook hook,
+                          void *data2) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  int i;
+
+  create_enc_workers(cpi, num_workers);
+  assert(num_workers <= cpi->num_workers);
+
+  for (i = 0; i < num_workers; i++) {
+    AVxWorker *const worker = &cpi->workers[i];
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
+
+    worker->hook = hook;
+    worker->data1 = thread_data;
+    worker->data2 = data2;
+    thread_data->start = i;
+    setup_worker_mb(cpi, thread_data);
+  }
+
+  for (i = 0; i < num_workers; i++) {
+    AVxWorker *const worker = &cpi->workers[i];
+    if (i == cpi->num_workers - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+
+  for (i = 0; i < num_workers; i++) winterface->sync(&cpi->workers[i]);
+}
@@ -12,6 +12,8 @@
 #ifndef AV1_ENCODER_ETHREAD_H_
 #define AV1_ENCODER_ETHREAD_H_
 
+#include "aom_util/aom_thread.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -27,6 +29,13 @@ typedef struct EncWorkerData {
 
 void av1_encode_tiles_mt(struct AV1_COMP *cpi);
 
+// Runs hook on the first num_workers encoder workers, creating them if needed,
+// and waits for all of them to finish. Each worker gets a fresh copy of the
+// main thread's MACROBLOCK and its index in EncWorkerData::start. num_workers
+// must not exceed cpi->num_workers once the workers exist.
+void av1_run_tile_workers(struct AV1_COMP *cpi, int num_workers,
+                          AVxWorkerHook hook, void *data2);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -727,10 +727,11 @@ void av1_first_pass(AV1_COMP *cpi, const struct lookahead_entry *source) {
         // Compute the motion error of the 0,0 motion using the last source
         // frame as the reference. Skip the further motion search on
         // reconstructed frame if this error is small.
-        unscaled_last_source_buf_2d.buf =
-            cpi->unscaled_last_source->y_buffer + recon_yoffset;
         unscaled_last_source_buf_2d.stride =
             cpi->unscaled_last_source->y_stride;
+        unscaled_last_source_buf_2d.buf =
+            cpi->unscaled_last_source->y_buffer +
+            mb_row * 16 * unscaled_last_source_buf_2d.stride + mb_col * 16;
         if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
           raw_motion_error = highbd_get_prediction_error(
               bsize, &x->plane[0].src, &unscaled_last_source_buf_2d, xd->bd);
@@ -31,6 +31,17 @@ typedef struct _block_hash {
 
 typedef struct _hash_table { Vector **p_lookup_table; } hash_table;
 
+#define AOM_BUFFER_SIZE_FOR_BLOCK_HASH (4096)
+
+// Scratch space for av1_get_block_hash_value(). Each thread that hashes
+// blocks needs its own.
+typedef struct _block_hash_buffer {
+  // [first hash/second hash]
+  // [two buffers used ping-pong]
+  // [num of 2x2 blocks in 128x128]
+  uint32_t values[2][2][AOM_BUFFER_SIZE_FOR_BLOCK_HASH];
+} block_hash_buffer;
+
 void av1_hash_table_init(hash_table *p_hash_table);
 void av1_hash_table_destroy(hash_table *p_hash_table);
 void av1_hash_table_create(hash_table *p_hash_table);
@@ -63,7 +74,8 @@ int av1_hash_is_horizontal_perfect(const YV12_BUFFER_CONFIG *picture,
 int av1_hash_is_vertical_perfect(const YV12_BUFFER_CONFIG *picture,
                                  int block_size, int x_start, int y_start);
 void av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size,
-                              uint32_t *hash_value1, uint32_t *hash_value2);
+                              uint32_t *hash_value1, uint32_t *hash_value2,
+                              block_hash_buffer *buffer);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "./av1_rtcd.h"
 #include "av1/encoder/palette.h"
 #include "av1/encoder/random.h"
 
@@ -22,8 +23,10 @@
 
 #define RENAME_(x, y) AV1_K_MEANS_RENAME(x, y)
 #define RENAME(x) RENAME_(x, AV1_K_MEANS_DIM)
+#define RENAME_C_(x, y) AV1_K_MEANS_RENAME_C(x, y)
+#define RENAME_C(x) RENAME_C_(x, AV1_K_MEANS_DIM)
 
-static int RENAME(calc_dist)(const int *p1, const int *p2) {
+static int RENAME(calc_dist)(const int16_t *p1, const int *p2) {
   int dist = 0;
   for (int i = 0; i < AV1_K_MEANS_DIM; ++i) {
     const int diff = p1[i] - p2[i];
@@ -32,8 +35,8 @@ static int RENAME(calc_dist)(const int *p1, const int *p2) {
   return dist;
 }
 
-void RENAME(av1_calc_indices)(const int *data, const int *centroids,
-                              uint8_t *indices, int n, int k) {
+void RENAME_C(av1_calc_indices)(const int16_t *data, const int *centroids,
+                                uint8_t *indices, int n, int k) {
   for (int i = 0; i < n; ++i) {
     int min_dist = RENAME(calc_dist)(data + i * AV1_K_MEANS_DIM, centroids);
     indices[i] = 0;
@@ -48,7 +51,7 @@ void RENAME(av1_calc_indices)(const int *data, const int *centroids,
   }
 }
 
-static void RENAME(calc_centroids)(const int *data, int *centroids,
+static void RENAME(calc_centroids)(const int16_t *data, int *centroids,
                                    const uint8_t *indices, int n, int k) {
   int i, j;
   int count[PALETTE_MAX_SIZE] = { 0 };
@@ -67,9 +70,10 @@ static void RENAME(calc_centroids)(const int *data, int *centroids,
 
   for (i = 0; i < k; ++i) {
     if (count[i] == 0) {
-      memcpy(centroids + i * AV1_K_MEANS_DIM,
-             data + (lcg_rand16(&rand_state) % n) * AV1_K_MEANS_DIM,
-             sizeof(centroids[0]) * AV1_K_MEANS_DIM);
+      const int16_t *const p =
+          data + (lcg_rand16(&rand_state) % n) * AV1_K_MEANS_DIM;
+      for (j = 0; j < AV1_K_MEANS_DIM; ++j)
+        centroids[i * AV1_K_MEANS_DIM + j] = p[j];
     } else {
       for (j = 0; j < AV1_K_MEANS_DIM; ++j) {
         centroids[i * AV1_K_MEANS_DIM + j] =
@@ -79,7 +83,8 @@ static void RENAME(calc_centroids)(const int *data, int *centroids,
   }
 }
 
-static int64_t RENAME(calc_total_dist)(const int *data, const int *centroids,
+static int64_t RENAME(calc_total_dist)(const int16_t *data,
+                                       const int *centroids,
                                        const uint8_t *indices, int n, int k) {
   int64_t dist = 0;
   (void)k;
@@ -90,8 +95,8 @@ static int64_t RENAME(calc_total_dist)(const int *data, const int *centroids,
   return dist;
 }
 
-void RENAME(av1_k_means)(const int *data, int *centroids, uint8_t *indices,
-                         int n, int k, int max_itr) {
+void RENAME(av1_k_means)(const int16_t *data, int *centroids,
+                         uint8_t *indices, int n, int k, int max_itr) {
   int pre_centroids[2 * PALETTE_MAX_SIZE];
   uint8_t pre_indices[MAX_SB_SQUARE];
 
@@ -121,3 +126,5 @@ void RENAME(av1_k_means)(const int *data, int *centroids, uint8_t *indices,
 }
 #undef RENAME_
 #undef RENAME
+#undef RENAME_C_
+#undef RENAME_C
@@ -21,6 +21,11 @@ extern "C" {
 
 #define MAX_LAG_BUFFERS 25
 
+// Source frames are only extended as far as the encoder reads past their
+// edges (see av1_copy_and_extend_frame()), at most 64 pixels, so the lookahead
+// buffers do not need the full border of a reference frame.
+#define LOOKAHEAD_BORDER_IN_PIXELS 64
+
 struct lookahead_entry {
   YV12_BUFFER_CONFIG img;
   int64_t ts_start;
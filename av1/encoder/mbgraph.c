@@ -169,20 +169,24 @@ static int find_best_16x16_intra(AV1_COMP *cpi, PREDICTION_MODE *pbest_mode) {
 static void update_mbgraph_mb_stats(AV1_COMP *cpi, MBGRAPH_MB_STATS *stats,
                                     YV12_BUFFER_CONFIG *buf, int mb_y_offset,
                                     YV12_BUFFER_CONFIG *golden_ref,
+                                    int gld_y_offset,
                                     const MV *prev_golden_ref_mv,
-                                    YV12_BUFFER_CONFIG *alt_ref, int mb_row,
-                                    int mb_col) {
+                                    YV12_BUFFER_CONFIG *alt_ref,
+                                    int arf_y_offset, int mb_row, int mb_col) {
   MACROBLOCK *const x = &cpi->td.mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   int intra_error;
   AV1_COMMON *cm = &cpi->common;
+  YV12_BUFFER_CONFIG *const new_buf = get_frame_new_buffer(cm);
 
   // FIXME in practice we're completely ignoring chroma here
   x->plane[0].src.buf = buf->y_buffer + mb_y_offset;
   x->plane[0].src.stride = buf->y_stride;
 
-  xd->plane[0].dst.buf = get_frame_new_buffer(cm)->y_buffer + mb_y_offset;
-  xd->plane[0].dst.stride = get_frame_new_buffer(cm)->y_stride;
+  // Source frames and reconstructed frames may have different strides.
+  xd->plane[0].dst.buf =
+      new_buf->y_buffer + mb_row * 16 * new_buf->y_stride + mb_col * 16;
+  xd->plane[0].dst.stride = new_buf->y_stride;
 
   // do intra 16x16 prediction
   intra_error = find_best_16x16_intra(cpi, &stats->ref[INTRA_FRAME].m.mode);
@@ -192,7 +196,7 @@ static void update_mbgraph_mb_stats(AV1_COMP *cpi, MBGRAPH_MB_STATS *stats,
   // Golden frame MV search, if it exists and is different than last frame
   if (golden_ref) {
     int g_motion_error;
-    xd->plane[0].pre[0].buf = golden_ref->y_buffer + mb_y_offset;
+    xd->plane[0].pre[0].buf = golden_ref->y_buffer + gld_y_offset;
     xd->plane[0].pre[0].stride = golden_ref->y_stride;
     g_motion_error =
         do_16x16_motion_search(cpi, prev_golden_ref_mv, mb_row, mb_col);
@@ -207,7 +211,7 @@ static void update_mbgraph_mb_stats(AV1_COMP *cpi, MBGRAPH_MB_STATS *stats,
   // last/golden frame.
   if (alt_ref) {
     int a_motion_error;
-    xd->plane[0].pre[0].buf = alt_ref->y_buffer + mb_y_offset;
+    xd->plane[0].pre[0].buf = alt_ref->y_buffer + arf_y_offset;
     xd->plane[0].pre[0].stride = alt_ref->y_stride;
     a_motion_error =
         do_16x16_zerozero_search(cpi, &stats->ref[ALTREF_FRAME].m.mv);
@@ -263,7 +267,8 @@ static void update_mbgraph_frame_stats(AV1_COMP *cpi,
       MBGRAPH_MB_STATS *mb_stats = &stats->mb_stats[offset + mb_col];
 
       update_mbgraph_mb_stats(cpi, mb_stats, buf, mb_y_in_offset, golden_ref,
-                              &gld_left_mv, alt_ref, mb_row, mb_col);
+                              gld_y_in_offset, &gld_left_mv, alt_ref,
+                              arf_y_in_offset, mb_row, mb_col);
       gld_left_mv = mb_stats->ref[GOLDEN_FRAME].m.mv.as_mv;
       if (mb_col == 0) {
         gld_top_mv = gld_left_mv;
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_PARTITION_MODEL_WEIGHTS_H_
+#define AV1_ENCODER_PARTITION_MODEL_WEIGHTS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Models used to prune the partition search of square blocks once
+// PARTITION_NONE has been evaluated. The features are, in order:
+//   log2 of the block width in 4-pixel units,
+//   base q index,
+//   log(1 + per-pixel source variance),
+//   log(1 + PARTITION_NONE rate per pixel),
+//   log(1 + PARTITION_NONE distortion per pixel),
+//   depth difference with the above neighbour,
+//   depth difference with the left neighbour,
+//   whether PARTITION_NONE is skippable.
+// Each model has one hidden layer of AV1_PARTITION_PRUNE_HIDDEN_UNITS ReLU
+// units. The weights are stored as the hidden layer weights, the hidden layer
+// biases, the output weights and the output bias. A score below the
+// threshold prunes the corresponding partition types.
+#define PARTITION_PRUNE_FEATURES 8
+#define AV1_PARTITION_PRUNE_HIDDEN_UNITS 8
+
+// Predicts whether PARTITION_SPLIT will be chosen.
+static const float av1_partition_prune_split_weights[] = {
+  1.24793f, 0.00239f, 0.06186f, -0.73994f, -1.33093f, -0.11336f, -2.66022f,
+  1.41930f, -2.05757f, -0.00755f, -0.75851f, -0.31760f, 1.40548f, -0.26045f,
+  -2.20021f, 2.66133f, -4.63544f, 0.07653f, -0.74742f, -2.21692f, -1.08297f,
+  -0.88202f, -3.21311f, 10.56915f, -4.09815f, 0.00216f, -0.86591f, -0.88257f,
+  -0.04507f, -2.21291f, 1.20174f, 4.80627f, -0.45740f, -0.04169f, -0.62329f,
+  -1.46704f, 0.87378f, -0.30900f, 0.06368f, 2.15991f, 3.18397f, -0.00872f,
+  0.56439f, 0.91298f, 0.83343f, -0.23195f, 0.35222f, 1.67939f, 0.48206f,
+  -0.00989f, -0.04454f, 0.74431f, 0.64605f, -2.24814f, 0.27473f, 2.11933f,
+  -0.17107f, -0.00932f, 0.32414f, -0.17069f, 0.10714f, 0.69248f, 1.16759f,
+  -1.82633f, 5.32458f, -0.79977f, 14.84766f, 9.63671f, 14.46231f, -19.82627f,
+  -9.29852f, -0.17205f, -0.74523f, 1.41509f, -2.41489f, 1.46346f, -1.07517f,
+  0.66336f, -0.51996f, 0.51414f, -0.20307f,
+};
+static const float av1_partition_prune_split_thresh = -1.73791f;
+
+// Predicts whether a rectangular or extended partition type will be chosen.
+static const float av1_partition_prune_rect_weights[] = {
+  3.77173f, 0.02500f, -0.99797f, 1.72179f, 0.06695f, 0.57948f, 0.07663f,
+  1.86714f, -1.44178f, -0.00218f, -0.00320f, 0.14740f, 0.10226f, -0.54964f,
+  1.64256f, -0.15815f, 0.00506f, -0.00035f, -0.12076f, -0.58788f, -0.28913f,
+  -0.05290f, -0.19313f, 0.29050f, 1.03414f, 0.00294f, 0.57116f, 0.43698f,
+  0.12314f, 0.94893f, 0.41168f, 1.83672f, -0.46136f, 0.02398f, 0.38828f,
+  -0.27221f, -0.68921f, 1.73869f, 0.19225f, -3.81463f, 1.33015f, -0.06160f,
+  -0.50907f, 1.32884f, 2.76410f, -0.07520f, -0.05873f, -0.89021f, -0.91449f,
+  -0.00891f, 0.08758f, 1.03968f, 0.76670f, -0.49328f, 0.05542f, 2.93637f,
+  -3.63602f, 0.01091f, 0.11674f, -1.53695f, -0.30174f, -0.39498f, -0.07461f,
+  -1.24655f, -17.80698f, -0.65189f, 6.29724f, -11.52132f, 1.07066f, -16.34284f,
+  -11.76895f, 12.60711f, -0.91707f, 0.46923f, -0.48218f, -0.74120f, 0.57006f,
+  0.64243f, -1.02375f, -0.68819f, -0.48401f,
+};
+static const float av1_partition_prune_rect_thresh = -1.53743f;
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_PARTITION_MODEL_WEIGHTS_H_
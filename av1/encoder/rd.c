@@ -104,18 +104,33 @@ static const int av1_ext_tx_set_idx_to_type[2][AOMMAX(EXT_TX_SETS_INTRA,
   },
 };
 
+// Most CDFs are not touched while a single superblock is coded, so the rate
+// tables are only refilled for the CDFs that differ from the copy in
+// x->cost_fc, which is brought up to date as a side effect.
+static int cdfs_changed(const MACROBLOCK *x, const FRAME_CONTEXT *fc,
+                        const void *cdfs, size_t size) {
+  uint8_t *const prev =
+      (uint8_t *)x->cost_fc + ((const uint8_t *)cdfs - (const uint8_t *)fc);
+  if (x->cost_fc_valid && !memcmp(cdfs, prev, size)) return 0;
+  memcpy(prev, cdfs, size);
+  return 1;
+}
+
+#define CDFS_CHANGED(x, fc, cdfs) \
+  cdfs_changed((x), (fc), &(fc)->cdfs, sizeof((fc)->cdfs))
+
 void av1_fill_mode_rates(AV1_COMMON *const cm, MACROBLOCK *x,
                          FRAME_CONTEXT *fc) {
   int i, j;
 
-  if (cm->frame_type == KEY_FRAME) {
+  if (cm->frame_type == KEY_FRAME && CDFS_CHANGED(x, fc, partition_cdf)) {
     for (i = 0; i < PARTITION_CONTEXTS_PRIMARY; ++i)
       av1_cost_tokens_from_cdf(x->partition_cost[i], fc->partition_cdf[i],
                                NULL);
   }
 
 #if CONFIG_EXT_SKIP
-  if (cm->skip_mode_flag) {
+  if (cm->skip_mode_flag && CDFS_CHANGED(x, fc, skip_mode_cdfs)) {
     for (i = 0; i < SKIP_CONTEXTS; ++i) {
       av1_cost_tokens_from_cdf(x->skip_mode_cost[i], fc->skip_mode_cdfs[i],
                                NULL);
@@ -123,232 +138,331 @@ void av1_fill_mode_rates(AV1_COMMON *const cm, MACROBLOCK *x,
   }
 #endif  // CONFIG_EXT_SKIP
 
-  for (i = 0; i < SKIP_CONTEXTS; ++i) {
-    av1_cost_tokens_from_cdf(x->skip_cost[i], fc->skip_cdfs[i], NULL);
+  if (CDFS_CHANGED(x, fc, skip_cdfs)) {
+    for (i = 0; i < SKIP_CONTEXTS; ++i) {
+      av1_cost_tokens_from_cdf(x->skip_cost[i], fc->skip_cdfs[i], NULL);
+    }
   }
 
+  if (CDFS_CHANGED(x, fc, kf_y_cdf)) {
 #if CONFIG_KF_CTX
-  for (i = 0; i < KF_MODE_CONTEXTS; ++i)
-    for (j = 0; j < KF_MODE_CONTEXTS; ++j)
-      av1_cost_tokens_from_cdf(x->y_mode_costs[i][j], fc->kf_y_cdf[i][j], NULL);
+    for (i = 0; i < KF_MODE_CONTEXTS; ++i)
+      for (j = 0; j < KF_MODE_CONTEXTS; ++j)
+        av1_cost_tokens_from_cdf(x->y_mode_costs[i][j], fc->kf_y_cdf[i][j],
+                                 NULL);
 #else
-  for (i = 0; i < INTRA_MODES; ++i)
-    for (j = 0; j < INTRA_MODES; ++j)
-      av1_cost_tokens_from_cdf(x->y_mode_costs[i][j], fc->kf_y_cdf[i][j], NULL);
+    for (i = 0; i < INTRA_MODES; ++i)
+      for (j = 0; j < INTRA_MODES; ++j)
+        av1_cost_tokens_from_cdf(x->y_mode_costs[i][j], fc->kf_y_cdf[i][j],
+                                 NULL);
 #endif
+  }
 
-  for (i = 0; i < BLOCK_SIZE_GROUPS; ++i)
-    av1_cost_tokens_from_cdf(x->mbmode_cost[i], fc->y_mode_cdf[i], NULL);
+  if (CDFS_CHANGED(x, fc, y_mode_cdf)) {
+    for (i = 0; i < BLOCK_SIZE_GROUPS; ++i)
+      av1_cost_tokens_from_cdf(x->mbmode_cost[i], fc->y_mode_cdf[i], NULL);
+  }
+  if (CDFS_CHANGED(x, fc, uv_mode_cdf)) {
 #if CONFIG_CFL
-  for (i = 0; i < CFL_ALLOWED_TYPES; ++i)
-    for (j = 0; j < INTRA_MODES; ++j)
-      av1_cost_tokens_from_cdf(x->intra_uv_mode_cost[i][j],
-                               fc->uv_mode_cdf[i][j], NULL);
+    for (i = 0; i < CFL_ALLOWED_TYPES; ++i)
+      for (j = 0; j < INTRA_MODES; ++j)
+        av1_cost_tokens_from_cdf(x->intra_uv_mode_cost[i][j],
+                                 fc->uv_mode_cdf[i][j], NULL);
 #else
-  for (i = 0; i < INTRA_MODES; ++i)
-    av1_cost_tokens_from_cdf(x->intra_uv_mode_cost[i], fc->uv_mode_cdf[i],
-                             NULL);
+    for (i = 0; i < INTRA_MODES; ++i)
+      av1_cost_tokens_from_cdf(x->intra_uv_mode_cost[i], fc->uv_mode_cdf[i],
+                               NULL);
 #endif
+  }
 
 #if CONFIG_FILTER_INTRA
-  av1_cost_tokens_from_cdf(x->filter_intra_mode_cost, fc->filter_intra_mode_cdf,
-                           NULL);
-  for (i = 0; i < TX_SIZES_ALL; ++i)
-    av1_cost_tokens_from_cdf(x->filter_intra_cost[i], fc->filter_intra_cdfs[i],
-                             NULL);
+  if (CDFS_CHANGED(x, fc, filter_intra_mode_cdf))
+    av1_cost_tokens_from_cdf(x->filter_intra_mode_cost,
+                             fc->filter_intra_mode_cdf, NULL);
+  if (CDFS_CHANGED(x, fc, filter_intra_cdfs)) {
+    for (i = 0; i < TX_SIZES_ALL; ++i)
+      av1_cost_tokens_from_cdf(x->filter_intra_cost[i],
+                               fc->filter_intra_cdfs[i], NULL);
+  }
 #endif
 
-  for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-    av1_cost_tokens_from_cdf(x->switchable_interp_costs[i],
-                             fc->switchable_interp_cdf[i], NULL);
-
-  for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
-    av1_cost_tokens_from_cdf(x->palette_y_size_cost[i],
-                             fc->palette_y_size_cdf[i], NULL);
-    av1_cost_tokens_from_cdf(x->palette_uv_size_cost[i],
-                             fc->palette_uv_size_cdf[i], NULL);
-    for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j) {
-      av1_cost_tokens_from_cdf(x->palette_y_mode_cost[i][j],
-                               fc->palette_y_mode_cdf[i][j], NULL);
+  if (CDFS_CHANGED(x, fc, switchable_interp_cdf)) {
+    for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
+      av1_cost_tokens_from_cdf(x->switchable_interp_costs[i],
+                               fc->switchable_interp_cdf[i], NULL);
+  }
+
+  if (CDFS_CHANGED(x, fc, palette_y_size_cdf)) {
+    for (i = 0; i < PALATTE_BSIZE_CTXS; ++i)
+      av1_cost_tokens_from_cdf(x->palette_y_size_cost[i],
+                               fc->palette_y_size_cdf[i], NULL);
+  }
+  if (CDFS_CHANGED(x, fc, palette_uv_size_cdf)) {
+    for (i = 0; i < PALATTE_BSIZE_CTXS; ++i)
+      av1_cost_tokens_from_cdf(x->palette_uv_size_cost[i],
+                               fc->palette_uv_size_cdf[i], NULL);
+  }
+  if (CDFS_CHANGED(x, fc, palette_y_mode_cdf)) {
+    for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
+      for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j) {
+        av1_cost_tokens_from_cdf(x->palette_y_mode_cost[i][j],
+                                 fc->palette_y_mode_cdf[i][j], NULL);
+      }
     }
   }
 
-  for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i) {
-    av1_cost_tokens_from_cdf(x->palette_uv_mode_cost[i],
-                             fc->palette_uv_mode_cdf[i], NULL);
+  if (CDFS_CHANGED(x, fc, palette_uv_mode_cdf)) {
+    for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i) {
+      av1_cost_tokens_from_cdf(x->palette_uv_mode_cost[i],
+                               fc->palette_uv_mode_cdf[i], NULL);
+    }
   }
 
-  for (i = 0; i < PALETTE_SIZES; ++i) {
-    for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
-      av1_cost_tokens_from_cdf(x->palette_y_color_cost[i][j],
-                               fc->palette_y_color_index_cdf[i][j], NULL);
-      av1_cost_tokens_from_cdf(x->palette_uv_color_cost[i][j],
-                               fc->palette_uv_color_index_cdf[i][j], NULL);
+  if (CDFS_CHANGED(x, fc, palette_y_color_index_cdf)) {
+    for (i = 0; i < PALETTE_SIZES; ++i) {
+      for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
+        av1_cost_tokens_from_cdf(x->palette_y_color_cost[i][j],
+                                 fc->palette_y_color_index_cdf[i][j], NULL);
+      }
+    }
+  }
+  if (CDFS_CHANGED(x, fc, palette_uv_color_index_cdf)) {
+    for (i = 0; i < PALETTE_SIZES; ++i) {
+      for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
+        av1_cost_tokens_from_cdf(x->palette_uv_color_cost[i][j],
+                                 fc->palette_uv_color_index_cdf[i][j], NULL);
+      }
     }
   }
 
 #if CONFIG_CFL
-  int sign_cost[CFL_JOINT_SIGNS];
-  av1_cost_tokens_from_cdf(sign_cost, fc->cfl_sign_cdf, NULL);
-  for (int joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
-    int *cost_u = x->cfl_cost[joint_sign][CFL_PRED_U];
-    int *cost_v = x->cfl_cost[joint_sign][CFL_PRED_V];
-    if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO) {
-      memset(cost_u, 0, CFL_ALPHABET_SIZE * sizeof(*cost_u));
-    } else {
-      const aom_cdf_prob *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
-      av1_cost_tokens_from_cdf(cost_u, cdf_u, NULL);
-    }
-    if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO) {
-      memset(cost_v, 0, CFL_ALPHABET_SIZE * sizeof(*cost_v));
-    } else {
-      const aom_cdf_prob *cdf_v = fc->cfl_alpha_cdf[CFL_CONTEXT_V(joint_sign)];
-      av1_cost_tokens_from_cdf(cost_v, cdf_v, NULL);
+  // Both CDFs must be compared so that the copy of each stays current.
+  if (CDFS_CHANGED(x, fc, cfl_sign_cdf) | CDFS_CHANGED(x, fc, cfl_alpha_cdf)) {
+    int sign_cost[CFL_JOINT_SIGNS];
+    av1_cost_tokens_from_cdf(sign_cost, fc->cfl_sign_cdf, NULL);
+    for (int joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
+      int *cost_u = x->cfl_cost[joint_sign][CFL_PRED_U];
+      int *cost_v = x->cfl_cost[joint_sign][CFL_PRED_V];
+      if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO) {
+        memset(cost_u, 0, CFL_ALPHABET_SIZE * sizeof(*cost_u));
+      } else {
+        const aom_cdf_prob *cdf_u =
+            fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
+        av1_cost_tokens_from_cdf(cost_u, cdf_u, NULL);
+      }
+      if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO) {
+        memset(cost_v, 0, CFL_ALPHABET_SIZE * sizeof(*cost_v));
+      } else {
+        const aom_cdf_prob *cdf_v =
+            fc->cfl_alpha_cdf[CFL_CONTEXT_V(joint_sign)];
+        av1_cost_tokens_from_cdf(cost_v, cdf_v, NULL);
+      }
+      for (int u = 0; u < CFL_ALPHABET_SIZE; u++)
+        cost_u[u] += sign_cost[joint_sign];
     }
-    for (int u = 0; u < CFL_ALPHABET_SIZE; u++)
-      cost_u[u] += sign_cost[joint_sign];
   }
 #endif  // CONFIG_CFL
 
-  for (i = 0; i < MAX_TX_CATS; ++i)
-    for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
-      av1_cost_tokens_from_cdf(x->tx_size_cost[i][j], fc->tx_size_cdf[i][j],
-                               NULL);
+  if (CDFS_CHANGED(x, fc, tx_size_cdf)) {
+    for (i = 0; i < MAX_TX_CATS; ++i)
+      for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
+        av1_cost_tokens_from_cdf(x->tx_size_cost[i][j], fc->tx_size_cdf[i][j],
+                                 NULL);
+  }
 
-  for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
-    av1_cost_tokens_from_cdf(x->txfm_partition_cost[i],
-                             fc->txfm_partition_cdf[i], NULL);
+  if (CDFS_CHANGED(x, fc, txfm_partition_cdf)) {
+    for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
+      av1_cost_tokens_from_cdf(x->txfm_partition_cost[i],
+                               fc->txfm_partition_cdf[i], NULL);
+    }
   }
 
-  for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
-    int s;
-    for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
-      if (use_inter_ext_tx_for_txsize[s][i]) {
-        av1_cost_tokens_from_cdf(
-            x->inter_tx_type_costs[s][i], fc->inter_ext_tx_cdf[s][i],
-            av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
+  if (CDFS_CHANGED(x, fc, inter_ext_tx_cdf)) {
+    for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
+      int s;
+      for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
+        if (use_inter_ext_tx_for_txsize[s][i]) {
+          av1_cost_tokens_from_cdf(
+              x->inter_tx_type_costs[s][i], fc->inter_ext_tx_cdf[s][i],
+              av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
+        }
       }
     }
-    for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
-      if (use_intra_ext_tx_for_txsize[s][i]) {
-        for (j = 0; j < INTRA_MODES; ++j) {
-          av1_cost_tokens_from_cdf(
-              x->intra_tx_type_costs[s][i][j], fc->intra_ext_tx_cdf[s][i][j],
-              av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+  }
+  if (CDFS_CHANGED(x, fc, intra_ext_tx_cdf)) {
+    for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
+      int s;
+      for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
+        if (use_intra_ext_tx_for_txsize[s][i]) {
+          for (j = 0; j < INTRA_MODES; ++j) {
+            av1_cost_tokens_from_cdf(
+                x->intra_tx_type_costs[s][i][j], fc->intra_ext_tx_cdf[s][i][j],
+                av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+          }
         }
       }
     }
   }
 #if CONFIG_EXT_INTRA_MOD
-  for (i = 0; i < DIRECTIONAL_MODES; ++i) {
-    av1_cost_tokens_from_cdf(x->angle_delta_cost[i], fc->angle_delta_cdf[i],
-                             NULL);
+  if (CDFS_CHANGED(x, fc, angle_delta_cdf)) {
+    for (i = 0; i < DIRECTIONAL_MODES; ++i) {
+      av1_cost_tokens_from_cdf(x->angle_delta_cost[i], fc->angle_delta_cdf[i],
+                               NULL);
+    }
   }
 #endif  // CONFIG_EXT_INTRA_MOD
 #if CONFIG_LOOP_RESTORATION
-  av1_cost_tokens_from_cdf(x->switchable_restore_cost,
-                           fc->switchable_restore_cdf, NULL);
-  av1_cost_tokens_from_cdf(x->wiener_restore_cost, fc->wiener_restore_cdf,
-                           NULL);
-  av1_cost_tokens_from_cdf(x->sgrproj_restore_cost, fc->sgrproj_restore_cdf,
-                           NULL);
+  if (CDFS_CHANGED(x, fc, switchable_restore_cdf))
+    av1_cost_tokens_from_cdf(x->switchable_restore_cost,
+                             fc->switchable_restore_cdf, NULL);
+  if (CDFS_CHANGED(x, fc, wiener_restore_cdf))
+    av1_cost_tokens_from_cdf(x->wiener_restore_cost, fc->wiener_restore_cdf,
+                             NULL);
+  if (CDFS_CHANGED(x, fc, sgrproj_restore_cdf))
+    av1_cost_tokens_from_cdf(x->sgrproj_restore_cost, fc->sgrproj_restore_cdf,
+                             NULL);
 #endif  // CONFIG_LOOP_RESTORATION
 #if CONFIG_INTRABC
-  av1_cost_tokens_from_cdf(x->intrabc_cost, fc->intrabc_cdf, NULL);
+  if (CDFS_CHANGED(x, fc, intrabc_cdf))
+    av1_cost_tokens_from_cdf(x->intrabc_cost, fc->intrabc_cdf, NULL);
 #endif  // CONFIG_INTRABC
 
   if (!frame_is_intra_only(cm)) {
-    for (i = 0; i < COMP_INTER_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->comp_inter_cost[i], fc->comp_inter_cdf[i],
-                               NULL);
+    if (CDFS_CHANGED(x, fc, comp_inter_cdf)) {
+      for (i = 0; i < COMP_INTER_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->comp_inter_cost[i], fc->comp_inter_cdf[i],
+                                 NULL);
+      }
     }
 
-    for (i = 0; i < REF_CONTEXTS; ++i) {
-      for (j = 0; j < SINGLE_REFS - 1; ++j) {
-        av1_cost_tokens_from_cdf(x->single_ref_cost[i][j],
-                                 fc->single_ref_cdf[i][j], NULL);
+    if (CDFS_CHANGED(x, fc, single_ref_cdf)) {
+      for (i = 0; i < REF_CONTEXTS; ++i) {
+        for (j = 0; j < SINGLE_REFS - 1; ++j) {
+          av1_cost_tokens_from_cdf(x->single_ref_cost[i][j],
+                                   fc->single_ref_cdf[i][j], NULL);
+        }
       }
     }
 
 #if CONFIG_EXT_COMP_REFS
-    for (i = 0; i < REF_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->comp_ref_type_cost[i],
-                               fc->comp_ref_type_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, comp_ref_type_cdf)) {
+      for (i = 0; i < REF_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->comp_ref_type_cost[i],
+                                 fc->comp_ref_type_cdf[i], NULL);
+      }
     }
 
-    for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
-      for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j) {
-        av1_cost_tokens_from_cdf(x->uni_comp_ref_cost[i][j],
-                                 fc->uni_comp_ref_cdf[i][j], NULL);
+    if (CDFS_CHANGED(x, fc, uni_comp_ref_cdf)) {
+      for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
+        for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j) {
+          av1_cost_tokens_from_cdf(x->uni_comp_ref_cost[i][j],
+                                   fc->uni_comp_ref_cdf[i][j], NULL);
+        }
       }
     }
 #endif  // CONFIG_EXT_COMP_REFS
 
-    for (i = 0; i < REF_CONTEXTS; ++i) {
-      for (j = 0; j < FWD_REFS - 1; ++j) {
-        av1_cost_tokens_from_cdf(x->comp_ref_cost[i][j], fc->comp_ref_cdf[i][j],
-                                 NULL);
+    if (CDFS_CHANGED(x, fc, comp_ref_cdf)) {
+      for (i = 0; i < REF_CONTEXTS; ++i) {
+        for (j = 0; j < FWD_REFS - 1; ++j) {
+          av1_cost_tokens_from_cdf(x->comp_ref_cost[i][j],
+                                   fc->comp_ref_cdf[i][j], NULL);
+        }
       }
     }
 
-    for (i = 0; i < COMP_BWDREF_CONTEXTS; ++i) {
-      for (j = 0; j < BWD_REFS - 1; ++j) {
-        av1_cost_tokens_from_cdf(x->comp_bwdref_cost[i][j],
-                                 fc->comp_bwdref_cdf[i][j], NULL);
+    if (CDFS_CHANGED(x, fc, comp_bwdref_cdf)) {
+      for (i = 0; i < COMP_BWDREF_CONTEXTS; ++i) {
+        for (j = 0; j < BWD_REFS - 1; ++j) {
+          av1_cost_tokens_from_cdf(x->comp_bwdref_cost[i][j],
+                                   fc->comp_bwdref_cdf[i][j], NULL);
+        }
       }
     }
 
-    for (i = 0; i < INTRA_INTER_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->intra_inter_cost[i], fc->intra_inter_cdf[i],
-                               NULL);
+    if (CDFS_CHANGED(x, fc, intra_inter_cdf)) {
+      for (i = 0; i < INTRA_INTER_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->intra_inter_cost[i],
+                                 fc->intra_inter_cdf[i], NULL);
+      }
     }
 
-    for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->newmv_mode_cost[i], fc->newmv_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, newmv_cdf)) {
+      for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->newmv_mode_cost[i], fc->newmv_cdf[i],
+                                 NULL);
+      }
     }
 
-    for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->zeromv_mode_cost[i], fc->zeromv_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, zeromv_cdf)) {
+      for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->zeromv_mode_cost[i], fc->zeromv_cdf[i],
+                                 NULL);
+      }
     }
 
-    for (i = 0; i < REFMV_MODE_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->refmv_mode_cost[i], fc->refmv_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, refmv_cdf)) {
+      for (i = 0; i < REFMV_MODE_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->refmv_mode_cost[i], fc->refmv_cdf[i],
+                                 NULL);
+      }
     }
 
-    for (i = 0; i < DRL_MODE_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->drl_mode_cost0[i], fc->drl_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, drl_cdf)) {
+      for (i = 0; i < DRL_MODE_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->drl_mode_cost0[i], fc->drl_cdf[i], NULL);
+      }
     }
-    for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
-      av1_cost_tokens_from_cdf(x->inter_compound_mode_cost[i],
-                               fc->inter_compound_mode_cdf[i], NULL);
-    for (i = 0; i < BLOCK_SIZES_ALL; ++i)
-      av1_cost_tokens_from_cdf(x->compound_type_cost[i],
-                               fc->compound_type_cdf[i], NULL);
-    for (i = 0; i < BLOCK_SIZE_GROUPS; ++i) {
-      av1_cost_tokens_from_cdf(x->interintra_cost[i], fc->interintra_cdf[i],
-                               NULL);
-      av1_cost_tokens_from_cdf(x->interintra_mode_cost[i],
-                               fc->interintra_mode_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, inter_compound_mode_cdf)) {
+      for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
+        av1_cost_tokens_from_cdf(x->inter_compound_mode_cost[i],
+                                 fc->inter_compound_mode_cdf[i], NULL);
     }
-    for (i = 0; i < BLOCK_SIZES_ALL; ++i) {
-      av1_cost_tokens_from_cdf(x->wedge_interintra_cost[i],
-                               fc->wedge_interintra_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, compound_type_cdf)) {
+      for (i = 0; i < BLOCK_SIZES_ALL; ++i)
+        av1_cost_tokens_from_cdf(x->compound_type_cost[i],
+                                 fc->compound_type_cdf[i], NULL);
     }
-    for (i = BLOCK_8X8; i < BLOCK_SIZES_ALL; i++) {
-      av1_cost_tokens_from_cdf(x->motion_mode_cost[i], fc->motion_mode_cdf[i],
-                               NULL);
+    if (CDFS_CHANGED(x, fc, interintra_cdf)) {
+      for (i = 0; i < BLOCK_SIZE_GROUPS; ++i)
+        av1_cost_tokens_from_cdf(x->interintra_cost[i], fc->interintra_cdf[i],
+                                 NULL);
+    }
+    if (CDFS_CHANGED(x, fc, interintra_mode_cdf)) {
+      for (i = 0; i < BLOCK_SIZE_GROUPS; ++i)
+        av1_cost_tokens_from_cdf(x->interintra_mode_cost[i],
+                                 fc->interintra_mode_cdf[i], NULL);
+    }
+    if (CDFS_CHANGED(x, fc, wedge_interintra_cdf)) {
+      for (i = 0; i < BLOCK_SIZES_ALL; ++i) {
+        av1_cost_tokens_from_cdf(x->wedge_interintra_cost[i],
+                                 fc->wedge_interintra_cdf[i], NULL);
+      }
     }
-    for (i = BLOCK_8X8; i < BLOCK_SIZES_ALL; i++) {
-      av1_cost_tokens_from_cdf(x->motion_mode_cost1[i], fc->obmc_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, motion_mode_cdf)) {
+      for (i = BLOCK_8X8; i < BLOCK_SIZES_ALL; i++) {
+        av1_cost_tokens_from_cdf(x->motion_mode_cost[i],
+                                 fc->motion_mode_cdf[i], NULL);
+      }
+    }
+    if (CDFS_CHANGED(x, fc, obmc_cdf)) {
+      for (i = BLOCK_8X8; i < BLOCK_SIZES_ALL; i++) {
+        av1_cost_tokens_from_cdf(x->motion_mode_cost1[i], fc->obmc_cdf[i],
+                                 NULL);
+      }
     }
 #if CONFIG_JNT_COMP
-    for (i = 0; i < COMP_INDEX_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->comp_idx_cost[i], fc->compound_index_cdf[i],
-                               NULL);
+    if (CDFS_CHANGED(x, fc, compound_index_cdf)) {
+      for (i = 0; i < COMP_INDEX_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->comp_idx_cost[i],
+                                 fc->compound_index_cdf[i], NULL);
+      }
     }
-    for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->comp_group_idx_cost[i],
-                               fc->comp_group_idx_cdf[i], NULL);
+    if (CDFS_CHANGED(x, fc, comp_group_idx_cdf)) {
+      for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->comp_group_idx_cost[i],
+                                 fc->comp_group_idx_cdf[i], NULL);
+      }
     }
 #endif  // CONFIG_JNT_COMP
   }
@@ -489,56 +603,99 @@ void av1_set_mvcost(MACROBLOCK *x, MV_REFERENCE_FRAME ref_frame, int ref,
 
 #if CONFIG_LV_MAP
 void av1_fill_coeff_costs(MACROBLOCK *x, FRAME_CONTEXT *fc) {
+  int dc_sign_changed[PLANE_TYPES];
+
   for (int eob_multi_size = 0; eob_multi_size < 7; ++eob_multi_size) {
     for (int plane = 0; plane < PLANE_TYPES; ++plane) {
       LV_MAP_EOB_COST *pcost = &x->eob_costs[eob_multi_size][plane];
+      aom_cdf_prob *pcdf;
+      size_t size;
+      switch (eob_multi_size) {
+        case 0:
+          pcdf = fc->eob_flag_cdf16[plane][0];
+          size = sizeof(fc->eob_flag_cdf16[plane]);
+          break;
+        case 1:
+          pcdf = fc->eob_flag_cdf32[plane][0];
+          size = sizeof(fc->eob_flag_cdf32[plane]);
+          break;
+        case 2:
+          pcdf = fc->eob_flag_cdf64[plane][0];
+          size = sizeof(fc->eob_flag_cdf64[plane]);
+          break;
+        case 3:
+          pcdf = fc->eob_flag_cdf128[plane][0];
+          size = sizeof(fc->eob_flag_cdf128[plane]);
+          break;
+        case 4:
+          pcdf = fc->eob_flag_cdf256[plane][0];
+          size = sizeof(fc->eob_flag_cdf256[plane]);
+          break;
+        case 5:
+          pcdf = fc->eob_flag_cdf512[plane][0];
+          size = sizeof(fc->eob_flag_cdf512[plane]);
+          break;
+        case 6:
+        default:
+          pcdf = fc->eob_flag_cdf1024[plane][0];
+          size = sizeof(fc->eob_flag_cdf1024[plane]);
+          break;
+      }
+      if (!cdfs_changed(x, fc, pcdf, size)) continue;
 
+      // The two contexts are stored back to back.
       for (int ctx = 0; ctx < 2; ++ctx) {
-        aom_cdf_prob *pcdf;
-        switch (eob_multi_size) {
-          case 0: pcdf = fc->eob_flag_cdf16[plane][ctx]; break;
-          case 1: pcdf = fc->eob_flag_cdf32[plane][ctx]; break;
-          case 2: pcdf = fc->eob_flag_cdf64[plane][ctx]; break;
-          case 3: pcdf = fc->eob_flag_cdf128[plane][ctx]; break;
-          case 4: pcdf = fc->eob_flag_cdf256[plane][ctx]; break;
-          case 5: pcdf = fc->eob_flag_cdf512[plane][ctx]; break;
-          case 6:
-          default: pcdf = fc->eob_flag_cdf1024[plane][ctx]; break;
-        }
-        av1_cost_tokens_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
-#if 0
-            printf("[%d, %d, %d]: ", eob_multi_size, plane, ctx);
-            for (int i = 0; i < 5; i++) {
-              printf("(%d, %d, %d) ", i, pcost->eob_cost[ctx][i], pcdf[i]);
-            }
-            printf("\n");
-#endif
+        const size_t cdf_size = size / sizeof(*pcdf) / 2;
+        av1_cost_tokens_from_cdf(pcost->eob_cost[ctx], pcdf + ctx * cdf_size,
+                                 NULL);
       }
     }
   }
+
+  // These CDFs are shared by several of the tables filled below, so they are
+  // only compared once.
+  for (int plane = 0; plane < PLANE_TYPES; ++plane)
+    dc_sign_changed[plane] = CDFS_CHANGED(x, fc, dc_sign_cdf[plane]);
+
   for (int tx_size = 0; tx_size < TX_SIZES; ++tx_size) {
+    const int txb_skip_changed = CDFS_CHANGED(x, fc, txb_skip_cdf[tx_size]);
+
     for (int plane = 0; plane < PLANE_TYPES; ++plane) {
       LV_MAP_COEFF_COST *pcost = &x->coeff_costs[tx_size][plane];
 
-      for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->txb_skip_cost[ctx],
-                                 fc->txb_skip_cdf[tx_size][ctx], NULL);
+      if (txb_skip_changed) {
+        for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->txb_skip_cost[ctx],
+                                   fc->txb_skip_cdf[tx_size][ctx], NULL);
+      }
 
-      for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->base_eob_cost[ctx],
-                                 fc->coeff_base_eob_cdf[tx_size][plane][ctx],
-                                 NULL);
-      for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->base_cost[ctx],
-                                 fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
+      if (CDFS_CHANGED(x, fc, coeff_base_eob_cdf[tx_size][plane])) {
+        for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->base_eob_cost[ctx],
+                                   fc->coeff_base_eob_cdf[tx_size][plane][ctx],
+                                   NULL);
+      }
+      if (CDFS_CHANGED(x, fc, coeff_base_cdf[tx_size][plane])) {
+        for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->base_cost[ctx],
+                                   fc->coeff_base_cdf[tx_size][plane][ctx],
+                                   NULL);
+      }
 
-      for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->eob_extra_cost[ctx],
-                                 fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
+      if (CDFS_CHANGED(x, fc, eob_extra_cdf[tx_size][plane])) {
+        for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->eob_extra_cost[ctx],
+                                   fc->eob_extra_cdf[tx_size][plane][ctx],
+                                   NULL);
+      }
+
+      if (dc_sign_changed[plane]) {
+        for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->dc_sign_cost[ctx],
+                                   fc->dc_sign_cdf[plane][ctx], NULL);
+      }
 
-      for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->dc_sign_cost[ctx],
-                                 fc->dc_sign_cdf[plane][ctx], NULL);
+      if (!CDFS_CHANGED(x, fc, coeff_br_cdf[tx_size][plane])) continue;
 
       for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
         int br_rate[BR_CDF_SIZE];
@@ -546,10 +703,6 @@ void av1_fill_coeff_costs(MACROBLOCK *x, FRAME_CONTEXT *fc) {
         int i, j;
         av1_cost_tokens_from_cdf(br_rate, fc->coeff_br_cdf[tx_size][plane][ctx],
                                  NULL);
-        // printf("br_rate: ");
-        // for(j = 0; j < BR_CDF_SIZE; j++)
-        //  printf("%4d ", br_rate[j]);
-        // printf("\n");
         for (i = 0; i < COEFF_BASE_RANGE; i += BR_CDF_SIZE - 1) {
           for (j = 0; j < BR_CDF_SIZE - 1; j++) {
             pcost->lps_cost[ctx][i + j] = prev_cost + br_rate[j];
@@ -557,10 +710,6 @@ void av1_fill_coeff_costs(MACROBLOCK *x, FRAME_CONTEXT *fc) {
           prev_cost += br_rate[j];
         }
         pcost->lps_cost[ctx][i] = prev_cost;
-        // printf("lps_cost: %d %d %2d : ", tx_size, plane, ctx);
-        // for (i = 0; i <= COEFF_BASE_RANGE; i++)
-        //  printf("%5d ", pcost->lps_cost[ctx][i]);
-        // printf("\n");
       }
     }
   }
@@ -1023,7 +1172,8 @@ void av1_set_rd_speed_thresholds(AV1_COMP *cpi) {
   SPEED_FEATURES *const sf = &cpi->sf;
 
   // Set baseline threshold values.
-  for (i = 0; i < MAX_MODES; ++i) rd->thresh_mult[i] = cpi->oxcf.mode == 0;
+  for (i = 0; i < MAX_MODES; ++i)
+    rd->thresh_mult[i] = cpi->oxcf.mode == GOOD || cpi->oxcf.mode == REALTIME;
 
   if (sf->adaptive_rd_thresh) {
     rd->thresh_mult[THR_NEARESTMV] = 300;
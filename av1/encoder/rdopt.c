@@ -1620,21 +1620,21 @@ static int64_t pixel_diff_dist(const MACROBLOCK *x, int plane,
                                   visible_rows);
 }
 
+// The color counters note each new color as they see it rather than scan the
+// whole histogram afterwards, which for high bit depths is far larger than
+// the block.
 int av1_count_colors(const uint8_t *src, int stride, int rows, int cols,
                      int *val_count) {
   const int max_pix_val = 1 << 8;
+  int n = 0;
   memset(val_count, 0, max_pix_val * sizeof(val_count[0]));
   for (int r = 0; r < rows; ++r) {
     for (int c = 0; c < cols; ++c) {
       const int this_val = src[r * stride + c];
       assert(this_val < max_pix_val);
-      ++val_count[this_val];
+      n += (val_count[this_val]++ == 0);
     }
   }
-  int n = 0;
-  for (int i = 0; i < max_pix_val; ++i) {
-    if (val_count[i]) ++n;
-  }
   return n;
 }
 
@@ -1643,18 +1643,15 @@ int av1_count_colors_highbd(const uint8_t *src8, int stride, int rows, int cols,
   assert(bit_depth <= 12);
   const int max_pix_val = 1 << bit_depth;
   const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  int n = 0;
   memset(val_count, 0, max_pix_val * sizeof(val_count[0]));
   for (int r = 0; r < rows; ++r) {
     for (int c = 0; c < cols; ++c) {
       const int this_val = src[r * stride + c];
       assert(this_val < max_pix_val);
-      ++val_count[this_val];
+      n += (val_count[this_val]++ == 0);
     }
   }
-  int n = 0;
-  for (int i = 0; i < max_pix_val; ++i) {
-    if (val_count[i]) ++n;
-  }
   return n;
 }
 
@@ -2480,6 +2477,8 @@ static void super_block_yrd(const AV1_COMP *const cpi, MACROBLOCK *x,
                             RD_STATS *rd_stats, BLOCK_SIZE bs,
                             int64_t ref_best_rd) {
   MACROBLOCKD *xd = &x->e_mbd;
+  struct aom_usec_timer timer;
+  av1_stage_timer_start(x->collect_stage_stats, &timer);
   av1_init_rd_stats(rd_stats);
 
   assert(bs == xd->mi[0]->mbmi.sb_type);
@@ -2491,6 +2490,8 @@ static void super_block_yrd(const AV1_COMP *const cpi, MACROBLOCK *x,
   } else {
     choose_tx_size_type_from_rd(cpi, x, rd_stats, ref_best_rd, bs);
   }
+  av1_stage_timer_accumulate(x->collect_stage_stats, &timer,
+                             &x->stage_stats.tx_search);
 }
 
 // Return the rate cost for luma prediction mode info. of intra blocks.
@@ -2734,8 +2735,8 @@ static void optimize_palette_colors(uint16_t *color_cache, int n_cache,
 // of palette mode.
 static void palette_rd_y(
     const AV1_COMP *const cpi, MACROBLOCK *x, MB_MODE_INFO *mbmi,
-    BLOCK_SIZE bsize, int dc_mode_cost, const int *data, int *centroids, int n,
-    uint16_t *color_cache, int n_cache, MB_MODE_INFO *best_mbmi,
+    BLOCK_SIZE bsize, int dc_mode_cost, const int16_t *data, int *centroids,
+    int n, uint16_t *color_cache, int n_cache, MB_MODE_INFO *best_mbmi,
     uint8_t *best_palette_color_map, int64_t *best_rd, int64_t *best_model_rd,
     int *rate, int *rate_tokenonly, int *rate_overhead, int64_t *distortion,
     int *skippable, PICK_MODE_CONTEXT *ctx, uint8_t *blk_skip) {
@@ -2825,7 +2826,7 @@ static int rd_pick_palette_intra_sby(
   if (colors > 1 && colors <= 64) {
     int r, c, i;
     const int max_itr = 50;
-    int *const data = x->palette_buffer->kmeans_data_buf;
+    int16_t *const data = x->palette_buffer->kmeans_data_buf;
     int centroids[PALETTE_MAX_SIZE];
     int lb, ub, val;
     uint16_t *src16 = CONVERT_TO_SHORTPTR(src);
@@ -4674,9 +4675,9 @@ static void set_skip_flag(const AV1_COMP *cpi, MACROBLOCK *x,
   rd_stats->dist = rd_stats->sse = (dist << 4);
 }
 
-static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
-                               RD_STATS *rd_stats, BLOCK_SIZE bsize, int mi_row,
-                               int mi_col, int64_t ref_best_rd) {
+static void pick_tx_size_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
+                                  RD_STATS *rd_stats, BLOCK_SIZE bsize,
+                                  int mi_row, int mi_col, int64_t ref_best_rd) {
   const AV1_COMMON *cm = &cpi->common;
   const TX_SIZE max_tx_size = max_txsize_lookup[bsize];
   MACROBLOCKD *const xd = &x->e_mbd;
@@ -4720,6 +4721,7 @@ static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
       if (tx_rd_record->tx_rd_info[index].hash_value == hash) {
         TX_RD_INFO *tx_rd_info = &tx_rd_record->tx_rd_info[index];
         fetch_tx_rd_info(n4, tx_rd_info, rd_stats, x);
+        ++x->stage_stats.tx_cache_hits;
         return;
       }
     }
@@ -4731,6 +4733,7 @@ static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
   if (is_inter && cpi->sf.tx_type_search.use_skip_flag_prediction &&
       predict_skip_flag(x, bsize, &dist)) {
     set_skip_flag(cpi, x, rd_stats, bsize, dist);
+    ++x->stage_stats.early_terminations;
     // Save the RD search results into tx_rd_record.
     if (within_border) save_tx_rd_info(n4, hash, x, rd_stats, tx_rd_record);
     return;
@@ -4826,6 +4829,16 @@ static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
   if (within_border) save_tx_rd_info(n4, hash, x, rd_stats, tx_rd_record);
 }
 
+static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
+                               RD_STATS *rd_stats, BLOCK_SIZE bsize, int mi_row,
+                               int mi_col, int64_t ref_best_rd) {
+  struct aom_usec_timer timer;
+  av1_stage_timer_start(x->collect_stage_stats, &timer);
+  pick_tx_size_type_yrd(cpi, x, rd_stats, bsize, mi_row, mi_col, ref_best_rd);
+  av1_stage_timer_accumulate(x->collect_stage_stats, &timer,
+                             &x->stage_stats.tx_search);
+}
+
 static void tx_block_rd(const AV1_COMP *cpi, MACROBLOCK *x, int blk_row,
                         int blk_col, int plane, int block, TX_SIZE tx_size,
                         BLOCK_SIZE plane_bsize, ENTROPY_CONTEXT *above_ctx,
@@ -4998,7 +5011,7 @@ static void rd_pick_palette_intra_sbuv(const AV1_COMP *const cpi, MACROBLOCK *x,
     const int max_itr = 50;
     int lb_u, ub_u, val_u;
     int lb_v, ub_v, val_v;
-    int *const data = x->palette_buffer->kmeans_data_buf;
+    int16_t *const data = x->palette_buffer->kmeans_data_buf;
     int centroids[2 * PALETTE_MAX_SIZE];
 
     uint16_t *src_u16 = CONVERT_TO_SHORTPTR(src_u);
@@ -6176,10 +6189,20 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
   // after full-pixel motion search.
   av1_set_mv_search_range(&x->mv_limits, &ref_mv);
 
-  if (mbmi->motion_mode != SIMPLE_TRANSLATION)
+  if (mbmi->motion_mode != SIMPLE_TRANSLATION) {
     mvp_full = mbmi->mv[0].as_mv;
-  else
-    mvp_full = pred_mv[x->mv_best_ref_index[ref]];
+  } else {
+    const RecodeMiInfo *const prev =
+        av1_get_recode_mi_info(cpi, mi_row, mi_col);
+    if (prev && prev->ref_frame == ref && prev->sb_type == bsize) {
+      // The previous recode iteration already searched this block, so start
+      // from its result with a shorter first step.
+      mvp_full = prev->mv.as_mv;
+      step_param = AOMMIN(step_param + 2, MAX_MVSEARCH_STEPS - 1);
+    } else {
+      mvp_full = pred_mv[x->mv_best_ref_index[ref]];
+    }
+  }
 
   mvp_full.col >>= 3;
   mvp_full.row >>= 3;
@@ -7449,8 +7472,12 @@ static int64_t motion_mode_rd(
       mbmi->motion_mode = OBMC_CAUSAL;
       if (!is_comp_pred && have_newmv_in_inter_mode(this_mode)) {
         int tmp_rate_mv = 0;
+        struct aom_usec_timer timer;
 
+        av1_stage_timer_start(x->collect_stage_stats, &timer);
         single_motion_search(cpi, x, bsize, mi_row, mi_col, 0, &tmp_rate_mv);
+        av1_stage_timer_accumulate(x->collect_stage_stats, &timer,
+                                   &x->stage_stats.motion_search);
         mbmi->mv[0].as_int = x->best_mv.as_int;
         if (discount_newmv_test(cpi, this_mode, mbmi->mv[0], mode_mv,
                                 refs[0])) {
@@ -8024,8 +8051,12 @@ static int64_t handle_inter_mode(
 #endif  // CONFIG_JNT_COMP
 
     if (have_newmv_in_inter_mode(this_mode)) {
+      struct aom_usec_timer timer;
+      av1_stage_timer_start(x->collect_stage_stats, &timer);
       ret_val = handle_newmv(cpi, x, bsize, mode_mv, mi_row, mi_col, &rate_mv,
                              single_newmv, args);
+      av1_stage_timer_accumulate(x->collect_stage_stats, &timer,
+                                 &x->stage_stats.motion_search);
 #if CONFIG_JNT_COMP
       if (ret_val != 0) {
         early_terminate = INT64_MAX;
@@ -8858,7 +8889,7 @@ static void restore_uv_color_map(const AV1_COMP *const cpi, MACROBLOCK *x) {
   int src_stride = x->plane[1].src.stride;
   const uint8_t *const src_u = x->plane[1].src.buf;
   const uint8_t *const src_v = x->plane[2].src.buf;
-  int *const data = x->palette_buffer->kmeans_data_buf;
+  int16_t *const data = x->palette_buffer->kmeans_data_buf;
   int centroids[2 * PALETTE_MAX_SIZE];
   uint8_t *const color_map = xd->plane[1].color_index_map;
   int r, c;
@@ -10761,6 +10792,224 @@ void av1_rd_pick_inter_mode_sb_seg_skip(const AV1_COMP *cpi,
   store_coding_context(x, ctx, THR_GLOBALMV, best_pred_diff, 0);
 }
 
+static int get_single_ref_mode_index(PREDICTION_MODE mode,
+                                     MV_REFERENCE_FRAME ref_frame) {
+  for (int i = 0; i < MAX_MODES; ++i) {
+    if (av1_mode_order[i].mode == mode &&
+        av1_mode_order[i].ref_frame[0] == ref_frame &&
+        av1_mode_order[i].ref_frame[1] == NONE_FRAME)
+      return i;
+  }
+  assert(0 && "Mode not in av1_mode_order");
+  return -1;
+}
+
+void av1_nonrd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
+                                  MACROBLOCK *x, int mi_row, int mi_col,
+                                  RD_STATS *rd_cost, BLOCK_SIZE bsize,
+                                  PICK_MODE_CONTEXT *ctx,
+                                  int64_t best_rd_so_far) {
+  const AV1_COMMON *const cm = &cpi->common;
+  MACROBLOCKD *const xd = &x->e_mbd;
+  MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  MB_MODE_INFO_EXT *const mbmi_ext = x->mbmi_ext;
+  const unsigned char segment_id = mbmi->segment_id;
+  static const MV_REFERENCE_FRAME ref_list[] = { LAST_FRAME, GOLDEN_FRAME,
+                                                 ALTREF_FRAME };
+  static const int flag_list[] = { AOM_LAST_FLAG, AOM_GOLD_FLAG,
+                                   AOM_ALT_FLAG };
+  static const PREDICTION_MODE mode_list[] = { NEARESTMV, NEARMV, GLOBALMV,
+                                               NEWMV };
+  int_mv frame_mv[MB_MODE_COUNT][TOTAL_REFS_PER_FRAME];
+  struct buf_2d yv12_mb[TOTAL_REFS_PER_FRAME][MAX_MB_PLANE];
+  unsigned int ref_costs_single[TOTAL_REFS_PER_FRAME];
+#if CONFIG_EXT_COMP_REFS
+  unsigned int ref_costs_comp[TOTAL_REFS_PER_FRAME][TOTAL_REFS_PER_FRAME];
+#else
+  unsigned int ref_costs_comp[TOTAL_REFS_PER_FRAME];
+#endif  // CONFIG_EXT_COMP_REFS
+  const int *comp_inter_cost =
+      x->comp_inter_cost[av1_get_reference_mode_context(cm, xd)];
+  const TX_SIZE tx_size = tx_size_from_tx_mode(bsize, cm->tx_mode, 1);
+  MB_MODE_INFO best_mbmode;
+  int64_t best_rd = INT64_MAX;
+  int best_rate = INT_MAX;
+  int64_t best_dist = INT64_MAX;
+  unsigned int best_sse = UINT_MAX;
+  int best_mode_index = -1;
+  int64_t best_pred_diff[REFERENCE_MODES];
+  int i;
+
+  // The model below neither codes intra blocks nor tries lossless, segment
+  // controlled or overlay references. Leave those to the full search.
+  if (xd->lossless[segment_id] || cpi->rc.is_src_frame_alt_ref ||
+      segfeature_active(&cm->seg, segment_id, SEG_LVL_REF_FRAME)) {
+    av1_rd_pick_inter_mode_sb(cpi, tile_data, x, mi_row, mi_col, rd_cost,
+                              bsize, ctx, best_rd_so_far);
+    return;
+  }
+
+  av1_zero(best_mbmode);
+  av1_invalid_rd_stats(rd_cost);
+  estimate_ref_frame_costs(cm, xd, x, segment_id, ref_costs_single,
+                           ref_costs_comp);
+  for (i = 0; i < TOTAL_REFS_PER_FRAME; ++i) x->pred_sse[i] = INT_MAX;
+
+  mbmi->palette_mode_info.palette_size[0] = 0;
+  mbmi->palette_mode_info.palette_size[1] = 0;
+#if CONFIG_FILTER_INTRA
+  mbmi->filter_intra_mode_info.use_filter_intra = 0;
+#endif  // CONFIG_FILTER_INTRA
+#if CONFIG_INTRABC
+  mbmi->use_intrabc = 0;
+#endif  // CONFIG_INTRABC
+#if CONFIG_EXT_SKIP
+  mbmi->skip_mode = 0;
+#endif  // CONFIG_EXT_SKIP
+  mbmi->uv_mode = UV_DC_PRED;
+  mbmi->ref_frame[1] = NONE_FRAME;
+  mbmi->interintra_mode = (INTERINTRA_MODE)(II_DC_PRED - 1);
+  mbmi->interinter_compound_type = COMPOUND_AVERAGE;
+  mbmi->motion_mode = SIMPLE_TRANSLATION;
+  mbmi->ref_mv_idx = 0;
+  mbmi->tx_type = DCT_DCT;
+  mbmi->tx_size = tx_size;
+  mbmi->min_tx_size = tx_size;
+  for (int idy = 0; idy < xd->n8_h; ++idy)
+    for (int idx = 0; idx < xd->n8_w; ++idx)
+      mbmi->inter_tx_size[idy][idx] = tx_size;
+
+  for (int r = 0; r < (int)(sizeof(ref_list) / sizeof(ref_list[0])); ++r) {
+    const MV_REFERENCE_FRAME ref_frame = ref_list[r];
+    x->pred_mv_sad[ref_frame] = INT_MAX;
+    mbmi_ext->mode_context[ref_frame] = 0;
+    mbmi_ext->compound_mode_context[ref_frame] = 0;
+    if (!(cpi->ref_frame_flags & flag_list[r])) continue;
+
+    assert(get_ref_frame_buffer(cpi, ref_frame) != NULL);
+    setup_buffer_inter(cpi, x, ref_frame, bsize, mi_row, mi_col,
+                       frame_mv[NEARESTMV], frame_mv[NEARMV], yv12_mb);
+    frame_mv[GLOBALMV][ref_frame].as_int =
+        gm_get_motion_vector(&cm->global_motion[ref_frame],
+                             cm->allow_high_precision_mv, bsize, mi_col, mi_row
+#if CONFIG_AMVR
+                             ,
+                             cm->cur_frame_force_integer_mv
+#endif
+                             )
+            .as_int;
+
+    mbmi->ref_frame[0] = ref_frame;
+    set_ref_ptrs(cm, xd, ref_frame, NONE_FRAME);
+    for (i = 0; i < MAX_MB_PLANE; i++)
+      xd->plane[i].pre[0] = yv12_mb[ref_frame][i];
+    const int16_t mode_ctx =
+        av1_mode_context_analyzer(mbmi_ext->mode_context, mbmi->ref_frame);
+
+    for (int m = 0; m < (int)(sizeof(mode_list) / sizeof(mode_list[0]));
+         ++m) {
+      const PREDICTION_MODE this_mode = mode_list[m];
+      int_mv this_mv;
+      int rate_mv = 0;
+
+      // With an all-zero context only NEWMV and GLOBALMV can be signaled.
+      if ((mode_ctx & (1 << ALL_ZERO_FLAG_OFFSET)) &&
+          (this_mode == NEARESTMV || this_mode == NEARMV))
+        continue;
+      if (this_mode == GLOBALMV &&
+          cm->global_motion[ref_frame].wmtype > TRANSLATION)
+        continue;
+
+      if (this_mode == NEWMV) {
+        single_motion_search(cpi, x, bsize, mi_row, mi_col, 0, &rate_mv);
+        if (x->best_mv.as_int == INVALID_MV) continue;
+        this_mv = x->best_mv;
+      } else {
+        this_mv = frame_mv[this_mode][ref_frame];
+        clamp_mv2(&this_mv.as_mv, xd);
+        if (mv_check_bounds(&x->mv_limits, &this_mv.as_mv)) continue;
+        // Each motion vector only needs to be tried with its cheapest mode.
+        if (this_mode == NEARMV &&
+            this_mv.as_int == frame_mv[NEARESTMV][ref_frame].as_int)
+          continue;
+        if (this_mode == GLOBALMV &&
+            (this_mv.as_int == frame_mv[NEARESTMV][ref_frame].as_int ||
+             this_mv.as_int == frame_mv[NEARMV][ref_frame].as_int))
+          continue;
+      }
+
+      mbmi->mode = this_mode;
+      mbmi->mv[0].as_int = this_mv.as_int;
+      set_default_interp_filters(mbmi, cm->interp_filter);
+
+      int rate_y;
+      int64_t dist_y;
+      int skip_txfm_sb;
+      int64_t skip_sse_sb;
+      av1_build_inter_predictors_sby(cm, xd, mi_row, mi_col, NULL, bsize);
+      model_rd_for_sb(cpi, bsize, x, xd, 0, 0, &rate_y, &dist_y,
+                      &skip_txfm_sb, &skip_sse_sb);
+
+      int rate = rate_y + rate_mv + cost_mv_ref(x, this_mode, mode_ctx) +
+                 ref_costs_single[ref_frame] +
+                 av1_get_switchable_rate(cm, x, xd);
+      if (cm->reference_mode == REFERENCE_MODE_SELECT)
+        rate += comp_inter_cost[0];
+      const int64_t this_rd = RDCOST(x->rdmult, rate, dist_y);
+
+      if (this_rd < best_rd) {
+        best_rd = this_rd;
+        best_rate = rate;
+        best_dist = dist_y;
+        best_sse = (unsigned int)x->pred_sse[ref_frame];
+        best_mbmode = *mbmi;
+        best_mode_index = get_single_ref_mode_index(this_mode, ref_frame);
+      }
+    }
+  }
+
+  // A prediction that is worse than the block's own mean suggests intra
+  // coding. Let the full search decide those blocks.
+  if (best_mode_index < 0 ||
+      best_sse > (x->source_variance << num_pels_log2_lookup[bsize])) {
+    av1_rd_pick_inter_mode_sb(cpi, tile_data, x, mi_row, mi_col, rd_cost,
+                              bsize, ctx, best_rd_so_far);
+    return;
+  }
+
+  if (best_rd >= best_rd_so_far) return;
+
+  *mbmi = best_mbmode;
+  if (mbmi->mode != NEWMV)
+    mbmi->pred_mv[0].as_int = mbmi->mv[0].as_int;
+  else
+    mbmi->pred_mv[0].as_int = mbmi_ext->ref_mvs[mbmi->ref_frame[0]][0].as_int;
+
+  // The bitstream writer derives the allowed motion modes from these.
+  av1_count_overlappable_neighbors(cm, xd, mi_row, mi_col);
+  mbmi->num_proj_ref[0] = 0;
+  mbmi->num_proj_ref[1] = 0;
+  if (is_motion_variation_allowed_bsize(bsize)) {
+    int pts[SAMPLES_ARRAY_SIZE], pts_inref[SAMPLES_ARRAY_SIZE];
+    mbmi->num_proj_ref[0] = findSamples(cm, xd, mi_row, mi_col, pts, pts_inref);
+#if CONFIG_EXT_WARPED_MOTION
+    if (mbmi->num_proj_ref[0] > 1)
+      mbmi->num_proj_ref[0] = selectSamples(&mbmi->mv[0].as_mv, pts, pts_inref,
+                                            mbmi->num_proj_ref[0], bsize);
+#endif  // CONFIG_EXT_WARPED_MOTION
+  }
+
+  rd_cost->rate = best_rate;
+  rd_cost->dist = best_dist;
+  rd_cost->rdcost = best_rd;
+
+  // No transform search was done, so every block is coded.
+  x->skip = 0;
+  memset(ctx->blk_skip[0], 0, sizeof(uint8_t) * ctx->num_4x4_blk);
+  av1_zero(best_pred_diff);
+  store_coding_context(x, ctx, best_mode_index, best_pred_diff, 0);
+}
+
 struct calc_target_weighted_pred_ctxt {
   const MACROBLOCK *x;
   const uint8_t *tmp;
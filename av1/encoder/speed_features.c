@@ -85,6 +85,10 @@ static void set_good_speed_feature_framesize_dependent(AV1_COMP *cpi,
                                                        int speed) {
   AV1_COMMON *const cm = &cpi->common;
 
+  // The partition pruning models were only trained on 176x144 clips, so they
+  // are not trusted on larger frames.
+  sf->ml_prune_partition = speed >= 1 && cm->width * cm->height <= 176 * 144;
+
   if (speed >= 2) {
     if (AOMMIN(cm->width, cm->height) >= 720) {
       sf->disable_split_mask =
@@ -142,6 +146,7 @@ static void set_good_speed_features_framesize_independent(AV1_COMP *cpi,
 
   if (speed >= 1) {
     sf->selective_ref_frame = 1;
+    sf->reuse_recode_decisions = 1;
     sf->tx_size_search_init_depth_rect = 1;
     sf->tx_size_search_init_depth_sqr = 1;
 #if CONFIG_EXT_PARTITION_TYPES
@@ -332,6 +337,21 @@ static void set_good_speed_features_framesize_independent(AV1_COMP *cpi,
   }
 }
 
+// Realtime starts from the good quality features for the same speed and trades
+// the remaining per-block RD searches for speed.
+static void set_rt_speed_features_framesize_independent(AV1_COMP *cpi,
+                                                        SPEED_FEATURES *sf,
+                                                        int speed) {
+  set_good_speed_features_framesize_independent(cpi, sf, speed);
+
+  if (speed >= 5) {
+    sf->use_nonrd_pick_mode = 1;
+  }
+  if (speed >= 7) {
+    sf->partition_search_type = VAR_BASED_PARTITION;
+  }
+}
+
 void av1_set_speed_features_framesize_dependent(AV1_COMP *cpi) {
   SPEED_FEATURES *const sf = &cpi->sf;
   const AV1EncoderConfig *const oxcf = &cpi->oxcf;
@@ -351,7 +371,7 @@ void av1_set_speed_features_framesize_dependent(AV1_COMP *cpi) {
     sf->use_upsampled_references = 0;
   }
 
-  if (oxcf->mode == GOOD) {
+  if (oxcf->mode == GOOD || oxcf->mode == REALTIME) {
     set_good_speed_feature_framesize_dependent(cpi, sf, oxcf->speed);
   }
 
@@ -484,6 +504,8 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   sf->disable_wedge_search_var_thresh = 0;
   sf->fast_wedge_sign_estimate = 0;
   sf->drop_ref = 0;
+  sf->reuse_recode_decisions = 0;
+  sf->use_nonrd_pick_mode = 0;
 
   for (i = 0; i < TX_SIZES; i++) {
     sf->intra_y_mode_mask[i] = INTRA_ALL;
@@ -517,6 +539,7 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   sf->prune_ext_partition_types_search = 0;
 #endif  // CONFIG_EXT_PARTITION_TYPES
   sf->fast_cdef_search = 0;
+  sf->ml_prune_partition = 0;
 
   // Set this at the appropriate speed levels
   sf->use_transform_domain_distortion = 0;
@@ -528,6 +551,8 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
 
   if (oxcf->mode == GOOD)
     set_good_speed_features_framesize_independent(cpi, sf, oxcf->speed);
+  else if (oxcf->mode == REALTIME)
+    set_rt_speed_features_framesize_independent(cpi, sf, oxcf->speed);
 
   // sf->partition_search_breakout_dist_thr is set assuming max 64x64
   // blocks. Normalise this if the blocks are bigger.
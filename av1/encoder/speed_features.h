@@ -222,7 +222,11 @@ typedef enum {
   // Always use a fixed size partition
   FIXED_PARTITION,
 
-  REFERENCE_PARTITION
+  REFERENCE_PARTITION,
+
+  // Use the source variance against a cheap prediction to choose the
+  // partitioning, without any rate-distortion search
+  VAR_BASED_PARTITION
 } PARTITION_SEARCH_TYPE;
 
 typedef enum {
@@ -352,6 +356,12 @@ typedef struct SPEED_FEATURES {
 
   int fast_cdef_search;
 
+  // Use a learned model to stop splitting square blocks, and to skip the
+  // rectangular and extended partition types, from the features of the
+  // PARTITION_NONE search. Only used on frames no larger than 176x144, the
+  // size the models were trained on.
+  int ml_prune_partition;
+
   // Skip rectangular partition test when partition type none gives better
   // rd than partition type split.
   int less_rectangular_check;
@@ -526,6 +536,14 @@ typedef struct SPEED_FEATURES {
 
   // flag to drop some ref frames in compound motion search
   int drop_ref;
+
+  // When a frame is recoded, seed the motion search and bound the partition
+  // search with the decisions made by the previous iteration.
+  int reuse_recode_decisions;
+
+  // Choose the inter mode of each block with a model-based estimate of its
+  // luma rate and distortion instead of the full rate-distortion search.
+  int use_nonrd_pick_mode;
 } SPEED_FEATURES;
 
 struct AV1_COMP;
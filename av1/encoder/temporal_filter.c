@@ -418,7 +418,8 @@ static void temporal_filter_iterate_c(AV1_COMP *cpi,
         }
       }
 
-      // Normalize filter output to produce AltRef frame
+      // Normalize filter output to produce AltRef frame. The output buffer
+      // does not share the stride of the source frames.
       if (mbd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
         uint16_t *dst1_16;
         uint16_t *dst2_16;
@@ -433,7 +434,7 @@ static void temporal_filter_iterate_c(AV1_COMP *cpi,
 #else
           stride = cpi->alt_ref_buffer.y_stride;
 #endif  // CONFIG_BGSPRITE
-        byte = mb_y_offset;
+        byte = mb_row * 16 * stride + mb_col * 16;
         for (i = 0, k = 0; i < 16; i++) {
           for (j = 0; j < 16; j++, k++) {
             dst1_16[byte] =
@@ -451,7 +452,7 @@ static void temporal_filter_iterate_c(AV1_COMP *cpi,
         dst1_16 = CONVERT_TO_SHORTPTR(dst1);
         dst2_16 = CONVERT_TO_SHORTPTR(dst2);
         stride = cpi->alt_ref_buffer.uv_stride;
-        byte = mb_uv_offset;
+        byte = mb_row * mb_uv_height * stride + mb_col * mb_uv_width;
         for (i = 0, k = 256; i < mb_uv_height; i++) {
           for (j = 0; j < mb_uv_width; j++, k++) {
             int m = k + 256;
@@ -478,7 +479,7 @@ static void temporal_filter_iterate_c(AV1_COMP *cpi,
           dst1 = cpi->alt_ref_buffer.y_buffer;
           stride = cpi->alt_ref_buffer.y_stride;
 #endif  // CONFIG_BGSPRITE
-        byte = mb_y_offset;
+        byte = mb_row * 16 * stride + mb_col * 16;
         for (i = 0, k = 0; i < 16; i++) {
           for (j = 0; j < 16; j++, k++) {
             dst1[byte] =
@@ -498,7 +499,7 @@ static void temporal_filter_iterate_c(AV1_COMP *cpi,
           dst2 = cpi->alt_ref_buffer.v_buffer;
           stride = cpi->alt_ref_buffer.uv_stride;
 #endif  // CONFIG_BGSPRITE
-        byte = mb_uv_offset;
+        byte = mb_row * mb_uv_height * stride + mb_col * mb_uv_width;
         for (i = 0, k = 256; i < mb_uv_height; i++) {
           for (j = 0; j < mb_uv_width; j++, k++) {
             int m = k + 256;
@@ -602,6 +603,9 @@ void av1_temporal_filter(AV1_COMP *cpi,
   struct scale_factors sf;
   YV12_BUFFER_CONFIG *frames[MAX_LAG_BUFFERS] = { NULL };
   const GF_GROUP *const gf_group = &cpi->twopass.gf_group;
+  struct aom_usec_timer timer;
+
+  av1_stage_timer_start(cpi->oxcf.enable_stage_stats, &timer);
 
   // Apply context specific adjustments to the arnr filter parameters.
   adjust_arnr_filter(cpi, distance, rc->gfu_boost, &frames_to_blur, &strength);
@@ -674,4 +678,7 @@ void av1_temporal_filter(AV1_COMP *cpi,
 #endif  // CONFIG_BGSPRITE
                             frames, frames_to_blur, frames_to_blur_backward,
                             strength, &sf);
+
+  av1_stage_timer_accumulate(cpi->oxcf.enable_stage_stats, &timer,
+                             &cpi->stage_stats.temporal_filter);
 }
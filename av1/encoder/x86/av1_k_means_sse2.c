@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <emmintrin.h>
+
+#include "./av1_rtcd.h"
+#include "aom/aom_integer.h"
+#include "av1/common/blockd.h"
+
+/**
+ * See av1_calc_indices_dim1_c
+ *
+ * Data and centroids are at most 12 bits, so the distances are compared as
+ * 16-bit absolute differences. These order the centroids exactly as the
+ * squared distances do, ties included.
+ */
+void av1_calc_indices_dim1_sse2(const int16_t *data, const int *centroids,
+                                uint8_t *indices, int n, int k) {
+  const __m128i v_zero = _mm_setzero_si128();
+  __m128i v_cent[PALETTE_MAX_SIZE];
+  int i;
+
+  assert(k <= PALETTE_MAX_SIZE);
+  for (int j = 0; j < k; ++j)
+    v_cent[j] = _mm_set1_epi16((int16_t)centroids[j]);
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    const __m128i v_data = _mm_loadu_si128((const __m128i *)(data + i));
+    const __m128i v_diff0 = _mm_sub_epi16(v_data, v_cent[0]);
+    __m128i v_min = _mm_max_epi16(v_diff0, _mm_sub_epi16(v_zero, v_diff0));
+    __m128i v_ind = v_zero;
+
+    for (int j = 1; j < k; ++j) {
+      const __m128i v_diff = _mm_sub_epi16(v_data, v_cent[j]);
+      const __m128i v_dist =
+          _mm_max_epi16(v_diff, _mm_sub_epi16(v_zero, v_diff));
+      const __m128i v_lt = _mm_cmplt_epi16(v_dist, v_min);
+      v_min = _mm_min_epi16(v_dist, v_min);
+      v_ind = _mm_or_si128(_mm_andnot_si128(v_lt, v_ind),
+                           _mm_and_si128(v_lt, _mm_set1_epi16(j)));
+    }
+    _mm_storel_epi64((__m128i *)(indices + i), _mm_packus_epi16(v_ind, v_ind));
+  }
+
+  if (i < n)
+    av1_calc_indices_dim1_c(data + i, centroids, indices + i, n - i, k);
+}
+
+/**
+ * See av1_calc_indices_dim2_c
+ *
+ * Each pair of 16-bit (u, v) samples is one point, so _mm_madd_epi16() of the
+ * differences with themselves gives the squared distance of four points at
+ * once.
+ */
+void av1_calc_indices_dim2_sse2(const int16_t *data, const int *centroids,
+                                uint8_t *indices, int n, int k) {
+  __m128i v_cent[PALETTE_MAX_SIZE];
+  int i;
+
+  assert(k <= PALETTE_MAX_SIZE);
+  for (int j = 0; j < k; ++j) {
+    v_cent[j] = _mm_set1_epi32((int)((uint32_t)centroids[2 * j + 1] << 16) |
+                               (centroids[2 * j] & 0xffff));
+  }
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    const __m128i v_data0 = _mm_loadu_si128((const __m128i *)(data + 2 * i));
+    const __m128i v_data1 =
+        _mm_loadu_si128((const __m128i *)(data + 2 * i + 8));
+    const __m128i v_diff00 = _mm_sub_epi16(v_data0, v_cent[0]);
+    const __m128i v_diff10 = _mm_sub_epi16(v_data1, v_cent[0]);
+    __m128i v_min0 = _mm_madd_epi16(v_diff00, v_diff00);
+    __m128i v_min1 = _mm_madd_epi16(v_diff10, v_diff10);
+    __m128i v_ind0 = _mm_setzero_si128();
+    __m128i v_ind1 = _mm_setzero_si128();
+
+    for (int j = 1; j < k; ++j) {
+      const __m128i v_j = _mm_set1_epi32(j);
+      const __m128i v_diff0 = _mm_sub_epi16(v_data0, v_cent[j]);
+      const __m128i v_diff1 = _mm_sub_epi16(v_data1, v_cent[j]);
+      const __m128i v_dist0 = _mm_madd_epi16(v_diff0, v_diff0);
+      const __m128i v_dist1 = _mm_madd_epi16(v_diff1, v_diff1);
+      const __m128i v_lt0 = _mm_cmplt_epi32(v_dist0, v_min0);
+      const __m128i v_lt1 = _mm_cmplt_epi32(v_dist1, v_min1);
+      v_min0 = _mm_or_si128(_mm_andnot_si128(v_lt0, v_min0),
+                            _mm_and_si128(v_lt0, v_dist0));
+      v_min1 = _mm_or_si128(_mm_andnot_si128(v_lt1, v_min1),
+                            _mm_and_si128(v_lt1, v_dist1));
+      v_ind0 = _mm_or_si128(_mm_andnot_si128(v_lt0, v_ind0),
+                            _mm_and_si128(v_lt0, v_j));
+      v_ind1 = _mm_or_si128(_mm_andnot_si128(v_lt1, v_ind1),
+                            _mm_and_si128(v_lt1, v_j));
+    }
+    const __m128i v_ind = _mm_packs_epi32(v_ind0, v_ind1);
+    _mm_storel_epi64((__m128i *)(indices + i), _mm_packus_epi16(v_ind, v_ind));
+  }
+
+  if (i < n)
+    av1_calc_indices_dim2_c(data + 2 * i, centroids, indices + i, n - i, k);
+}
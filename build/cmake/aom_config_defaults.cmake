@@ -44,6 +44,7 @@ set(HAVE_SSSE3 0 CACHE NUMBER "Enables SSSE3 optimizations.")
 # Flags describing the build environment.
 set(HAVE_AOM_PORTS 0 CACHE NUMBER "Internal flag, deprecated.")
 set(HAVE_FEXCEPT 0 CACHE NUMBER "Internal flag, GNU fenv.h present for target.")
+set(HAVE_MMAP 0 CACHE NUMBER "Internal flag, sys/mman.h present for target.")
 set(HAVE_PTHREAD_H 0 CACHE NUMBER "Internal flag, target pthread support.")
 set(HAVE_UNISTD_H 0 CACHE NUMBER "Internal flag, unistd.h present for target.")
 set(HAVE_WXWIDGETS 0 CACHE NUMBER "WxWidgets present.")
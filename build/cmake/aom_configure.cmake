@@ -187,6 +187,7 @@ aom_check_source_compiles("aom_ports_check"
                           HAVE_AOM_PORTS)
 aom_check_source_compiles("pthread_check" "#include <pthread.h>" HAVE_PTHREAD_H)
 aom_check_source_compiles("unistd_check" "#include <unistd.h>" HAVE_UNISTD_H)
+aom_check_source_compiles("mmap_check" "#include <sys/mman.h>" HAVE_MMAP)
 
 if (NOT MSVC)
   aom_push_var(CMAKE_REQUIRED_LIBRARIES "m")
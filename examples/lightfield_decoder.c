@@ -163,18 +163,25 @@ int main(int argc, char **argv) {
   int ref_bu = tile_u / lf_blocksize;
   int ref_bv = tile_v / lf_blocksize;
   int ref_bi = ref_bu + ref_bv * u_blocks;
-  av1_ref_frame_t ref;
-  ref.idx = 0;
-  ref.img = reference_images[ref_bi];
-  // This is too slow for real lightfield rendering.  This copies the
-  // reference image bytes.  We need a way to just set a pointer
-  // in order to make this fast enough.
-  if (aom_codec_control(&codec, AV1_SET_REFERENCE, &ref)) {
-    die_codec(&codec, "Failed to set reference image.");
-  }
+  // The reference images stay in place for all the tiles decoded from them.
+  av1_ext_ref_frame_t ext_refs;
+  ext_refs.img = reference_images;
+  ext_refs.num = u_blocks * v_blocks;
+  if (aom_codec_control(&codec, AV1D_SET_EXT_REF_PTR, &ext_refs))
+    die_codec(&codec, "Failed to set reference images.");
+  // A tile list can hold all the tiles needed from a frame, they are output
+  // as one mosaic image. Here it is just the requested tile.
+  aom_tile_list_entry_t entry;
+  entry.tile_row = tile_t;
+  entry.tile_col = tile_s;
+  entry.ref_idx = ref_bi;
+  aom_tile_list_t tile_list;
+  tile_list.entries = &entry;
+  tile_list.num_entries = 1;
+  tile_list.output_cols = 1;
   aom_codec_control_(&codec, AV1_SET_TILE_MODE, 1);
-  aom_codec_control_(&codec, AV1_SET_DECODE_TILE_ROW, tile_t);
-  aom_codec_control_(&codec, AV1_SET_DECODE_TILE_COL, tile_s);
+  if (aom_codec_control(&codec, AV1D_SET_TILE_LIST, &tile_list))
+    die_codec(&codec, "Failed to set tile list.");
   aom_codec_err_t aom_status =
       aom_codec_decode(&codec, frame, (unsigned int)frame_size, NULL);
   if (aom_status) die_codec(&codec, "Failed to decode tile.");
@@ -183,6 +190,9 @@ int main(int argc, char **argv) {
   aom_img_write(img, outfile);
 
   if (aom_codec_destroy(&codec)) die_codec(&codec, "Failed to destroy codec");
+  for (int i = 0; i < u_blocks * v_blocks; ++i)
+    aom_img_free(&reference_images[i]);
+  free(reference_images);
   aom_video_reader_close(reader);
   fclose(outfile);
 
@@ -73,3 +73,40 @@ TEST(AV1, TestAccounting) {
   GTEST_ASSERT_NE(aom_accounting_dictionary_lookup(&accounting, "AB"),
                   aom_accounting_dictionary_lookup(&accounting, "BA"));
 }
+
+TEST(AV1, TestAccountingMerge) {
+  Accounting tiles[2];
+  aom_accounting_init(&tiles[0]);
+  aom_accounting_init(&tiles[1]);
+  // The tiles see the symbols in a different order, so their ids differ.
+  aom_accounting_set_context(&tiles[0], 0, 0);
+  aom_accounting_record(&tiles[0], "A", 8);
+  aom_accounting_record(&tiles[0], "B", 16);
+  aom_accounting_set_context(&tiles[1], 64, 0);
+  aom_accounting_record(&tiles[1], "C", 24);
+  aom_accounting_record(&tiles[1], "B", 32);
+  aom_accounting_record(&tiles[1], "B", 40);
+  tiles[1].syms.num_binary_syms = 3;
+
+  Accounting accounting;
+  aom_accounting_init(&accounting);
+  aom_accounting_merge(&accounting, &tiles[0]);
+  aom_accounting_merge(&accounting, &tiles[1]);
+
+  const char *const kStrs[] = { "A", "B", "C", "B" };
+  const uint32_t kBits[] = { 8, 16, 24, 72 };
+  const uint32_t kSamples[] = { 1, 1, 1, 2 };
+  GTEST_ASSERT_EQ(accounting.syms.num_syms, 4);
+  GTEST_ASSERT_EQ(accounting.syms.num_binary_syms, 3);
+  for (int i = 0; i < accounting.syms.num_syms; i++) {
+    const AccountingSymbol *sym = &accounting.syms.syms[i];
+    EXPECT_STREQ(accounting.syms.dictionary.strs[sym->id], kStrs[i]);
+    EXPECT_EQ(sym->bits, kBits[i]);
+    EXPECT_EQ(sym->samples, kSamples[i]);
+    EXPECT_EQ(sym->context.x, i < 2 ? 0 : 64);
+  }
+
+  aom_accounting_clear(&accounting);
+  aom_accounting_clear(&tiles[0]);
+  aom_accounting_clear(&tiles[1]);
+}
@@ -230,12 +230,56 @@ aomenc_av1_webm_non_square_par() {
   fi
 }
 
+# Encodes a three rendition ladder with --abr-ladder, which encodes the streams
+# concurrently, and checks that every rendition is bit identical to the same
+# stream encoded on its own.
+aomenc_av1_ivf_abr_ladder() {
+  if [ "$(aomenc_can_encode_av1)" = "yes" ]; then
+    local readonly output="${AOM_TEST_OUTPUT_DIR}/av1_abr_ladder"
+    local readonly stream0="--ivf --target-bitrate=400"
+    local readonly stream1="--ivf --target-bitrate=200"
+    local readonly stream2="--ivf --target-bitrate=100 --width=80 --height=44"
+    aomenc $(y4m_input_non_square_par) \
+      --codec=av1 \
+      --limit="${TEST_FRAMES}" \
+      --passes=2 \
+      --abr-ladder \
+      ${stream0} --output="${output}_0.ivf" -- \
+      ${stream1} --output="${output}_1.ivf" -- \
+      ${stream2} --output="${output}_2.ivf" || return 1
+
+    aomenc $(y4m_input_non_square_par) \
+      --codec=av1 \
+      --limit="${TEST_FRAMES}" \
+      --passes=2 \
+      ${stream0} --output="${output}_standalone_0.ivf" || return 1
+    aomenc $(y4m_input_non_square_par) \
+      --codec=av1 \
+      --limit="${TEST_FRAMES}" \
+      --passes=2 \
+      ${stream1} --output="${output}_standalone_1.ivf" || return 1
+    aomenc $(y4m_input_non_square_par) \
+      --codec=av1 \
+      --limit="${TEST_FRAMES}" \
+      --passes=2 \
+      ${stream2} --output="${output}_standalone_2.ivf" || return 1
+
+    for i in 0 1 2; do
+      if ! cmp -s "${output}_${i}.ivf" "${output}_standalone_${i}.ivf"; then
+        elog "Ladder rendition ${i} differs from its standalone encode."
+        return 1
+      fi
+    done
+  fi
+}
+
 aomenc_tests="aomenc_av1_ivf
               aomenc_av1_webm
               aomenc_av1_webm_2pass
               aomenc_av1_ivf_lossless
               aomenc_av1_ivf_minq0_maxq0
               aomenc_av1_webm_lag5_frames10
-              aomenc_av1_webm_non_square_par"
+              aomenc_av1_webm_non_square_par
+              aomenc_av1_ivf_abr_ladder"
 
 run_tests aomenc_verify_environment "${aomenc_tests}"
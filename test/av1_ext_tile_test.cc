@@ -177,6 +177,37 @@ class AV1ExtTileTest
       ::libaom_test::MD5 md5_res;
       md5_res.Add(&tile_img_);
       tile_md5_.push_back(md5_res.Get());
+
+      // Decode the last frame once more as a tile list of all the tiles in
+      // raster order, whose mosaic is the whole frame.
+      const int kTileCols = kImgWidth / kTIleSizeInPixels;
+      const int kTileRows = kImgHeight / kTIleSizeInPixels;
+      std::vector<aom_tile_list_entry_t> entries(kTileRows * kTileCols);
+      for (int i = 0; i < kTileRows * kTileCols; ++i) {
+        entries[i].tile_row = i / kTileCols;
+        entries[i].tile_col = i % kTileCols;
+        entries[i].ref_idx = 0;
+      }
+      aom_tile_list_t tile_list = { &entries[0],
+                                    static_cast<int>(entries.size()),
+                                    kTileCols };
+      decoder_->Control(AV1_SET_DECODE_TILE_ROW, -1);
+      decoder_->Control(AV1_SET_DECODE_TILE_COL, -1);
+      decoder_->Control(AV1D_SET_TILE_LIST, &tile_list);
+      const aom_codec_err_t res = decoder_->DecodeFrame(
+          reinterpret_cast<uint8_t *>(pkt->data.frame.buf), pkt->data.frame.sz);
+      if (res != AOM_CODEC_OK) {
+        abort_ = true;
+        ASSERT_EQ(AOM_CODEC_OK, res);
+      }
+      const aom_image_t *img = decoder_->GetDxData().Next();
+      ASSERT_TRUE(img != NULL);
+      ::libaom_test::MD5 list_md5_res;
+      list_md5_res.Add(img);
+      tile_list_md5_ = list_md5_res.Get();
+
+      tile_list.num_entries = 0;
+      decoder_->Control(AV1D_SET_TILE_LIST, &tile_list);
     }
   }
 
@@ -186,6 +217,7 @@ class AV1ExtTileTest
   aom_image_t tile_img_;
   std::vector<std::string> md5_;
   std::vector<std::string> tile_md5_;
+  std::string tile_list_md5_;
 };
 
 TEST_P(AV1ExtTileTest, DISABLED_DecoderResultTest) {
@@ -203,10 +235,188 @@ TEST_P(AV1ExtTileTest, DISABLED_DecoderResultTest) {
 
   // Compare to check if two vectors are equal.
   ASSERT_EQ(md5_, tile_md5_);
+  ASSERT_EQ(md5_.back(), tile_list_md5_);
 }
 
 AV1_INSTANTIATE_TEST_CASE(
     // Now only test 2-pass mode.
     AV1ExtTileTest, ::testing::Values(::libaom_test::kTwoPassGood),
     ::testing::Range(0, 4));
+
+const int kListLimit = 4;
+const int kListImgWidth = 4 * kTIleSizeInPixels;
+const int kListImgHeight = 3 * kTIleSizeInPixels;
+const int kListTileCols = kListImgWidth / kTIleSizeInPixels;
+const int kListTileRows = kListImgHeight / kTIleSizeInPixels;
+
+// Decodes the inter frames of a large-scale tile stream as tile lists, which
+// predict every tile from an external reference set with AV1D_SET_EXT_REF_PTR
+// instead of the decoder's own LAST_FRAME. The inter frames only refer to
+// LAST_FRAME, the key frame.
+class AV1ExtTileListTest : public ::libaom_test::CodecTestWithParam<int>,
+                           public ::libaom_test::EncoderTest {
+ protected:
+  AV1ExtTileListTest()
+      : EncoderTest(GET_PARAM(0)), set_cpu_used_(GET_PARAM(1)) {
+    aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
+    cfg.w = kListImgWidth;
+    cfg.h = kListImgHeight;
+    cfg.allow_lowbitdepth = 1;
+
+    decoder_ = codec_->CreateDecoder(cfg, 0);
+    decoder_->Control(AV1_SET_TILE_MODE, 1);
+    decoder_->Control(AV1_SET_DECODE_TILE_ROW, -1);
+    decoder_->Control(AV1_SET_DECODE_TILE_COL, -1);
+
+    // External reference 0 is the key frame, 1 is a flat image.
+    for (int i = 0; i < 2; ++i) {
+      aom_img_alloc(&ext_ref_img_[i], AOM_IMG_FMT_I420, kListImgWidth,
+                    kListImgHeight, 32);
+    }
+    for (int plane = 0; plane < 3; ++plane) {
+      const int plane_height = (kListImgHeight + (plane > 0)) >> (plane > 0);
+      memset(ext_ref_img_[1].planes[plane], 128,
+             ext_ref_img_[1].stride[plane] * plane_height);
+    }
+  }
+
+  virtual ~AV1ExtTileListTest() {
+    for (int i = 0; i < 2; ++i) aom_img_free(&ext_ref_img_[i]);
+    delete decoder_;
+  }
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libaom_test::kOnePassGood);
+
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_end_usage = AOM_VBR;
+    cfg_.rc_target_bitrate = 500;
+    cfg_.large_scale_tile = 1;
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, set_cpu_used_);
+      encoder->Control(AOME_SET_ENABLEAUTOALTREF, 0);
+      encoder->Control(AV1E_SET_FRAME_PARALLEL_DECODING, 1);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, kTileSize);
+      encoder->Control(AV1E_SET_TILE_ROWS, kTileSize);
+      encoder->Control(AV1E_SET_SINGLE_TILE_DECODING, 1);
+#if CONFIG_EXT_PARTITION
+      encoder->Control(AV1E_SET_SUPERBLOCK_SIZE, AOM_SUPERBLOCK_SIZE_64X64);
+#endif
+#if CONFIG_LOOPFILTERING_ACROSS_TILES
+#if CONFIG_LOOPFILTERING_ACROSS_TILES_EXT
+      encoder->Control(AV1E_SET_TILE_LOOPFILTER_V, 0);
+      encoder->Control(AV1E_SET_TILE_LOOPFILTER_H, 0);
+#else
+      encoder->Control(AV1E_SET_TILE_LOOPFILTER, 0);
+#endif
+#endif
+    } else if (video->frame() == 1) {
+      frame_flags_ = AOM_EFLAG_NO_UPD_LAST | AOM_EFLAG_NO_UPD_GF |
+                     AOM_EFLAG_NO_UPD_ARF | AOM_EFLAG_NO_REF_LAST2 |
+                     AOM_EFLAG_NO_REF_LAST3 | AOM_EFLAG_NO_REF_GF |
+                     AOM_EFLAG_NO_REF_ARF | AOM_EFLAG_NO_REF_BWD |
+                     AOM_EFLAG_NO_REF_ARF2;
+    }
+  }
+
+  virtual void DecompressedFrameHook(const aom_image_t &img,
+                                     aom_codec_pts_t pts) {
+    (void)pts;
+    ::libaom_test::MD5 md5_res;
+    md5_res.Add(&img);
+    md5_.push_back(md5_res.Get());
+  }
+
+  // Decodes the frame as a tile list of all its tiles in raster order, each
+  // one predicted from the external reference ref_idx, and returns the MD5 of
+  // the mosaic.
+  std::string DecodeTileList(const aom_codec_cx_pkt_t *pkt, int ref_idx) {
+    std::vector<aom_tile_list_entry_t> entries(kListTileRows * kListTileCols);
+    for (int i = 0; i < kListTileRows * kListTileCols; ++i) {
+      entries[i].tile_row = i / kListTileCols;
+      entries[i].tile_col = i % kListTileCols;
+      entries[i].ref_idx = ref_idx;
+    }
+    aom_tile_list_t tile_list = { &entries[0],
+                                  static_cast<int>(entries.size()),
+                                  kListTileCols };
+    decoder_->Control(AV1D_SET_TILE_LIST, &tile_list);
+    const aom_codec_err_t res = decoder_->DecodeFrame(
+        reinterpret_cast<uint8_t *>(pkt->data.frame.buf), pkt->data.frame.sz);
+    tile_list.num_entries = 0;
+    decoder_->Control(AV1D_SET_TILE_LIST, &tile_list);
+    if (res != AOM_CODEC_OK) {
+      abort_ = true;
+      EXPECT_EQ(AOM_CODEC_OK, res) << decoder_->DecodeError();
+      return "";
+    }
+    const aom_image_t *img = decoder_->GetDxData().Next();
+    EXPECT_TRUE(img != NULL);
+    if (img == NULL) return "";
+    ::libaom_test::MD5 md5_res;
+    md5_res.Add(img);
+    return md5_res.Get();
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    if (pkt->data.frame.pts == 0) {
+      // The key frame is decoded as a whole and becomes external reference 0.
+      const aom_codec_err_t res = decoder_->DecodeFrame(
+          reinterpret_cast<uint8_t *>(pkt->data.frame.buf),
+          pkt->data.frame.sz);
+      if (res != AOM_CODEC_OK) {
+        abort_ = true;
+        ASSERT_EQ(AOM_CODEC_OK, res) << decoder_->DecodeError();
+      }
+      const aom_image_t *img = decoder_->GetDxData().Next();
+      ASSERT_TRUE(img != NULL);
+      aom_image_t *const ref = &ext_ref_img_[0];
+      for (int plane = 0; plane < 3; ++plane) {
+        const int shift = plane > 0;
+        for (int r = 0; r < (kListImgHeight >> shift); ++r) {
+          memcpy(ref->planes[plane] + ref->stride[plane] * r,
+                 img->planes[plane] + img->stride[plane] * r,
+                 kListImgWidth >> shift);
+        }
+      }
+      ::libaom_test::MD5 md5_res;
+      md5_res.Add(img);
+      tile_list_md5_.push_back(md5_res.Get());
+
+      av1_ext_ref_frame_t ext_refs = { ext_ref_img_, 2 };
+      decoder_->Control(AV1D_SET_EXT_REF_PTR, &ext_refs);
+      return;
+    }
+
+    tile_list_md5_.push_back(DecodeTileList(pkt, 0));
+    // The tiles really are predicted from the external reference.
+    flat_ref_md5_.push_back(DecodeTileList(pkt, 1));
+  }
+
+  int set_cpu_used_;
+  ::libaom_test::Decoder *decoder_;
+  aom_image_t ext_ref_img_[2];
+  std::vector<std::string> md5_;
+  std::vector<std::string> tile_list_md5_;
+  std::vector<std::string> flat_ref_md5_;
+};
+
+TEST_P(AV1ExtTileListTest, ExtRefDecoderResultTest) {
+  ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv",
+                                       kListImgWidth, kListImgHeight, 30, 1, 0,
+                                       kListLimit);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+  ASSERT_EQ(kListLimit, static_cast<int>(md5_.size()));
+  ASSERT_EQ(md5_, tile_list_md5_);
+  for (int i = 0; i < kListLimit - 1; ++i)
+    EXPECT_NE(md5_[i + 1], flat_ref_md5_[i]) << "Frame " << i + 1;
+}
+
+AV1_INSTANTIATE_TEST_CASE(AV1ExtTileListTest, ::testing::Values(1, 4));
 }  // namespace
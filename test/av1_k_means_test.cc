@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+
+#include "aom_ports/mem.h"
+#include "av1/common/blockd.h"
+
+#include "test/acm_random.h"
+#include "test/function_equivalence_test.h"
+#include "test/register_state_check.h"
+
+using libaom_test::ACMRandom;
+using libaom_test::FunctionEquivalenceTest;
+
+namespace {
+
+typedef void (*CalcIndicesFunc)(const int16_t *data, const int *centroids,
+                                uint8_t *indices, int n, int k);
+typedef libaom_test::FuncParam<CalcIndicesFunc> TestFuncs;
+
+// The dimension of the data points is passed as the bit_depth field.
+class CalcIndicesTest : public FunctionEquivalenceTest<CalcIndicesFunc> {
+ protected:
+  static const int kIterations = 5000;
+
+  void Check(int max_val) {
+    const int dim = params_.bit_depth;
+    DECLARE_ALIGNED(16, int16_t, data[2 * MAX_PALETTE_SQUARE]);
+    int centroids[2 * PALETTE_MAX_SIZE];
+    uint8_t ind_ref[MAX_PALETTE_SQUARE];
+    uint8_t ind_tst[MAX_PALETTE_SQUARE];
+
+    for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+      const int n = rng_(MAX_PALETTE_SQUARE) + 1;
+      const int k = PALETTE_MIN_SIZE +
+                    rng_(PALETTE_MAX_SIZE - PALETTE_MIN_SIZE + 1);
+      for (int i = 0; i < n * dim; ++i) data[i] = rng_(max_val + 1);
+      // Repeated centroids exercise the tie breaking.
+      for (int i = 0; i < k * dim; ++i)
+        centroids[i] = (i >= dim && rng_(4) == 0) ? centroids[i - dim]
+                                                  : rng_(max_val + 1);
+      memset(ind_ref, 0xff, sizeof(ind_ref));
+      memset(ind_tst, 0xff, sizeof(ind_tst));
+
+      params_.ref_func(data, centroids, ind_ref, n, k);
+      ASM_REGISTER_STATE_CHECK(
+          params_.tst_func(data, centroids, ind_tst, n, k));
+
+      for (int i = 0; i < MAX_PALETTE_SQUARE; ++i)
+        ASSERT_EQ(ind_ref[i], ind_tst[i]) << "i: " << i << " n: " << n;
+    }
+  }
+};
+
+TEST_P(CalcIndicesTest, RandomValues8Bit) { Check(255); }
+
+TEST_P(CalcIndicesTest, RandomValues12Bit) { Check(4095); }
+
+TEST_P(CalcIndicesTest, FewValues) { Check(3); }
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, CalcIndicesTest,
+    ::testing::Values(TestFuncs(av1_calc_indices_dim1_c,
+                                av1_calc_indices_dim1_sse2, 1),
+                      TestFuncs(av1_calc_indices_dim2_c,
+                                av1_calc_indices_dim2_sse2, 2)));
+#endif  // HAVE_SSE2
+
+}  // namespace
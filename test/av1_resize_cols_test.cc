@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+
+#include "aom_dsp/aom_filter.h"
+
+#include "test/acm_random.h"
+#include "test/function_equivalence_test.h"
+#include "test/register_state_check.h"
+
+using libaom_test::ACMRandom;
+using libaom_test::FunctionEquivalenceTest;
+
+namespace {
+
+typedef void (*ResizeVertFunc)(const uint8_t *const *rows,
+                               const int16_t *filter, uint8_t *output,
+                               int cols);
+typedef libaom_test::FuncParam<ResizeVertFunc> TestFuncs;
+
+class ResizeVertTest : public FunctionEquivalenceTest<ResizeVertFunc> {
+ protected:
+  static const int kIterations = 5000;
+  static const int kMaxCols = 64;
+  static const int kRows = 2 * SUBPEL_TAPS;
+
+  // Taps are drawn from [-tap_range, tap_range]. With large taps the sums go
+  // well outside the pixel range, which exercises the clipping.
+  void Check(int tap_range) {
+    uint8_t input[kRows][kMaxCols];
+    uint8_t out_ref[kMaxCols + 1];
+    uint8_t out_tst[kMaxCols + 1];
+    const uint8_t *rows[SUBPEL_TAPS];
+    int16_t filter[SUBPEL_TAPS];
+
+    for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+      const int cols = rng_(kMaxCols) + 1;
+      for (int r = 0; r < kRows; ++r)
+        for (int c = 0; c < kMaxCols; ++c) input[r][c] = rng_.Rand8();
+      // Rows may repeat, as they do where the taps are clamped to the ends of
+      // a column.
+      for (int k = 0; k < SUBPEL_TAPS; ++k) {
+        rows[k] = input[rng_(kRows)];
+        filter[k] = rng_(2 * tap_range + 1) - tap_range;
+      }
+      memset(out_ref, 0xa5, sizeof(out_ref));
+      memset(out_tst, 0xa5, sizeof(out_tst));
+
+      params_.ref_func(rows, filter, out_ref, cols);
+      ASM_REGISTER_STATE_CHECK(params_.tst_func(rows, filter, out_tst, cols));
+
+      for (int c = 0; c <= kMaxCols; ++c)
+        ASSERT_EQ(out_ref[c], out_tst[c]) << "c: " << c << " cols: " << cols;
+    }
+  }
+};
+
+TEST_P(ResizeVertTest, SmallTaps) { Check(1 << (FILTER_BITS - 2)); }
+
+TEST_P(ResizeVertTest, LargeTaps) { Check(1 << FILTER_BITS); }
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, ResizeVertTest,
+    ::testing::Values(TestFuncs(av1_resize_vert_8tap_c,
+                                av1_resize_vert_8tap_sse2)));
+#endif  // HAVE_SSE2
+}  // namespace
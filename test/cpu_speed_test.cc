@@ -169,6 +169,21 @@ TEST_P(CpuSpeedTestLarge, TestTuneScreen) { TestTuneScreen(); }
 TEST_P(CpuSpeedTestLarge, TestEncodeHighBitrate) { TestEncodeHighBitrate(); }
 TEST_P(CpuSpeedTestLarge, TestLowBitrate) { TestLowBitrate(); }
 
+// Runs the mismatch checks through the realtime usage, which picks inter modes
+// from a model rather than with the full RD search at speeds 5 and up.
+class CpuSpeedTestRealtime : public CpuSpeedTest {
+ protected:
+  virtual void SetUp() {
+    ASSERT_EQ(AOM_CODEC_OK,
+              codec_->DefaultEncoderConfig(&cfg_, AOM_USAGE_REALTIME));
+    SetMode(encoding_mode_);
+  }
+};
+
+TEST_P(CpuSpeedTestRealtime, TestQ0) { TestQ0(); }
+TEST_P(CpuSpeedTestRealtime, TestEncodeHighBitrate) { TestEncodeHighBitrate(); }
+TEST_P(CpuSpeedTestRealtime, TestLowBitrate) { TestLowBitrate(); }
+
 AV1_INSTANTIATE_TEST_CASE(CpuSpeedTest,
                           ::testing::Values(::libaom_test::kTwoPassGood,
                                             ::libaom_test::kOnePassGood),
@@ -177,4 +192,7 @@ AV1_INSTANTIATE_TEST_CASE(CpuSpeedTestLarge,
                           ::testing::Values(::libaom_test::kTwoPassGood,
                                             ::libaom_test::kOnePassGood),
                           ::testing::Range(0, 1));
+AV1_INSTANTIATE_TEST_CASE(CpuSpeedTestRealtime,
+                          ::testing::Values(::libaom_test::kRealTime),
+                          ::testing::Range(5, 9));
 }  // namespace
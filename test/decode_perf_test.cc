@@ -9,7 +9,9 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
 */
 
+#include <ostream>
 #include <string>
+#include <vector>
 #include "test/codec_factory.h"
 #include "test/decode_test_driver.h"
 #include "test/encode_test_driver.h"
@@ -17,10 +19,12 @@
 #include "test/ivf_video_source.h"
 #include "test/md5_helper.h"
 #include "test/util.h"
+#include "test/video_source.h"
 #include "test/webm_video_source.h"
 #include "aom_ports/aom_timer.h"
 #include "./ivfenc.h"
 #include "./aom_version.h"
+#include "aom/aomdx.h"
 
 using std::tr1::make_tuple;
 
@@ -157,7 +161,7 @@ class AV1NewEncodeDecodePerfTest
               pkt->data.frame.sz);
   }
 
-  virtual bool DoDecode() { return false; }
+  virtual bool DoDecode() const { return false; }
 
   void set_speed(unsigned int speed) { speed_ = speed; }
 
@@ -241,4 +245,136 @@ TEST_P(AV1NewEncodeDecodePerfTest, PerfTest) {
 
 AV1_INSTANTIATE_TEST_CASE(AV1NewEncodeDecodePerfTest,
                           ::testing::Values(::libaom_test::kTwoPassGood));
+
+/*
+ AV1DecodeStagePerfTest encodes a synthetic pattern in memory, then decodes
+ the resulting stream with several thread counts and reports the time spent in
+ each decoder stage as reported by AV1D_GET_STAGE_TIMING. It needs no external
+ test data, so it can be run anywhere to catch regressions or size hardware.
+ */
+struct DecodePerfResolution {
+  unsigned int width;
+  unsigned int height;
+};
+
+void PrintTo(const DecodePerfResolution &resolution, ::std::ostream *os) {
+  *os << resolution.width << "x" << resolution.height;
+}
+
+const DecodePerfResolution kDecodePerfResolutions[] = {
+  { 352, 288 }, { 1280, 720 }, { 1920, 1080 },
+};
+
+const unsigned int kDecodePerfBitDepths[] = { 8, 10 };
+const int kDecodePerfLog2TileCols[] = { 0, 1, 2 };
+const unsigned int kDecodePerfThreads[] = { 1, 2, 4 };
+const int kDecodePerfFrames = 10;
+
+class AV1DecodeStagePerfTest
+    : public ::libaom_test::CodecTestWith3Params<DecodePerfResolution,
+                                                 unsigned int, int>,
+      public ::libaom_test::EncoderTest {
+ protected:
+  AV1DecodeStagePerfTest()
+      : EncoderTest(GET_PARAM(0)), resolution_(GET_PARAM(1)),
+        bit_depth_(GET_PARAM(2)), log2_tile_cols_(GET_PARAM(3)) {}
+
+  virtual ~AV1DecodeStagePerfTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libaom_test::kOnePassGood);
+
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_end_usage = AOM_VBR;
+    cfg_.rc_target_bitrate = resolution_.width * resolution_.height / 256;
+    cfg_.g_bit_depth = static_cast<aom_bit_depth_t>(bit_depth_);
+    cfg_.g_input_bit_depth = bit_depth_;
+    if (bit_depth_ > 8) init_flags_ = AOM_CODEC_USE_HIGHBITDEPTH;
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 4);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, log2_tile_cols_);
+    }
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    const uint8_t *const buf =
+        static_cast<const uint8_t *>(pkt->data.frame.buf);
+    packets_.push_back(std::vector<uint8_t>(buf, buf + pkt->data.frame.sz));
+  }
+
+  virtual bool DoDecode() const { return false; }
+
+  void DecodeAndReport(unsigned int threads) {
+    aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
+    cfg.threads = threads;
+    cfg.allow_lowbitdepth = bit_depth_ == 8;
+    libaom_test::AV1Decoder decoder(cfg, 0);
+
+    aom_usec_timer t;
+    aom_usec_timer_start(&t);
+    for (size_t i = 0; i < packets_.size(); ++i) {
+      ASSERT_EQ(AOM_CODEC_OK,
+                decoder.DecodeFrame(&packets_[i][0], packets_[i].size()));
+    }
+    aom_usec_timer_mark(&t);
+    const double elapsed_secs =
+        static_cast<double>(aom_usec_timer_elapsed(&t)) / kUsecsInSec;
+
+    aom_dec_stage_timing_t timing;
+    ASSERT_EQ(AOM_CODEC_OK, aom_codec_control(decoder.GetDecoder(),
+                                              AV1D_GET_STAGE_TIMING, &timing));
+    const unsigned frames = static_cast<unsigned>(packets_.size());
+
+    printf("{\n");
+    printf("\t\"type\" : \"decode_stage_perf_test\",\n");
+    printf("\t\"version\" : \"%s\",\n", VERSION_STRING_NOSP);
+    printf("\t\"width\" : %u,\n", resolution_.width);
+    printf("\t\"height\" : %u,\n", resolution_.height);
+    printf("\t\"bitDepth\" : %u,\n", bit_depth_);
+    printf("\t\"log2TileCols\" : %d,\n", log2_tile_cols_);
+    printf("\t\"threadCount\" : %u,\n", threads);
+    printf("\t\"decodeTimeSecs\" : %f,\n", elapsed_secs);
+    printf("\t\"totalFrames\" : %u,\n", frames);
+    printf("\t\"framesPerSecond\" : %f,\n", frames / elapsed_secs);
+    printf("\t\"tileParseSecs\" : %f,\n", timing.tile_parse / kUsecsInSec);
+    printf("\t\"tileReconSecs\" : %f,\n", timing.tile_recon / kUsecsInSec);
+    printf("\t\"coeffReadSecs\" : %f,\n", timing.coeff_read / kUsecsInSec);
+    printf("\t\"loopFilterSecs\" : %f,\n", timing.loop_filter / kUsecsInSec);
+    printf("\t\"cdefSecs\" : %f,\n", timing.cdef / kUsecsInSec);
+    printf("\t\"superresSecs\" : %f,\n", timing.superres / kUsecsInSec);
+    printf("\t\"loopRestorationSecs\" : %f\n",
+           timing.loop_restoration / kUsecsInSec);
+    printf("}\n");
+  }
+
+  DecodePerfResolution resolution_;
+  unsigned int bit_depth_;
+  int log2_tile_cols_;
+  std::vector<std::vector<uint8_t> > packets_;
+};
+
+TEST_P(AV1DecodeStagePerfTest, PerfTest) {
+  libaom_test::PatternVideoSource video(bit_depth_);
+  video.SetSize(resolution_.width, resolution_.height);
+  if (bit_depth_ > 8) video.SetImageFormat(AOM_IMG_FMT_I42016);
+  video.set_limit(kDecodePerfFrames);
+
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_FALSE(packets_.empty());
+
+  const size_t num_threads =
+      sizeof(kDecodePerfThreads) / sizeof(kDecodePerfThreads[0]);
+  for (size_t i = 0; i < num_threads; ++i)
+    ASSERT_NO_FATAL_FAILURE(DecodeAndReport(kDecodePerfThreads[i]));
+}
+
+AV1_INSTANTIATE_TEST_CASE(AV1DecodeStagePerfTest,
+                          ::testing::ValuesIn(kDecodePerfResolutions),
+                          ::testing::ValuesIn(kDecodePerfBitDepths),
+                          ::testing::ValuesIn(kDecodePerfLog2TileCols));
 }  // namespace
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+
+namespace {
+
+// Superres denominators are relative to this numerator, so this one leaves
+// frames unscaled.
+const int kScaleNumerator = 8;
+
+// Encodes a clip and decodes every frame with a single-threaded decoder and
+// with a decoder that splits the frame-level jobs, such as the superres upscale
+// and the motion field projection, between several workers. The two must
+// produce identical frames.
+class DecodeThreadsTest
+    : public ::libaom_test::CodecTestWithParam<int>,
+      public ::libaom_test::EncoderTest {
+ protected:
+  DecodeThreadsTest()
+      : EncoderTest(GET_PARAM(0)), superres_denominator_(GET_PARAM(1)),
+        num_frames_(0) {
+    aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
+    cfg.allow_lowbitdepth = 1;
+    cfg.threads = 1;
+    single_dec_ = codec_->CreateDecoder(cfg, 0);
+    cfg.threads = 4;
+    multi_dec_ = codec_->CreateDecoder(cfg, 0);
+  }
+
+  virtual ~DecodeThreadsTest() {
+    delete single_dec_;
+    delete multi_dec_;
+  }
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libaom_test::kOnePassGood);
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_end_usage = AOM_VBR;
+    cfg_.rc_target_bitrate = 300;
+    if (superres_denominator_ > kScaleNumerator) {
+      cfg_.rc_superres_mode = 1;  // SUPERRES_FIXED
+      cfg_.rc_superres_denominator = superres_denominator_;
+      cfg_.rc_superres_kf_denominator = superres_denominator_;
+    }
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) encoder->Control(AOME_SET_CPUUSED, 5);
+  }
+
+  const char *DecodeAndHash(::libaom_test::Decoder *dec,
+                            const aom_codec_cx_pkt_t *pkt,
+                            ::libaom_test::MD5 *md5) {
+    const aom_codec_err_t res = dec->DecodeFrame(
+        reinterpret_cast<uint8_t *>(pkt->data.frame.buf), pkt->data.frame.sz);
+    if (res != AOM_CODEC_OK) {
+      abort_ = true;
+      EXPECT_EQ(AOM_CODEC_OK, res) << dec->DecodeError();
+      return "";
+    }
+    ::libaom_test::DxDataIterator dec_iter = dec->GetDxData();
+    const aom_image_t *img;
+    while ((img = dec_iter.Next()) != NULL) md5->Add(img);
+    return md5->Get();
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    ::libaom_test::MD5 single_md5, multi_md5;
+    const std::string single_str =
+        DecodeAndHash(single_dec_, pkt, &single_md5);
+    const std::string multi_str = DecodeAndHash(multi_dec_, pkt, &multi_md5);
+    if (abort_) return;
+    ASSERT_EQ(single_str, multi_str) << "Frame " << num_frames_;
+    ++num_frames_;
+  }
+
+  void DoTest(unsigned int lag_in_frames) {
+    cfg_.g_lag_in_frames = lag_in_frames;
+    ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352,
+                                         288, 30, 1, 0, 10);
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+    EXPECT_GT(num_frames_, 0);
+  }
+
+  int superres_denominator_;
+  int num_frames_;
+  ::libaom_test::Decoder *single_dec_;
+  ::libaom_test::Decoder *multi_dec_;
+};
+
+TEST_P(DecodeThreadsTest, MD5Match) { DoTest(0); }
+
+// With lag the encoder codes alt-ref frames, so the motion field of later
+// frames is also projected from references that follow them.
+TEST_P(DecodeThreadsTest, MotionFieldMD5Match) { DoTest(12); }
+
+AV1_INSTANTIATE_TEST_CASE(DecodeThreadsTest,
+                          ::testing::Values(kScaleNumerator,
+                                            kScaleNumerator + 3,
+                                            2 * kScaleNumerator));
+}  // namespace
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+
+#include "aom_ports/aom_timer.h"
+#include "aom_ports/mem.h"
+#include "av1/common/blockd.h"
+
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+
+using libaom_test::ACMRandom;
+
+namespace {
+
+// All three zones are tested through one signature per bit depth.
+template <typename Pixel>
+struct DrPred {
+  typedef void (*Func)(Pixel *dst, ptrdiff_t stride, int bw, int bh,
+                       const Pixel *above, const Pixel *left,
+                       int upsample_above, int upsample_left, int dx, int dy,
+                       int bd);
+};
+
+typedef void (*DrPredZ1Func)(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
+                             const uint8_t *above, const uint8_t *left,
+                             int upsample_above, int dx, int dy);
+typedef void (*DrPredZ2Func)(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
+                             const uint8_t *above, const uint8_t *left,
+                             int upsample_above, int upsample_left, int dx,
+                             int dy);
+typedef DrPredZ1Func DrPredZ3Func;
+typedef void (*HighbdDrPredZ1Func)(uint16_t *dst, ptrdiff_t stride, int bw,
+                                   int bh, const uint16_t *above,
+                                   const uint16_t *left, int upsample_above,
+                                   int dx, int dy, int bd);
+typedef void (*HighbdDrPredZ2Func)(uint16_t *dst, ptrdiff_t stride, int bw,
+                                   int bh, const uint16_t *above,
+                                   const uint16_t *left, int upsample_above,
+                                   int upsample_left, int dx, int dy, int bd);
+typedef HighbdDrPredZ1Func HighbdDrPredZ3Func;
+
+template <DrPredZ1Func fn>
+void z1_wrapper(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
+                const uint8_t *above, const uint8_t *left, int upsample_above,
+                int upsample_left, int dx, int dy, int bd) {
+  (void)upsample_left;
+  (void)bd;
+  fn(dst, stride, bw, bh, above, left, upsample_above, dx, dy);
+}
+
+template <DrPredZ2Func fn>
+void z2_wrapper(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
+                const uint8_t *above, const uint8_t *left, int upsample_above,
+                int upsample_left, int dx, int dy, int bd) {
+  (void)bd;
+  fn(dst, stride, bw, bh, above, left, upsample_above, upsample_left, dx, dy);
+}
+
+template <DrPredZ3Func fn>
+void z3_wrapper(uint8_t *dst, ptrdiff_t stride, int bw, int bh,
+                const uint8_t *above, const uint8_t *left, int upsample_above,
+                int upsample_left, int dx, int dy, int bd) {
+  (void)upsample_above;
+  (void)bd;
+  fn(dst, stride, bw, bh, above, left, upsample_left, dx, dy);
+}
+
+template <HighbdDrPredZ1Func fn>
+void highbd_z1_wrapper(uint16_t *dst, ptrdiff_t stride, int bw, int bh,
+                       const uint16_t *above, const uint16_t *left,
+                       int upsample_above, int upsample_left, int dx, int dy,
+                       int bd) {
+  (void)upsample_left;
+  fn(dst, stride, bw, bh, above, left, upsample_above, dx, dy, bd);
+}
+
+template <HighbdDrPredZ2Func fn>
+void highbd_z2_wrapper(uint16_t *dst, ptrdiff_t stride, int bw, int bh,
+                       const uint16_t *above, const uint16_t *left,
+                       int upsample_above, int upsample_left, int dx, int dy,
+                       int bd) {
+  fn(dst, stride, bw, bh, above, left, upsample_above, upsample_left, dx, dy,
+     bd);
+}
+
+template <HighbdDrPredZ3Func fn>
+void highbd_z3_wrapper(uint16_t *dst, ptrdiff_t stride, int bw, int bh,
+                       const uint16_t *above, const uint16_t *left,
+                       int upsample_above, int upsample_left, int dx, int dy,
+                       int bd) {
+  (void)upsample_above;
+  fn(dst, stride, bw, bh, above, left, upsample_left, dx, dy, bd);
+}
+
+const int kBlockSizes[][2] = { { 4, 4 },   { 4, 8 },   { 8, 4 },   { 8, 8 },
+                               { 8, 16 },  { 16, 8 },  { 16, 16 }, { 16, 32 },
+                               { 32, 16 }, { 32, 32 }, { 32, 64 }, { 64, 32 },
+                               { 64, 64 }, { 4, 16 },  { 16, 4 },  { 8, 32 },
+                               { 32, 8 },  { 16, 64 }, { 64, 16 } };
+
+// A reference and a tested predictor for one zone (1, 2 or 3).
+template <typename Pixel>
+struct DrPredParam {
+  DrPredParam(typename DrPred<Pixel>::Func ref = NULL,
+              typename DrPred<Pixel>::Func tst = NULL, int zone = 0)
+      : ref_func(ref), tst_func(tst), zone(zone) {}
+  typename DrPred<Pixel>::Func ref_func;
+  typename DrPred<Pixel>::Func tst_func;
+  int zone;
+};
+
+template <typename Pixel>
+std::ostream &operator<<(std::ostream &os, const DrPredParam<Pixel> &p) {
+  return os << "zone:" << p.zone
+            << " function:" << reinterpret_cast<const void *>(p.ref_func)
+            << " function:" << reinterpret_cast<const void *>(p.tst_func);
+}
+
+template <typename Pixel>
+class DrPredTest : public ::testing::TestWithParam<DrPredParam<Pixel> > {
+ public:
+  DrPredTest() : rng_(ACMRandom::DeterministicSeed()) {}
+
+  virtual void SetUp() { params_ = this->GetParam(); }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  static const int kStride = MAX_TX_SIZE + 16;
+  // The predictors read up to two samples before the start of each edge and
+  // at most 2 * MAX_TX_SIZE samples from it.
+  static const int kEdgeOffset = 16;
+  static const int kEdgeSize = kEdgeOffset + 2 * MAX_TX_SIZE + 16;
+
+  // Returns whether angle is in the zone under test, setting dx and dy.
+  bool GetDerivatives(int angle, int *dx, int *dy) const {
+    const int zone = params_.zone;
+    *dx = *dy = 1;
+    if (zone == 1 && angle > 0 && angle < 90) {
+      *dx = dr_intra_derivative[angle];
+    } else if (zone == 2 && angle > 90 && angle < 180) {
+      *dx = dr_intra_derivative[180 - angle];
+      *dy = dr_intra_derivative[angle - 90];
+    } else if (zone == 3 && angle > 180 && angle < 270) {
+      *dy = dr_intra_derivative[270 - angle];
+    } else {
+      return false;
+    }
+    // Some derivatives are never used.
+    return *dx > 0 && *dy > 0;
+  }
+
+  void FillEdges(int max_val) {
+    // Saturated edges exercise the rounding at the limits.
+    const bool extreme = rng_(4) == 0;
+    for (int i = 0; i < kEdgeSize; ++i) {
+      above_[i] = extreme ? (rng_(2) ? max_val : 0) : rng_(max_val + 1);
+      left_[i] = extreme ? (rng_(2) ? max_val : 0) : rng_(max_val + 1);
+    }
+  }
+
+  void Check(int bd) {
+    const int max_val = (1 << bd) - 1;
+
+    for (size_t s = 0; s < sizeof(kBlockSizes) / sizeof(kBlockSizes[0]);
+         ++s) {
+      const int bw = kBlockSizes[s][0];
+      const int bh = kBlockSizes[s][1];
+      for (int upsample = 0; upsample < 4; ++upsample) {
+        // Edges are only upsampled for small blocks.
+        if (upsample && bw + bh > 16) break;
+        for (int angle = 0; angle < 270 && !this->HasFatalFailure(); ++angle) {
+          int dx, dy;
+          if (!GetDerivatives(angle, &dx, &dy)) continue;
+          FillEdges(max_val);
+          for (int i = 0; i < kStride * MAX_TX_SIZE; ++i)
+            dst_ref_[i] = dst_tst_[i] = rng_(max_val + 1);
+
+          params_.ref_func(dst_ref_, kStride, bw, bh,
+                                 above_ + kEdgeOffset, left_ + kEdgeOffset,
+                                 upsample & 1, upsample >> 1, dx, dy, bd);
+          ASM_REGISTER_STATE_CHECK(params_.tst_func(
+              dst_tst_, kStride, bw, bh, above_ + kEdgeOffset,
+              left_ + kEdgeOffset, upsample & 1, upsample >> 1, dx, dy, bd));
+
+          for (int i = 0; i < kStride * MAX_TX_SIZE; ++i) {
+            ASSERT_EQ(dst_ref_[i], dst_tst_[i])
+                << "bw: " << bw << " bh: " << bh << " angle: " << angle
+                << " upsample: " << upsample << " r: " << i / kStride
+                << " c: " << i % kStride;
+          }
+        }
+      }
+    }
+  }
+
+  void Speed(int bw, int bh) {
+    const int kNumTests = 20000;
+    double elapsed[2];
+
+    FillEdges(255);
+    for (int f = 0; f < 2; ++f) {
+      const typename DrPred<Pixel>::Func func =
+          f ? params_.tst_func : params_.ref_func;
+      aom_usec_timer timer;
+      aom_usec_timer_start(&timer);
+      for (int n = 0; n < kNumTests; ++n) {
+        for (int angle = 0; angle < 270; angle += 3) {
+          int dx, dy;
+          if (!GetDerivatives(angle, &dx, &dy)) continue;
+          func(dst_tst_, kStride, bw, bh, above_ + kEdgeOffset,
+               left_ + kEdgeOffset, 0, 0, dx, dy, 8);
+        }
+      }
+      aom_usec_timer_mark(&timer);
+      elapsed[f] = static_cast<double>(aom_usec_timer_elapsed(&timer));
+    }
+    printf("zone %d %dx%d: ref %.0f us, tst %.0f us, %.2fx\n", params_.zone,
+           bw, bh, elapsed[0], elapsed[1], elapsed[0] / elapsed[1]);
+  }
+
+  ACMRandom rng_;
+  DrPredParam<Pixel> params_;
+  DECLARE_ALIGNED(16, Pixel, above_[kEdgeSize]);
+  DECLARE_ALIGNED(16, Pixel, left_[kEdgeSize]);
+  DECLARE_ALIGNED(16, Pixel, dst_ref_[kStride * MAX_TX_SIZE]);
+  DECLARE_ALIGNED(16, Pixel, dst_tst_[kStride * MAX_TX_SIZE]);
+};
+
+class LowbdDrPredTest : public DrPredTest<uint8_t> {};
+
+TEST_P(LowbdDrPredTest, RandomValues) { Check(8); }
+
+TEST_P(LowbdDrPredTest, DISABLED_Speed) {
+  Speed(8, 8);
+  Speed(16, 16);
+  Speed(32, 32);
+}
+
+class HighbdDrPredTest : public DrPredTest<uint16_t> {};
+
+TEST_P(HighbdDrPredTest, RandomValues8Bit) { Check(8); }
+
+TEST_P(HighbdDrPredTest, RandomValues10Bit) { Check(10); }
+
+TEST_P(HighbdDrPredTest, RandomValues12Bit) { Check(12); }
+
+TEST_P(HighbdDrPredTest, DISABLED_Speed) {
+  Speed(8, 8);
+  Speed(16, 16);
+  Speed(32, 32);
+}
+
+#if HAVE_SSE4_1
+typedef DrPredParam<uint8_t> LowbdParam;
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, LowbdDrPredTest,
+    ::testing::Values(
+        LowbdParam(z1_wrapper<av1_dr_prediction_z1_c>,
+                   z1_wrapper<av1_dr_prediction_z1_sse4_1>, 1),
+        LowbdParam(z2_wrapper<av1_dr_prediction_z2_c>,
+                   z2_wrapper<av1_dr_prediction_z2_sse4_1>, 2),
+        LowbdParam(z3_wrapper<av1_dr_prediction_z3_c>,
+                   z3_wrapper<av1_dr_prediction_z3_sse4_1>, 3)));
+
+typedef DrPredParam<uint16_t> HighbdParam;
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, HighbdDrPredTest,
+    ::testing::Values(
+        HighbdParam(highbd_z1_wrapper<av1_highbd_dr_prediction_z1_c>,
+                    highbd_z1_wrapper<av1_highbd_dr_prediction_z1_sse4_1>, 1),
+        HighbdParam(highbd_z2_wrapper<av1_highbd_dr_prediction_z2_c>,
+                    highbd_z2_wrapper<av1_highbd_dr_prediction_z2_sse4_1>, 2),
+        HighbdParam(highbd_z3_wrapper<av1_highbd_dr_prediction_z3_c>,
+                    highbd_z3_wrapper<av1_highbd_dr_prediction_z3_sse4_1>,
+                    3)));
+#endif  // HAVE_SSE4_1
+
+}  // namespace
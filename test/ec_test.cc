@@ -12,9 +12,17 @@
 #include "third_party/googletest/src/googletest/include/gtest/gtest.h"
 
 #include <cstdlib>
+#include <cstring>
 
+#include "./aom_config.h"
+#include "./aom_dsp_rtcd.h"
 #include "aom_dsp/entenc.h"
 #include "aom_dsp/entdec.h"
+#include "aom_dsp/prob.h"
+#if ARCH_X86 || ARCH_X86_64
+#include "aom_ports/x86.h"
+#endif
+#include "test/acm_random.h"
 
 TEST(EC_TEST, random_ec_test) {
   od_ec_enc enc;
@@ -157,3 +165,51 @@ TEST(EC_TEST, random_ec_test) {
   od_ec_enc_clear(&enc);
   EXPECT_EQ(ret, 0);
 }
+
+namespace {
+
+typedef void (*UpdateCdfFunc)(aom_cdf_prob *cdf, int val, int nsymbs);
+
+// Checks that an optimized aom_update_cdf() adapts every alphabet size the
+// same way as update_cdf(), including the adaptation counter, and leaves the
+// entries that follow the counter alone.
+void TestUpdateCdf(UpdateCdfFunc update) {
+  libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+  for (int nsymbs = 2; nsymbs <= 16; ++nsymbs) {
+    for (int iter = 0; iter < 1000; ++iter) {
+      aom_cdf_prob ref[CDF_SIZE(16) + 8];
+      aom_cdf_prob tst[CDF_SIZE(16) + 8];
+      int i;
+      for (i = 0; i < CDF_SIZE(16) + 8; ++i) ref[i] = rnd.Rand16();
+      // Build a valid inverse CDF: non-increasing, ending in 0.
+      ref[0] = rnd.Rand16() % (CDF_PROB_TOP + 1);
+      for (i = 1; i < nsymbs - 1; ++i) ref[i] = rnd.Rand16() % (ref[i - 1] + 1);
+      ref[nsymbs - 1] = 0;
+      ref[nsymbs] = rnd.Rand8() % 33;
+      memcpy(tst, ref, sizeof(ref));
+      const int val = rnd.Rand8() % nsymbs;
+      update_cdf(ref, val, nsymbs);
+      update(tst, val, nsymbs);
+      for (i = 0; i < CDF_SIZE(16) + 8; ++i) {
+        ASSERT_EQ(ref[i], tst[i]) << "nsymbs " << nsymbs << " val " << val
+                                  << " index " << i;
+      }
+    }
+  }
+}
+
+#if HAVE_SSE2
+TEST(EC_TEST, UpdateCdfSSE2) {
+  if (!(x86_simd_caps() & HAS_SSE2)) return;
+  TestUpdateCdf(aom_update_cdf_sse2);
+}
+#endif
+
+#if HAVE_AVX2
+TEST(EC_TEST, UpdateCdfAVX2) {
+  if (!(x86_simd_caps() & HAS_AVX2)) return;
+  TestUpdateCdf(aom_update_cdf_avx2);
+}
+#endif
+
+}  // namespace
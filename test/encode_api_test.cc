@@ -9,11 +9,16 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
 */
 
+#include <string.h>
+
 #include "third_party/googletest/src/googletest/include/gtest/gtest.h"
 
 #include "./aom_config.h"
+#include "test/acm_random.h"
 #include "test/util.h"
 #include "aom/aomcx.h"
+#include "aom/aomdx.h"
+#include "aom/aom_decoder.h"
 #include "aom/aom_encoder.h"
 
 namespace {
@@ -49,7 +54,8 @@ TEST(EncodeAPI, InvalidParams) {
     EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
               aom_codec_enc_init(&enc, kCodecs[i], NULL, 0));
     EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
-              aom_codec_enc_config_default(kCodecs[i], &cfg, 1));
+              aom_codec_enc_config_default(kCodecs[i], &cfg,
+                                           AOM_USAGE_REALTIME + 1));
 
     EXPECT_EQ(AOM_CODEC_OK, aom_codec_enc_config_default(kCodecs[i], &cfg, 0));
     EXPECT_EQ(AOM_CODEC_OK, aom_codec_enc_init(&enc, kCodecs[i], &cfg, 0));
@@ -59,4 +65,164 @@ TEST(EncodeAPI, InvalidParams) {
   }
 }
 
+#if CONFIG_AV1_ENCODER
+// Encodes a few frames of a small gradient and returns the encoder's
+// accumulated stage statistics.
+void EncodeWithStageStats(unsigned int enable, aom_enc_stage_stats_t *stats) {
+  const int kWidth = 64;
+  const int kHeight = 64;
+  const int kFrames = 3;
+  aom_codec_ctx_t enc;
+  aom_codec_enc_cfg_t cfg;
+  aom_image_t img;
+
+  ASSERT_EQ(AOM_CODEC_OK,
+            aom_codec_enc_config_default(&aom_codec_av1_cx_algo, &cfg, 0));
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 0;
+  ASSERT_EQ(AOM_CODEC_OK,
+            aom_codec_enc_init(&enc, &aom_codec_av1_cx_algo, &cfg, 0));
+  ASSERT_EQ(AOM_CODEC_OK, aom_codec_control(&enc, AOME_SET_CPUUSED, 8));
+  ASSERT_EQ(AOM_CODEC_OK,
+            aom_codec_control(&enc, AV1E_SET_ENABLE_STAGE_STATS, enable));
+
+  ASSERT_TRUE(aom_img_alloc(&img, AOM_IMG_FMT_I420, kWidth, kHeight, 1) !=
+              NULL);
+  for (int frame = 0; frame < kFrames; ++frame) {
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x)
+        img.planes[0][y * img.stride[0] + x] = (x + y + 8 * frame) & 0xff;
+    }
+    memset(img.planes[1], 128, img.stride[1] * (kHeight >> 1));
+    memset(img.planes[2], 128, img.stride[2] * (kHeight >> 1));
+    EXPECT_EQ(AOM_CODEC_OK, aom_codec_encode(&enc, &img, frame, 1, 0));
+  }
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_encode(&enc, NULL, 0, 0, 0));
+
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(&enc, AV1E_GET_STAGE_STATS,
+                              static_cast<aom_enc_stage_stats_t *>(NULL)));
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_control(&enc, AV1E_GET_STAGE_STATS, stats));
+
+  aom_img_free(&img);
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&enc));
+}
+
+TEST(EncodeAPI, StageStats) {
+  aom_enc_stage_stats_t stats;
+
+  EncodeWithStageStats(1, &stats);
+  EXPECT_EQ(3, stats.frames);
+  EXPECT_GT(stats.blocks_evaluated, 0);
+  EXPECT_GT(stats.partition_search, 0);
+
+  // Counters are always gathered, timings only on request.
+  EncodeWithStageStats(0, &stats);
+  EXPECT_EQ(3, stats.frames);
+  EXPECT_GT(stats.blocks_evaluated, 0);
+  EXPECT_EQ(0, stats.partition_search);
+  EXPECT_EQ(0, stats.motion_search);
+  EXPECT_EQ(0, stats.tx_search);
+  EXPECT_EQ(0, stats.pack_bitstream);
+}
+
+#if CONFIG_AV1_DECODER
+// Encodes noisy flat areas losslessly with the denoiser on, so that the
+// decoded frames are the denoised sources, and checks them against the
+// noise-free frames. The encoder assumes a noise level well below the actual
+// one, so only the first frame is left noisy: the following ones are denoised
+// with the noise strength fitted on the previous frames.
+void DenoiseNoisySource(int threads) {
+  const int kWidth = 96;
+  const int kHeight = 64;
+  const int kFrames = 4;
+  libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+  aom_codec_ctx_t enc, dec;
+  aom_codec_enc_cfg_t cfg;
+  aom_image_t img;
+  uint8_t clean[kHeight][kWidth];
+
+  ASSERT_EQ(AOM_CODEC_OK,
+            aom_codec_enc_config_default(&aom_codec_av1_cx_algo, &cfg, 0));
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 0;
+  cfg.g_threads = threads;
+  ASSERT_EQ(AOM_CODEC_OK,
+            aom_codec_enc_init(&enc, &aom_codec_av1_cx_algo, &cfg, 0));
+  ASSERT_EQ(AOM_CODEC_OK, aom_codec_dec_init(&dec, &aom_codec_av1_dx_algo,
+                                             NULL, 0));
+  ASSERT_EQ(AOM_CODEC_OK, aom_codec_control(&enc, AOME_SET_CPUUSED, 8));
+  ASSERT_EQ(AOM_CODEC_OK, aom_codec_control(&enc, AV1E_SET_LOSSLESS, 1));
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(&enc, AV1E_SET_DENOISE_NOISE_LEVEL, 51));
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(&enc, AV1E_SET_DENOISE_BLOCK_SIZE, 4));
+  ASSERT_EQ(AOM_CODEC_OK,
+            aom_codec_control(&enc, AV1E_SET_DENOISE_NOISE_LEVEL, 1));
+  ASSERT_EQ(AOM_CODEC_OK,
+            aom_codec_control(&enc, AV1E_SET_DENOISE_BLOCK_SIZE, 16));
+
+  for (int y = 0; y < kHeight; ++y)
+    for (int x = 0; x < kWidth; ++x) clean[y][x] = 64 + 32 * (x / 32);
+
+  ASSERT_TRUE(aom_img_alloc(&img, AOM_IMG_FMT_I420, kWidth, kHeight, 1) !=
+              NULL);
+  memset(img.planes[1], 128, img.stride[1] * (kHeight >> 1));
+  memset(img.planes[2], 128, img.stride[2] * (kHeight >> 1));
+  for (int frame = 0; frame < kFrames; ++frame) {
+    // Uniform noise in [-8, 8], whose variance is 24.
+    int64_t noisy_sse = 0;
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        const int noise = rnd(17) - 8;
+        img.planes[0][y * img.stride[0] + x] = clean[y][x] + noise;
+        noisy_sse += noise * noise;
+      }
+    }
+    ASSERT_EQ(AOM_CODEC_OK, aom_codec_encode(&enc, &img, frame, 1, 0));
+
+    aom_codec_iter_t iter = NULL;
+    const aom_codec_cx_pkt_t *pkt;
+    int decoded = 0;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) continue;
+      ASSERT_EQ(AOM_CODEC_OK,
+                aom_codec_decode(&dec,
+                                 static_cast<uint8_t *>(pkt->data.frame.buf),
+                                 static_cast<unsigned int>(pkt->data.frame.sz),
+                                 NULL));
+      aom_codec_iter_t dec_iter = NULL;
+      const aom_image_t *out = aom_codec_get_frame(&dec, &dec_iter);
+      ASSERT_TRUE(out != NULL);
+      int64_t sse = 0;
+      for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+          const int diff = out->planes[0][y * out->stride[0] + x] - clean[y][x];
+          sse += diff * diff;
+        }
+      }
+      if (frame == 0)
+        EXPECT_GT(4 * sse, 3 * noisy_sse) << "threads: " << threads;
+      else
+        EXPECT_LT(4 * sse, noisy_sse) << "frame: " << frame
+                                      << " threads: " << threads;
+      ++decoded;
+    }
+    EXPECT_EQ(1, decoded);
+  }
+
+  aom_img_free(&img);
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&dec));
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&enc));
+}
+
+TEST(EncodeAPI, DenoiseNoisySource) {
+  DenoiseNoisySource(1);
+  DenoiseNoisySource(2);
+}
+#endif  // CONFIG_AV1_DECODER
+#endif  // CONFIG_AV1_ENCODER
+
 }  // namespace
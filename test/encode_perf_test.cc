@@ -53,13 +53,37 @@ const EncodePerfTestVideo kAV1EncodePerfTestVectors[] = {
 const int kEncodePerfTestSpeeds[] = { 5, 6, 7, 8 };
 const int kEncodePerfTestThreads[] = { 1, 2, 4 };
 
+// Prints the members of aom_enc_stage_stats_t as JSON fields. Times are
+// summed over all encoder threads.
+void PrintStageStats(const aom_enc_stage_stats_t &stats) {
+  printf("\t\"partitionSearchSecs\" : %f,\n",
+         stats.partition_search / kUsecsInSec);
+  printf("\t\"motionSearchSecs\" : %f,\n", stats.motion_search / kUsecsInSec);
+  printf("\t\"txSearchSecs\" : %f,\n", stats.tx_search / kUsecsInSec);
+  printf("\t\"temporalFilterSecs\" : %f,\n",
+         stats.temporal_filter / kUsecsInSec);
+  printf("\t\"loopFilterSearchSecs\" : %f,\n",
+         stats.loop_filter_search / kUsecsInSec);
+  printf("\t\"cdefSearchSecs\" : %f,\n", stats.cdef_search / kUsecsInSec);
+  printf("\t\"restorationSearchSecs\" : %f,\n",
+         stats.restoration_search / kUsecsInSec);
+  printf("\t\"packBitstreamSecs\" : %f,\n", stats.pack_bitstream / kUsecsInSec);
+  printf("\t\"blocksEvaluated\" : %.0f,\n",
+         static_cast<double>(stats.blocks_evaluated));
+  printf("\t\"earlyTerminations\" : %.0f,\n",
+         static_cast<double>(stats.early_terminations));
+  printf("\t\"txCacheHits\" : %.0f\n",
+         static_cast<double>(stats.tx_cache_hits));
+}
+
 class AV1EncodePerfTest
     : public ::libaom_test::CodecTestWithParam<libaom_test::TestMode>,
       public ::libaom_test::EncoderTest {
  protected:
   AV1EncodePerfTest()
       : EncoderTest(GET_PARAM(0)), min_psnr_(kMaxPsnr), nframes_(0),
-        encoding_mode_(GET_PARAM(1)), speed_(0), threads_(1) {}
+        encoding_mode_(GET_PARAM(1)), speed_(0), threads_(1),
+        stage_stats_() {}
 
   virtual ~AV1EncodePerfTest() {}
 
@@ -89,7 +113,10 @@ class AV1EncodePerfTest
       encoder->Control(AV1E_SET_TILE_COLUMNS, log2_tile_columns);
       encoder->Control(AV1E_SET_FRAME_PARALLEL_DECODING, 1);
       encoder->Control(AOME_SET_ENABLEAUTOALTREF, 0);
+      encoder->Control(AV1E_SET_ENABLE_STAGE_STATS, 1);
     }
+    // The encoder is gone once RunLoop() returns, so keep a running copy.
+    encoder->Control(AV1E_GET_STAGE_STATS, &stage_stats_);
   }
 
   virtual void BeginPassHook(unsigned int /*pass*/) {
@@ -108,6 +135,8 @@ class AV1EncodePerfTest
 
   double min_psnr() const { return min_psnr_; }
 
+  const aom_enc_stage_stats_t &stage_stats() const { return stage_stats_; }
+
   void set_speed(unsigned int speed) { speed_ = speed; }
 
   void set_threads(unsigned int threads) { threads_ = threads; }
@@ -118,6 +147,7 @@ class AV1EncodePerfTest
   libaom_test::TestMode encoding_mode_;
   unsigned speed_;
   unsigned int threads_;
+  aom_enc_stage_stats_t stage_stats_;
 };
 
 TEST_P(AV1EncodePerfTest, PerfTest) {
@@ -174,7 +204,8 @@ TEST_P(AV1EncodePerfTest, PerfTest) {
         printf("\t\"framesPerSecond\" : %f,\n", fps);
         printf("\t\"minPsnr\" : %f,\n", minimum_psnr);
         printf("\t\"speed\" : %d,\n", kEncodePerfTestSpeeds[j]);
-        printf("\t\"threads\" : %d\n", kEncodePerfTestThreads[k]);
+        printf("\t\"threads\" : %d,\n", kEncodePerfTestThreads[k]);
+        PrintStageStats(stage_stats());
         printf("}\n");
       }
     }
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./av1_rtcd.h"
+
+#include "aom_ports/mem.h"
+#include "av1/common/common_data.h"
+#include "av1/common/enums.h"
+
+#include "test/acm_random.h"
+#include "test/function_equivalence_test.h"
+#include "test/register_state_check.h"
+
+using libaom_test::ACMRandom;
+using libaom_test::FunctionEquivalenceTest;
+
+namespace {
+
+typedef void (*FilterIntraFunc)(uint8_t *dst, ptrdiff_t stride,
+                                TX_SIZE tx_size, const uint8_t *above,
+                                const uint8_t *left);
+typedef void (*HighbdFilterIntraFunc)(uint16_t *dst, ptrdiff_t stride,
+                                      TX_SIZE tx_size, const uint16_t *above,
+                                      const uint16_t *left, int bd);
+
+const int kStride = 48;
+const int kEdgeSize = 2 * 32 + 16;
+
+// Filter intra is only used for transforms up to 32x32.
+bool IsValidTxSize(int tx_size) {
+  return tx_size_wide[tx_size] <= 32 && tx_size_high[tx_size] <= 32;
+}
+
+class FilterIntraTest : public FunctionEquivalenceTest<FilterIntraFunc> {
+ protected:
+  void Check(bool extreme) {
+    DECLARE_ALIGNED(16, uint8_t, above[kEdgeSize]);
+    DECLARE_ALIGNED(16, uint8_t, left[kEdgeSize]);
+    DECLARE_ALIGNED(16, uint8_t, dst_ref[kStride * 32]);
+    DECLARE_ALIGNED(16, uint8_t, dst_tst[kStride * 32]);
+
+    for (int iter = 0; iter < 100 && !HasFatalFailure(); ++iter) {
+      for (int tx_size = 0; tx_size < TX_SIZES_ALL; ++tx_size) {
+        if (!IsValidTxSize(tx_size)) continue;
+        for (int i = 0; i < kEdgeSize; ++i) {
+          above[i] = extreme ? 255 * rng_(2) : rng_.Rand8();
+          left[i] = extreme ? 255 * rng_(2) : rng_.Rand8();
+        }
+        for (int i = 0; i < kStride * 32; ++i)
+          dst_ref[i] = dst_tst[i] = rng_.Rand8();
+
+        params_.ref_func(dst_ref, kStride, static_cast<TX_SIZE>(tx_size),
+                         above + 16, left);
+        ASM_REGISTER_STATE_CHECK(
+            params_.tst_func(dst_tst, kStride, static_cast<TX_SIZE>(tx_size),
+                             above + 16, left));
+
+        for (int i = 0; i < kStride * 32; ++i)
+          ASSERT_EQ(dst_ref[i], dst_tst[i]) << "tx_size: " << tx_size
+                                            << " r: " << i / kStride
+                                            << " c: " << i % kStride;
+      }
+    }
+  }
+};
+
+TEST_P(FilterIntraTest, RandomValues) { Check(false); }
+
+TEST_P(FilterIntraTest, ExtremeValues) { Check(true); }
+
+class HighbdFilterIntraTest
+    : public FunctionEquivalenceTest<HighbdFilterIntraFunc> {
+ protected:
+  void Check(int bd, bool extreme) {
+    const int max_val = (1 << bd) - 1;
+    DECLARE_ALIGNED(16, uint16_t, above[kEdgeSize]);
+    DECLARE_ALIGNED(16, uint16_t, left[kEdgeSize]);
+    DECLARE_ALIGNED(16, uint16_t, dst_ref[kStride * 32]);
+    DECLARE_ALIGNED(16, uint16_t, dst_tst[kStride * 32]);
+
+    for (int iter = 0; iter < 100 && !HasFatalFailure(); ++iter) {
+      for (int tx_size = 0; tx_size < TX_SIZES_ALL; ++tx_size) {
+        if (!IsValidTxSize(tx_size)) continue;
+        for (int i = 0; i < kEdgeSize; ++i) {
+          above[i] = extreme ? max_val * rng_(2) : rng_(max_val + 1);
+          left[i] = extreme ? max_val * rng_(2) : rng_(max_val + 1);
+        }
+        for (int i = 0; i < kStride * 32; ++i)
+          dst_ref[i] = dst_tst[i] = rng_(max_val + 1);
+
+        params_.ref_func(dst_ref, kStride, static_cast<TX_SIZE>(tx_size),
+                         above + 16, left, bd);
+        ASM_REGISTER_STATE_CHECK(
+            params_.tst_func(dst_tst, kStride, static_cast<TX_SIZE>(tx_size),
+                             above + 16, left, bd));
+
+        for (int i = 0; i < kStride * 32; ++i)
+          ASSERT_EQ(dst_ref[i], dst_tst[i]) << "tx_size: " << tx_size
+                                            << " r: " << i / kStride
+                                            << " c: " << i % kStride;
+      }
+    }
+  }
+};
+
+TEST_P(HighbdFilterIntraTest, RandomValues10Bit) { Check(10, false); }
+
+TEST_P(HighbdFilterIntraTest, RandomValues12Bit) { Check(12, false); }
+
+TEST_P(HighbdFilterIntraTest, ExtremeValues12Bit) { Check(12, true); }
+
+#if HAVE_SSE4_1
+typedef libaom_test::FuncParam<FilterIntraFunc> FilterIntraParam;
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, FilterIntraTest,
+    ::testing::Values(FilterIntraParam(av1_dc_filter_predictor_c,
+                                       av1_dc_filter_predictor_sse4_1),
+                      FilterIntraParam(av1_v_filter_predictor_c,
+                                       av1_v_filter_predictor_sse4_1),
+                      FilterIntraParam(av1_h_filter_predictor_c,
+                                       av1_h_filter_predictor_sse4_1),
+                      FilterIntraParam(av1_d153_filter_predictor_c,
+                                       av1_d153_filter_predictor_sse4_1),
+                      FilterIntraParam(av1_paeth_filter_predictor_c,
+                                       av1_paeth_filter_predictor_sse4_1)));
+
+typedef libaom_test::FuncParam<HighbdFilterIntraFunc> HighbdFilterIntraParam;
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, HighbdFilterIntraTest,
+    ::testing::Values(
+        HighbdFilterIntraParam(av1_highbd_dc_filter_predictor_c,
+                               av1_highbd_dc_filter_predictor_sse4_1),
+        HighbdFilterIntraParam(av1_highbd_v_filter_predictor_c,
+                               av1_highbd_v_filter_predictor_sse4_1),
+        HighbdFilterIntraParam(av1_highbd_h_filter_predictor_c,
+                               av1_highbd_h_filter_predictor_sse4_1),
+        HighbdFilterIntraParam(av1_highbd_d153_filter_predictor_c,
+                               av1_highbd_d153_filter_predictor_sse4_1),
+        HighbdFilterIntraParam(av1_highbd_paeth_filter_predictor_c,
+                               av1_highbd_paeth_filter_predictor_sse4_1)));
+#endif  // HAVE_SSE4_1
+
+}  // namespace
@@ -1,12 +1,47 @@
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
+#include "./aom_config.h"
+#include "./aom_dsp_rtcd.h"
 #include "./aom_dsp/noise_model.h"
 #include "./aom_dsp/noise_util.h"
+#include "aom_util/aom_thread.h"
+#include "test/acm_random.h"
 #include "third_party/googletest/src/googletest/include/gtest/gtest.h"
 
 extern "C" double aom_randn(double sigma);
 
+using libaom_test::ACMRandom;
+
+namespace {
+
+// Idle workers to split the noise model functions between. The last worker
+// runs on the calling thread and is not started.
+class TestWorkers {
+ public:
+  explicit TestWorkers(int num_workers) : workers_(num_workers) {
+    const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+    for (int i = 0; i < num_workers; ++i) {
+      winterface->init(&workers_[i]);
+      if (i < num_workers - 1) {
+        EXPECT_TRUE(winterface->reset(&workers_[i]));
+      }
+    }
+  }
+  ~TestWorkers() {
+    for (size_t i = 0; i < workers_.size(); ++i)
+      aom_get_worker_interface()->end(&workers_[i]);
+  }
+  AVxWorker *workers() { return &workers_[0]; }
+  int num_workers() const { return static_cast<int>(workers_.size()); }
+
+ private:
+  std::vector<AVxWorker> workers_;
+};
+
+}  // namespace
+
 TEST(NoiseStrengthSolver, GetCentersTwoBins) {
   aom_noise_strength_solver_t solver;
   aom_noise_strength_solver_init(&solver, 2);
@@ -268,7 +303,7 @@ TEST(FlatBlockEstimator, FindFlatBlocks) {
   }
 
   EXPECT_EQ(4, aom_flat_block_finder_run(&flat_block_finder, &data[0], w, h,
-                                         stride, &flat_blocks[0]));
+                                         stride, &flat_blocks[0], NULL, 0));
 
   // First two blocks are not flat
   EXPECT_EQ(0, flat_blocks[0]);
@@ -287,6 +322,46 @@ TEST(FlatBlockEstimator, FindFlatBlocks) {
   aom_flat_block_finder_free(&flat_block_finder);
 }
 
+TEST(FlatBlockEstimator, FindFlatBlocksThreaded) {
+  const int kBlockSize = 16;
+  // Not a multiple of the block size, so that the last row and column of
+  // blocks cross the frame edge.
+  const int w = 200;
+  const int h = 150;
+  const int stride = 208;
+  const int num_blocks = ((w + kBlockSize - 1) / kBlockSize) *
+                         ((h + kBlockSize - 1) / kBlockSize);
+  aom_flat_block_finder_t flat_block_finder;
+  ASSERT_EQ(1, aom_flat_block_finder_init(&flat_block_finder, kBlockSize));
+
+  // Flat noisy areas mixed with edges and textures.
+  std::vector<uint8_t> data(h * stride, 0);
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; ++x) {
+      const int texture = ((x / 24 + y / 40) % 3 == 0) ? ((x ^ y) & 12) : 0;
+      data[y * stride + x] =
+          (uint8_t)(aom_randn(2) + 64 + x / 4 + (y > 90 ? 48 : 0) + texture);
+    }
+  }
+
+  std::vector<uint8_t> flat_blocks(num_blocks, 0);
+  const int num_flat = aom_flat_block_finder_run(
+      &flat_block_finder, &data[0], w, h, stride, &flat_blocks[0], NULL, 0);
+  EXPECT_LT(0, num_flat);
+  EXPECT_GT(num_blocks, num_flat);
+
+  for (int num_workers = 2; num_workers <= 4; ++num_workers) {
+    TestWorkers workers(num_workers);
+    std::vector<uint8_t> threaded_flat_blocks(num_blocks, 0);
+    EXPECT_EQ(num_flat, aom_flat_block_finder_run(
+                            &flat_block_finder, &data[0], w, h, stride,
+                            &threaded_flat_blocks[0], workers.workers(),
+                            workers.num_workers()));
+    EXPECT_EQ(flat_blocks, threaded_flat_blocks);
+  }
+  aom_flat_block_finder_free(&flat_block_finder);
+}
+
 class NoiseModelUpdateTest : public ::testing::Test {
  public:
   static const int kWidth = 128;
@@ -341,7 +416,7 @@ TEST_F(NoiseModelUpdateTest, UpdateFailsNoFlatBlocks) {
   EXPECT_EQ(AOM_NOISE_STATUS_INSUFFICIENT_FLAT_BLOCKS,
             aom_noise_model_update(&model_, data_ptr_, denoised_ptr_, kWidth,
                                    kHeight, strides_, chroma_sub_,
-                                   &flat_blocks_[0], kBlockSize));
+                                   &flat_blocks_[0], kBlockSize, NULL, 0));
 }
 
 TEST_F(NoiseModelUpdateTest, UpdateSuccessForZeroNoiseAllFlat) {
@@ -351,7 +426,7 @@ TEST_F(NoiseModelUpdateTest, UpdateSuccessForZeroNoiseAllFlat) {
   EXPECT_EQ(AOM_NOISE_STATUS_INTERNAL_ERROR,
             aom_noise_model_update(&model_, data_ptr_, denoised_ptr_, kWidth,
                                    kHeight, strides_, chroma_sub_,
-                                   &flat_blocks_[0], kBlockSize));
+                                   &flat_blocks_[0], kBlockSize, NULL, 0));
 }
 
 TEST_F(NoiseModelUpdateTest, UpdateFailsBlockSizeTooSmall) {
@@ -362,7 +437,7 @@ TEST_F(NoiseModelUpdateTest, UpdateFailsBlockSizeTooSmall) {
       AOM_NOISE_STATUS_INVALID_ARGUMENT,
       aom_noise_model_update(&model_, data_ptr_, denoised_ptr_, kWidth, kHeight,
                              strides_, chroma_sub_, &flat_blocks_[0],
-                             6 /* block_size=2 is too small*/));
+                             6 /* block_size=2 is too small*/, NULL, 0));
 }
 
 TEST_F(NoiseModelUpdateTest, UpdateSuccessForWhiteRandomNoise) {
@@ -381,7 +456,7 @@ TEST_F(NoiseModelUpdateTest, UpdateSuccessForWhiteRandomNoise) {
   EXPECT_EQ(AOM_NOISE_STATUS_OK,
             aom_noise_model_update(&model_, data_ptr_, denoised_ptr_, kWidth,
                                    kHeight, strides_, chroma_sub_,
-                                   &flat_blocks_[0], kBlockSize));
+                                   &flat_blocks_[0], kBlockSize, NULL, 0));
 
   const double kCoeffEps = 0.075;
   const int n = model_.n;
@@ -443,7 +518,7 @@ TEST_F(NoiseModelUpdateTest, UpdateSuccessForScaledWhiteNoise) {
   EXPECT_EQ(AOM_NOISE_STATUS_OK,
             aom_noise_model_update(&model_, data_ptr_, denoised_ptr_, kWidth,
                                    kHeight, strides_, chroma_sub_,
-                                   &flat_blocks_[0], kBlockSize));
+                                   &flat_blocks_[0], kBlockSize, NULL, 0));
 
   const int n = model_.n;
   // The noise is uncorrelated spatially and with the y channel.
@@ -519,7 +594,7 @@ TEST_F(NoiseModelUpdateTest, UpdateSuccessForCorrelatedNoise) {
   EXPECT_EQ(AOM_NOISE_STATUS_OK,
             aom_noise_model_update(&model_, data_ptr_, denoised_ptr_, kWidth,
                                    kHeight, strides_, chroma_sub_,
-                                   &flat_blocks_[0], kBlockSize));
+                                   &flat_blocks_[0], kBlockSize, NULL, 0));
 
   // For the Y plane, the solved coefficients should be close to the original
   const int n = model_.n;
@@ -556,3 +631,101 @@ TEST_F(NoiseModelUpdateTest, UpdateSuccessForCorrelatedNoise) {
                 kStdEps);
   }
 }
+
+TEST_F(NoiseModelUpdateTest, UpdateIsIndependentOfThreads) {
+  const double kCoeffs[24] = {
+    0.02884, -0.03356, 0.00633,  0.01757,  0.02849,  -0.04620,
+    0.02833, -0.07178, 0.07076,  -0.11603, -0.10413, -0.16571,
+    0.05158, -0.07969, 0.02640,  -0.07191, 0.02530,  0.41968,
+    0.21450, -0.00702, -0.01401, -0.03676, -0.08713, 0.44196,
+  };
+  ASSERT_EQ(24, model_.n);
+  aom_noise_synth(model_.params.lag, model_.n, model_.coords, kCoeffs,
+                  &noise_[0], kWidth, kHeight);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      for (int c = 0; c < 3; ++c) {
+        const uint8_t value = 64 + x / 2 + y / 4;
+        denoised_ptr_[c][y * kWidth + x] = value;
+        data_ptr_[c][y * kWidth + x] =
+            uint8_t(value + noise_[y * kWidth + x] * 4 + aom_randn(1));
+      }
+    }
+  }
+  for (size_t i = 0; i < flat_blocks_.size(); ++i) flat_blocks_[i] = i % 5 > 0;
+  ASSERT_EQ(AOM_NOISE_STATUS_OK,
+            aom_noise_model_update(&model_, data_ptr_, denoised_ptr_, kWidth,
+                                   kHeight, strides_, chroma_sub_,
+                                   &flat_blocks_[0], kBlockSize, NULL, 0));
+
+  TestWorkers workers(3);
+  aom_noise_model_t threaded_model;
+  ASSERT_TRUE(aom_noise_model_init(&threaded_model, model_.params));
+  ASSERT_EQ(AOM_NOISE_STATUS_OK,
+            aom_noise_model_update(&threaded_model, data_ptr_, denoised_ptr_,
+                                   kWidth, kHeight, strides_, chroma_sub_,
+                                   &flat_blocks_[0], kBlockSize,
+                                   workers.workers(), workers.num_workers()));
+  for (int c = 0; c < 3; ++c) {
+    const aom_equation_system_t &eqns = model_.latest_state[c].eqns;
+    const aom_equation_system_t &threaded_eqns =
+        threaded_model.latest_state[c].eqns;
+    const aom_equation_system_t &strength =
+        model_.latest_state[c].strength_solver.eqns;
+    const aom_equation_system_t &threaded_strength =
+        threaded_model.latest_state[c].strength_solver.eqns;
+    for (int i = 0; i < eqns.n; ++i) {
+      for (int j = 0; j < eqns.n; ++j)
+        EXPECT_EQ(eqns.A[i * eqns.n + j], threaded_eqns.A[i * eqns.n + j]);
+      EXPECT_EQ(eqns.b[i], threaded_eqns.b[i]);
+      EXPECT_EQ(eqns.x[i], threaded_eqns.x[i]);
+    }
+    for (int i = 0; i < strength.n; ++i)
+      EXPECT_EQ(strength.x[i], threaded_strength.x[i]);
+  }
+  aom_noise_model_free(&threaded_model);
+}
+
+#if HAVE_SSE2
+TEST(NoiseModelSimd, FlatBlockMomentsMatchC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kStride = 160;
+  std::vector<uint8_t> data(kStride * 128);
+  for (int block_size = 8; block_size <= 128; block_size += 8) {
+    for (int iter = 0; iter < 20; ++iter) {
+      // Alternate random and extreme data to exercise the largest sums.
+      for (size_t i = 0; i < data.size(); ++i)
+        data[i] = (iter % 4 == 0) ? (i & 1) * 255 : rnd.Rand8();
+      aom_flat_block_moments_t ref, simd;
+      aom_flat_block_get_moments_c(&data[0], kStride, block_size, &ref);
+      aom_flat_block_get_moments_sse2(&data[0], kStride, block_size, &simd);
+      EXPECT_EQ(0, memcmp(&ref, &simd, sizeof(ref)))
+          << "block_size " << block_size;
+    }
+  }
+}
+
+TEST(NoiseModelSimd, AccumulateCovarianceMatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int n = 1; n <= 42; ++n) {
+    const int stride = (n + 7) & ~7;
+    for (int num_samples = 0; num_samples <= 9; ++num_samples) {
+      std::vector<int16_t> samples(num_samples * stride + 1, 0);
+      std::vector<int32_t> ref(n * stride, 0), simd(n * stride, 0);
+      for (int k = 0; k < num_samples; ++k) {
+        for (int i = 0; i < n; ++i)
+          samples[k * stride + i] = rnd.Rand9Signed() % 256;
+      }
+      aom_noise_accumulate_covariance_c(&samples[0], num_samples, n, stride,
+                                        &ref[0]);
+      aom_noise_accumulate_covariance_sse2(&samples[0], num_samples, n,
+                                           stride, &simd[0]);
+      for (int i = 0; i < n; ++i) {
+        for (int j = i; j < n; ++j)
+          ASSERT_EQ(ref[i * stride + j], simd[i * stride + j])
+              << "n " << n << " samples " << num_samples;
+      }
+    }
+  }
+}
+#endif  // HAVE_SSE2
@@ -77,6 +77,7 @@ if (NOT BUILD_SHARED_LIBS)
   if (HAVE_SSE2)
     set(AOM_UNIT_TEST_COMMON_SOURCES
         ${AOM_UNIT_TEST_COMMON_SOURCES}
+        "${AOM_ROOT}/test/av1_resize_cols_test.cc"
         "${AOM_ROOT}/test/warp_filter_test.cc"
         "${AOM_ROOT}/test/warp_filter_test_util.cc"
         "${AOM_ROOT}/test/warp_filter_test_util.h")
@@ -123,6 +124,7 @@ if (NOT BUILD_SHARED_LIBS)
         ${AOM_UNIT_TEST_COMMON_SOURCES}
         "${AOM_ROOT}/test/av1_convolve_optimz_test.cc"
         "${AOM_ROOT}/test/av1_convolve_test.cc"
+        "${AOM_ROOT}/test/dr_prediction_test.cc"
         "${AOM_ROOT}/test/intrapred_test.cc"
         "${AOM_ROOT}/test/lpf_test.cc"
         "${AOM_ROOT}/test/simd_cmp_impl.h")
@@ -135,6 +137,12 @@ if (NOT BUILD_SHARED_LIBS)
         ${AOM_UNIT_TEST_COMMON_SOURCES}
         "${AOM_ROOT}/test/cdef_test.cc")
 
+    if (CONFIG_FILTER_INTRA)
+      set(AOM_UNIT_TEST_COMMON_SOURCES
+          ${AOM_UNIT_TEST_COMMON_SOURCES}
+          "${AOM_ROOT}/test/filterintra_test.cc")
+    endif ()
+
     if (CONFIG_INTRABC)
         set(AOM_UNIT_TEST_COMMON_SOURCES
             ${AOM_UNIT_TEST_COMMON_SOURCES}
@@ -214,6 +222,7 @@ if (CONFIG_AV1_ENCODER)
         "${AOM_ROOT}/test/av1_inv_txfm1d_test.cc"
         "${AOM_ROOT}/test/av1_inv_txfm2d_test.cc"
         "${AOM_ROOT}/test/av1_inv_txfm_test.cc"
+        "${AOM_ROOT}/test/av1_k_means_test.cc"
         "${AOM_ROOT}/test/av1_wedge_utils_test.cc"
         "${AOM_ROOT}/test/avg_test.cc"
         "${AOM_ROOT}/test/blend_a64_mask_1d_test.cc"
@@ -290,6 +299,7 @@ if (NOT BUILD_SHARED_LIBS)
   if (CONFIG_AV1_DECODER AND CONFIG_AV1_ENCODER)
     set(AOM_UNIT_TEST_COMMON_SOURCES
         ${AOM_UNIT_TEST_COMMON_SOURCES}
+        "${AOM_ROOT}/test/decode_threads_test.cc"
         "${AOM_ROOT}/test/divu_small_test.cc"
         "${AOM_ROOT}/test/ethread_test.cc"
         "${AOM_ROOT}/test/coding_path_sync.cc"
@@ -202,6 +202,46 @@ class DummyVideoSource : public VideoSource {
   aom_img_fmt_t format_;
 };
 
+// Generates a deterministic moving test pattern with both smooth gradients and
+// hard edges, so that benchmarks can produce representative streams without
+// external test vectors. Use SetImageFormat(AOM_IMG_FMT_I42016) together with
+// a bit depth greater than 8 to produce high bitdepth input.
+class PatternVideoSource : public DummyVideoSource {
+ public:
+  explicit PatternVideoSource(unsigned int bit_depth = 8)
+      : bit_depth_(bit_depth) {}
+
+ protected:
+  virtual void FillFrame() {
+    if (!img_) return;
+    const int shift = bit_depth_ > 8 ? bit_depth_ - 8 : 0;
+    for (int plane = 0; plane < 3; ++plane) {
+      const unsigned int w =
+          plane ? (img_->d_w + img_->x_chroma_shift) >> img_->x_chroma_shift
+                : img_->d_w;
+      const unsigned int h =
+          plane ? (img_->d_h + img_->y_chroma_shift) >> img_->y_chroma_shift
+                : img_->d_h;
+      for (unsigned int y = 0; y < h; ++y) {
+        uint8_t *const row = img_->planes[plane] + y * img_->stride[plane];
+        for (unsigned int x = 0; x < w; ++x) {
+          // A diagonal gradient panning across the frame, overlaid with a
+          // checkerboard that moves at a different speed.
+          int v = (3 * x + 2 * y + 4 * frame_ + 64 * plane) & 0xff;
+          if ((((x + frame_) >> 4) + ((y + 2 * frame_) >> 4)) & 1) v ^= 0x3f;
+          if (img_->fmt & AOM_IMG_FMT_HIGHBITDEPTH)
+            reinterpret_cast<uint16_t *>(row)[x] =
+                static_cast<uint16_t>(v << shift);
+          else
+            row[x] = static_cast<uint8_t>(v);
+        }
+      }
+    }
+  }
+
+  unsigned int bit_depth_;
+};
+
 class RandomVideoSource : public DummyVideoSource {
  public:
   RandomVideoSource(int seed = ACMRandom::DeterministicSeed())
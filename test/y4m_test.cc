@@ -9,12 +9,16 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
 */
 
+#include <string.h>
+
 #include <string>
+#include <vector>
 
 #include "third_party/googletest/src/googletest/include/gtest/gtest.h"
 
 #include "./aom_config.h"
 #include "./y4menc.h"
+#include "test/acm_random.h"
 #include "test/md5_helper.h"
 #include "test/util.h"
 #include "test/y4m_video_source.h"
@@ -189,4 +193,158 @@ TEST_P(Y4mVideoWriteTest, WriteTest) {
 
 INSTANTIATE_TEST_CASE_P(C, Y4mVideoWriteTest,
                         ::testing::ValuesIn(kY4mTestVectors));
+
+static const int kConvertWidth = 75;
+static const int kConvertHeight = 21;
+static const int kConvertFrames = 3;
+
+struct Y4mConvertParam {
+  const char *chroma_type;
+  int src_c_dec_h;
+  int src_c_dec_v;
+};
+
+const Y4mConvertParam kY4mConvertParams[] = {
+  { "420jpeg", 2, 2 }, { "420mpeg2", 2, 2 }, { "422jpeg", 2, 1 },
+  { "422", 2, 1 },     { "444", 1, 1 },
+};
+
+static int ClampTap(int v, int size) {
+  return v < 0 ? 0 : (v >= size ? size - 1 : v);
+}
+
+static uint8_t ClampPixel(int v) {
+  return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// Plain C versions of the y4m chroma filters, with the taps clamped to the
+// plane. The reader's SSE2 paths must match them exactly.
+static std::vector<uint8_t> ShiftRows(const std::vector<uint8_t> &src, int w,
+                                      int h) {
+  std::vector<uint8_t> dst(w * h);
+  for (int y = 0; y < h; ++y) {
+    const uint8_t *const s = &src[y * w];
+    for (int x = 0; x < w; ++x) {
+      dst[y * w + x] = ClampPixel(
+          (4 * s[ClampTap(x - 2, w)] - 17 * s[ClampTap(x - 1, w)] +
+           114 * s[x] + 35 * s[ClampTap(x + 1, w)] -
+           9 * s[ClampTap(x + 2, w)] + s[ClampTap(x + 3, w)] + 64) >>
+          7);
+    }
+  }
+  return dst;
+}
+
+static int Decimate(const uint8_t *s, int stride, int i, int size) {
+  return (3 * (s[ClampTap(i - 2, size) * stride] +
+               s[ClampTap(i + 3, size) * stride]) -
+          17 * (s[ClampTap(i - 1, size) * stride] +
+                s[ClampTap(i + 2, size) * stride]) +
+          78 * (s[i * stride] + s[ClampTap(i + 1, size) * stride]) + 64) >>
+         7;
+}
+
+static std::vector<uint8_t> DecimateColumns(const std::vector<uint8_t> &src,
+                                            int w, int h) {
+  const int dst_w = (w + 1) / 2;
+  std::vector<uint8_t> dst(dst_w * h);
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; x += 2) {
+      dst[y * dst_w + x / 2] = ClampPixel(Decimate(&src[y * w], 1, x, w));
+    }
+  }
+  return dst;
+}
+
+static std::vector<uint8_t> DecimateRows(const std::vector<uint8_t> &src,
+                                         int w, int h) {
+  std::vector<uint8_t> dst(w * ((h + 1) / 2));
+  for (int y = 0; y < h; y += 2) {
+    for (int x = 0; x < w; ++x) {
+      dst[y / 2 * w + x] = ClampPixel(Decimate(&src[x], w, y, h));
+    }
+  }
+  return dst;
+}
+
+// Converts one chroma plane to 4:2:0 jpeg siting, as the reader does when
+// only 4:2:0 output is allowed.
+static std::vector<uint8_t> ConvertChroma(const std::string &chroma_type,
+                                          const std::vector<uint8_t> &src,
+                                          int w, int h) {
+  if (chroma_type == "420mpeg2") return ShiftRows(src, w, h);
+  if (chroma_type == "422jpeg") return DecimateRows(src, w, h);
+  if (chroma_type == "422") return DecimateRows(ShiftRows(src, w, h), w, h);
+  if (chroma_type == "444") {
+    return DecimateRows(DecimateColumns(src, w, h), (w + 1) / 2, h);
+  }
+  return src;
+}
+
+// Writes a y4m file of random frames, reads it back with the y4m reader and
+// checks every plane against the C conversion of the written data.
+class Y4mConvertTest : public ::testing::TestWithParam<Y4mConvertParam> {};
+
+TEST_P(Y4mConvertTest, MatchesReference) {
+  const Y4mConvertParam param = GetParam();
+  const int c_w = (kConvertWidth + param.src_c_dec_h - 1) / param.src_c_dec_h;
+  const int c_h = (kConvertHeight + param.src_c_dec_v - 1) / param.src_c_dec_v;
+  const int dst_c_w = (kConvertWidth + 1) / 2;
+  const int dst_c_h = (kConvertHeight + 1) / 2;
+  libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+  libaom_test::TempOutFile tmpfile;
+  FILE *const file = tmpfile.file();
+  std::vector<std::vector<uint8_t> > planes[3];
+  ASSERT_TRUE(file != NULL);
+
+  fprintf(file, "YUV4MPEG2 W%d H%d F30:1 Ip A1:1 C%s\n", kConvertWidth,
+          kConvertHeight, param.chroma_type);
+  for (int i = 0; i < kConvertFrames; ++i) {
+    fputs("FRAME\n", file);
+    for (int plane = 0; plane < 3; ++plane) {
+      const int size = plane ? c_w * c_h : kConvertWidth * kConvertHeight;
+      std::vector<uint8_t> data(size);
+      for (int j = 0; j < size; ++j) data[j] = rnd.Rand8();
+      ASSERT_EQ(fwrite(&data[0], 1, size, file), (size_t)size);
+      planes[plane].push_back(
+          plane ? ConvertChroma(param.chroma_type, data, c_w, c_h) : data);
+    }
+  }
+  ASSERT_EQ(fflush(file), 0);
+  rewind(file);
+
+  y4m_input y4m = y4m_input();
+  aom_image_t first;
+  ASSERT_EQ(y4m_input_open(&y4m, file, NULL, 0, 1), 0);
+  for (int i = 0; i < kConvertFrames; ++i) {
+    aom_image_t img;
+    ASSERT_EQ(y4m_input_fetch_frame(&y4m, file, &img), 1);
+    ASSERT_EQ(img.fmt, AOM_IMG_FMT_I420);
+    for (int plane = 0; plane < 3; ++plane) {
+      const int w = plane ? dst_c_w : kConvertWidth;
+      const int h = plane ? dst_c_h : kConvertHeight;
+      for (int y = 0; y < h; ++y) {
+        ASSERT_EQ(memcmp(img.planes[plane] + y * img.stride[plane],
+                         &planes[plane][i][y * w], w),
+                  0)
+            << "frame " << i << " plane " << plane << " row " << y;
+      }
+    }
+    if (i == 0) first = img;
+  }
+  // Frames are handed out in place when the file is mapped and needs no
+  // conversion, and stay valid after later frames are read.
+  if (HAVE_MMAP && !strcmp(param.chroma_type, "420jpeg")) {
+    ASSERT_TRUE(y4m_input_frame_is_mapped(&y4m, &first));
+    ASSERT_EQ(memcmp(first.planes[0], &planes[0][0][0],
+                     kConvertWidth * kConvertHeight),
+              0);
+  }
+  aom_image_t img;
+  EXPECT_EQ(y4m_input_fetch_frame(&y4m, file, &img), 0);
+  y4m_input_close(&y4m);
+}
+
+INSTANTIATE_TEST_CASE_P(C, Y4mConvertTest,
+                        ::testing::ValuesIn(kY4mConvertParams));
 }  // namespace
@@ -11,10 +11,24 @@
  * Based on code from the OggTheora software codec source code,
  * Copyright (C) 2002-2010 The Xiph.Org Foundation and contributors.
  */
+#define _POSIX_C_SOURCE 200112L  // fileno(), ftello(), posix_madvise()
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "./aom_config.h"
+#if HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#if HAVE_SSE2 && (defined(__SSE2__) || defined(_M_X64) || \
+                  (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define Y4M_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define Y4M_USE_SSE2 0
+#endif
+
 #include "aom/aom_integer.h"
 #include "y4minput.h"
 
@@ -139,6 +153,51 @@ static int y4m_parse_tags(y4m_input *_y4m, char *_tags) {
 #define OC_MAXI(_a, _b) ((_a) < (_b) ? (_b) : (_a))
 #define OC_CLAMPI(_a, _b, _c) (OC_MAXI(_a, OC_MINI(_b, _c)))
 
+#if Y4M_USE_SSE2
+/*Loads 8 pixels, widened to 16 bits.*/
+static __m128i y4m_load_8_sse2(const unsigned char *_src) {
+  return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)_src),
+                           _mm_setzero_si128());
+}
+
+/*Loads every other pixel of the next 16, widened to 16 bits.*/
+static __m128i y4m_load_even_8_sse2(const unsigned char *_src) {
+  return _mm_and_si128(_mm_loadu_si128((const __m128i *)_src),
+                       _mm_set1_epi16(0xFF));
+}
+
+/*The SSE2 filters sum the positive and negative taps separately, so that both
+   sums fit in unsigned 16-bit lanes.
+  The saturating subtraction then clamps negative results to 0, and packing
+   the results clamps them to 255, exactly matching OC_CLAMPI().*/
+
+/*Applies the [3 -17 78 78 -17 3]/128 filter to 8 sets of taps.*/
+static __m128i y4m_filter_decimate_sse2(__m128i _a, __m128i _b, __m128i _c,
+                                        __m128i _d, __m128i _e, __m128i _f) {
+  const __m128i pos = _mm_add_epi16(
+      _mm_add_epi16(
+          _mm_mullo_epi16(_mm_add_epi16(_a, _f), _mm_set1_epi16(3)),
+          _mm_mullo_epi16(_mm_add_epi16(_c, _d), _mm_set1_epi16(78))),
+      _mm_set1_epi16(64));
+  const __m128i neg =
+      _mm_mullo_epi16(_mm_add_epi16(_b, _e), _mm_set1_epi16(17));
+  return _mm_srli_epi16(_mm_subs_epu16(pos, neg), 7);
+}
+
+/*Applies the [4 -17 114 35 -9 1]/128 filter to 8 sets of taps.*/
+static __m128i y4m_filter_shift_sse2(__m128i _a, __m128i _b, __m128i _c,
+                                     __m128i _d, __m128i _e, __m128i _f) {
+  const __m128i pos = _mm_add_epi16(
+      _mm_add_epi16(_mm_add_epi16(_mm_slli_epi16(_a, 2), _f),
+                    _mm_add_epi16(_mm_mullo_epi16(_c, _mm_set1_epi16(114)),
+                                  _mm_mullo_epi16(_d, _mm_set1_epi16(35)))),
+      _mm_set1_epi16(64));
+  const __m128i neg = _mm_add_epi16(_mm_mullo_epi16(_b, _mm_set1_epi16(17)),
+                                    _mm_mullo_epi16(_e, _mm_set1_epi16(9)));
+  return _mm_srli_epi16(_mm_subs_epu16(pos, neg), 7);
+}
+#endif
+
 /*420jpeg chroma samples are sited like:
   Y-------Y-------Y-------Y-------
   |       |       |       |
@@ -198,6 +257,15 @@ static void y4m_42xmpeg2_42xjpeg_helper(unsigned char *_dst,
               7,
           255);
     }
+#if Y4M_USE_SSE2
+    for (; x + 8 <= _c_w - 3; x += 8) {
+      const __m128i r = y4m_filter_shift_sse2(
+          y4m_load_8_sse2(_src + x - 2), y4m_load_8_sse2(_src + x - 1),
+          y4m_load_8_sse2(_src + x), y4m_load_8_sse2(_src + x + 1),
+          y4m_load_8_sse2(_src + x + 2), y4m_load_8_sse2(_src + x + 3));
+      _mm_storel_epi64((__m128i *)(_dst + x), _mm_packus_epi16(r, r));
+    }
+#endif
     for (; x < _c_w - 3; x++) {
       _dst[x] = (unsigned char)OC_CLAMPI(
           0,
@@ -400,38 +468,42 @@ static void y4m_422jpeg_420jpeg_helper(unsigned char *_dst,
                                        int _c_h) {
   int y;
   int x;
-  /*Filter: [3 -17 78 78 -17 3]/128, derived from a 6-tap Lanczos window.*/
-  for (x = 0; x < _c_w; x++) {
-    for (y = 0; y < OC_MINI(_c_h, 2); y += 2) {
-      _dst[(y >> 1) * _c_w] =
-          OC_CLAMPI(0,
-                    (64 * _src[0] + 78 * _src[OC_MINI(1, _c_h - 1) * _c_w] -
-                     17 * _src[OC_MINI(2, _c_h - 1) * _c_w] +
-                     3 * _src[OC_MINI(3, _c_h - 1) * _c_w] + 64) >>
-                        7,
-                    255);
+  /*Filter: [3 -17 78 78 -17 3]/128, derived from a 6-tap Lanczos window.
+    Taps above and below the plane are clamped to the edge rows, so each output
+     row is a whole row of contiguous pixels filtered from six input rows.*/
+  for (y = 0; y < _c_h; y += 2) {
+    const unsigned char *r[6];
+    int k;
+    for (k = 0; k < 6; k++) {
+      r[k] = _src + OC_CLAMPI(0, y + k - 2, _c_h - 1) * _c_w;
     }
-    for (; y < _c_h - 3; y += 2) {
-      _dst[(y >> 1) * _c_w] =
-          OC_CLAMPI(0,
-                    (3 * (_src[(y - 2) * _c_w] + _src[(y + 3) * _c_w]) -
-                     17 * (_src[(y - 1) * _c_w] + _src[(y + 2) * _c_w]) +
-                     78 * (_src[y * _c_w] + _src[(y + 1) * _c_w]) + 64) >>
-                        7,
-                    255);
+    x = 0;
+#if Y4M_USE_SSE2
+    for (; x + 16 <= _c_w; x += 16) {
+      const __m128i zero = _mm_setzero_si128();
+      __m128i lo[6];
+      __m128i hi[6];
+      for (k = 0; k < 6; k++) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(r[k] + x));
+        lo[k] = _mm_unpacklo_epi8(v, zero);
+        hi[k] = _mm_unpackhi_epi8(v, zero);
+      }
+      _mm_storeu_si128(
+          (__m128i *)(_dst + x),
+          _mm_packus_epi16(y4m_filter_decimate_sse2(lo[0], lo[1], lo[2], lo[3],
+                                                    lo[4], lo[5]),
+                           y4m_filter_decimate_sse2(hi[0], hi[1], hi[2], hi[3],
+                                                    hi[4], hi[5])));
     }
-    for (; y < _c_h; y += 2) {
-      _dst[(y >> 1) * _c_w] = OC_CLAMPI(
-          0,
-          (3 * (_src[(y - 2) * _c_w] + _src[(_c_h - 1) * _c_w]) -
-           17 * (_src[(y - 1) * _c_w] + _src[OC_MINI(y + 2, _c_h - 1) * _c_w]) +
-           78 * (_src[y * _c_w] + _src[OC_MINI(y + 1, _c_h - 1) * _c_w]) +
-           64) >>
-              7,
-          255);
+#endif
+    for (; x < _c_w; x++) {
+      _dst[x] = OC_CLAMPI(0,
+                          (3 * (r[0][x] + r[5][x]) - 17 * (r[1][x] + r[4][x]) +
+                           78 * (r[2][x] + r[3][x]) + 64) >>
+                              7,
+                          255);
     }
-    _src++;
-    _dst++;
+    _dst += _c_w;
   }
 }
 
@@ -732,6 +804,17 @@ static void y4m_convert_444_420jpeg(y4m_input *_y4m, unsigned char *_dst,
                                     7,
                                 255);
       }
+#if Y4M_USE_SSE2
+      for (; x + 19 <= c_w; x += 16) {
+        const __m128i r = y4m_filter_decimate_sse2(
+            y4m_load_even_8_sse2(_aux + x - 2),
+            y4m_load_even_8_sse2(_aux + x - 1), y4m_load_even_8_sse2(_aux + x),
+            y4m_load_even_8_sse2(_aux + x + 1),
+            y4m_load_even_8_sse2(_aux + x + 2),
+            y4m_load_even_8_sse2(_aux + x + 3));
+        _mm_storel_epi64((__m128i *)(tmp + (x >> 1)), _mm_packus_epi16(r, r));
+      }
+#endif
       for (; x < c_w - 3; x += 2) {
         tmp[x >> 1] = OC_CLAMPI(0,
                                 (3 * (_aux[x - 2] + _aux[x + 3]) -
@@ -778,6 +861,51 @@ static void y4m_convert_null(y4m_input *_y4m, unsigned char *_dst,
   (void)_aux;
 }
 
+#if HAVE_MMAP
+/*Maps a regular input file into memory, so that frames can be handed out in
+   place instead of being copied out of the file.
+  Pipes and other inputs that cannot be mapped are read with fread().
+  The mapping is private and writable, so callers may still modify the frames
+   they are given without touching the file.*/
+static void y4m_input_map(y4m_input *_y4m, FILE *_fin) {
+  struct stat st;
+  const off_t pos = ftello(_fin);
+  void *map;
+  if (pos < 0 || fstat(fileno(_fin), &st) || !S_ISREG(st.st_mode)) return;
+  if (st.st_size <= pos || (uint64_t)st.st_size > SIZE_MAX) return;
+  map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+             fileno(_fin), 0);
+  if (map == MAP_FAILED) return;
+  posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+  _y4m->map = (unsigned char *)map;
+  _y4m->map_sz = (size_t)st.st_size;
+  _y4m->map_pos = (size_t)pos;
+}
+
+/*Returns the data of the next frame in the mapped input and advances past it,
+   or returns NULL if the mapping does not hold the whole frame, leaving it to
+   the fread() path to read the frame or report the error.*/
+static unsigned char *y4m_input_map_frame(y4m_input *_y4m, FILE *_fin) {
+  unsigned char *frame = _y4m->map + _y4m->map_pos;
+  const size_t avail = _y4m->map_sz - _y4m->map_pos;
+  const size_t frame_sz = _y4m->dst_buf_read_sz + _y4m->aux_buf_read_sz;
+  size_t hdr_sz;
+  if (avail < 6 || memcmp(frame, "FRAME", 5)) return NULL;
+  /*The frame header is at most 85 bytes, as in y4m_input_fetch_frame().*/
+  for (hdr_sz = 5; hdr_sz < OC_MINI(avail, 85) && frame[hdr_sz] != '\n';
+       hdr_sz++) {
+  }
+  if (hdr_sz == OC_MINI(avail, 85)) return NULL;
+  hdr_sz++;
+  if (avail - hdr_sz < frame_sz) return NULL;
+  _y4m->map_pos += hdr_sz + frame_sz;
+  /*Keep the file position in step, for progress reporting and in case a
+     later frame has to be read with fread().*/
+  fseeko(_fin, (off_t)_y4m->map_pos, SEEK_SET);
+  return frame + hdr_sz;
+}
+#endif
+
 int y4m_input_open(y4m_input *_y4m, FILE *_fin, char *_skip, int _nskip,
                    int only_420) {
   char buffer[80] = { 0 };
@@ -1071,21 +1199,26 @@ int y4m_input_open(y4m_input *_y4m, FILE *_fin, char *_skip, int _nskip,
 
   if (_y4m->aux_buf_sz > 0)
     _y4m->aux_buf = (unsigned char *)malloc(_y4m->aux_buf_sz);
+  _y4m->map = NULL;
+  _y4m->map_sz = _y4m->map_pos = 0;
+#if HAVE_MMAP
+  y4m_input_map(_y4m, _fin);
+#endif
   return 0;
 }
 
 void y4m_input_close(y4m_input *_y4m) {
   free(_y4m->dst_buf);
   free(_y4m->aux_buf);
+#if HAVE_MMAP
+  if (_y4m->map != NULL) munmap(_y4m->map, _y4m->map_sz);
+#endif
 }
 
-int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, aom_image_t *_img) {
+/*Reads the next frame with fread(). Returns 1 on success, 0 at the end of the
+   input and -1 on error.*/
+static int y4m_input_read_frame(y4m_input *_y4m, FILE *_fin) {
   char frame[6];
-  int pic_sz;
-  int c_w;
-  int c_h;
-  int c_sz;
-  int bytes_per_sample = _y4m->bit_depth > 8 ? 2 : 1;
   /*Read and skip the frame header.*/
   if (!file_read(frame, 6, _fin)) return 0;
   if (memcmp(frame, "FRAME", 5)) {
@@ -1112,6 +1245,40 @@ int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, aom_image_t *_img) {
     fprintf(stderr, "Error reading Y4M frame data.\n");
     return -1;
   }
+  return 1;
+}
+
+int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, aom_image_t *_img) {
+  /*The buffers the luma and the remaining planes are found in.*/
+  unsigned char *luma_buf = _y4m->dst_buf;
+  unsigned char *buf = _y4m->dst_buf;
+  int pic_sz;
+  int c_w;
+  int c_h;
+  int c_sz;
+  int bytes_per_sample = _y4m->bit_depth > 8 ? 2 : 1;
+  unsigned char *frame = NULL;
+#if HAVE_MMAP
+  if (_y4m->map != NULL) frame = y4m_input_map_frame(_y4m, _fin);
+#endif
+  if (frame == NULL) {
+    const int ret = y4m_input_read_frame(_y4m, _fin);
+    if (ret <= 0) return ret;
+  } else {
+    if ((uintptr_t)frame & (bytes_per_sample - 1)) {
+      /*Misaligned high bit depth samples cannot be used in place.*/
+      memcpy(_y4m->dst_buf, frame, _y4m->dst_buf_read_sz);
+    } else {
+      /*The data read into dst_buf needs no conversion, and always starts with
+         the luma plane.*/
+      luma_buf = frame;
+      if (_y4m->convert == y4m_convert_null) buf = frame;
+    }
+    if (_y4m->aux_buf_read_sz > 0) {
+      memcpy(_y4m->aux_buf, frame + _y4m->dst_buf_read_sz,
+             _y4m->aux_buf_read_sz);
+    }
+  }
   /*Now convert the just read frame.*/
   (*_y4m->convert)(_y4m, _y4m->dst_buf, _y4m->aux_buf);
   /*Fill in the frame buffer pointers.
@@ -1135,9 +1302,24 @@ int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, aom_image_t *_img) {
   _img->stride[AOM_PLANE_Y] = _img->stride[AOM_PLANE_ALPHA] =
       _y4m->pic_w * bytes_per_sample;
   _img->stride[AOM_PLANE_U] = _img->stride[AOM_PLANE_V] = c_w;
-  _img->planes[AOM_PLANE_Y] = _y4m->dst_buf;
-  _img->planes[AOM_PLANE_U] = _y4m->dst_buf + pic_sz;
-  _img->planes[AOM_PLANE_V] = _y4m->dst_buf + pic_sz + c_sz;
-  _img->planes[AOM_PLANE_ALPHA] = _y4m->dst_buf + pic_sz + 2 * c_sz;
+  _img->planes[AOM_PLANE_Y] = luma_buf;
+  _img->planes[AOM_PLANE_U] = buf + pic_sz;
+  _img->planes[AOM_PLANE_V] = buf + pic_sz + c_sz;
+  _img->planes[AOM_PLANE_ALPHA] = buf + pic_sz + 2 * c_sz;
+  return 1;
+}
+
+/*Returns 1 if all planes of a frame returned by y4m_input_fetch_frame() point
+   into the mapped input file, and 0 if any of them is in the reader's own
+   buffer.
+  Mapped frames are not overwritten by later fetches and stay valid until
+   y4m_input_close(), so they can be used without being copied.*/
+int y4m_input_frame_is_mapped(const y4m_input *_y4m, const aom_image_t *_img) {
+  int pli;
+  if (_y4m->map == NULL) return 0;
+  for (pli = 0; pli < 3; pli++) {
+    const unsigned char *plane = _img->planes[pli];
+    if (plane < _y4m->map || plane >= _y4m->map + _y4m->map_sz) return 0;
+  }
   return 1;
 }
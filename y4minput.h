@@ -52,6 +52,12 @@ struct y4m_input {
   y4m_convert_func convert;
   unsigned char *dst_buf;
   unsigned char *aux_buf;
+  /*The input file mapped into memory, or NULL if it is read with fread().*/
+  unsigned char *map;
+  /*The size of the mapping.*/
+  size_t map_sz;
+  /*The offset of the next frame header in the mapping.*/
+  size_t map_pos;
   enum aom_img_fmt aom_fmt;
   int bps;
   unsigned int bit_depth;
@@ -61,6 +67,7 @@ int y4m_input_open(y4m_input *_y4m, FILE *_fin, char *_skip, int _nskip,
                    int only_420);
 void y4m_input_close(y4m_input *_y4m);
 int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, aom_image_t *img);
+int y4m_input_frame_is_mapped(const y4m_input *_y4m, const aom_image_t *img);
 
 #ifdef __cplusplus
 }  // extern "C"